@@ -39,6 +39,7 @@ typedef enum websocket_flags {
     // marks
     WS_FINAL_FRAME = 0x10,
     WS_HAS_MASK    = 0x20,
+    WS_RSV1        = 0x40, // per-message compressed, see https://tools.ietf.org/html/rfc7692
 } websocket_flags;
 
 #define WS_OP_MASK 0xF
@@ -32,10 +32,34 @@
 #include "axmol/rhi/ProgramState.h"
 #include "axmol/base/Director.h"
 #include "axmol/base/StencilStateManager.h"
+#include "axmol/2d/Camera.h"
+#include "axmol/2d/DrawNode.h"
 
 namespace ax
 {
 
+namespace
+{
+using ClippingStats = ClippingNode::ClippingStats;
+
+unsigned int s_clippingStatsFrame = 0;
+ClippingStats s_currentClippingStats;
+ClippingStats s_lastClippingStats;
+
+ClippingStats& currentClippingStats()
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (frame != s_clippingStatsFrame)
+    {
+        // counts of a skipped frame are stale
+        s_lastClippingStats    = frame == s_clippingStatsFrame + 1 ? s_currentClippingStats : ClippingStats{};
+        s_currentClippingStats = ClippingStats{};
+        s_clippingStatsFrame   = frame;
+    }
+    return s_currentClippingStats;
+}
+}  // namespace
+
 ClippingNode::ClippingNode() : _stencilStateManager(new StencilStateManager()) {}
 
 ClippingNode::~ClippingNode()
@@ -46,6 +70,7 @@ ClippingNode::~ClippingNode()
         _stencil->release();
     }
     AX_SAFE_DELETE(_stencilStateManager);
+    AX_SAFE_RELEASE(_alphaTestProgramState);
 
     for (auto&& stencilProgramState : _originalStencilProgramState)
     {
@@ -150,6 +175,34 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
 
+    Rect scissorRect;
+    if (getScissorRect(scissorRect))
+    {
+        ++currentClippingStats().scissor;
+
+        auto* groupCommand = renderer->getNextGroupCommand();
+        groupCommand->init(_globalZOrder);
+        renderer->addCommand(groupCommand);
+        renderer->pushGroup(groupCommand->getRenderQueueID());
+
+        auto beforeVisitCmdScissor = renderer->nextCallbackCommand();
+        beforeVisitCmdScissor->init(_globalZOrder);
+        beforeVisitCmdScissor->func = [this, scissorRect]() { onBeforeVisitScissor(scissorRect); };
+        renderer->addCommand(beforeVisitCmdScissor);
+
+        visitContent(renderer, flags);
+
+        auto afterVisitCmdScissor = renderer->nextCallbackCommand();
+        afterVisitCmdScissor->init(_globalZOrder);
+        afterVisitCmdScissor->func = AX_CALLBACK_0(ClippingNode::onAfterVisitScissor, this);
+        renderer->addCommand(afterVisitCmdScissor);
+
+        renderer->popGroup();
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        return;
+    }
+    ++currentClippingStats().stencil;
+
     // Add group command
 
     auto* groupCommandStencil = renderer->getNextGroupCommand();
@@ -166,13 +219,14 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     auto alphaThreshold = this->getAlphaThreshold();
     if (alphaThreshold < 1)
     {
-        auto* program      = axpm->getBuiltinProgram(rhi::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
-        auto programState  = new rhi::ProgramState(program);
-        auto alphaLocation = programState->getUniformLocation("u_alpha_value");
-        programState->setUniform(alphaLocation, &alphaThreshold, sizeof(alphaThreshold));
-        setProgramStateRecursively(_stencil, programState);
-
-        AX_SAFE_RELEASE_NULL(programState);
+        if (!_alphaTestProgramState)
+        {
+            auto* program          = axpm->getBuiltinProgram(rhi::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
+            _alphaTestProgramState = new rhi::ProgramState(program);
+        }
+        auto alphaLocation = _alphaTestProgramState->getUniformLocation("u_alpha_value");
+        _alphaTestProgramState->setUniform(alphaLocation, &alphaThreshold, sizeof(alphaThreshold));
+        setProgramStateRecursively(_stencil, _alphaTestProgramState);
     }
     _stencil->visit(renderer, _modelViewTransform, flags);
 
@@ -192,6 +246,24 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
 
     renderer->pushGroup(groupCommandChildren->getRenderQueueID());
 
+    visitContent(renderer, flags);
+
+    renderer->popGroup();
+
+    auto _afterVisitCmd = renderer->nextCallbackCommand();
+    _afterVisitCmd->init(_globalZOrder);
+    _afterVisitCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterVisit, _stencilStateManager);
+    renderer->addCommand(_afterVisitCmd);
+
+    renderer->popGroup();
+
+    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void ClippingNode::visitContent(Renderer* renderer, uint32_t flags)
+{
+    bool visibleByCamera = isVisitableByVisitingCamera();
+
     if (!_children.empty())
     {
         sortAllChildren();
@@ -217,17 +289,85 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     {
         this->draw(renderer, _modelViewTransform, flags);
     }
+}
 
-    renderer->popGroup();
+bool ClippingNode::getScissorRect(Rect& rect) const
+{
+    if (isInverted() || getAlphaThreshold() < 1 || !_stencil->getChildren().empty())
+        return false;
+
+    auto drawNode = dynamic_cast<DrawNode*>(_stencil);
+    if (!drawNode || !drawNode->isVisible() || !drawNode->getFilledRect(rect))
+        return false;
+
+    // the scissor box is set in screen points, so skip cameras and render textures with their own projection
+    // a node visited outside of a camera, e.g. by hand into a render texture, has no screen to clip against either
+    auto camera = Camera::getVisitingCamera();
+    if (!camera || camera != Camera::getDefaultCamera())
+        return false;
+
+    auto& projection     = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    auto& viewProjection = camera->getViewProjectionMatrix();
+    if (!std::equal(std::begin(projection.m), std::end(projection.m), std::begin(viewProjection.m)))
+        return false;
+
+    // only scale and translation keep the rectangle axis-aligned
+    const Mat4 transform = _modelViewTransform * drawNode->getNodeToParentTransform();
+    const float* m       = transform.m;
+    if (m[1] != 0 || m[2] != 0 || m[3] != 0 || m[4] != 0 || m[6] != 0 || m[7] != 0 || m[15] != 1)
+        return false;
+
+    Vec3 bottomLeft(rect.getMinX(), rect.getMinY(), 0);
+    Vec3 topRight(rect.getMaxX(), rect.getMaxY(), 0);
+    transform.transformPoint(&bottomLeft);
+    transform.transformPoint(&topRight);
+    rect = Rect(std::min(bottomLeft.x, topRight.x), std::min(bottomLeft.y, topRight.y),
+                std::abs(topRight.x - bottomLeft.x), std::abs(topRight.y - bottomLeft.y));
+    return true;
+}
 
-    auto _afterVisitCmd = renderer->nextCallbackCommand();
-    _afterVisitCmd->init(_globalZOrder);
-    _afterVisitCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterVisit, _stencilStateManager);
-    renderer->addCommand(_afterVisitCmd);
+void ClippingNode::onBeforeVisitScissor(const Rect& rect)
+{
+    auto renderView  = _director->getRenderView();
+    _scissorOldState = renderView->isScissorEnabled();
 
-    renderer->popGroup();
+    Rect clippingRect = rect;
+    if (_scissorOldState)
+    {
+        // nested inside another scissor, clip to both
+        _scissorOldRect  = renderView->getScissorInPoints();
+        const float minX = std::max(clippingRect.getMinX(), _scissorOldRect.getMinX());
+        const float minY = std::max(clippingRect.getMinY(), _scissorOldRect.getMinY());
+        const float maxX = std::min(clippingRect.getMaxX(), _scissorOldRect.getMaxX());
+        const float maxY = std::min(clippingRect.getMaxY(), _scissorOldRect.getMaxY());
+        clippingRect     = Rect(minX, minY, std::max(0.0f, maxX - minX), std::max(0.0f, maxY - minY));
+    }
+    else
+    {
+        _director->getRenderer()->setScissorTest(true);
+    }
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    renderView->setScissorInPoints(clippingRect.origin.x, clippingRect.origin.y, clippingRect.size.width,
+                                   clippingRect.size.height);
+}
+
+void ClippingNode::onAfterVisitScissor()
+{
+    if (_scissorOldState)
+    {
+        _director->getRenderView()->setScissorInPoints(_scissorOldRect.origin.x, _scissorOldRect.origin.y,
+                                                       _scissorOldRect.size.width, _scissorOldRect.size.height);
+    }
+    else
+    {
+        _director->getRenderer()->setScissorTest(false);
+    }
+}
+
+ClippingNode::ClippingStats ClippingNode::getClippingStats()
+{
+    currentClippingStats();
+    return s_lastClippingStats;
 }
 
 void ClippingNode::setGlobalZOrder(float globalZOrder)
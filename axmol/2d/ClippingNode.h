@@ -141,6 +141,16 @@ public:
 
     void setCameraMask(unsigned short mask, bool applyChildren = true) override;
 
+    /** How the clipping nodes of one frame were drawn, for profiling. */
+    struct ClippingStats
+    {
+        unsigned int scissor = 0;  // rectangular stencils clipped with the scissor test
+        unsigned int stencil = 0;  // stencils drawn into the stencil buffer
+    };
+
+    /** @return How the clipping nodes of the previous frame were drawn. */
+    static ClippingStats getClippingStats();
+
     ClippingNode();
 
     /**
@@ -161,6 +171,14 @@ protected:
     void setProgramStateRecursively(Node* node, rhi::ProgramState* programState);
     void restoreAllProgramStates();
 
+    /* Returns whether the stencil is a filled axis-aligned rectangle on screen, which the scissor test can clip
+     * without touching the stencil buffer.
+     */
+    bool getScissorRect(Rect& rect) const;
+    void visitContent(Renderer* renderer, uint32_t flags);
+    void onBeforeVisitScissor(const Rect& rect);
+    void onAfterVisitScissor();
+
     bool _uniqueChildStencils                 = false;
     Node* _stencil                            = nullptr;
     StencilStateManager* _stencilStateManager = nullptr;
@@ -169,6 +187,11 @@ protected:
     // CallbackCommand _afterVisitCmd;
     std::unordered_map<Node*, rhi::ProgramState*> _originalStencilProgramState;
 
+    rhi::ProgramState* _alphaTestProgramState = nullptr;
+
+    bool _scissorOldState = false;
+    Rect _scissorOldRect;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ClippingNode);
 };
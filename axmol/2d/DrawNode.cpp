@@ -802,6 +802,51 @@ void DrawNode::clear()
     _lines.clear();
 }
 
+bool DrawNode::getFilledRect(ax::Rect& rect) const
+{
+    if (_isolated || _triangles.empty() || !_points.empty() || !_lines.empty())
+        return false;
+
+    Vec2 min = _triangles[0].position;
+    Vec2 max = min;
+    for (auto&& vertex : _triangles)
+    {
+        min.x = std::min(min.x, vertex.position.x);
+        min.y = std::min(min.y, vertex.position.y);
+        max.x = std::max(max.x, vertex.position.x);
+        max.y = std::max(max.y, vertex.position.y);
+    }
+    if (max.x <= min.x || max.y <= min.y)
+        return false;
+
+    // with every vertex on a corner, each triangle covers one half of the rectangle or nothing,
+    // record the corner that each half leaves out
+    unsigned int missingCorners = 0;
+    for (size_t i = 0; i + 2 < _triangles.size(); i += 3)
+    {
+        unsigned int corners = 0;
+        for (size_t j = i; j < i + 3; ++j)
+        {
+            auto& position = _triangles[j].position;
+            const bool right = position.x == max.x;
+            const bool top   = position.y == max.y;
+            if ((!right && position.x != min.x) || (!top && position.y != min.y))
+                return false;
+            corners |= 1u << ((right ? 1 : 0) + (top ? 2 : 0));
+        }
+        const unsigned int missing = ~corners & 0xF;
+        if (missing && !(missing & (missing - 1)))
+            missingCorners |= missing;
+    }
+
+    // two halves leaving out opposite corners fill the rectangle
+    if ((missingCorners & 0x9) != 0x9 && (missingCorners & 0x6) != 0x6)
+        return false;
+
+    rect = ax::Rect(min, max - min);
+    return true;
+}
+
 const BlendFunc& DrawNode::getBlendFunc() const
 {
     return _blendFunc;
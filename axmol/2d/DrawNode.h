@@ -507,6 +507,12 @@ public:
 
     /** Clear the geometry in the node's buffer. */
     virtual void clear();
+
+    /** Returns whether the drawn triangles fill exactly one axis-aligned rectangle, without points or lines.
+     *
+     * @param rect Receives the rectangle in node space.
+     */
+    bool getFilledRect(ax::Rect& rect) const;
     /** Get the color mixed mode.
      * @lua NA
      */
@@ -27,12 +27,16 @@
 
 #include "axmol/2d/FontAtlas.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "axmol/2d/FontFreeType.h"
 #include "axmol/base/text_utils.h"
 #include "axmol/base/Director.h"
 #include "axmol/base/EventListenerCustom.h"
 #include "axmol/base/EventDispatcher.h"
 #include "axmol/base/EventType.h"
+#include "axmol/base/JobSystem.h"
 
 #include "simdjson/simdjson.h"
 #include "zlib.h"
@@ -44,6 +48,29 @@ namespace ax
 const int FontAtlas::CacheTextureWidth     = 512;
 const int FontAtlas::CacheTextureHeight    = 512;
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__ax_RESET_FONTATLAS";
+bool FontAtlas::_asyncRasterizationEnabled = false;
+
+struct FontAtlas::RasterizeQueue
+{
+    struct Glyph
+    {
+        char32_t charCode{0};
+        FontFreeType* renderer{nullptr};  // nullptr: nothing to rasterize
+        unsigned int glyphIndex{0};
+        int width{0};
+        int height{0};
+        int xAdvance{0};
+        Rect rect;
+        std::unique_ptr<unsigned char[]> bitmap;
+    };
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> hasFinished{false};  // set under mtx whenever finished grows
+    std::mutex mtx;
+    std::condition_variable cv;
+    int inflight{0};
+    std::vector<Glyph> finished;
+};
 
 void FontAtlas::loadFontAtlas(std::string_view fontatlasFile, tlx::string_map<FontAtlas*>& outAtlasMap)
 {
@@ -178,6 +205,18 @@ void FontAtlas::reinit()
 
 FontAtlas::~FontAtlas()
 {
+    if (_rasterizeQueue)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_glyphsUploadListener);
+        _glyphsUploadListener = nullptr;
+
+        // running jobs use our fonts, let them bail out before releasing
+        _rasterizeQueue->cancelled.store(true, std::memory_order_relaxed);
+
+        std::unique_lock<std::mutex> lck(_rasterizeQueue->mtx);
+        _rasterizeQueue->cv.wait(lck, [this] { return _rasterizeQueue->inflight == 0; });
+    }
+
 #if AX_ENABLE_CONTEXT_LOSS_RECOVERY
     if (_fontFreeType && _rendererRecreatedListener)
     {
@@ -317,166 +356,295 @@ bool FontAtlas::findNewCharacters(const std::u32string& u32Text)
 {
     _newChars.clear();
 
-    if (_letterDefinitions.empty())
+    if (_letterDefinitions.empty() && _pendingChars.empty())
     {
         _newChars.insert(u32Text.begin(), u32Text.end());
     }
     else
     {
         for (auto&& charCode : u32Text)
-            if (_letterDefinitions.find(charCode) == _letterDefinitions.end())
+            if (_letterDefinitions.find(charCode) == _letterDefinitions.end() && !isGlyphPending(charCode))
                 _newChars.insert(charCode);
     }
 
     return !_newChars.empty();
 }
 
-bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
+bool FontAtlas::resolveGlyph(char32_t charCode, FontFreeType*& renderer, unsigned int& glyphIndex)
 {
-    if (!_fontFreeType)
+    auto missingIt = _missingGlyphFallbackFonts.find(charCode);
+    if (missingIt != _missingGlyphFallbackFonts.end())
+    {  // Found fallback font for missing characters
+        renderer   = missingIt->second.first;
+        glyphIndex = missingIt->second.second;
+        return true;
+    }
+
+    renderer = _fontFreeType;
+    const GlyphResolution* res{nullptr};
+    {
+        std::lock_guard<std::mutex> lck(renderer->getFaceMutex());
+        if (renderer->getGlyphIndex(charCode, glyphIndex, res))
+            return true;
+    }
+
+    if (!res)
         return false;
-    if (!_currentPageData)
-        reinit();
 
-    if (!findNewCharacters(utf32Text))
+    auto fallbackIt = _missingFallbackFonts.find(res->faceInfo.family);
+    if (fallbackIt != _missingFallbackFonts.end())
+    {
+        renderer = fallbackIt->second;
+    }
+    else
+    {
+        renderer = FontFreeType::createFallbackFont(res->faceInfo, _fontFreeType);
+        if (renderer)
+            _missingFallbackFonts.insert(res->faceInfo.family, renderer);
+    }
+
+    if (!renderer)
         return false;
 
+    glyphIndex = res->glyphIndex;
+    _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(renderer, glyphIndex));
+    return true;
+}
+
+void FontAtlas::insertGlyph(char32_t charCode,
+                            FontFreeType* renderer,
+                            unsigned char* bitmap,
+                            int bitmapWidth,
+                            int bitmapHeight,
+                            const Rect& rect,
+                            int xAdvance,
+                            int& uploadStartY)
+{
     const int adjustForDistanceMap = _letterPadding / 2;
     const int adjustForExtend      = _letterEdgeExtend / 2;
 
-    int bitmapWidth = 0, bitmapHeight = 0;
-    Rect tempRect;
     FontLetterDefinition tempDef{};
+    tempDef.xAdvance = xAdvance;
 
-    auto pixelFormat     = _pixelFormat;
-    int startY           = static_cast<int>(_currentPageOrigY);
-    int pageUploadStartY = startY;  // Upload start position of the current page
-    int pageUploadEndY   = startY;  // Upload end position of the current page (updated dynamically)
-
-    for (auto&& charCode : _newChars)
+    if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
     {
-        auto missingIt             = _missingGlyphFallbackFonts.find(charCode);
-        uint8_t* bitmap            = nullptr;
-        FontFreeType* charRenderer = _fontFreeType;
-        bool sharedBitmapData{true};  // does the bitmap data shared from FontFreeType engine
-        if (missingIt == _missingGlyphFallbackFonts.end())
-        {
-            const GlyphResolution* res{nullptr};
-            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance, res,
-                                                  sharedBitmapData);
-            if (!bitmap && res)
-            {
-                auto fallbackIt = _missingFallbackFonts.find(res->faceInfo.family);
-                if (fallbackIt != _missingFallbackFonts.end())
-                {
-                    charRenderer = fallbackIt->second;
-                }
-                else
-                {
-                    charRenderer = FontFreeType::createFallbackFont(res->faceInfo, _fontFreeType);
-                    if (charRenderer)
-                        _missingFallbackFonts.insert(res->faceInfo.family, charRenderer);
-                }
+        // Calculate occupied area using actual bitmap size
+        const int glyphWidth  = bitmapWidth + _letterPadding + _letterEdgeExtend;
+        const int glyphHeight = bitmapHeight + _letterPadding + _letterEdgeExtend;
 
-                if (charRenderer)
-                {
-                    unsigned int glyphIndex = res->glyphIndex;
-                    bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect,
-                                                                 tempDef.xAdvance, sharedBitmapData);
-                    _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
-                }
-            }
-        }
-        else
-        {  // Found fallback font for missing characters, getGlyphBitmap without fallback
-            charRenderer            = missingIt->second.first;
-            unsigned int glyphIndex = missingIt->second.second;
-            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect,
-                                                         tempDef.xAdvance, sharedBitmapData);
+        // Not enough width in current line → wrap to next line
+        if (_currentPageOrigX + glyphWidth > _width)
+        {
+            _currentPageOrigY += _currLineHeight;
+            _currLineHeight   = 0;
+            _currentPageOrigX = 0;
         }
 
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+        // Not enough height → upload current page and start a new page
+        if (_currentPageOrigY + glyphHeight > _height)
         {
-            // Calculate occupied area using actual bitmap size
-            const int glyphWidth  = bitmapWidth + _letterPadding + _letterEdgeExtend;
-            const int glyphHeight = bitmapHeight + _letterPadding + _letterEdgeExtend;
+            // Upload the written region of the current page (uploadStartY..max written Y)
+            if (uploadStartY >= 0)
+                updateTextureContent(_pixelFormat, uploadStartY);
+            // Start a new page
+            addNewPage();
+            _currentPageOrigX = 0;
+            _currentPageOrigY = 0;
+            _currLineHeight   = 0;
+            uploadStartY      = -1;
+        }
 
-            // Not enough width in current line → wrap to next line
-            if (_currentPageOrigX + glyphWidth > _width)
-            {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-            }
+        if (uploadStartY < 0)
+            uploadStartY = static_cast<int>(_currentPageOrigY);
 
-            // Not enough height → upload current page and start a new page
-            if (_currentPageOrigY + glyphHeight > _height)
-            {
-                // Upload the written region of the current page (startY..pageUploadEndY)
-                updateTextureContent(pixelFormat, pageUploadStartY);
-                // Start a new page
-                addNewPage();
-                _currentPageOrigX = 0;
-                _currentPageOrigY = 0;
-                _currLineHeight   = 0;
-                pageUploadStartY  = 0;
-                pageUploadEndY    = 0;
-            }
+        // Calculate tempDef offsets (based on rect)
+        tempDef.validDefinition = true;
+        tempDef.width           = rect.size.width + _letterPadding + _letterEdgeExtend;
+        tempDef.height          = rect.size.height + _letterPadding + _letterEdgeExtend;
+        tempDef.offsetX         = rect.origin.x - adjustForDistanceMap - adjustForExtend;
+        tempDef.offsetY         = _fontAscender + rect.origin.y - adjustForDistanceMap - adjustForExtend;
 
-            // Calculate tempDef offsets (based on tempRect)
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
-
-            // Render glyph into the current page
-            charRenderer->renderCharAt(_currentPageData, static_cast<int>(_currentPageOrigX) + adjustForExtend,
-                                       static_cast<int>(_currentPageOrigY) + adjustForExtend, bitmap, bitmapWidth,
-                                       bitmapHeight, _width, _height);
-
-            // Record glyph position and page
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-
-            // Update line height and X pointer (leave 1 pixel spacing between glyphs)
-            _currLineHeight = std::max(glyphHeight, _currLineHeight);
-            _currentPageOrigX += glyphWidth + 1;
-
-            // Maintain upload range (highest Y written on this page)
-            pageUploadEndY = std::max<int>(pageUploadEndY, _currentPageOrigY + _currLineHeight);
-
-            // Convert pixel dimensions to points
-            tempDef.width /= _scaleFactor;
-            tempDef.height /= _scaleFactor;
-            tempDef.U /= _scaleFactor;
-            tempDef.V /= _scaleFactor;
-            tempDef.rotated = false;
-        }
-        else
+        // Render glyph into the current page
+        renderer->renderCharAt(_currentPageData, static_cast<int>(_currentPageOrigX) + adjustForExtend,
+                               static_cast<int>(_currentPageOrigY) + adjustForExtend, bitmap, bitmapWidth,
+                               bitmapHeight, _width, _height);
+
+        // Record glyph position and page
+        tempDef.U         = _currentPageOrigX;
+        tempDef.V         = _currentPageOrigY;
+        tempDef.textureID = _currentPage;
+
+        // Update line height and X pointer (leave 1 pixel spacing between glyphs)
+        _currLineHeight = std::max(glyphHeight, _currLineHeight);
+        _currentPageOrigX += glyphWidth + 1;
+
+        // Convert pixel dimensions to points
+        tempDef.width /= _scaleFactor;
+        tempDef.height /= _scaleFactor;
+        tempDef.U /= _scaleFactor;
+        tempDef.V /= _scaleFactor;
+        tempDef.rotated = false;
+    }
+    else
+    {
+        tempDef.validDefinition = !!tempDef.xAdvance;
+        tempDef.width = tempDef.height = tempDef.U = tempDef.V = 0;
+        tempDef.offsetX = tempDef.offsetY = 0;
+        tempDef.textureID                 = 0;
+        tempDef.rotated                   = false;
+        _currentPageOrigX += 1;
+    }
+
+    _letterDefinitions[charCode] = tempDef;
+}
+
+bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
+{
+    if (!_fontFreeType)
+        return false;
+    if (!_currentPageData)
+        reinit();
+
+    if (!findNewCharacters(utf32Text))
+        return false;
+
+    if (_asyncRasterizationEnabled)
+    {
+        requestGlyphs();
+        return false;
+    }
+
+    int uploadStartY = -1;  // Upload start position of the current page
+
+    for (auto&& charCode : _newChars)
+    {
+        FontFreeType* renderer  = nullptr;
+        unsigned int glyphIndex = 0;
+        if (!resolveGlyph(charCode, renderer, glyphIndex))
         {
-            tempDef.validDefinition = !!tempDef.xAdvance;
-            tempDef.width = tempDef.height = tempDef.U = tempDef.V = 0;
-            tempDef.offsetX = tempDef.offsetY = 0;
-            tempDef.textureID                 = 0;
-            tempDef.rotated                   = false;
-            _currentPageOrigX += 1;
+            insertGlyph(charCode, nullptr, nullptr, 0, 0, Rect::ZERO, 0, uploadStartY);
+            continue;
         }
 
+        int bitmapWidth = 0, bitmapHeight = 0, xAdvance = 0;
+        Rect tempRect;
+        bool sharedBitmapData{true};  // does the bitmap data shared from FontFreeType engine
+
+        std::lock_guard<std::mutex> lck(renderer->getFaceMutex());
+        auto bitmap = renderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, xAdvance,
+                                                      sharedBitmapData);
+        insertGlyph(charCode, renderer, bitmap, bitmapWidth, bitmapHeight, tempRect, xAdvance, uploadStartY);
+
         if (!sharedBitmapData && bitmap)
             delete[] bitmap;
+    }
+
+    // Handle remaining upload for the current page (from uploadStartY to max written Y)
+    if (uploadStartY >= 0)
+        updateTextureContent(_pixelFormat, uploadStartY);
+
+    return true;
+}
+
+void FontAtlas::requestGlyphs()
+{
+    if (!_rasterizeQueue)
+    {
+        _rasterizeQueue = std::make_shared<RasterizeQueue>();
 
-        _letterDefinitions[charCode] = tempDef;
+        // one pass per frame packs everything the jobs finished since the last one, before the scene is drawn
+        _glyphsUploadListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+            Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { collectGlyphs(); });
     }
 
-    // Handle remaining upload for the current page (from startY to max written Y)
-    if (pageUploadEndY > pageUploadStartY)
+    // fallback fonts are created here, workers only rasterize
+    auto glyphs = std::make_shared<std::vector<RasterizeQueue::Glyph>>(_newChars.size());
+    size_t index = 0;
+    for (auto&& charCode : _newChars)
     {
-        updateTextureContent(pixelFormat, pageUploadStartY);
+        auto& glyph    = (*glyphs)[index++];
+        glyph.charCode = charCode;
+        if (!resolveGlyph(charCode, glyph.renderer, glyph.glyphIndex))
+            glyph.renderer = nullptr;
+        _pendingChars.insert(charCode);
     }
 
-    return true;
+    auto queue = _rasterizeQueue;
+    {
+        std::lock_guard<std::mutex> lck(queue->mtx);
+        ++queue->inflight;
+    }
+
+    Director::getInstance()->getJobSystem()->enqueue(
+        [queue, glyphs] {
+            for (auto&& glyph : *glyphs)
+            {
+                if (!glyph.renderer || queue->cancelled.load(std::memory_order_relaxed))
+                    continue;
+
+                bool sharedBitmapData{true};
+                std::lock_guard<std::mutex> lck(glyph.renderer->getFaceMutex());
+                auto bitmap = glyph.renderer->getGlyphBitmapByIndex(glyph.glyphIndex, glyph.width, glyph.height,
+                                                                    glyph.rect, glyph.xAdvance, sharedBitmapData);
+                if (bitmap && sharedBitmapData)
+                {
+                    // the face reuses its glyph slot for the next glyph
+                    const size_t size = static_cast<size_t>(glyph.width) * glyph.height;
+                    glyph.bitmap.reset(new unsigned char[size]);
+                    memcpy(glyph.bitmap.get(), bitmap, size);
+                }
+                else
+                    glyph.bitmap.reset(bitmap);
+            }
+
+            std::lock_guard<std::mutex> lck(queue->mtx);
+            std::move(glyphs->begin(), glyphs->end(), std::back_inserter(queue->finished));
+            queue->hasFinished.store(true, std::memory_order_relaxed);
+            --queue->inflight;
+            queue->cv.notify_all();
+        });
+}
+
+void FontAtlas::collectGlyphs()
+{
+    if (!_rasterizeQueue->hasFinished.exchange(false, std::memory_order_relaxed))
+        return;
+
+    std::vector<RasterizeQueue::Glyph> finished;
+    {
+        std::lock_guard<std::mutex> lck(_rasterizeQueue->mtx);
+        finished.swap(_rasterizeQueue->finished);
+    }
+
+    if (finished.empty())
+        return;
+    if (!_currentPageData)
+        reinit();
+
+    int uploadStartY = -1;
+    for (auto&& glyph : finished)
+    {
+        insertGlyph(glyph.charCode, glyph.renderer, glyph.bitmap.get(), glyph.width, glyph.height, glyph.rect,
+                    glyph.xAdvance, uploadStartY);
+        _pendingChars.erase(glyph.charCode);
+    }
+
+    if (uploadStartY >= 0)
+        updateTextureContent(_pixelFormat, uploadStartY);
+
+    ++_glyphGeneration;
+}
+
+void FontAtlas::finishPendingGlyphs()
+{
+    if (!_rasterizeQueue)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lck(_rasterizeQueue->mtx);
+        _rasterizeQueue->cv.wait(lck, [this] { return _rasterizeQueue->inflight == 0; });
+    }
+    collectGlyphs();
 }
 
 void FontAtlas::updateTextureContent(rhi::PixelFormat format, int startY)
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 #include "axmol/platform/PlatformMacros.h"
 #include "axmol/base/Object.h"
@@ -71,6 +72,15 @@ public:
     static const int CacheTextureHeight;
     static const char* CMD_RESET_FONTATLAS;
     static void loadFontAtlas(std::string_view fontatlasFile, tlx::string_map<FontAtlas*>& outAtlasMap);
+
+    /**
+     * Rasterize missing glyphs on the job system instead of blocking prepareLetterDefinitions, labels relayout once
+     * the glyphs are in the atlas. The glyphs finished since the previous frame are packed and uploaded in one pass
+     * per atlas before the frame is drawn. Disabled by default.
+     */
+    static void setAsyncRasterizationEnabled(bool enabled) { _asyncRasterizationEnabled = enabled; }
+    static bool isAsyncRasterizationEnabled() { return _asyncRasterizationEnabled; }
+
     /**
      */
     FontAtlas(Font* theFont);
@@ -85,6 +95,15 @@ public:
 
     bool prepareLetterDefinitions(const std::u32string& utf16String);
 
+    /** Whether the glyph of utf32Char is being rasterized asynchronously. */
+    bool isGlyphPending(char32_t utf32Char) const { return _pendingChars.find(utf32Char) != _pendingChars.end(); }
+
+    /** Incremented whenever asynchronously rasterized glyphs were added. */
+    unsigned int getGlyphGeneration() const { return _glyphGeneration; }
+
+    /** Blocks until all asynchronously requested glyphs are added to the atlas. */
+    void finishPendingGlyphs();
+
     const auto& getLetterDefinitions() const { return _letterDefinitions; }
 
     const std::unordered_map<unsigned int, Texture2D*>& getTextures() const { return _atlasTextures; }
@@ -136,6 +155,30 @@ protected:
 
     bool findNewCharacters(const std::u32string& u32Text);
 
+    struct RasterizeQueue;
+
+    /** Finds the font rendering utf32Char, creating fallback fonts as needed, main thread only. */
+    bool resolveGlyph(char32_t utf32Char, FontFreeType*& renderer, unsigned int& glyphIndex);
+
+    /**
+     * Places a rasterized glyph into the current page and records its definition.
+     * uploadStartY is the first row written since the last upload, -1 if none, a full page is uploaded before
+     * moving on.
+     */
+    void insertGlyph(char32_t utf32Char,
+                     FontFreeType* renderer,
+                     unsigned char* bitmap,
+                     int bitmapWidth,
+                     int bitmapHeight,
+                     const Rect& rect,
+                     int xAdvance,
+                     int& uploadStartY);
+
+    void requestGlyphs();
+
+    /** Packs the finished glyphs and uploads them, runs once per frame before drawing. */
+    void collectGlyphs();
+
     /**
      * Scale each font letter by scaleFactor.
      *
@@ -146,6 +189,10 @@ protected:
     void updateTextureContent(rhi::PixelFormat format, int startY);
 
     tlx::flat_set<char32_t> _newChars;
+    tlx::flat_set<char32_t> _pendingChars;
+    std::shared_ptr<RasterizeQueue> _rasterizeQueue;
+    EventListenerCustom* _glyphsUploadListener = nullptr;
+    unsigned int _glyphGeneration = 0;
 
     std::unordered_map<unsigned int, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
@@ -179,6 +226,8 @@ protected:
     bool _antialiasEnabled                          = true;
     int _currLineHeight                             = 0;
 
+    static bool _asyncRasterizationEnabled;
+
     friend class Label;
 };
 
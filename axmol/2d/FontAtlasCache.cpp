@@ -39,6 +39,8 @@ namespace ax
 {
 
 tlx::string_map<FontAtlas*> FontAtlasCache::_atlasMap;
+bool FontAtlasCache::_sharedSDFEnabled = false;
+int FontAtlasCache::_sharedSDFFaceSize = FontFreeType::DEFAULT_BASE_FONT_SIZE;
 
 void FontAtlasCache::purgeCachedData()
 {
@@ -56,14 +58,17 @@ void FontAtlasCache::preloadFontAtlas(std::string_view fontatlasFile)
     FontAtlas::loadFontAtlas(fontatlasFile, _atlasMap);
 }
 
-FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
+FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config, int* atlasFaceSize)
 {
     auto& realFontFilename = config->fontFilePath;
     bool useDistanceField  = config->distanceFieldEnabled;
     int outlineSize        = useDistanceField ? 0 : config->outlineSize;
 
     // underlaying font engine (freetype2) only support int type, so convert to int avoid precision issue
-    const int faceSize  = config->distanceFieldEnabled ? config->faceSize : static_cast<int>(config->fontSize);
+    int faceSize = useDistanceField ? config->faceSize : static_cast<int>(config->fontSize);
+    // a shared distance field atlas is rendered at the reference size, whatever the first label asks for
+    if (useDistanceField && _sharedSDFEnabled)
+        faceSize = _sharedSDFFaceSize;
     auto scaledFaceSize = static_cast<int>(faceSize * AX_CONTENT_SCALE_FACTOR());
 
     std::string atlasName = config->distanceFieldEnabled
@@ -71,6 +76,9 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
                                 : fmt::format("{} {} {}", scaledFaceSize, outlineSize, realFontFilename);
     auto it               = _atlasMap.find(atlasName);
 
+    if (atlasFaceSize)
+        *atlasFaceSize = scaledFaceSize;
+
     if (it == _atlasMap.end())
     {
         auto font = FontFreeType::create(realFontFilename, scaledFaceSize, config->glyphs, config->customGlyphs,
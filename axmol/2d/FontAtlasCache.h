@@ -46,7 +46,29 @@ public:
      * since axmol-2.1.0, must call before creating any Label
      */
     static void preloadFontAtlas(std::string_view fontatlasFile);
-    static FontAtlas* getFontAtlasTTF(const _ttfConfig* config);
+    /**
+     * @param atlasFaceSize receives the scaled face size the returned atlas was rendered with, which differs from the
+     * one of config when a shared distance field atlas is returned, see setSharedSDFEnabled
+     */
+    static FontAtlas* getFontAtlasTTF(const _ttfConfig* config, int* atlasFaceSize = nullptr);
+
+    /**
+     * @brief Serve every TTF config of a font file from one distance field atlas
+     * Labels render all font sizes and outline widths of the font with the distance field shader, so each glyph is
+     * rasterized once, at the face size set with setSharedSDFFaceSize whatever label is created first. An atlas
+     * preloaded from SDFGen output is used when it was generated at that face size.
+     * Disabled by default, must be set before creating any Label.
+     */
+    static void setSharedSDFEnabled(bool enabled) { _sharedSDFEnabled = enabled; }
+    static bool isSharedSDFEnabled() { return _sharedSDFEnabled; }
+
+    /**
+     * The face size shared distance field atlases are rendered at, before the content scale factor, a larger one
+     * keeps big text sharp at the cost of atlas space. FontFreeType::DEFAULT_BASE_FONT_SIZE by default, must be set
+     * before creating any Label.
+     */
+    static void setSharedSDFFaceSize(int faceSize) { _sharedSDFFaceSize = faceSize; }
+    static int getSharedSDFFaceSize() { return _sharedSDFFaceSize; }
 
     static FontAtlas* getFontAtlasFNT(std::string_view fontFileName);
     static FontAtlas* getFontAtlasFNT(std::string_view fontFileName, std::string_view subTextureKey);
@@ -80,6 +102,8 @@ public:
 
 private:
     static tlx::string_map<FontAtlas*> _atlasMap;
+    static bool _sharedSDFEnabled;
+    static int _sharedSDFFaceSize;
 };
 
 }  // namespace ax
@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "axmol/platform/FileUtils.h"
 #include "axmol/platform/FileStream.h"
 #include "axmol/platform/Application.h"
+#include <atomic>
+#include <mutex>
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
@@ -54,6 +56,18 @@ const int FontFreeType::DistanceMapSpread   = 6;
 // By default, will render square when character glyph missing in current font
 char32_t FontFreeType::_mssingGlyphCharacter = 0;
 
+unsigned int FontFreeType::_kerningCacheCapacity = 128;
+
+namespace
+{
+std::atomic<unsigned int> s_kerningCacheHits{0};
+std::atomic<unsigned int> s_kerningCacheMisses{0};
+
+// FreeType wants face creation and destruction on a shared FT_Library serialized, async glyph jobs
+// rasterize with it while the main thread opens fallback fonts or releases fonts
+std::mutex s_libraryMutex;
+}  // namespace
+
 using namespace std::string_view_literals;
 constexpr std::string_view _glyphASCII =
     "\"!#$%&'()*+,-./"
@@ -107,7 +121,12 @@ FontFreeType* FontFreeType::createFallbackFont(const FontFaceInfo& faceInfo, Fon
     {
         // create our new face for render
         FT_Face face{nullptr};
-        auto error = FT_New_Face(getFTLibrary(), faceInfo.path.data(), faceInfo.faceIndex, &face);
+        auto library = getFTLibrary();
+        FT_Error error;
+        {
+            std::lock_guard<std::mutex> lck(s_libraryMutex);
+            error = FT_New_Face(library, faceInfo.path.data(), faceInfo.faceIndex, &face);
+        }
         if (!error)
         {
             FontFreeType* tempFont = new FontFreeType(mainFont->isDistanceFieldEnabled(), mainFont->getOutlineSize());
@@ -171,6 +190,7 @@ void FontFreeType::shutdownFreeType()
 {
     if (_FTInitialized)
     {
+        std::lock_guard<std::mutex> lck(s_libraryMutex);
         FT_Done_FreeType(_FTlibrary);
         s_cacheFontData.clear();
         _FTInitialized = false;
@@ -198,7 +218,11 @@ FontFreeType::FontFreeType(bool distanceFieldEnabled /* = false */, float outlin
     if (outline > 0.0f)
     {
         _outlineSize = outline * AX_CONTENT_SCALE_FACTOR();
-        FT_Stroker_New(FontFreeType::getFTLibrary(), &_stroker);
+        auto library = FontFreeType::getFTLibrary();
+        {
+            std::lock_guard<std::mutex> lck(s_libraryMutex);
+            FT_Stroker_New(library, &_stroker);
+        }
         FT_Stroker_Set(_stroker,
             (int)(_outlineSize * 64),
             FT_STROKER_LINECAP_ROUND,
@@ -212,6 +236,7 @@ FontFreeType::~FontFreeType()
 {
     if (_FTInitialized)
     {
+        std::lock_guard<std::mutex> lck(s_libraryMutex);
         if (_stroker)
             FT_Stroker_Done(_stroker);
 
@@ -257,7 +282,9 @@ bool FontFreeType::initWithFontPath(std::string_view fontPath, int faceSize)
 
         _fontStream = fts;
 
-        if (FT_Open_Face(getFTLibrary(), &args, 0, &face))
+        auto library = getFTLibrary();
+        std::lock_guard<std::mutex> lck(s_libraryMutex);
+        if (FT_Open_Face(library, &args, 0, &face))
             return false;
     }
     else
@@ -275,9 +302,11 @@ bool FontFreeType::initWithFontPath(std::string_view fontPath, int faceSize)
         }
 
         ++sharableData->referenceCount;
-        auto& data = sharableData->data;
+        auto& data   = sharableData->data;
+        auto library = getFTLibrary();
+        std::lock_guard<std::mutex> lck(s_libraryMutex);
         if (data.isNull() ||
-            FT_New_Memory_Face(getFTLibrary(), data.getBytes(), static_cast<FT_Long>(data.getSize()), 0, &face))
+            FT_New_Memory_Face(library, data.getBytes(), static_cast<FT_Long>(data.getSize()), 0, &face))
             return false;
     }
 
@@ -339,7 +368,10 @@ bool FontFreeType::initWithFontFace(FT_Face face, std::string_view fontPath, int
         return true;
     } while (false);
 
-    FT_Done_Face(face);
+    {
+        std::lock_guard<std::mutex> lck(s_libraryMutex);
+        FT_Done_Face(face);
+    }
 
     AXLOGI("Init font '{}' failed, only unicode ttf/ttc was supported.", fontPath);
     return false;
@@ -372,18 +404,54 @@ int* FontFreeType::getHorizontalKerningForTextUTF32(const std::u32string& text,
     int* sizes = new int[outNumLetters];
     memset(sizes, 0, outNumLetters * sizeof(int));
 
-    bool hasKerning = FT_HAS_KERNING(_fontFace) != 0;
-    if (hasKerning)
+    // fonts without kerning pairs only produce zeros
+    if (!FT_HAS_KERNING(_fontFace) || outNumLetters < 2)
+        return sizes;
+
+    std::lock_guard<std::mutex> lck(_faceMutex);
+    if (_kerningCacheCapacity > 0)
     {
-        for (int c = 1; c < outNumLetters; ++c)
+        auto it = _kerningCacheIndex.find(text);
+        if (it != _kerningCacheIndex.end())
         {
-            sizes[c] = getHorizontalKerningForChars(text[c - 1], text[c]);
+            _kerningCache.splice(_kerningCache.begin(), _kerningCache, it->second);
+            memcpy(sizes, it->second->second.data(), outNumLetters * sizeof(int));
+            ++s_kerningCacheHits;
+            return sizes;
+        }
+        ++s_kerningCacheMisses;
+    }
+
+    for (int c = 1; c < outNumLetters; ++c)
+    {
+        sizes[c] = getHorizontalKerningForChars(text[c - 1], text[c]);
+    }
+
+    if (_kerningCacheCapacity > 0)
+    {
+        _kerningCache.emplace_front(text, std::vector<int>(sizes, sizes + outNumLetters));
+        _kerningCacheIndex[_kerningCache.front().first] = _kerningCache.begin();
+        while (_kerningCache.size() > _kerningCacheCapacity)
+        {
+            _kerningCacheIndex.erase(_kerningCache.back().first);
+            _kerningCache.pop_back();
         }
     }
 
     return sizes;
 }
 
+FontFreeType::KerningCacheStats FontFreeType::getKerningCacheStats()
+{
+    return KerningCacheStats{s_kerningCacheHits.load(), s_kerningCacheMisses.load()};
+}
+
+void FontFreeType::resetKerningCacheStats()
+{
+    s_kerningCacheHits   = 0;
+    s_kerningCacheMisses = 0;
+}
+
 int FontFreeType::getHorizontalKerningForChars(uint64_t firstChar, uint64_t secondChar) const
 {
     // get the ID to the char we need
@@ -419,16 +487,12 @@ const char* FontFreeType::getFontFamily() const
     return _fontFace->family_name;
 }
 
-unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
-                                            int& outWidth,
-                                            int& outHeight,
-                                            Rect& outRect,
-                                            int& xAdvance,
-                                            const GlyphResolution*& outFallbackRes,
-                                            bool& sharedBitmapData)
+bool FontFreeType::getGlyphIndex(char32_t charCode,
+                                 unsigned int& glyphIndex,
+                                 const GlyphResolution*& outFallbackRes) const
 {
     // @remark: glyphIndex=0 means charactor is mssing on current font face
-    auto glyphIndex = FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode));
+    glyphIndex = FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode));
     if (glyphIndex == 0)
     {
 #if defined(_AX_DEBUG) && _AX_DEBUG > 0
@@ -448,7 +512,7 @@ unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
             if (res)
             {
                 outFallbackRes = res;
-                return nullptr;
+                return false;
             }
         }
 
@@ -456,15 +520,32 @@ unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
         if (_mssingGlyphCharacter != 0)
         {
             if (_mssingGlyphCharacter == 0x1A)
-            {
-                xAdvance = 0;
-                return nullptr;  // don't render anything for this character
-            }
+                return false;  // don't render anything for this character
+
             // Try get new glyph index with missing glyph character code
             glyphIndex = FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(_mssingGlyphCharacter));
         }
     }
 
+    return true;
+}
+
+unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
+                                            int& outWidth,
+                                            int& outHeight,
+                                            Rect& outRect,
+                                            int& xAdvance,
+                                            const GlyphResolution*& outFallbackRes,
+                                            bool& sharedBitmapData)
+{
+    unsigned int glyphIndex = 0;
+    if (!getGlyphIndex(charCode, glyphIndex, outFallbackRes))
+    {
+        if (!outFallbackRes)
+            xAdvance = 0;
+        return nullptr;
+    }
+
     return getGlyphBitmapByIndex(glyphIndex, outWidth, outHeight, outRect, xAdvance, sharedBitmapData);
 }
 
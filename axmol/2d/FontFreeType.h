@@ -29,6 +29,10 @@
 #include "axmol/2d/Font.h"
 #include "axmol/2d/IFontEngine.h"
 #include <string>
+#include <mutex>
+#include <list>
+#include <vector>
+#include <unordered_map>
 
 namespace ax
 {
@@ -111,6 +115,25 @@ public:
     static void setNativeBytecodeHintingEnabled(bool bEnabled) { _doNativeBytecodeHinting = bEnabled; }
     static bool isNativeBytecodeHintingEnabled() { return _doNativeBytecodeHinting; }
 
+    /**
+     * @brief Sets how many kerned text runs each font keeps, least recently used runs are evicted first.
+     * Repeated strings then skip the per pair kerning lookups, 0 disables the cache.
+     */
+    static void setKerningCacheCapacity(unsigned int capacity) { _kerningCacheCapacity = capacity; }
+    static unsigned int getKerningCacheCapacity() { return _kerningCacheCapacity; }
+
+    struct KerningCacheStats
+    {
+        unsigned int hits   = 0;
+        unsigned int misses = 0;
+    };
+
+    /**
+     * @brief Returns the kerning cache lookups of all fonts since the last reset.
+     */
+    static KerningCacheStats getKerningCacheStats();
+    static void resetKerningCacheStats();
+
     static FontFreeType* create(std::string_view fontPath,
                                 int faceSize,
                                 GlyphCollection glyphs,
@@ -140,6 +163,19 @@ public:
 
     int* getHorizontalKerningForTextUTF32(const std::u32string& text, int& outNumLetters) const override;
 
+    /**
+     * Resolves the glyph index of charCode, the missing glyph character is used when the face doesn't contain it.
+     *
+     * @return false if this face shouldn't render the character, fallbackRes is set when another face provides it.
+     */
+    bool getGlyphIndex(char32_t charCode, unsigned int& glyphIndex, const GlyphResolution*& fallbackRes) const;
+
+    /**
+     * The face isn't thread safe, lock this while resolving or rasterizing glyphs and while using bitmap data shared
+     * from the face when other threads may rasterize with this font.
+     */
+    std::mutex& getFaceMutex() const { return _faceMutex; }
+
     unsigned char* getGlyphBitmap(char32_t charCode,
                                   int& outWidth,
                                   int& outHeight,
@@ -175,6 +211,7 @@ private:
     static bool _doNativeBytecodeHinting;
     static bool _globalSDFEnabled;
     static char32_t _mssingGlyphCharacter;
+    static unsigned int _kerningCacheCapacity;
 
     static bool initFreeType();
 
@@ -204,6 +241,13 @@ private:
 
     GlyphCollection _usedGlyphs;
     std::string _customGlyphs;
+
+    mutable std::mutex _faceMutex;
+
+    // kernings by text run, most recently used first, guarded by _faceMutex
+    using KerningCache = std::list<std::pair<std::u32string, std::vector<int>>>;
+    mutable KerningCache _kerningCache;
+    mutable std::unordered_map<std::u32string_view, KerningCache::iterator> _kerningCacheIndex;
 };
 
 // end of _2d group
@@ -76,6 +76,8 @@ void updateBlend(rhi::BlendDesc& blendDesc, BlendFunc blendFunc)
 }
 }  // namespace
 
+bool Label::_incrementalLayoutEnabled = false;
+
 /**
  * LabelLetter used to update the quad in texture atlas without SpriteBatchNode.
  */
@@ -481,6 +483,7 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
     , _fontAtlas(nullptr)
     , _reusedLetter(nullptr)
     , _horizontalKernings(nullptr)
+    , _horizontalKerningsCount(0)
     , _boldEnabled(false)
     , _lineDrawNode(nullptr)
     , _strikethroughEnabled(false)
@@ -568,8 +571,13 @@ void Label::reset()
     _currentLabelType = LabelType::STRING_TEXTURE;
     _currLabelEffect  = LabelEffect::NORMAL;
     _contentDirty     = false;
+    _glyphsPending    = false;
+    _glyphGeneration  = 0;
     _numberOfLines    = 0;
     _lengthOfString   = 0;
+    _letterOffsetY    = 0.f;
+    _tailoredTopY     = 0.f;
+    _tailoredBottomY  = 0.f;
     _utf32Text.clear();
     _utf8Text.clear();
 
@@ -592,6 +600,8 @@ void Label::reset()
         delete[] _horizontalKernings;
         _horizontalKernings = nullptr;
     }
+    _horizontalKerningsCount = 0;
+    invalidateIncrementalLayout();
     _additionalKerning      = 0.f;
     _lineHeight             = 0.f;
     _lineSpacing            = 0.f;
@@ -767,6 +777,7 @@ bool Label::setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled /* = false
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
     }
     _fontAtlas = atlas;
+    invalidateIncrementalLayout();
 
     if (_reusedLetter == nullptr)
     {
@@ -915,7 +926,9 @@ void Label::setString(std::string_view text)
         std::u32string utf32String;
         if (text_utils::UTF8ToUTF32(_utf8Text, utf32String))
         {
-            _utf32Text = utf32String;
+            auto changed     = std::mismatch(_utf32Text.begin(), _utf32Text.end(), utf32String.begin(), utf32String.end());
+            _textChangeIndex = std::min(_textChangeIndex, static_cast<int>(changed.first - _utf32Text.begin()));
+            _utf32Text       = std::move(utf32String);
         }
     }
 }
@@ -1057,10 +1070,13 @@ void Label::alignText()
 {
     if (_fontAtlas == nullptr || _utf32Text.empty())
     {
+        invalidateIncrementalLayout();
         setContentSize(Vec2::ZERO);
         return;
     }
 
+    _glyphsPending   = false;
+    _glyphGeneration = _fontAtlas->getGlyphGeneration();
     _fontAtlas->prepareLetterDefinitions(_utf32Text);
 
     float currentFontSize = getRenderingFontSize();
@@ -1098,13 +1114,14 @@ void Label::alignText()
     }
 
     updateBatchNode();
+
+    _textChangeIndex = std::numeric_limits<int>::max();
 }
 
 bool Label::tryTextPlacement(float fontSize)
 {
     _lengthOfString    = 0;
     _textDesiredHeight = 0.f;
-    _linesWidth.clear();
 
     const bool atMinimumFontSizeLimit = fontSize <= 1.f;
 
@@ -1162,8 +1179,19 @@ void Label::updateBatchNode()
 
     _reusedLetter->setBatchNode(_batchNodes.at(0));
 
+    const auto prevLinesOffsetX  = std::move(_linesOffsetX);
+    const float prevLetterOffsetY = _letterOffsetY;
     computeAlignmentOffset();
 
+    // letter sprites write their own quads, and a vertical shift moves every letter
+    if (!_letters.empty() || _letterOffsetY != prevLetterOffsetY)
+        _reusableLetterCount = 0;
+    for (size_t line = 0; line < _lineStarts.size() && _lineStarts[line].letterIndex < _reusableLetterCount; ++line)
+    {
+        if (line >= prevLinesOffsetX.size() || prevLinesOffsetX[line] != _linesOffsetX[line])
+            _reusableLetterCount = _lineStarts[line].letterIndex;
+    }
+
     updateQuads();
 
     updateLabelLetters();
@@ -1173,14 +1201,42 @@ void Label::updateBatchNode()
 
 bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
 {
+    const int letterCount = static_cast<int>(stringToRender.length());
+
+    // kerning i belongs to the letters i - 1 and i, so the ones in front of the first changed letter still hold
+    const int validCount = _incrementalLayoutEnabled ? std::min(_textChangeIndex, _horizontalKerningsCount) : 0;
+    if (_horizontalKernings && validCount > 1)
+    {
+        if (validCount < letterCount)
+        {
+            int tailCount = 0;
+            int* tail     = _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(
+                stringToRender.substr(validCount - 1), tailCount);
+
+            auto kernings = new int[letterCount];
+            memcpy(kernings, _horizontalKernings, validCount * sizeof(int));
+            if (tail)
+                memcpy(kernings + validCount, tail + 1, (letterCount - validCount) * sizeof(int));
+            else
+                memset(kernings + validCount, 0, (letterCount - validCount) * sizeof(int));
+
+            delete[] tail;
+            delete[] _horizontalKernings;
+            _horizontalKernings = kernings;
+        }
+        _horizontalKerningsCount = letterCount;
+        return true;
+    }
+
     if (_horizontalKernings)
     {
         delete[] _horizontalKernings;
         _horizontalKernings = nullptr;
     }
 
-    int letterCount     = 0;
-    _horizontalKernings = _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(stringToRender, letterCount);
+    int kerningCount         = 0;
+    _horizontalKernings      = _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(stringToRender, kerningCount);
+    _horizontalKerningsCount = _horizontalKernings ? kerningCount : 0;
 
     if (!_horizontalKernings)
         return false;
@@ -1207,14 +1263,44 @@ bool Label::isLetterHorizontallyClamped(float letterPositionX, float letterWidth
 bool Label::updateQuads()
 {
     bool ret = true;
-    for (auto&& batchNode : _batchNodes)
+
+    // quads are inserted in letter order, so the leading letters own the leading quads of every batch node
+    int reusedCount = _incrementalLayoutEnabled ? std::min(_reusableLetterCount, _lengthOfString) : 0;
+    std::vector<ssize_t> keptQuads(_batchNodes.size(), 0);
+    for (int ctr = 0; ctr < reusedCount; ++ctr)
+    {
+        auto& letterInfo = _lettersInfo[ctr];
+        if (letterInfo.valid && letterInfo.atlasIndex >= 0)
+        {
+            auto textureID = static_cast<size_t>(_fontAtlas->_letterDefinitions[letterInfo.utf32Char].textureID);
+            if (textureID >= keptQuads.size())
+            {
+                reusedCount = 0;
+                break;
+            }
+            keptQuads[textureID] = letterInfo.atlasIndex + 1;
+        }
+    }
+    for (size_t i = 0; i < keptQuads.size() && reusedCount > 0; ++i)
     {
-        batchNode->getTextureAtlas()->removeAllQuads();
+        if (keptQuads[i] > static_cast<ssize_t>(_batchNodes.at(i)->getTextureAtlas()->getTotalQuads()))
+            reusedCount = 0;
     }
 
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    for (size_t i = 0; i < keptQuads.size(); ++i)
     {
-        auto& letterInfo = _lettersInfo[ctr];
+        auto textureAtlas     = _batchNodes.at(i)->getTextureAtlas();
+        const auto totalQuads = static_cast<ssize_t>(textureAtlas->getTotalQuads());
+        if (reusedCount == 0)
+            textureAtlas->removeAllQuads();
+        else if (keptQuads[i] < totalQuads)
+            textureAtlas->removeQuadsAtIndex(keptQuads[i], totalQuads - keptQuads[i]);
+    }
+
+    for (int ctr = reusedCount; ctr < _lengthOfString; ++ctr)
+    {
+        auto& letterInfo      = _lettersInfo[ctr];
+        letterInfo.atlasIndex = -1;
         if (letterInfo.valid)
         {
             auto& letterDef = _fontAtlas->_letterDefinitions[letterInfo.utf32Char];
@@ -1285,7 +1371,13 @@ bool Label::setTTFConfigInternal(const TTFConfig& ttfConfig)
 
 bool Label::updateTTFConfigInternal(unsigned int mods)
 {
-    FontAtlas* newAtlas = FontAtlasCache::getFontAtlasTTF(&_fontConfig);
+    // sizes and outlines of a font come from one distance field atlas, see FontAtlasCache::setSharedSDFEnabled,
+    // the user's config is kept as is
+    auto atlasConfig = _fontConfig;
+    if (FontAtlasCache::isSharedSDFEnabled())
+        atlasConfig.distanceFieldEnabled = true;
+
+    FontAtlas* newAtlas = FontAtlasCache::getFontAtlasTTF(&atlasConfig, &_atlasFaceSize);
 
     if (!newAtlas)
     {
@@ -1294,14 +1386,14 @@ bool Label::updateTTFConfigInternal(unsigned int mods)
     }
 
     _currentLabelType = LabelType::TTF;
-    bool atlasUpdated = setFontAtlas(newAtlas, _fontConfig.distanceFieldEnabled, true);
+    bool atlasUpdated = setFontAtlas(newAtlas, atlasConfig.distanceFieldEnabled, true);
 
     /*
      * In distance field text rendering, different font sizes share the same `fontAtlas`, so we need to additionally
      * check if `fontSize` has changed in order to set `contentDirty`. The same applies to `outlineSize`. See
      * `FontAtlasCache` for details.
      */
-    if (!atlasUpdated && mods && _fontConfig.distanceFieldEnabled)
+    if (!atlasUpdated && mods && atlasConfig.distanceFieldEnabled)
         _contentDirty = true;
 
     if (_fontConfig.outlineSize > 0)
@@ -1727,6 +1819,7 @@ void Label::clearTextures()
             AX_SAFE_RELEASE_NULL(_reusedLetter);
             FontAtlasCache::releaseFontAtlas(_fontAtlas);
             _fontAtlas = nullptr;
+            invalidateIncrementalLayout();
         }
 
         _systemFontDirty = false;
@@ -1856,6 +1949,7 @@ void Label::updateContent()
     }
 
     _contentDirty = false;
+    _redrawDirty  = true;
 
 #if AX_LABEL_DEBUG_DRAW
     _debugDrawNode->clear();
@@ -2172,6 +2266,9 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
+    if (_glyphsPending && _fontAtlas && _fontAtlas->getGlyphGeneration() != _glyphGeneration)
+        _contentDirty = true;
+
     if (_systemFontDirty || _contentDirty)
     {
         // Label overflow shrink fix #566
@@ -2247,6 +2344,8 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
 
 void Label::drawSelf(bool visibleByCamera, Renderer* renderer, uint32_t flags)
 {
+    _redrawDirty = false;
+
     if (_textSprite)
     {
         if (_shadowNode)
@@ -2261,6 +2360,13 @@ void Label::drawSelf(bool visibleByCamera, Renderer* renderer, uint32_t flags)
     }
 }
 
+bool Label::isContentDirty() const
+{
+    // getContentSize() relayouts and clears _contentDirty, so the last update is tracked until it is drawn
+    return _contentDirty || _systemFontDirty || _redrawDirty ||
+           (_glyphsPending && _fontAtlas && _fontAtlas->getGlyphGeneration() != _glyphGeneration);
+}
+
 void Label::setSystemFontName(std::string_view systemFont)
 {
     if (systemFont != _systemFont)
@@ -2895,13 +3001,15 @@ void Label::updateFontScale()
         auto originalFontSize = bmFont->getOriginalFontSize();
         _fontScale            = _bmFontSize * scaleFactor / originalFontSize;
     }
-    else if (_currentLabelType == LabelType::TTF && _fontConfig.distanceFieldEnabled)
+    else if (_currentLabelType == LabelType::TTF && _useDistanceField)
     {
         //! Due to underlaying font engine(freetype2) only support int type faceSize, so not only SDF require fontScale,
         //! and current, we check SDF for compatible purpose only. FUTURE: add macro to control behavior
 
         //! faceSize=10, factor=1.55, realSize=(int)15.5=15, so should be (15 / 1.55), not 15.5/1.55
-        const auto scaledFaceSize = static_cast<int>(_fontConfig.faceSize * scaleFactor);
+        //! a shared atlas may be built for another face size, so take the one the atlas is keyed by
+        const auto scaledFaceSize =
+            _atlasFaceSize > 0 ? _atlasFaceSize : static_cast<int>(_fontConfig.faceSize * scaleFactor);
         _fontScale                = _fontConfig.fontSize * scaleFactor / scaledFaceSize;
     }
     else
@@ -2931,7 +3039,39 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
 
     this->updateFontScale();
 
-    for (int index = 0; index < textLen;)
+    const LayoutParams layoutParams{_fontAtlas,  _fontScale,   contentScaleFactor, _maxLineWidth,
+                                    _labelWidth, _labelHeight, _lineHeight,        _lineSpacing,
+                                    _additionalKerning, _overflow, _enableWrap, breakOnChar};
+
+    int index            = 0;
+    _reusableLetterCount = 0;
+    if (_incrementalLayoutEnabled && _overflow != Overflow::SHRINK && !_lineStarts.empty() &&
+        layoutParams == _layoutParams)
+    {
+        // a shorter token may now fit at the end of the previous line, so resume one line before the changed one
+        auto changedLine = std::upper_bound(
+            _lineStarts.begin(), _lineStarts.end(), _textChangeIndex,
+            [](int letterIndex, const LineStart& lineStart) { return letterIndex < lineStart.letterIndex; });
+        lineIndex = std::max(static_cast<int>(changedLine - _lineStarts.begin()) - 2, 0);
+
+        auto& lineStart      = _lineStarts[lineIndex];
+        index                = lineStart.letterIndex;
+        nextTokenY           = lineStart.nextTokenY;
+        highestY             = lineStart.highestY;
+        lowestY              = lineStart.lowestY;
+        nextWhitespaceWidth  = lineStart.whitespaceWidth;
+        nextChangeSize       = lineStart.nextChangeSize;
+        _reusableLetterCount = index;
+    }
+    else
+    {
+        _lineStarts.assign(1, LineStart{0, 0.f, 0.f, 0.f, 0.f, true});
+    }
+    _lineStarts.resize(lineIndex + 1);
+    _linesWidth.resize(lineIndex);
+    _layoutParams = layoutParams;
+
+    while (index < textLen)
     {
         char32_t character = _utf32Text[index];
         if (character == text_utils::UnicodeCharacters::NewLine)
@@ -2943,6 +3083,8 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
             nextTokenY -= _lineHeight * _fontScale + lineSpacing;
             recordPlaceholderInfo(index, character);
             index++;
+            _lineStarts.emplace_back(
+                LineStart{index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
             continue;
         }
 
@@ -2965,6 +3107,7 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
                     if (!text_utils::isUnicodeSpace(nextChar) && !text_utils::isCJKUnicode(nextChar))
                     {
                         // No point continuing here
+                        _lineStarts.clear();
                         return false;
                     }
                 }
@@ -2998,8 +3141,11 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
             if (!getFontLetterDef(character, letterDef))
             {
                 recordPlaceholderInfo(letterIndex, character);
-                AXLOGW("LabelTextFormatter error: can't find letter definition in font file for letter: 0x{:x}",
-                       static_cast<uint32_t>(character));
+                if (_fontAtlas->isGlyphPending(character))
+                    _glyphsPending = true;  // laid out again once the glyph is in the atlas
+                else
+                    AXLOGW("LabelTextFormatter error: can't find letter definition in font file for letter: 0x{:x}",
+                           static_cast<uint32_t>(character));
                 continue;
             }
 
@@ -3014,6 +3160,7 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
                 lineIndex++;
                 nextTokenX = 0.f;
                 nextTokenY -= (_lineHeight * _fontScale + lineSpacing);
+                _lineStarts.emplace_back(LineStart{index, nextTokenY, highestY, lowestY, 0.f, nextChangeSize});
                 newLine = true;
                 break;
             }
@@ -3092,6 +3239,9 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
 
     setContentSize(contentSize);
 
+    const float prevTailoredTopY    = _tailoredTopY;
+    const float prevTailoredBottomY = _tailoredBottomY;
+
     _tailoredTopY    = contentSize.height;
     _tailoredBottomY = 0.f;
 
@@ -3101,6 +3251,14 @@ bool Label::multilineTextWrap(bool breakOnChar, bool ignoreOverflow)
     if (lowestY < -_textDesiredHeight)
         _tailoredBottomY = _textDesiredHeight + lowestY;
 
+    // the quads of the leading letters are clipped against the tailored bounds
+    if (_tailoredTopY != prevTailoredTopY || _tailoredBottomY != prevTailoredBottomY)
+        _reusableLetterCount = 0;
+
+    // shrinking and pending glyphs lay out the whole string again
+    if (_overflow == Overflow::SHRINK || _glyphsPending)
+        invalidateIncrementalLayout();
+
     return true;
 }
 
@@ -3187,6 +3345,13 @@ void Label::recordLetterInfo(const ax::Vec2& point,
     _lettersInfo[letterIndex].offsetY    = offsetY;
 }
 
+void Label::invalidateIncrementalLayout()
+{
+    _lineStarts.clear();
+    _textChangeIndex     = 0;
+    _reusableLetterCount = 0;
+}
+
 void Label::recordPlaceholderInfo(int letterIndex, char32_t utf32Char)
 {
     if (static_cast<std::size_t>(letterIndex) >= _lettersInfo.size())
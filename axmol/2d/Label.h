@@ -663,6 +663,14 @@ public:
 
     FontAtlas* getFontAtlas() { return _fontAtlas; }
 
+    /**
+     * When only part of the string changes, lay out again from the line holding the first changed letter and keep
+     * the glyph quads of the letters before it. Disabled by default, LabelIncrementalLayoutTest in cpp-tests checks
+     * that it matches a full layout.
+     */
+    static void setIncrementalLayoutEnabled(bool enabled) { _incrementalLayoutEnabled = enabled; }
+    static bool isIncrementalLayoutEnabled() { return _incrementalLayoutEnabled; }
+
     const BlendFunc& getBlendFunc() const override { return _blendFunc; }
     void setBlendFunc(const BlendFunc& blendFunc) override;
 
@@ -678,6 +686,7 @@ public:
 
     void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
     void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
+    bool isContentDirty() const override;
 
     void setCameraMask(unsigned short mask, bool applyChildren = true) override;
 
@@ -721,6 +730,36 @@ protected:
         float offsetY;
     };
 
+    // wrap state at the first letter of a line, multilineTextWrap resumes from it
+    struct LineStart
+    {
+        int letterIndex;
+        float nextTokenY;
+        float highestY;
+        float lowestY;
+        float whitespaceWidth;
+        bool nextChangeSize;
+    };
+
+    // everything besides the text that the positions recorded by multilineTextWrap depend on
+    struct LayoutParams
+    {
+        FontAtlas* fontAtlas;
+        float fontScale;
+        float contentScaleFactor;
+        float maxLineWidth;
+        float labelWidth;
+        float labelHeight;
+        float lineHeight;
+        float lineSpacing;
+        float additionalKerning;
+        Overflow overflow;
+        bool enableWrap;
+        bool breakOnChar;
+
+        bool operator==(const LayoutParams&) const = default;
+    };
+
     struct BatchCommand
     {
         BatchCommand();
@@ -806,7 +845,12 @@ protected:
 
     void updateBatchCommand(BatchCommand& batch);
 
+    void invalidateIncrementalLayout();
+
     bool _contentDirty;
+    bool _redrawDirty = true;  // the content was updated since the label was last drawn
+    bool _glyphsPending;  // some letters wait for asynchronously rasterized glyphs
+    unsigned int _glyphGeneration;
     bool _useDistanceField;
     bool _useA8Shader;
     bool _shadowDirty;
@@ -860,6 +904,8 @@ protected:
     float _shadowBlurRadius;
     float _bmFontSize;
     float _fontScale;  // The bmFontScale or ttfFontScale(SDF rendering mode)
+    // scaled face size of the TTF atlas, differs from _fontConfig when a shared SDF atlas is used
+    int _atlasFaceSize = 0;
 
     Overflow _overflow;
     float _originalFontSize;
@@ -874,6 +920,7 @@ protected:
     Sprite* _textSprite;
     Sprite* _shadowNode;
     int* _horizontalKernings;
+    int _horizontalKerningsCount;
     FontAtlas* _fontAtlas;
     //! used for optimization
     Sprite* _reusedLetter;
@@ -902,6 +949,13 @@ protected:
     std::vector<float> _linesWidth;
     std::vector<float> _linesOffsetX;
 
+    std::vector<LineStart> _lineStarts;
+    LayoutParams _layoutParams{};
+    int _textChangeIndex;      // first letter that differs from the last laid out string
+    int _reusableLetterCount;  // letters in front of it whose quads are still valid
+
+    static bool _incrementalLayoutEnabled;
+
     QuadCommand _quadCommand;
 
     std::vector<BatchCommand> _batchCommands;
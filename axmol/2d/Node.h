@@ -1481,6 +1481,17 @@ public:
     virtual const Mat4& getNodeToParentTransform() const;
     virtual AffineTransform getNodeToParentAffineTransform() const;
 
+    /**
+     * Returns whether the transform or the content size changed since the node was last visited.
+     */
+    bool isVisitDirty() const { return _transformUpdated || _contentSizeDirty; }
+
+    /**
+     * Returns whether what the node draws changed since it was last drawn beyond its transform, size, color and
+     * opacity, e.g. the text of a Label or the texture of a Sprite. Render caches use it to know when to redraw.
+     */
+    virtual bool isContentDirty() const { return false; }
+
     /**
      * Returns the matrix that transform the node's (local) space coordinates into the parent's space coordinates.
      * The matrix is in Pixels.
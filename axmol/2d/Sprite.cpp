@@ -426,7 +426,8 @@ void Sprite::setTexture(Texture2D* texture)
         {
             AX_SAFE_RETAIN(texture);
             AX_SAFE_RELEASE(_texture);
-            _texture = texture;
+            _texture      = texture;
+            _contentDirty = true;
         }
         updateBlendFunc();
     }
@@ -467,6 +468,8 @@ void Sprite::setTextureRect(const Rect& rect, bool rotated, const Vec2& untrimme
 
 void Sprite::updatePoly()
 {
+    _contentDirty = true;
+
     // There are 3 cases:
     //
     // A) a non 9-sliced, non stretched
@@ -692,11 +695,31 @@ void Sprite::updatePoly()
             setVertexCoords(verticesRects[i], &tmpQuad);
             populateTriangle(i, tmpQuad);
         }
+        // only index the quads with an area, insets of zero or a content size that leaves no room for the
+        // center produce empty slices which would still cost 2 triangles each in the batch
+        unsigned int indexCount = 0;
+        for (int i = 0; i < 9; ++i)
+        {
+            const int index_bl = i * 4 / 3;
+            const auto& bl     = _trianglesVertex[index_bl].position;
+            const auto& tr     = _trianglesVertex[index_bl + 5].position;
+            if (bl.x == tr.x || bl.y == tr.y)
+                continue;
+
+            // populate indices in CCW direction
+            _trianglesIndex[indexCount++] = index_bl + 4;
+            _trianglesIndex[indexCount++] = index_bl + 0;
+            _trianglesIndex[indexCount++] = index_bl + 5;
+            _trianglesIndex[indexCount++] = index_bl + 1;
+            _trianglesIndex[indexCount++] = index_bl + 5;
+            _trianglesIndex[indexCount++] = index_bl + 0;
+        }
+
         TrianglesCommand::Triangles triangles;
         triangles.verts      = _trianglesVertex;
         triangles.vertCount  = 16;
         triangles.indices    = _trianglesIndex;
-        triangles.indexCount = 6 * 9;  // 9 quads, each needs 6 vertices
+        triangles.indexCount = indexCount;  // up to 9 quads, each needs 6 vertices
 
         // probably we can update the _trianglesCommand directly
         // to avoid memcpy'ing stuff
@@ -738,19 +761,8 @@ void Sprite::setCenterRectNormalized(const ax::Rect& rectTopLeft)
                 _renderMode = RenderMode::SLICE9;
                 // 9 quads + 7 exterior points = 16
                 _trianglesVertex = (V3F_T2F_C4B*)malloc(sizeof(*_trianglesVertex) * (9 + 3 + 4));
-                // 9 quads, each needs 6 vertices = 54
+                // 9 quads, each needs 6 vertices = 54, populated by updatePoly()
                 _trianglesIndex = (unsigned short*)malloc(sizeof(*_trianglesIndex) * 6 * 9);
-
-                // populate indices in CCW direction
-                for (int i = 0; i < 9; ++i)
-                {
-                    _trianglesIndex[i * 6 + 0] = (i * 4 / 3) + 4;
-                    _trianglesIndex[i * 6 + 1] = (i * 4 / 3) + 0;
-                    _trianglesIndex[i * 6 + 2] = (i * 4 / 3) + 5;
-                    _trianglesIndex[i * 6 + 3] = (i * 4 / 3) + 1;
-                    _trianglesIndex[i * 6 + 4] = (i * 4 / 3) + 5;
-                    _trianglesIndex[i * 6 + 5] = (i * 4 / 3) + 0;
-                }
             }
         }
 
@@ -1066,6 +1078,7 @@ void Sprite::updateTransform()
 // draw
 void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    _contentDirty = false;
     if (_texture == nullptr || _texture->getRHITexture() == nullptr)
         return;
 
@@ -1364,6 +1377,10 @@ void Sprite::setContentSize(const Vec2& size)
     if (_stretchEnabled && (_renderMode == RenderMode::QUAD_BATCHNODE || _renderMode == RenderMode::POLYGON))
         AXLOGW("Sprite::setContentSize() doesn't stretch the sprite when using QUAD_BATCHNODE or POLYGON render modes");
 
+    // the slices only depend on the content size here, everything else rebuilds them when it changes
+    if (_renderMode == RenderMode::SLICE9 && size.equals(_contentSize))
+        return;
+
     Node::setContentSize(size);
 
     updateStretchFactor();
@@ -1457,6 +1474,7 @@ bool Sprite::isFlippedY() const
 
 void Sprite::flipX()
 {
+    _contentDirty = true;
     if (_renderMode == RenderMode::QUAD_BATCHNODE)
         setDirty(true);
     else if (_renderMode == RenderMode::POLYGON)
@@ -1474,6 +1492,7 @@ void Sprite::flipX()
 
 void Sprite::flipY()
 {
+    _contentDirty = true;
     if (_renderMode == RenderMode::QUAD_BATCHNODE)
         setDirty(true);
     else if (_renderMode == RenderMode::POLYGON)
@@ -1708,8 +1727,9 @@ const PolygonInfo& Sprite::getPolygonInfo() const
 
 void Sprite::setPolygonInfo(const PolygonInfo& info)
 {
-    _polyInfo   = info;
-    _renderMode = RenderMode::POLYGON;
+    _polyInfo     = info;
+    _renderMode   = RenderMode::POLYGON;
+    _contentDirty = true;
 }
 
 void Sprite::setMVPMatrixUniform()
@@ -393,6 +393,7 @@ public:
     void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
     void setOpacityModifyRGB(bool modify) override;
     bool isOpacityModifyRGB() const override;
+    bool isContentDirty() const override { return _contentDirty; }
     /// @}
 
     /**
@@ -723,6 +724,7 @@ protected:
     bool _flippedY = false;  /// Whether the sprite is flipped vertically or not
 
     bool _insideBounds = true;  /// whether or not the sprite was inside bounds the previous frame
+    bool _contentDirty = true;  /// whether the texture or the geometry changed since the sprite was last drawn
 
     std::string _fileName;
     int _fileType = 0;
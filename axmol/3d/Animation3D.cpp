@@ -33,11 +33,36 @@
 namespace ax
 {
 
+// .c3a: compressed animation written by Animation3D::saveCompressed
+static const char C3A_MAGIC[] = {'C', '3', 'A', '\0'};
+static const uint32_t C3A_VERSION = 1;
+
+enum C3ACurveMask : uint8_t
+{
+    C3A_TRANSLATION = 1,
+    C3A_ROTATION    = 1 << 1,
+    C3A_SCALE       = 1 << 2,
+};
+
+Animation3D::CompressionConfig Animation3D::s_compressionConfig;
+
+// curves built from bundles depend on the compression config, keep one cache entry per config
+static std::string makeCacheKey(std::string_view fullPath, std::string_view animationName)
+{
+    std::string key{fullPath};
+    key.append("#").append(animationName);
+
+    auto& config = Animation3D::getCompressionConfig();
+    if (config.enabled && FileUtils::getPathExtension(fullPath) != ".c3a")
+        fmt::format_to(std::back_inserter(key), "#{}/{}/{}", config.translationError, config.rotationError,
+                       config.scaleError);
+    return key;
+}
+
 Animation3D* Animation3D::create(std::string_view fileName, std::string_view animationName)
 {
-    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
-    fullPath.append("#").append(animationName);
-    auto animation = Animation3DCache::getInstance()->getAnimation(fullPath);
+    auto fullPath  = FileUtils::getInstance()->fullPathForFilename(fileName);
+    auto animation = Animation3DCache::getInstance()->getAnimation(makeCacheKey(fullPath, animationName));
     if (animation != nullptr)
         return animation;
 
@@ -58,13 +83,20 @@ bool Animation3D::initWithFile(std::string_view filename, std::string_view anima
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
+    if (FileUtils::getPathExtension(fullPath) == ".c3a")
+    {
+        if (!initWithCompressedData(FileUtils::getInstance()->getDataFromFile(fullPath)))
+            return false;
+        Animation3DCache::getInstance()->addAnimation(makeCacheKey(fullPath, animationName), this);
+        return true;
+    }
+
     // load animation here
     auto bundle = Bundle3D::createBundle();
     Animation3DData animationdata;
     if (bundle->load(fullPath) && bundle->loadAnimationData(animationName, &animationdata) && init(animationdata))
     {
-        fullPath.append("#").append(animationName);
-        Animation3DCache::getInstance()->addAnimation(fullPath, this);
+        Animation3DCache::getInstance()->addAnimation(makeCacheKey(fullPath, animationName), this);
         Bundle3D::destroyBundle(bundle);
         return true;
     }
@@ -83,6 +115,30 @@ Animation3D::Curve* Animation3D::getBoneCurveByName(std::string_view name) const
     return nullptr;
 }
 
+Animation3D::Curve* Animation3D::getOrCreateBoneCurve(std::string_view name)
+{
+    Curve*& curve = _boneCurves[name];
+    if (curve == nullptr)
+        curve = new Curve();
+    return curve;
+}
+
+size_t Animation3D::getMemorySize() const
+{
+    size_t size = 0;
+    for (const auto& iter : _boneCurves)
+    {
+        const Curve* curve = iter.second;
+        if (curve->translateCurve)
+            size += curve->translateCurve->getMemorySize();
+        if (curve->rotCurve)
+            size += curve->rotCurve->getMemorySize();
+        if (curve->scaleCurve)
+            size += curve->scaleCurve->getMemorySize();
+    }
+    return size;
+}
+
 Animation3D::Animation3D() : _duration(0) {}
 
 Animation3D::~Animation3D()
@@ -113,12 +169,7 @@ bool Animation3D::init(const Animation3DData& data)
         tlx::pod_vector<Vec3> values;
         for (const auto& iter : data._translationKeys)
         {
-            Curve* curve = _boneCurves[iter.first];
-            if (curve == nullptr)
-            {
-                curve                   = new Curve();
-                _boneCurves[iter.first] = curve;
-            }
+            Curve* curve = getOrCreateBoneCurve(iter.first);
 
             if (iter.second.empty())
                 continue;
@@ -128,7 +179,11 @@ bool Animation3D::init(const Animation3DData& data)
             tlx::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                       [](const auto& keyIter) { return keyIter._key; });
 
-            curve->translateCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
+            if (s_compressionConfig.enabled)
+                curve->translateCurve = Curve::AnimationCurveVec3::createCompressed(
+                    &keys[0], &values[0].x, (int)keys.size(), s_compressionConfig.translationError);
+            else
+                curve->translateCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
             if (curve->translateCurve)
                 curve->translateCurve->retain();
         }
@@ -139,12 +194,7 @@ bool Animation3D::init(const Animation3DData& data)
         tlx::pod_vector<Quaternion> values;
         for (const auto& iter : data._rotationKeys)
         {
-            Curve* curve = _boneCurves[iter.first];
-            if (curve == nullptr)
-            {
-                curve                   = new Curve();
-                _boneCurves[iter.first] = curve;
-            }
+            Curve* curve = getOrCreateBoneCurve(iter.first);
 
             if (iter.second.empty())
                 continue;
@@ -154,7 +204,11 @@ bool Animation3D::init(const Animation3DData& data)
             tlx::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                       [](const auto& keyIter) { return keyIter._key; });
 
-            curve->rotCurve = Curve::AnimationCurveQuat::create(&keys[0], &values[0].x, (int)keys.size());
+            if (s_compressionConfig.enabled)
+                curve->rotCurve = Curve::AnimationCurveQuat::createCompressed(
+                    &keys[0], &values[0].x, (int)keys.size(), s_compressionConfig.rotationError);
+            else
+                curve->rotCurve = Curve::AnimationCurveQuat::create(&keys[0], &values[0].x, (int)keys.size());
             if (curve->rotCurve)
                 curve->rotCurve->retain();
         }
@@ -165,12 +219,7 @@ bool Animation3D::init(const Animation3DData& data)
         tlx::pod_vector<Vec3> values;
         for (const auto& iter : data._scaleKeys)
         {
-            Curve* curve = _boneCurves[iter.first];
-            if (curve == nullptr)
-            {
-                curve                   = new Curve();
-                _boneCurves[iter.first] = curve;
-            }
+            Curve* curve = getOrCreateBoneCurve(iter.first);
 
             if (iter.second.empty())
                 continue;
@@ -180,7 +229,11 @@ bool Animation3D::init(const Animation3DData& data)
             tlx::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                       [](const auto& keyIter) { return keyIter._key; });
 
-            curve->scaleCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
+            if (s_compressionConfig.enabled)
+                curve->scaleCurve = Curve::AnimationCurveVec3::createCompressed(
+                    &keys[0], &values[0].x, (int)keys.size(), s_compressionConfig.scaleError);
+            else
+                curve->scaleCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
             if (curve->scaleCurve)
                 curve->scaleCurve->retain();
         }
@@ -189,6 +242,113 @@ bool Animation3D::init(const Animation3DData& data)
     return true;
 }
 
+bool Animation3D::initWithCompressedData(const Data& data)
+{
+    if (data.getSize() < sizeof(C3A_MAGIC) + sizeof(uint32_t) ||
+        memcmp(data.getBytes(), C3A_MAGIC, sizeof(C3A_MAGIC)) != 0)
+    {
+        AXLOGW("warning: Animation3D: invalid compressed animation data");
+        return false;
+    }
+
+    auto rejectCurve = [] {
+        AXLOGW("warning: Animation3D: compressed animation curve doesn't fit in the file");
+        return false;
+    };
+
+    yasio::fast_ibstream_view ibs((const char*)data.getBytes(), data.getSize());
+    try
+    {
+        ibs.advance(sizeof(C3A_MAGIC));
+        auto version = ibs.read<uint32_t>();
+        if (version != C3A_VERSION)
+        {
+            AXLOGW("warning: Animation3D: unsupported compressed animation version {}", version);
+            return false;
+        }
+
+        _duration      = ibs.read<float>();
+        auto boneCount = ibs.read<uint32_t>();
+        for (uint32_t i = 0; i < boneCount; ++i)
+        {
+            Curve* curve = getOrCreateBoneCurve(ibs.read_v32());
+            auto mask    = ibs.read<uint8_t>();
+            if (mask & C3A_TRANSLATION)
+            {
+                curve->translateCurve = Curve::AnimationCurveVec3::createFromStream(ibs);
+                if (!curve->translateCurve)
+                    return rejectCurve();
+                curve->translateCurve->retain();
+            }
+            if (mask & C3A_ROTATION)
+            {
+                curve->rotCurve = Curve::AnimationCurveQuat::createFromStream(ibs);
+                if (!curve->rotCurve)
+                    return rejectCurve();
+                curve->rotCurve->retain();
+            }
+            if (mask & C3A_SCALE)
+            {
+                curve->scaleCurve = Curve::AnimationCurveVec3::createFromStream(ibs);
+                if (!curve->scaleCurve)
+                    return rejectCurve();
+                curve->scaleCurve->retain();
+            }
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        AXLOGW("warning: Animation3D: failed to read compressed animation: {}", ex.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool Animation3D::saveCompressed(std::string_view fullPath) const
+{
+    yasio::fast_obstream obs;
+    obs.write_bytes(C3A_MAGIC, sizeof(C3A_MAGIC));
+    obs.write<uint32_t>(C3A_VERSION);
+    obs.write<float>(_duration);
+    obs.write<uint32_t>(static_cast<uint32_t>(_boneCurves.size()));
+
+    auto writeCurve = [&obs](auto* curve, float maxError) {
+        using CurveType = std::remove_pointer_t<decltype(curve)>;
+        if (curve->isCompressed())
+        {
+            curve->writeCompressed(obs);
+            return;
+        }
+
+        CurveType::createCompressed(curve->getKeyTimes(), curve->getKeyValues(), curve->getKeyCount(), maxError)
+            ->writeCompressed(obs);
+    };
+
+    for (const auto& iter : _boneCurves)
+    {
+        const Curve* curve = iter.second;
+        obs.write_v32(iter.first);
+        uint8_t mask = 0;
+        if (curve->translateCurve)
+            mask |= C3A_TRANSLATION;
+        if (curve->rotCurve)
+            mask |= C3A_ROTATION;
+        if (curve->scaleCurve)
+            mask |= C3A_SCALE;
+        obs.write<uint8_t>(mask);
+
+        if (curve->translateCurve)
+            writeCurve(curve->translateCurve, s_compressionConfig.translationError);
+        if (curve->rotCurve)
+            writeCurve(curve->rotCurve, s_compressionConfig.rotationError);
+        if (curve->scaleCurve)
+            writeCurve(curve->scaleCurve, s_compressionConfig.scaleError);
+    }
+
+    return FileUtils::writeBinaryToFile(obs.data(), obs.length(), fullPath);
+}
+
 ////////////////////////////////////////////////////////////////
 Animation3DCache* Animation3DCache::_cacheInstance = nullptr;
 
@@ -31,6 +31,7 @@
 
 #include "axmol/base/Macros.h"
 #include "axmol/base/Object.h"
+#include "axmol/base/Data.h"
 #include "axmol/3d/Bundle3DData.h"
 
 namespace ax
@@ -68,6 +69,25 @@ public:
         ~Curve();
     };
 
+    /**
+     * keyframe compression applied by init, disabled by default
+     * errors are the max absolute error per component allowed when dropping redundant keys
+     */
+    struct CompressionConfig
+    {
+        bool enabled           = false;
+        float translationError = 0.001f;
+        float rotationError    = 0.0005f;
+        float scaleError       = 0.0005f;
+    };
+
+    /**
+     * set or get the compression config used by animations created afterwards,
+     * Animation3D::create caches one animation per file and config, so changing it doesn't affect existing ones
+     */
+    static void setCompressionConfig(const CompressionConfig& config) { s_compressionConfig = config; }
+    static const CompressionConfig& getCompressionConfig() { return s_compressionConfig; }
+
     /**read all animation or only the animation with given animationName? animationName == "" read the first.*/
     static Animation3D* create(std::string_view filename, std::string_view animationName = "");
 
@@ -84,6 +104,15 @@ public:
     /**get the bone Curves set*/
     const tlx::string_map<Curve*>& getBoneCurves() const { return _boneCurves; }
 
+    /**get memory used by keyframe data of all curves in bytes*/
+    size_t getMemorySize() const;
+
+    /**
+     * save curves as compressed animation (.c3a), curves not yet compressed are compressed with current config
+     * errors. This is the offline converter for .c3b/.c3t animations, .c3a files are loaded by create directly.
+     */
+    bool saveCompressed(std::string_view fullPath) const;
+
     Animation3D();
     virtual ~Animation3D();
     /**init Animation3D from bundle data*/
@@ -92,10 +121,17 @@ public:
     /**init Animation3D with file name and animation name*/
     bool initWithFile(std::string_view filename, std::string_view animationName);
 
+    /**init Animation3D with compressed animation data written by saveCompressed*/
+    bool initWithCompressedData(const Data& data);
+
 protected:
+    Curve* getOrCreateBoneCurve(std::string_view name);
+
     tlx::string_map<Curve*> _boneCurves;  // bone curves map, key bone name, value AnimationCurve
 
     float _duration;  // animation duration
+
+    static CompressionConfig s_compressionConfig;
 };
 
 /**
@@ -24,12 +24,17 @@
  ****************************************************************************/
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "axmol/platform/PlatformMacros.h"
 #include "axmol/base/Object.h"
 #include "axmol/math/Math.h"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
 
 namespace ax
 {
@@ -62,6 +67,20 @@ public:
     /**create animation curve*/
     static AnimationCurve* create(float* keytime, float* value, int count);
 
+    /**
+     * create animation curve stored in compressed form.
+     * Keys which can be rebuilt from their neighbours within maxError are dropped, key times are quantized
+     * to 16 bits, vec3 keys to 16 bits per component and rotation keys to 48 bits (smallest three).
+     * @param maxError Max absolute error per component allowed when dropping keys
+     */
+    static AnimationCurve* createCompressed(const float* keytime, const float* value, int count, float maxError);
+
+    /**create compressed animation curve from data written by writeCompressed*/
+    static AnimationCurve* createFromStream(yasio::fast_ibstream_view& ibs);
+
+    /**write compressed keys to stream, the curve must be compressed*/
+    void writeCompressed(yasio::fast_obstream& obs) const;
+
     /**
      * evaluate value of time
      * @param time Time to be estimated
@@ -79,6 +98,19 @@ public:
     /**get end time*/
     float getEndTime() const;
 
+    /**is keyframe data compressed*/
+    bool isCompressed() const { return _compressed; }
+
+    /**get number of stored keys*/
+    int getKeyCount() const { return _count; }
+
+    /**get raw key times and values, nullptr when compressed*/
+    const float* getKeyTimes() const { return _keytime; }
+    const float* getKeyValues() const { return _value; }
+
+    /**get memory used by keyframe data in bytes*/
+    size_t getMemorySize() const;
+
     AnimationCurve();
     virtual ~AnimationCurve();
 
@@ -88,12 +120,30 @@ public:
     int determineIndex(float time) const;
 
 protected:
+    void interpolate(const float* fromValue, const float* toValue, float t, float time, float* dst, EvaluateType type)
+        const;
+
+    void evaluateCompressed(float time, float* dst, EvaluateType type) const;
+    void decodeKey(int index, float* dst) const;
+    float decodeTime(int index) const { return _startTime + _packedTimes[index] * _timeStep; }
+
+    static bool isKeyRedundant(const float* keytime, const float* value, int from, int to, float maxError);
+
     float* _value;    //
     float* _keytime;  // key time(0 - 1), start time _keytime[0], end time _keytime[_count - 1]
     int _count;
     int _componentSizeByte;  // component size in byte, position and scale 3 * sizeof(float), rotation 4 * sizeof(float)
 
     std::function<void(float time, float* dst)> _evaluateFun;  // user defined function
+
+    // compressed storage, used instead of _keytime and _value when _compressed is true
+    bool _compressed;
+    float _startTime;
+    float _timeStep;                      // time of one quantization step
+    float _valueMin[componentSize];       // vec3 curves only, quantization range start
+    float _valueStep[componentSize];      // vec3 curves only, value of one quantization step
+    std::vector<uint16_t> _packedTimes;   // key time in quantization steps from _startTime
+    std::vector<uint16_t> _packedValues;  // 3 words per key
 };
 
 // end of 3d group
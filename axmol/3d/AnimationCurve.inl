@@ -4,6 +4,12 @@ namespace ax
 template <int componentSize>
 void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateType type) const
 {
+    if (_compressed)
+    {
+        evaluateCompressed(time, dst, type);
+        return;
+    }
+
     if (_count == 1 || time <= _keytime[0])
     {
         memcpy(dst, _value, _componentSizeByte);
@@ -23,6 +29,17 @@ void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateTyp
     float* fromValue = &_value[index * componentSize];
     float* toValue = fromValue + componentSize;
 
+    interpolate(fromValue, toValue, t, time, dst, type);
+}
+
+template <int componentSize>
+void AnimationCurve<componentSize>::interpolate(const float* fromValue,
+                                                const float* toValue,
+                                                float t,
+                                                float time,
+                                                float* dst,
+                                                EvaluateType type) const
+{
     switch (type) {
         case EvaluateType::INT_LINEAR:
         {
@@ -33,7 +50,7 @@ void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateTyp
         break;
         case EvaluateType::INT_NEAR:
         {
-            float* src = std::abs(t) > 0.5f ? toValue : fromValue;
+            const float* src = std::abs(t) > 0.5f ? toValue : fromValue;
             memcpy(dst, src, _componentSizeByte);
         }
         break;
@@ -41,10 +58,12 @@ void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateTyp
         {
             // Evaluate.
             Quaternion quat;
+            Quaternion from(fromValue[0], fromValue[1], fromValue[2], fromValue[3]);
+            Quaternion to(toValue[0], toValue[1], toValue[2], toValue[3]);
             if (t >= 0)
-                Quaternion::slerp(Quaternion(fromValue), Quaternion(toValue), t, &quat);
+                Quaternion::slerp(from, to, t, &quat);
             else
-                Quaternion::slerp(Quaternion(toValue), Quaternion(fromValue), t, &quat);
+                Quaternion::slerp(to, from, t, &quat);
 
             dst[0] = quat.x;
             dst[1] = quat.y;
@@ -64,6 +83,106 @@ void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateTyp
     }
 }
 
+template <int componentSize>
+void AnimationCurve<componentSize>::evaluateCompressed(float time, float* dst, EvaluateType type) const
+{
+    if (_count == 1 || time <= _startTime)
+    {
+        decodeKey(0, dst);
+        return;
+    }
+    else if (time >= decodeTime(_count - 1))
+    {
+        decodeKey(_count - 1, dst);
+        return;
+    }
+
+    // keys are fixed width, so only the two keys around time need to be decoded
+    const float steps = (time - _startTime) / _timeStep;
+    auto it = std::upper_bound(_packedTimes.begin(), _packedTimes.end(), steps,
+                               [](float value, uint16_t key) { return value < key; });
+    int index = static_cast<int>(it - _packedTimes.begin()) - 1;
+    index     = std::clamp(index, 0, _count - 2);
+
+    float fromTime = decodeTime(index);
+    float t        = (time - fromTime) / (decodeTime(index + 1) - fromTime);
+
+    float fromValue[componentSize];
+    float toValue[componentSize];
+    decodeKey(index, fromValue);
+    decodeKey(index + 1, toValue);
+
+    interpolate(fromValue, toValue, t, time, dst, type);
+}
+
+template <int componentSize>
+void AnimationCurve<componentSize>::decodeKey(int index, float* dst) const
+{
+    const uint16_t* packed = &_packedValues[index * 3];
+    if constexpr (componentSize == 4)
+    {
+        // smallest three: bit 15 of the first two words holds the index of the dropped largest component
+        constexpr float kInvScale = 1.0f / (32767.0f * 1.41421356f);
+        int largest               = ((packed[0] >> 15) << 1) | (packed[1] >> 15);
+        float sum                 = 0;
+        for (int i = 0, c = 0; i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+            float v = (static_cast<float>(packed[c++] & 0x7fff) * 2.0f - 32767.0f) * kInvScale;
+            dst[i]  = v;
+            sum += v * v;
+        }
+        dst[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    }
+    else
+    {
+        for (int i = 0; i < componentSize; ++i)
+            dst[i] = _valueMin[i] + packed[i] * _valueStep[i];
+    }
+}
+
+template <int componentSize>
+bool AnimationCurve<componentSize>::isKeyRedundant(const float* keytime,
+                                                   const float* value,
+                                                   int from,
+                                                   int to,
+                                                   float maxError)
+{
+    const float* fromValue = &value[from * componentSize];
+    const float* toValue   = &value[to * componentSize];
+    for (int k = from + 1; k < to; ++k)
+    {
+        float t              = (keytime[k] - keytime[from]) / (keytime[to] - keytime[from]);
+        const float* keyValue = &value[k * componentSize];
+        float error          = 0;
+        if constexpr (componentSize == 4)
+        {
+            Quaternion quat;
+            Quaternion::slerp(Quaternion(fromValue[0], fromValue[1], fromValue[2], fromValue[3]),
+                              Quaternion(toValue[0], toValue[1], toValue[2], toValue[3]), std::clamp(t, 0.0f, 1.0f),
+                              &quat);
+            const float rebuilt[4] = {quat.x, quat.y, quat.z, quat.w};
+            // q and -q are the same rotation
+            float errorPos = 0, errorNeg = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                errorPos = std::max(errorPos, std::abs(rebuilt[i] - keyValue[i]));
+                errorNeg = std::max(errorNeg, std::abs(rebuilt[i] + keyValue[i]));
+            }
+            error = std::min(errorPos, errorNeg);
+        }
+        else
+        {
+            for (int i = 0; i < componentSize; ++i)
+                error = std::max(error, std::abs(fromValue[i] + (toValue[i] - fromValue[i]) * t - keyValue[i]));
+        }
+        if (error > maxError)
+            return false;
+    }
+    return true;
+}
+
 template <int componentSize>
 void AnimationCurve<componentSize>::setEvaluateFun(std::function<void(float time, float* dst)> fun)
 {
@@ -91,16 +210,172 @@ AnimationCurve<componentSize>* AnimationCurve<componentSize>::create(float* keyt
     return curve;
 }
 
+template <int componentSize>
+AnimationCurve<componentSize>* AnimationCurve<componentSize>::createCompressed(const float* keytime,
+                                                                               const float* value,
+                                                                               int count,
+                                                                               float maxError)
+{
+    static_assert(componentSize == 3 || componentSize == 4, "only vec3 and quaternion curves can be compressed");
+
+    // greedy keyframe reduction, keep a key only when the segment from the last kept key can't skip it
+    std::vector<int> kept;
+    kept.reserve(count);
+    kept.push_back(0);
+    for (int i = 2; i < count; ++i)
+    {
+        if (!isKeyRedundant(keytime, value, kept.back(), i, maxError))
+            kept.push_back(i - 1);
+    }
+    if (count > 1)
+        kept.push_back(count - 1);
+
+    AnimationCurve* curve = new AnimationCurve();
+    curve->_compressed          = true;
+    curve->_componentSizeByte   = componentSize * sizeof(float);
+    curve->_startTime           = keytime[0];
+    float duration              = keytime[count - 1] - keytime[0];
+    curve->_timeStep            = duration > 0 ? duration / 65535.0f : 1.0f;
+
+    if constexpr (componentSize == 3)
+    {
+        for (int i = 0; i < componentSize; ++i)
+        {
+            float minValue = value[i], maxValue = value[i];
+            for (auto k : kept)
+            {
+                minValue = std::min(minValue, value[k * componentSize + i]);
+                maxValue = std::max(maxValue, value[k * componentSize + i]);
+            }
+            curve->_valueMin[i]  = minValue;
+            curve->_valueStep[i] = (maxValue - minValue) / 65535.0f;
+        }
+    }
+
+    curve->_packedTimes.reserve(kept.size());
+    curve->_packedValues.reserve(kept.size() * 3);
+    for (auto k : kept)
+    {
+        auto packedTime = static_cast<uint16_t>(std::lround((keytime[k] - keytime[0]) / curve->_timeStep));
+        // keys closer than a quantization step collapse, the later one wins
+        if (!curve->_packedTimes.empty() && curve->_packedTimes.back() == packedTime)
+        {
+            curve->_packedTimes.pop_back();
+            curve->_packedValues.resize(curve->_packedValues.size() - 3);
+        }
+        curve->_packedTimes.push_back(packedTime);
+
+        const float* keyValue = &value[k * componentSize];
+        if constexpr (componentSize == 4)
+        {
+            int largest = 0;
+            for (int i = 1; i < 4; ++i)
+            {
+                if (std::abs(keyValue[i]) > std::abs(keyValue[largest]))
+                    largest = i;
+            }
+            float sign = keyValue[largest] < 0 ? -1.0f : 1.0f;
+            float len  = std::sqrt(keyValue[0] * keyValue[0] + keyValue[1] * keyValue[1] +
+                                   keyValue[2] * keyValue[2] + keyValue[3] * keyValue[3]);
+            sign /= len > 0 ? len : 1.0f;
+
+            uint16_t words[3];
+            for (int i = 0, c = 0; i < 4; ++i)
+            {
+                if (i == largest)
+                    continue;
+                // remaining components lie in [-1/sqrt(2), 1/sqrt(2)]
+                float v    = std::clamp(keyValue[i] * sign * 1.41421356f, -1.0f, 1.0f);
+                words[c++] = static_cast<uint16_t>(std::lround((v + 1.0f) * 0.5f * 32767.0f));
+            }
+            words[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+            words[1] |= static_cast<uint16_t>((largest & 1) << 15);
+            curve->_packedValues.insert(curve->_packedValues.end(), words, words + 3);
+        }
+        else
+        {
+            for (int i = 0; i < componentSize; ++i)
+            {
+                float steps = curve->_valueStep[i] > 0 ? (keyValue[i] - curve->_valueMin[i]) / curve->_valueStep[i] : 0;
+                curve->_packedValues.push_back(static_cast<uint16_t>(std::clamp(std::lround(steps), 0l, 65535l)));
+            }
+        }
+    }
+    curve->_count = static_cast<int>(curve->_packedTimes.size());
+    curve->_packedTimes.shrink_to_fit();
+    curve->_packedValues.shrink_to_fit();
+
+    curve->autorelease();
+    return curve;
+}
+
+template <int componentSize>
+AnimationCurve<componentSize>* AnimationCurve<componentSize>::createFromStream(yasio::fast_ibstream_view& ibs)
+{
+    static_assert(componentSize == 3 || componentSize == 4, "only vec3 and quaternion curves can be compressed");
+
+    // ibs throws on truncated input
+    std::unique_ptr<AnimationCurve> curve{new AnimationCurve()};
+    curve->_compressed        = true;
+    curve->_componentSizeByte = componentSize * sizeof(float);
+    curve->_count             = ibs.read<int32_t>();
+    curve->_startTime         = ibs.read<float>();
+    curve->_timeStep          = ibs.read<float>();
+    if constexpr (componentSize == 3)
+    {
+        ibs.read_blob(curve->_valueMin);
+        ibs.read_blob(curve->_valueStep);
+    }
+
+    // the count sizes the allocations below, reject it unless the keys it announces are in the stream
+    const auto remaining = static_cast<int64_t>(ibs.length()) - static_cast<int64_t>(ibs.tell());
+    if (curve->_count <= 0 || static_cast<int64_t>(curve->_count) * 4 * sizeof(uint16_t) > remaining)
+        return nullptr;
+
+    curve->_packedTimes.resize(curve->_count);
+    curve->_packedValues.resize(curve->_count * 3);
+    ibs.read_blob(curve->_packedTimes.data(), sizeof(uint16_t), curve->_count);
+    ibs.read_blob(curve->_packedValues.data(), sizeof(uint16_t), curve->_count * 3);
+
+    curve->autorelease();
+    return curve.release();
+}
+
+template <int componentSize>
+void AnimationCurve<componentSize>::writeCompressed(yasio::fast_obstream& obs) const
+{
+    AXASSERT(_compressed, "AnimationCurve::writeCompressed: curve is not compressed");
+
+    obs.write<int32_t>(_count);
+    obs.write<float>(_startTime);
+    obs.write<float>(_timeStep);
+    if constexpr (componentSize == 3)
+    {
+        obs.write_bytes(_valueMin, static_cast<int>(sizeof(_valueMin)));
+        obs.write_bytes(_valueStep, static_cast<int>(sizeof(_valueStep)));
+    }
+    obs.write_bytes(_packedTimes.data(), static_cast<int>(_packedTimes.size() * sizeof(uint16_t)));
+    obs.write_bytes(_packedValues.data(), static_cast<int>(_packedValues.size() * sizeof(uint16_t)));
+}
+
+template <int componentSize>
+size_t AnimationCurve<componentSize>::getMemorySize() const
+{
+    if (_compressed)
+        return (_packedTimes.capacity() + _packedValues.capacity()) * sizeof(uint16_t);
+    return _count * (sizeof(float) + _componentSizeByte);
+}
+
 template <int componentSize>
 float AnimationCurve<componentSize>::getStartTime() const
 {
-    return _keytime[0];
+    return _compressed ? _startTime : _keytime[0];
 }
 
 template <int componentSize>
 float AnimationCurve<componentSize>::getEndTime() const
 {
-    return _keytime[_count - 1];
+    return _compressed ? decodeTime(_count - 1) : _keytime[_count - 1];
 }
 
 
@@ -111,6 +386,11 @@ AnimationCurve<componentSize>::AnimationCurve()
 , _count(0)
 , _componentSizeByte(0)
 , _evaluateFun(nullptr)
+, _compressed(false)
+, _startTime(0)
+, _timeStep(0)
+, _valueMin{}
+, _valueStep{}
 {
 
 }
@@ -160,6 +160,7 @@ void Bundle3D::clear()
     if (_isBinary)
     {
         _binaryBuffer.clear();
+        _mappedFile.reset();
         AX_SAFE_DELETE_ARRAY(_references);
     }
     else
@@ -200,6 +201,26 @@ bool Bundle3D::load(std::string_view path)
     return ret;
 }
 
+bool Bundle3D::mapBinary(std::string_view path)
+{
+    // only local disk files have a native handle, the mapping stays valid after the stream is closed
+    auto fileStream = FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+    if (!fileStream || fileStream->nativeHandle() == (osfhnd_t)-1 || fileStream->size() <= 0)
+        return false;
+
+    std::error_code error;
+    auto mappedFile = std::make_shared<mio::mmap_source>();
+    mappedFile->map(fileStream->nativeHandle(), 0, mio::map_entire_file, error);
+    if (error || !mappedFile->is_mapped())
+    {
+        AXLOGW("warning: Failed to map file: {}, {}", path, error.message());
+        return false;
+    }
+
+    _mappedFile = std::move(mappedFile);
+    return true;
+}
+
 bool Bundle3D::loadObj(MeshDatas& meshdatas,
                        MaterialDatas& materialdatas,
                        NodeDatas& nodedatas,
@@ -425,25 +446,47 @@ bool Bundle3D::loadMeshDatasBinary(MeshDatas& meshdatas)
                 goto FAILED;
             }
 
-            meshData->vertex.resize(vertexSizeInFloat);
+            // zero-copy when mapped, versions without stored aabbs need the vertices to compute them
+            const bool hasAABB  = _version != "0.3" && _version != "0.4" && _version != "0.5";
+            const bool zeroCopy = _mappedFile && hasAABB;
+            if (zeroCopy)
+            {
+                auto vertexBytes       = _binaryReader.read_bytes(vertexSizeInFloat * sizeof(float));
+                meshData->mappedVertex = {reinterpret_cast<const uint8_t*>(vertexBytes.data()), vertexBytes.size()};
+                meshData->mappedSource = _mappedFile;
+            }
+            else
+            {
+                meshData->vertex.resize(vertexSizeInFloat);
 
-            _binaryReader.read_blob(&meshData->vertex[0], 4, vertexSizeInFloat);
+                _binaryReader.read_blob(&meshData->vertex[0], 4, vertexSizeInFloat);
+            }
 
             // Read index data
             unsigned int meshPartCount = _binaryReader.read<unsigned int>();
             for (unsigned int k = 0; k < meshPartCount; ++k)
             {
-                IndexArray indexArray{};
                 std::string_view meshPartid = _binaryReader.read_v32();
                 meshData->subMeshIds.emplace_back(meshPartid);
                 unsigned int nIndexCount = _binaryReader.read<unsigned int>();
-                indexArray.resize(nIndexCount);
-                _binaryReader.read_blob(indexArray.data(), 2, nIndexCount);
-                auto& storedIndices = meshData->subMeshIndices.emplace_back(std::move(indexArray));
-                meshData->numIndex  = (int)meshData->subMeshIndices.size();
+                if (zeroCopy)
+                {
+                    auto indexBytes = _binaryReader.read_bytes(nIndexCount * sizeof(uint16_t));
+                    meshData->mappedSubMeshIndices.emplace_back(reinterpret_cast<const uint8_t*>(indexBytes.data()),
+                                                                indexBytes.size());
+                    meshData->numIndex = (int)meshData->mappedSubMeshIndices.size();
+                }
+                else
+                {
+                    IndexArray indexArray{};
+                    indexArray.resize(nIndexCount);
+                    _binaryReader.read_blob(indexArray.data(), 2, nIndexCount);
+                    meshData->subMeshIndices.emplace_back(std::move(indexArray));
+                    meshData->numIndex = (int)meshData->subMeshIndices.size();
+                }
                 // meshData->subMeshAABB.emplace_back(calculateAABB(meshData->vertex, meshData->getPerVertexSize(),
                 // indexArray));
-                if (_version != "0.3" && _version != "0.4" && _version != "0.5")
+                if (hasAABB)
                 {
                     // read mesh aabb
                     Vec3 aabb[2];
@@ -452,8 +495,8 @@ bool Bundle3D::loadMeshDatasBinary(MeshDatas& meshdatas)
                 }
                 else
                 {
-                    meshData->subMeshAABB.emplace_back(
-                        calculateAABB(meshData->vertex, meshData->getPerVertexSize(), storedIndices));
+                    meshData->subMeshAABB.emplace_back(calculateAABB(meshData->vertex, meshData->getPerVertexSize(),
+                                                                     meshData->subMeshIndices.back()));
                 }
             }
             meshdatas.meshDatas.emplace_back(meshData);
@@ -1074,18 +1117,25 @@ bool Bundle3D::loadBinary(std::string_view path)
 {
     clear();
 
-    // get file data
+    // get file data, map it when possible
     _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
-    if (_binaryBuffer.isNull())
+    if (s_mappedFileEnabled && mapBinary(path))
     {
-        clear();
-        AXLOGW("warning: Failed to read file: {}", path);
-        return false;
+        _binaryReader.reset(_mappedFile->data(), _mappedFile->size());
     }
+    else
+    {
+        _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
+        if (_binaryBuffer.isNull())
+        {
+            clear();
+            AXLOGW("warning: Failed to read file: {}", path);
+            return false;
+        }
 
-    // Initialise bundle reader
-    _binaryReader.reset((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
+        // Initialise bundle reader
+        _binaryReader.reset((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
+    }
 
     try
     {
@@ -2316,22 +2366,44 @@ std::vector<Vec3> Bundle3D::getTrianglesList(std::string_view path)
     }
 
     Bundle3D::destroyBundle(bundle);
+
+    // mapped meshes keep their blobs in the file mapping, which stays alive as long as the mesh data holds it, and
+    // the views may not be aligned, so go through the byte accessors for both kinds of mesh data
     for (auto&& iter : meshs.meshDatas)
     {
-        int preVertexSize = iter->getPerVertexSize() / sizeof(float);
-        for (const auto& indices : iter->subMeshIndices)
+        const size_t stride = iter->getPerVertexSize();
+        auto vertexBytes    = iter->getVertexBytes();
+        for (size_t subMesh = 0; subMesh < iter->getSubMeshCount(); ++subMesh)
         {
-            indices.for_each([&](unsigned int ind) {
-                trianglesList.emplace_back(Vec3(iter->vertex[ind * preVertexSize],
-                                                iter->vertex[ind * preVertexSize + 1],
-                                                iter->vertex[ind * preVertexSize + 2]));
-            });
+            auto indexBytes        = iter->getIndexBytes(subMesh);
+            const size_t indexSize = iter->getIndexFormat(subMesh) == rhi::IndexFormat::U_INT ? 4 : 2;
+            for (size_t offset = 0; offset + indexSize <= indexBytes.size(); offset += indexSize)
+            {
+                uint32_t ind = 0;
+                if (indexSize == 4)
+                    memcpy(&ind, indexBytes.data() + offset, sizeof(uint32_t));
+                else
+                {
+                    uint16_t ind16;
+                    memcpy(&ind16, indexBytes.data() + offset, sizeof(uint16_t));
+                    ind = ind16;
+                }
+
+                if ((ind + 1) * stride > vertexBytes.size())
+                    continue;
+
+                Vec3 position;
+                memcpy(&position, vertexBytes.data() + ind * stride, sizeof(Vec3));
+                trianglesList.emplace_back(position);
+            }
         }
     }
 
     return trianglesList;
 }
 
+bool Bundle3D::s_mappedFileEnabled = true;
+
 Bundle3D::Bundle3D()
     : _modelPath(""), _path(""), _version(""), _referenceCount(0), _references(nullptr), _isBinary(false)
 {}
@@ -30,6 +30,7 @@
 #include "axmol/3d/Bundle3DData.h"
 #include "axmol/base/json.h"
 #include "yasio/ibstream.hpp"
+#include "mio/mio.hpp"
 
 namespace ax
 {
@@ -72,6 +73,15 @@ public:
      */
     static rhi::SamplerAddressMode parseSamplerAddressMode(std::string_view str);
 
+    /**
+     * Enable or disable memory mapping of .c3b files, enabled by default.
+     * When mapped, mesh vertices and indices are not copied into MeshData but referenced from the mapping
+     * and uploaded straight from it, see MeshData::isMapped. Files which can't be mapped (e.g. inside an apk)
+     * are read into memory as before.
+     */
+    static void setMappedFileEnabled(bool enabled) { s_mappedFileEnabled = enabled; }
+    static bool isMappedFileEnabled() { return s_mappedFileEnabled; }
+
     /**
      * load a file. You must load a file first, then call loadMeshData, loadSkinData, and so on
      * @param path File to be loaded
@@ -120,6 +130,7 @@ public:
 protected:
     bool loadJson(std::string_view path);
     bool loadBinary(std::string_view path);
+    bool mapBinary(std::string_view path);
     bool loadMeshDatasJson(MeshDatas& meshdatas);
     bool loadMeshDataJson_0_1(MeshDatas& meshdatas);
     bool loadMeshDataJson_0_2(MeshDatas& meshdatas);
@@ -192,10 +203,13 @@ protected:
 
     // for binary reading
     Data _binaryBuffer;
+    std::shared_ptr<mio::mmap_source> _mappedFile;  // used instead of _binaryBuffer when mapped
     yasio::fast_ibstream_view _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
     bool _isBinary;
+
+    static bool s_mappedFileEnabled;
 };
 
 // end of 3d group
@@ -17,11 +17,13 @@ int MeshVertexAttrib::getAttribSizeBytes() const
     case rhi::VertexFormat::FLOAT2:
     case rhi::VertexFormat::INT2:
     case rhi::VertexFormat::USHORT4:
+    case rhi::VertexFormat::HALF4:
         return 8;
     case rhi::VertexFormat::FLOAT:
     case rhi::VertexFormat::INT:
     case rhi::VertexFormat::UBYTE4:
     case rhi::VertexFormat::USHORT2:
+    case rhi::VertexFormat::HALF2:
         return 4;
     default:
         AXASSERT(false, "VertexFormat convert to size error");
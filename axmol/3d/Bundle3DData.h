@@ -33,6 +33,8 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 
 #include "axmol/3d/shaderinfos.h"
@@ -52,6 +54,8 @@ struct AX_DLL MeshVertexAttrib
 {
     rhi::VertexFormat type;
     shaderinfos::VertexKey vertexAttrib;
+    /**integer attributes are read as [0,1] floats by shader, e.g. compact vertex*/
+    bool normalized = false;
     int getAttribSizeBytes() const;
 };
 
@@ -143,7 +147,41 @@ struct MeshData
     tlx::pod_vector<MeshVertexAttrib> attribs;
     int attribCount;
 
+    // zero-copy views into a mapped .c3b file, used instead of vertex and subMeshIndices when set,
+    // the bytes may be unaligned and are only valid while mappedSource is alive
+    std::span<const uint8_t> mappedVertex;
+    std::vector<std::span<const uint8_t>> mappedSubMeshIndices;
+    std::shared_ptr<const void> mappedSource;
+
 public:
+    /** is vertex and index data referencing a mapped file */
+    bool isMapped() const { return mappedSource != nullptr; }
+
+    /** get count of sub meshes */
+    size_t getSubMeshCount() const { return isMapped() ? mappedSubMeshIndices.size() : subMeshIndices.size(); }
+
+    /** get vertex bytes for upload */
+    std::span<const uint8_t> getVertexBytes() const
+    {
+        if (isMapped())
+            return mappedVertex;
+        return {reinterpret_cast<const uint8_t*>(vertex.data()), vertex.size() * sizeof(float)};
+    }
+
+    /** get index bytes of the sub mesh for upload */
+    std::span<const uint8_t> getIndexBytes(size_t subMesh) const
+    {
+        if (isMapped())
+            return mappedSubMeshIndices[subMesh];
+        return {subMeshIndices[subMesh].data(), subMeshIndices[subMesh].size_bytes()};
+    }
+
+    /** get index format of the sub mesh, mapped indices are always 16 bits */
+    rhi::IndexFormat getIndexFormat(size_t subMesh) const
+    {
+        return isMapped() ? rhi::IndexFormat::U_SHORT : subMeshIndices[subMesh].format();
+    }
+
     /**
      * Get per vertex size
      * @return return the sum size of all vertex attributes.
@@ -167,6 +205,9 @@ public:
         subMeshIndices.clear();
         subMeshAABB.clear();
         attribs.clear();
+        mappedVertex = {};
+        mappedSubMeshIndices.clear();
+        mappedSource.reset();
         vertexSizeInFloat = 0;
         numIndex          = 0;
         attribCount       = 0;
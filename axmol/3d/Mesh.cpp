@@ -502,11 +502,13 @@ void Mesh::draw(Renderer* renderer,
 
     // set default uniforms for Mesh
     // 'u_color' and others
-    const auto scene = Director::getInstance()->getRunningScene();
-    auto technique   = _material->_currentTechnique;
+    const auto scene          = Director::getInstance()->getRunningScene();
+    auto technique            = _material->_currentTechnique;
+    const float compactVertex = _meshIndexData->getMeshVertexData()->isCompact() ? 1.0f : 0.0f;
     for (const auto pass : technique->_passes)
     {
         pass->setUniformColor(&color, sizeof(color));
+        pass->setUniformCompactVertex(&compactVertex, sizeof(compactVertex));
 
         if (_skin)
             pass->setUniformMatrixPalette(_skin->getMatrixPalette(), _skin->getMatrixPaletteSizeInBytes());
@@ -23,6 +23,8 @@
  THE SOFTWARE.
  ****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <list>
 #include <fstream>
 #include <iostream>
@@ -84,11 +86,18 @@ MeshIndexData::MeshIndexData()
 
 void MeshIndexData::setIndexData(const ax::MeshData::IndexArray& indexdata)
 {
-#if AX_ENABLE_CONTEXT_LOSS_RECOVERY
     if (!_indexData.empty())
         return;
     _indexData = indexdata;
-#endif
+}
+
+void MeshIndexData::setIndexData(std::span<const uint8_t> indexdata, rhi::IndexFormat format)
+{
+    if (!_indexData.empty())
+        return;
+    _indexData = MeshData::IndexArray(format);
+    _indexData.resize(indexdata.size() / MeshData::IndexArray::formatToStride(format));
+    memcpy(_indexData.data(), indexdata.data(), _indexData.size_bytes());
 }
 
 MeshIndexData::~MeshIndexData()
@@ -102,57 +111,253 @@ MeshIndexData::~MeshIndexData()
 
 void MeshVertexData::setVertexData(const std::vector<float>& vertexData)
 {
-#if AX_ENABLE_CONTEXT_LOSS_RECOVERY
     if (!_vertexData.empty())
         return;
     _vertexData = vertexData;
-#endif
 }
 
+void MeshVertexData::setVertexData(std::span<const uint8_t> vertexData)
+{
+    if (!_vertexData.empty())
+        return;
+    // mapped bytes may be unaligned, copy instead of reinterpreting
+    _vertexData.resize(vertexData.size() / sizeof(float));
+    memcpy(_vertexData.data(), vertexData.data(), _vertexData.size() * sizeof(float));
+}
+
+bool MeshVertexData::s_keepCPUData          = false;
+bool MeshVertexData::s_compactVertexEnabled = false;
+
+namespace
+{
+uint16_t toHalfFloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const int exponent  = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+    const uint32_t mantissa = bits & 0x7fffff;
+    if (exponent <= 0)  // flush denormals, texture coordinates never need them
+        return static_cast<uint16_t>(sign);
+    if (exponent >= 31)
+        return static_cast<uint16_t>(sign | 0x7c00);
+    // round to nearest, a mantissa carry correctly bumps the exponent
+    return static_cast<uint16_t>((sign | (exponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1));
+}
+
+uint8_t toUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+uint16_t toUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+// octahedral encoding, decoded by decodeOctahedral in compactVertex.glsl
+void toOctahedral(const float* v, uint16_t* out)
+{
+    float l1 = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+    float x = 0, y = 0;
+    if (l1 > 0)
+    {
+        x = v[0] / l1;
+        y = v[1] / l1;
+        if (v[2] < 0)
+        {
+            float ox = x;
+            x        = (1.0f - std::abs(y)) * (ox >= 0 ? 1.0f : -1.0f);
+            y        = (1.0f - std::abs(ox)) * (y >= 0 ? 1.0f : -1.0f);
+        }
+    }
+    out[0] = toUnorm16(x * 0.5f + 0.5f);
+    out[1] = toUnorm16(y * 0.5f + 0.5f);
+}
+
+/**
+ * Repack interleaved float vertices into the compact layout.
+ * Returns false if nothing can be packed, e.g. bone indices out of the unorm8 range.
+ */
+bool packCompactVertices(std::span<const uint8_t> vertices,
+                         const tlx::pod_vector<MeshVertexAttrib>& attribs,
+                         int sizePerVertex,
+                         tlx::pod_vector<MeshVertexAttrib>& packedAttribs,
+                         std::vector<uint8_t>& packed,
+                         int& packedSizePerVertex)
+{
+    using VertexKey = shaderinfos::VertexKey;
+
+    packedAttribs       = attribs;
+    packedSizePerVertex = 0;
+    for (auto& attrib : packedAttribs)
+    {
+        switch (attrib.vertexAttrib)
+        {
+        case VertexKey::VERTEX_ATTRIB_NORMAL:
+        case VertexKey::VERTEX_ATTRIB_TANGENT:
+        case VertexKey::VERTEX_ATTRIB_BINORMAL:
+            if (attrib.type == rhi::VertexFormat::FLOAT3)
+                attrib = MeshVertexAttrib{rhi::VertexFormat::USHORT2, attrib.vertexAttrib, true};
+            break;
+        case VertexKey::VERTEX_ATTRIB_TEX_COORD:
+        case VertexKey::VERTEX_ATTRIB_TEX_COORD1:
+        case VertexKey::VERTEX_ATTRIB_TEX_COORD2:
+        case VertexKey::VERTEX_ATTRIB_TEX_COORD3:
+            if (attrib.type == rhi::VertexFormat::FLOAT2)
+                attrib.type = rhi::VertexFormat::HALF2;
+            break;
+        case VertexKey::VERTEX_ATTRIB_BLEND_WEIGHT:
+        case VertexKey::VERTEX_ATTRIB_BLEND_INDEX:
+        case VertexKey::VERTEX_ATTRIB_COLOR:
+            if (attrib.type == rhi::VertexFormat::FLOAT4)
+                attrib = MeshVertexAttrib{rhi::VertexFormat::UBYTE4, attrib.vertexAttrib, true};
+            break;
+        default:
+            break;
+        }
+        packedSizePerVertex += attrib.getAttribSizeBytes();
+    }
+    if (packedSizePerVertex == sizePerVertex || sizePerVertex <= 0)
+        return false;
+
+    const size_t vertexCount = vertices.size() / sizePerVertex;
+    packed.resize(vertexCount * packedSizePerVertex);
+    auto dst = packed.data();
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        auto src = vertices.data() + i * sizePerVertex;
+        for (size_t k = 0; k < attribs.size(); ++k)
+        {
+            const auto& from = attribs[k];
+            const auto& to   = packedAttribs[k];
+            const int size   = from.getAttribSizeBytes();
+            if (from.type == to.type)
+            {
+                memcpy(dst, src, size);
+            }
+            else
+            {
+                // the source may be a mapped file, never read floats in place
+                float v[4];
+                memcpy(v, src, size);
+                switch (to.type)
+                {
+                case rhi::VertexFormat::USHORT2:
+                    toOctahedral(v, reinterpret_cast<uint16_t*>(dst));
+                    break;
+                case rhi::VertexFormat::HALF2:
+                    reinterpret_cast<uint16_t*>(dst)[0] = toHalfFloat(v[0]);
+                    reinterpret_cast<uint16_t*>(dst)[1] = toHalfFloat(v[1]);
+                    break;
+                case rhi::VertexFormat::UBYTE4:
+                    if (from.vertexAttrib == shaderinfos::VertexKey::VERTEX_ATTRIB_BLEND_INDEX)
+                    {
+                        for (int c = 0; c < 4; ++c)
+                        {
+                            if (v[c] < 0 || v[c] > 255)
+                                return false;
+                            dst[c] = static_cast<uint8_t>(v[c] + 0.5f);
+                        }
+                    }
+                    else
+                    {
+                        int sum = 0, largest = 0;
+                        for (int c = 0; c < 4; ++c)
+                        {
+                            dst[c] = toUnorm8(v[c]);
+                            sum += dst[c];
+                            if (dst[c] > dst[largest])
+                                largest = c;
+                        }
+                        // keep the skinning weights summing to exactly one
+                        if (from.vertexAttrib == shaderinfos::VertexKey::VERTEX_ATTRIB_BLEND_WEIGHT && sum > 0)
+                            dst[largest] = static_cast<uint8_t>(std::clamp(dst[largest] + 255 - sum, 0, 255));
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+            src += size;
+            dst += to.getAttribSizeBytes();
+        }
+    }
+    return true;
+}
+}  // namespace
+
 MeshVertexData* MeshVertexData::create(const MeshData& meshdata, CustomCommand::IndexFormat format)
 {
-    auto vertexdata           = new MeshVertexData();
-    vertexdata->_vertexBuffer = axdrv->createBuffer(meshdata.vertex.size() * sizeof(meshdata.vertex[0]),
-                                                    rhi::BufferType::VERTEX, rhi::BufferUsage::STATIC);
-    // AX_SAFE_RETAIN(vertexdata->_vertexBuffer);
+#if AX_ENABLE_CONTEXT_LOSS_RECOVERY
+    const bool keepCPUData = true;
+#else
+    const bool keepCPUData = s_keepCPUData;
+#endif
+
+    // vertices and indices are uploaded straight from the mapped file when the mesh data is mapped
+    auto vertexBytes = meshdata.getVertexBytes();
+    auto vertexdata  = new MeshVertexData();
 
     vertexdata->_sizePerVertex = meshdata.getPerVertexSize();
+    vertexdata->_attribs       = meshdata.attribs;
 
-    vertexdata->_attribs = meshdata.attribs;
+    std::vector<uint8_t> packedBytes;
+    if (s_compactVertexEnabled)
+    {
+        tlx::pod_vector<MeshVertexAttrib> packedAttribs;
+        int packedSizePerVertex = 0;
+        if (packCompactVertices(vertexBytes, meshdata.attribs, meshdata.getPerVertexSize(), packedAttribs, packedBytes,
+                                packedSizePerVertex))
+        {
+            vertexBytes                      = packedBytes;
+            vertexdata->_sourceAttribs       = meshdata.attribs;
+            vertexdata->_sourceSizePerVertex = meshdata.getPerVertexSize();
+            vertexdata->_sizePerVertex       = packedSizePerVertex;
+            vertexdata->_attribs             = std::move(packedAttribs);
+            vertexdata->_compact             = true;
+        }
+    }
+
+    vertexdata->_vertexBuffer = axdrv->createBuffer(vertexBytes.size(), rhi::BufferType::VERTEX, rhi::BufferUsage::STATIC);
+    // AX_SAFE_RETAIN(vertexdata->_vertexBuffer);
 
     if (vertexdata->_vertexBuffer)
     {
+        // keep the float layout for cpu side users, compact vertices are packed again on context loss
+        if (keepCPUData)
+            vertexdata->setVertexData(meshdata.getVertexBytes());
 #if AX_ENABLE_CONTEXT_LOSS_RECOVERY
-        vertexdata->setVertexData(meshdata.vertex);
         vertexdata->_vertexBuffer->usingDefaultStoredData(false);
 #endif
-        vertexdata->_vertexBuffer->updateData((void*)&meshdata.vertex[0],
-                                              meshdata.vertex.size() * sizeof(meshdata.vertex[0]));
+        vertexdata->_vertexBuffer->updateData((void*)vertexBytes.data(), vertexBytes.size());
     }
 
-    bool needCalcAABB = (meshdata.subMeshAABB.size() != meshdata.subMeshIndices.size());
-    for (size_t i = 0, size = meshdata.subMeshIndices.size(); i < size; ++i)
+    const size_t subMeshCount = meshdata.getSubMeshCount();
+    bool needCalcAABB         = (meshdata.subMeshAABB.size() != subMeshCount);
+    for (size_t i = 0; i < subMeshCount; ++i)
     {
-        auto& indices    = meshdata.subMeshIndices[i];
-        auto indexBuffer = axdrv->createBuffer(indices.size_bytes(), rhi::BufferType::INDEX, rhi::BufferUsage::STATIC);
+        auto indexBytes  = meshdata.getIndexBytes(i);
+        auto indexBuffer = axdrv->createBuffer(indexBytes.size(), rhi::BufferType::INDEX, rhi::BufferUsage::STATIC);
         indexBuffer->autorelease();
 #if AX_ENABLE_CONTEXT_LOSS_RECOVERY
         indexBuffer->usingDefaultStoredData(false);
 #endif
-        indexBuffer->updateData((void*)indices.data(), indices.size_bytes());
+        indexBuffer->updateData((void*)indexBytes.data(), indexBytes.size());
 
         std::string id           = (i < meshdata.subMeshIds.size() ? meshdata.subMeshIds[i] : "");
         MeshIndexData* indexdata = nullptr;
         if (needCalcAABB)
         {
-            auto aabb = Bundle3D::calculateAABB(meshdata.vertex, meshdata.getPerVertexSize(), indices);
+            // mapped mesh data always carries aabbs, see Bundle3D::loadMeshDatasBinary
+            auto aabb =
+                Bundle3D::calculateAABB(meshdata.vertex, meshdata.getPerVertexSize(), meshdata.subMeshIndices[i]);
             indexdata = MeshIndexData::create(id, vertexdata, indexBuffer, aabb);
         }
         else
             indexdata = MeshIndexData::create(id, vertexdata, indexBuffer, meshdata.subMeshAABB[i]);
-#if AX_ENABLE_CONTEXT_LOSS_RECOVERY
-        indexdata->setIndexData(indices);
-#endif
+        if (keepCPUData)
+            indexdata->setIndexData(indexBytes, meshdata.getIndexFormat(i));
         vertexdata->_indices.pushBack(indexdata);
     }
 
@@ -184,7 +389,19 @@ MeshVertexData::MeshVertexData()
 {
 #if AX_ENABLE_CONTEXT_LOSS_RECOVERY
     _backToForegroundListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
-        _vertexBuffer->updateData((void*)_vertexData.data(), _vertexData.size() * sizeof(_vertexData[0]));
+        if (_compact)
+        {
+            std::span<const uint8_t> vertexBytes{reinterpret_cast<const uint8_t*>(_vertexData.data()),
+                                                 _vertexData.size() * sizeof(_vertexData[0])};
+            tlx::pod_vector<MeshVertexAttrib> packedAttribs;
+            std::vector<uint8_t> packedBytes;
+            int packedSizePerVertex = 0;
+            packCompactVertices(vertexBytes, _sourceAttribs, static_cast<int>(_sourceSizePerVertex), packedAttribs,
+                                packedBytes, packedSizePerVertex);
+            _vertexBuffer->updateData(packedBytes.data(), packedBytes.size());
+        }
+        else
+            _vertexBuffer->updateData((void*)_vertexData.data(), _vertexData.size() * sizeof(_vertexData[0]));
     });
     Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, 1);
 #endif
@@ -82,6 +82,10 @@ public:
     void setPrimitiveType(MeshCommand::PrimitiveType primitive) { _primitiveType = primitive; }
 
     void setIndexData(const MeshData::IndexArray& indexdata);
+    void setIndexData(std::span<const uint8_t> indexdata, rhi::IndexFormat format);
+
+    /**get cpu copy of indices, empty unless MeshVertexData::setKeepCPUData is enabled*/
+    const MeshData::IndexArray& getIndexData() const { return _indexData; }
 
     MeshIndexData();
     virtual ~MeshIndexData();
@@ -138,6 +142,42 @@ public:
     bool hasVertexAttrib(shaderinfos::VertexKey attrib) const;
 
     void setVertexData(const std::vector<float>& vertexData);
+    void setVertexData(std::span<const uint8_t> vertexData);
+
+    /**
+     * get cpu copy of vertices, empty unless setKeepCPUData is enabled.
+     * The copy keeps the float layout of the mesh data even if the uploaded vertices are compact,
+     * see getVertexDataAttribs and getVertexDataSizePerVertex.
+     */
+    const std::vector<float>& getVertexData() const { return _vertexData; }
+
+    /**get attributes of the cpu copy of vertices*/
+    const tlx::pod_vector<MeshVertexAttrib>& getVertexDataAttribs() const
+    {
+        return _compact ? _sourceAttribs : _attribs;
+    }
+
+    /**get size per vertex of the cpu copy of vertices*/
+    ssize_t getVertexDataSizePerVertex() const { return _compact ? _sourceSizePerVertex : _sizePerVertex; }
+
+    /**whether the vertices were packed into the compact layout, see setCompactVertexEnabled*/
+    bool isCompact() const { return _compact; }
+
+    /**
+     * Keep cpu copies of vertex and index data after upload, e.g. for collision or picking.
+     * Disabled by default, the copies are always kept when context loss recovery is enabled.
+     */
+    static void setKeepCPUData(bool keep) { s_keepCPUData = keep; }
+    static bool isKeepCPUData() { return s_keepCPUData; }
+
+    /**
+     * Pack float vertex attributes before upload: octahedral unorm16x2 normals, tangents and binormals,
+     * half-float texture coordinates, unorm8 blend weights, colors and bone indices.
+     * The built-in 3D shaders decode them when u_compactVertex is set, positions are kept as is.
+     * Disabled by default, only affects vertex data created afterwards.
+     */
+    static void setCompactVertexEnabled(bool enabled) { s_compactVertexEnabled = enabled; }
+    static bool isCompactVertexEnabled() { return s_compactVertexEnabled; }
 
     MeshVertexData();
     virtual ~MeshVertexData();
@@ -150,6 +190,13 @@ protected:
 
     int _vertexCount = 0;  // vertex count
     std::vector<float> _vertexData;
+    bool _compact = false;
+    // layout of the mesh data before packing, only set when compact
+    tlx::pod_vector<MeshVertexAttrib> _sourceAttribs;
+    ssize_t _sourceSizePerVertex = -1;
+
+    static bool s_keepCPUData;
+    static bool s_compactVertexEnabled;
 #if AX_ENABLE_CONTEXT_LOSS_RECOVERY
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
@@ -30,6 +30,8 @@ using namespace ax;
 #include <stdlib.h>
 #include <float.h>
 #include <set>
+#include <atomic>
+#include <algorithm>
 #include <stddef.h>  // offsetof
 #include "axmol/renderer/Renderer.h"
 #include "axmol/renderer/Shaders.h"
@@ -160,6 +162,14 @@ void Terrain::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t f
     }
     auto camera = Camera::getVisitingCamera();
 
+    // the budgets are shared by all cameras drawing the terrain in a frame
+    if (_budgetFrame != _director->getTotalFrames())
+    {
+        _budgetFrame           = _director->getTotalFrames();
+        _chunkUploadsThisFrame = 0;
+        _lodUpdatesThisFrame   = 0;
+    }
+
     if (memcmp(&_CameraMatrix, &camera->getViewMatrix(), sizeof(Mat4)) != 0)
     {
         _isCameraViewChanged = true;
@@ -207,15 +217,25 @@ bool Terrain::initHeightMap(std::string_view heightMap)
         calculateNormal();
         memset(_chunkesArray, 0, sizeof(_chunkesArray));
 
+        std::vector<Chunk*> chunks;
+        chunks.reserve(chunk_amount_y * chunk_amount_x);
         for (int m = 0; m < chunk_amount_y; m++)
         {
             for (int n = 0; n < chunk_amount_x; n++)
             {
-                _chunkesArray[m][n]        = new Chunk(this);
-                _chunkesArray[m][n]->_size = _chunkSize;
-                _chunkesArray[m][n]->generate(_imageWidth, _imageHeight, m, n, _data);
+                auto chunk          = new Chunk(this);
+                chunk->_size        = _chunkSize;
+                chunk->_posY        = m;
+                chunk->_posX        = n;
+                _chunkesArray[m][n] = chunk;
+                chunk->calculateAABB();
+                chunks.emplace_back(chunk);
             }
         }
+        // the geometry is generated on the job system and the GPU buffers are created lazily in
+        // Chunk::bindAndDraw, see setChunkUploadBudget
+        generateChunks(chunks);
+        _pendingChunkCount = static_cast<int>(chunks.size());
 
         // calculate the neighbor
         for (int m = 0; m < chunk_amount_y; m++)
@@ -267,19 +287,472 @@ void Terrain::setChunksLOD(const Vec3& cameraPos)
     for (int m = 0; m < chunk_amount_y; m++)
         for (int n = 0; n < chunk_amount_x; n++)
         {
-            AABB aabb                        = _chunkesArray[m][n]->_parent->_worldSpaceAABB;
-            auto center                      = aabb.getCenter();
-            float dist                       = Vec2(center.x, center.z).distance(Vec2(cameraPos.x, cameraPos.z));
-            _chunkesArray[m][n]->_currentLod = 3;
+            auto chunk  = _chunkesArray[m][n];
+            AABB aabb   = chunk->_parent->_worldSpaceAABB;
+            auto center = aabb.getCenter();
+            float dist  = Vec2(center.x, center.z).distance(Vec2(cameraPos.x, cameraPos.z));
+            int lod     = 3;
             for (int i = 0; i < 3; ++i)
             {
                 if (dist <= _lodDistance[i])
                 {
-                    _chunkesArray[m][n]->_currentLod = i;
+                    lod = i;
                     break;
                 }
             }
+            if (chunk->_currentLod == lod)
+                continue;
+
+            // only the chunks whose LOD changed need new indices, the neighbors too when fixing cracks by
+            // increasing lower LOD
+            chunk->_currentLod = lod;
+            chunk->_lodDirty   = true;
+            if (_crackFixedType == CrackFixedType::INCREASE_LOWER)
+            {
+                for (auto neighbor : {chunk->_left, chunk->_right, chunk->_front, chunk->_back})
+                {
+                    if (neighbor)
+                        neighbor->_lodDirty = true;
+                }
+            }
+        }
+}
+
+namespace
+{
+// the indices only depend on the LOD and the neighbors' LOD, never on the chunk, so they can be built on any thread
+void buildIndicesLOD(int lod,
+                     bool left,
+                     bool right,
+                     bool back,
+                     bool front,
+                     int gridX,
+                     int gridY,
+                     std::vector<uint16_t>& indices)
+{
+    int step = 1 << lod;
+    if (left || right || back || front)
+    // need update indices.
+    {
+        // t-junction inner
+        indices.clear();
+        for (int i = step; i < gridY - step; i += step)
+        {
+            for (int j = step; j < gridX - step; j += step)
+            {
+                int nLocIndex = i * (gridX + 1) + j;
+                indices.emplace_back(nLocIndex);
+                indices.emplace_back(nLocIndex + step * (gridX + 1));
+                indices.emplace_back(nLocIndex + step);
+
+                indices.emplace_back(nLocIndex + step);
+                indices.emplace_back(nLocIndex + step * (gridX + 1));
+                indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
+            }
+        }
+        // fix T-crack
+        int next_step = 1 << (lod + 1);
+        if (left)  // left
+        {
+            for (int i = 0; i < gridY; i += next_step)
+            {
+                indices.emplace_back(i * (gridX + 1) + step);
+                indices.emplace_back(i * (gridX + 1));
+                indices.emplace_back((i + next_step) * (gridX + 1));
+
+                indices.emplace_back(i * (gridX + 1) + step);
+                indices.emplace_back((i + next_step) * (gridX + 1));
+                indices.emplace_back((i + step) * (gridX + 1) + step);
+
+                indices.emplace_back((i + step) * (gridX + 1) + step);
+                indices.emplace_back((i + next_step) * (gridX + 1));
+                indices.emplace_back((i + next_step) * (gridX + 1) + step);
+            }
+        }
+        else
+        {
+            int start = 0;
+            int end   = gridY;
+            if (front)
+                end -= step;
+            if (back)
+                start += step;
+            for (int i = start; i < end; i += step)
+            {
+                indices.emplace_back(i * (gridX + 1) + step);
+                indices.emplace_back(i * (gridX + 1));
+                indices.emplace_back((i + step) * (gridX + 1));
+
+                indices.emplace_back(i * (gridX + 1) + step);
+                indices.emplace_back((i + step) * (gridX + 1));
+                indices.emplace_back((i + step) * (gridX + 1) + step);
+            }
+        }
+
+        if (right)  // LEFT
+        {
+            for (int i = 0; i < gridY; i += next_step)
+            {
+                indices.emplace_back(i * (gridX + 1) + gridX);
+                indices.emplace_back(i * (gridX + 1) + gridX - step);
+                indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
+
+                indices.emplace_back(i * (gridX + 1) + gridX);
+                indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
+                indices.emplace_back((i + next_step) * (gridX + 1) + gridX - step);
+
+                indices.emplace_back(i * (gridX + 1) + gridX);
+                indices.emplace_back((i + next_step) * (gridX + 1) + gridX - step);
+                indices.emplace_back((i + next_step) * (gridX + 1) + gridX);
+            }
+        }
+        else
+        {
+            int start = 0;
+            int end   = gridY;
+            if (front)
+                end -= step;
+            if (back)
+                start += step;
+            for (int i = start; i < end; i += step)
+            {
+                indices.emplace_back(i * (gridX + 1) + gridX);
+                indices.emplace_back(i * (gridX + 1) + gridX - step);
+                indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
+
+                indices.emplace_back(i * (gridX + 1) + gridX);
+                indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
+                indices.emplace_back((i + step) * (gridX + 1) + gridX);
+            }
+        }
+        if (front)  // front
+        {
+            for (int i = 0; i < gridX; i += next_step)
+            {
+                indices.emplace_back((gridY - step) * (gridX + 1) + i);
+                indices.emplace_back(gridY * (gridX + 1) + i);
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
+
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
+                indices.emplace_back(gridY * (gridX + 1) + i);
+                indices.emplace_back(gridY * (gridX + 1) + i + next_step);
+
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
+                indices.emplace_back(gridY * (gridX + 1) + i + next_step);
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + next_step);
+            }
+        }
+        else
+        {
+            for (int i = step; i < gridX - step; i += step)
+            {
+                indices.emplace_back((gridY - step) * (gridX + 1) + i);
+                indices.emplace_back(gridY * (gridX + 1) + i);
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
+
+                indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
+                indices.emplace_back(gridY * (gridX + 1) + i);
+                indices.emplace_back(gridY * (gridX + 1) + i + step);
+            }
+        }
+        if (back)  // back
+        {
+            for (int i = 0; i < gridX; i += next_step)
+            {
+                indices.emplace_back(i);
+                indices.emplace_back(step * (gridX + 1) + i);
+                indices.emplace_back(step * (gridX + 1) + i + step);
+
+                indices.emplace_back(i);
+                indices.emplace_back(step * (gridX + 1) + i + step);
+                indices.emplace_back(i + next_step);
+
+                indices.emplace_back(i + next_step);
+                indices.emplace_back(step * (gridX + 1) + i + step);
+                indices.emplace_back(step * (gridX + 1) + i + next_step);
+            }
+        }
+        else
+        {
+            for (int i = step; i < gridX - step; i += step)
+            {
+                indices.emplace_back(i);
+                indices.emplace_back(step * (gridX + 1) + i);
+                indices.emplace_back(step * (gridX + 1) + i + step);
+
+                indices.emplace_back(i);
+                indices.emplace_back(step * (gridX + 1) + i + step);
+                indices.emplace_back(i + step);
+            }
+        }
+    }
+    else
+    {
+        // No lod difference, use simple method
+        indices.clear();
+        for (int i = 0; i < gridY; i += step)
+        {
+            for (int j = 0; j < gridX; j += step)
+            {
+
+                int nLocIndex = i * (gridX + 1) + j;
+                indices.emplace_back(nLocIndex);
+                indices.emplace_back(nLocIndex + step * (gridX + 1));
+                indices.emplace_back(nLocIndex + step);
+
+                indices.emplace_back(nLocIndex + step);
+                indices.emplace_back(nLocIndex + step * (gridX + 1));
+                indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
+            }
+        }
+    }
+}
+
+void buildIndicesLODSkirt(int lod,
+                          const int skirtVerticesOffset[4],
+                          int gridX,
+                          int gridY,
+                          std::vector<uint16_t>& indices)
+{
+    indices.clear();
+    int step  = 1 << lod;
+    int k     = 0;
+    for (int i = 0; i < gridY; i += step, k += step)
+    {
+        for (int j = 0; j < gridX; j += step)
+        {
+            int nLocIndex = i * (gridX + 1) + j;
+            indices.emplace_back(nLocIndex);
+            indices.emplace_back(nLocIndex + step * (gridX + 1));
+            indices.emplace_back(nLocIndex + step);
+
+            indices.emplace_back(nLocIndex + step);
+            indices.emplace_back(nLocIndex + step * (gridX + 1));
+            indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
+        }
+    }
+    // add skirt
+    // #1
+    for (int i = 0; i < gridY; i += step)
+    {
+        int nLocIndex = i * (gridX + 1) + gridX;
+        indices.emplace_back(nLocIndex);
+        indices.emplace_back(nLocIndex + step * (gridX + 1));
+        indices.emplace_back((gridY + 1) * (gridX + 1) + i);
+
+        indices.emplace_back((gridY + 1) * (gridX + 1) + i);
+        indices.emplace_back(nLocIndex + step * (gridX + 1));
+        indices.emplace_back((gridY + 1) * (gridX + 1) + i + step);
+    }
+
+    // #2
+    for (int j = 0; j < gridX; j += step)
+    {
+        int nLocIndex = (gridY) * (gridX + 1) + j;
+        indices.emplace_back(nLocIndex);
+        indices.emplace_back(skirtVerticesOffset[1] + j);
+        indices.emplace_back(nLocIndex + step);
+
+        indices.emplace_back(nLocIndex + step);
+        indices.emplace_back(skirtVerticesOffset[1] + j);
+        indices.emplace_back(skirtVerticesOffset[1] + j + step);
+    }
+
+    // #3
+    for (int i = 0; i < gridY; i += step)
+    {
+        int nLocIndex = i * (gridX + 1);
+        indices.emplace_back(nLocIndex);
+        indices.emplace_back(skirtVerticesOffset[2] + i);
+        indices.emplace_back((i + step) * (gridX + 1));
+
+        indices.emplace_back((i + step) * (gridX + 1));
+        indices.emplace_back(skirtVerticesOffset[2] + i);
+        indices.emplace_back(skirtVerticesOffset[2] + i + step);
+    }
+
+    // #4
+    for (int j = 0; j < gridX; j += step)
+    {
+        int nLocIndex = j;
+        indices.emplace_back(nLocIndex + step);
+        indices.emplace_back(skirtVerticesOffset[3] + j);
+        indices.emplace_back(nLocIndex);
+
+        indices.emplace_back(skirtVerticesOffset[3] + j + step);
+        indices.emplace_back(skirtVerticesOffset[3] + j);
+        indices.emplace_back(nLocIndex + step);
+    }
+}
+}  // namespace
+
+struct Terrain::ChunkGenerateTask
+{
+    enum State
+    {
+        PENDING,
+        GENERATING,
+        READY,
+        CANCELLED
+    };
+
+    std::vector<Chunk*> chunks;
+    std::unique_ptr<std::atomic<int>[]> states;
+    std::atomic<size_t> next{0};
+    int imageWidth;
+    int imageHeight;
+    const unsigned char* data;
+    Mat4 transform;
+
+    // whoever moves the chunk out of PENDING generates it, the workers never touch a cancelled chunk
+    bool tryGenerate(size_t i)
+    {
+        int expected = PENDING;
+        if (!states[i].compare_exchange_strong(expected, GENERATING, std::memory_order_acquire))
+            return false;
+
+        auto chunk = chunks[i];
+        chunk->generate(imageWidth, imageHeight, chunk->_posY, chunk->_posX, data);
+        for (auto&& triangle : chunk->_trianglesList)
+            triangle.transform(transform);
+
+        states[i].store(READY, std::memory_order_release);
+        states[i].notify_all();
+        return true;
+    }
+
+    void execute()
+    {
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < chunks.size();)
+            tryGenerate(i);
+    }
+
+    void wait(size_t i)
+    {
+        if (tryGenerate(i))
+            return;
+        for (int state; (state = states[i].load(std::memory_order_acquire)) == GENERATING;)
+            states[i].wait(state, std::memory_order_acquire);
+    }
+
+    void cancel()
+    {
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            int expected = PENDING;
+            if (!states[i].compare_exchange_strong(expected, CANCELLED, std::memory_order_acquire))
+                wait(i);
+        }
+    }
+};
+
+struct Terrain::LODIndexPatterns
+{
+    // by LOD and the mask of neighbors with a higher LOD, the skirt patterns only use mask 0
+    std::vector<uint16_t> indices[4][16];
+    int skirtVerticesOffset[4];
+    std::atomic<bool> ready{false};
+};
+
+void Terrain::generateChunks(std::span<Chunk*> chunks)
+{
+    if (chunks.empty())
+        return;
+
+    auto task         = std::make_shared<ChunkGenerateTask>();
+    task->chunks      = {chunks.begin(), chunks.end()};
+    task->states      = std::make_unique<std::atomic<int>[]>(chunks.size());
+    task->imageWidth  = _imageWidth;
+    task->imageHeight = _imageHeight;
+    task->data        = _data;
+    task->transform   = getNodeToWorldTransform();
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        task->states[i].store(ChunkGenerateTask::PENDING, std::memory_order_relaxed);
+        chunks[i]->_generateIndex = i;
+    }
+    _generateTask = task;
+
+    auto jobSystem         = _director->getJobSystem();
+    const size_t parallels = std::clamp<size_t>(jobSystem->getThreadCount(), 1, chunks.size());
+    for (size_t i = 0; i < parallels; ++i)
+        jobSystem->enqueue([task] { task->execute(); });
+
+    // the index patterns only depend on the chunk size, so they don't need the chunks
+    auto patterns = std::make_shared<LODIndexPatterns>();
+    int gridX     = static_cast<int>(_chunkSize.width);
+    int gridY     = static_cast<int>(_chunkSize.height);
+    patterns->skirtVerticesOffset[0] = (gridY + 1) * (gridX + 1);
+    patterns->skirtVerticesOffset[1] = patterns->skirtVerticesOffset[0] + gridY + 1;
+    patterns->skirtVerticesOffset[2] = patterns->skirtVerticesOffset[1] + gridX + 1;
+    patterns->skirtVerticesOffset[3] = patterns->skirtVerticesOffset[2] + gridY + 1;
+    _lodIndexPatterns = patterns;
+
+    jobSystem->enqueue([patterns, gridX, gridY, skirt = _crackFixedType == CrackFixedType::SKIRT] {
+        for (int lod = 0; lod < 4; ++lod)
+        {
+            if (skirt)
+            {
+                buildIndicesLODSkirt(lod, patterns->skirtVerticesOffset, gridX, gridY, patterns->indices[lod][0]);
+                continue;
+            }
+            for (int mask = 0; mask < 16; ++mask)
+                buildIndicesLOD(lod, mask & 1, mask & 2, mask & 4, mask & 8, gridX, gridY,
+                                patterns->indices[lod][mask]);
         }
+        patterns->ready.store(true, std::memory_order_release);
+    });
+}
+
+void Terrain::waitChunkGenerated(Chunk* chunk) const
+{
+    if (_generateTask)
+        _generateTask->wait(chunk->_generateIndex);
+}
+
+bool Terrain::isChunkGenerated(const Chunk* chunk) const
+{
+    return !_generateTask || _generateTask->states[chunk->_generateIndex].load(std::memory_order_acquire) ==
+                                 ChunkGenerateTask::READY;
+}
+
+void Terrain::cancelChunkGeneration()
+{
+    if (_generateTask)
+    {
+        _generateTask->cancel();
+        _generateTask.reset();
+    }
+}
+
+const std::vector<uint16_t>* Terrain::findLODIndexPattern(int selfLod, int higherNeighborMask) const
+{
+    if (!_lodIndexPatterns || !_lodIndexPatterns->ready.load(std::memory_order_acquire))
+        return nullptr;
+    return &_lodIndexPatterns->indices[selfLod][higherNeighborMask];
+}
+
+const std::vector<uint16_t>* Terrain::findLODIndexPatternSkirt(int selfLod, const int skirtVerticesOffset[4]) const
+{
+    // the patterns are built for chunks of the full size
+    if (!_lodIndexPatterns || !_lodIndexPatterns->ready.load(std::memory_order_acquire) ||
+        !std::equal(skirtVerticesOffset, skirtVerticesOffset + 4, _lodIndexPatterns->skirtVerticesOffset))
+        return nullptr;
+    return &_lodIndexPatterns->indices[selfLod][0];
+}
+
+const Terrain::ChunkIndices& Terrain::getPlaceholderIndices()
+{
+    if (!_placeholderIndices._indexBuffer)
+    {
+        // two triangles through the corners, wound like the chunk grid
+        const uint16_t indices[] = {0, 2, 1, 1, 2, 3};
+        auto buffer = axdrv->createBuffer(sizeof(indices), rhi::BufferType::INDEX, rhi::BufferUsage::STATIC);
+        buffer->updateData(indices, sizeof(indices));
+        _placeholderIndices._indexBuffer = buffer;
+        _placeholderIndices._size        = static_cast<unsigned short>(std::size(indices));
+    }
+    return _placeholderIndices;
 }
 
 float Terrain::getHeight(float x, float z, Vec3* normal) const
@@ -456,6 +929,7 @@ Terrain::~Terrain()
     AX_SAFE_RELEASE(_heightMapImage);
     AX_SAFE_RELEASE(_dummyTexture);
     delete _quadRoot;
+    cancelChunkGeneration();
     for (int i = 0; i < 4; ++i)
     {
         if (_detailMapTextures[i])
@@ -540,6 +1014,7 @@ bool Terrain::getIntersectionPoint(const Ray& ray_, Vec3& intersectionPoint) con
                 {
                     if (closeList.find(chunk) == closeList.end())
                     {
+                        waitChunkGenerated(chunk);
                         if (chunk->getIntersectPointWithRay(ray, tmpIntersectionPoint))
                         {
                             float dist = (ray._origin - tmpIntersectionPoint).length();
@@ -600,6 +1075,7 @@ ax::Vec2 Terrain::convertToTerrainSpace(const Vec2& worldSpaceXZ) const
 
 void Terrain::resetHeightMap(std::string_view heightMap)
 {
+    cancelChunkGeneration();
     _heightMapImage->release();
     _vertices.clear();
     free(_data);
@@ -716,7 +1192,7 @@ Terrain::ChunkIndices Terrain::lookForIndicesLOD(int neighborLod[4], int selfLod
     return tmp;
 }
 
-Terrain::ChunkIndices Terrain::insertIndicesLOD(int neighborLod[4], int selfLod, uint16_t* indices, int size)
+Terrain::ChunkIndices Terrain::insertIndicesLOD(int neighborLod[4], int selfLod, const uint16_t* indices, int size)
 {
     ChunkLODIndices lodIndices;
     memcpy(lodIndices._relativeLod, neighborLod, sizeof(int[4]));
@@ -754,7 +1230,7 @@ Terrain::ChunkIndices Terrain::lookForIndicesLODSkrit(int selfLod, bool* result)
     return badResult;
 }
 
-Terrain::ChunkIndices Terrain::insertIndicesLODSkirt(int selfLod, uint16_t* indices, int size)
+Terrain::ChunkIndices Terrain::insertIndicesLODSkirt(int selfLod, const uint16_t* indices, int size)
 {
     ChunkLODIndicesSkirt skirtIndices;
     skirtIndices._selfLod            = selfLod;
@@ -888,13 +1364,20 @@ void Terrain::reload()
     {
         for (int n = 0; n < chunk_amount_x; n++)
         {
-            _chunkesArray[m][n]->finish();
+            auto chunk = _chunkesArray[m][n];
+            if (chunk->_buffer)
+            {
+                chunk->finish();
+                chunk->_lodDirty = true;
+            }
+            AX_SAFE_RELEASE_NULL(chunk->_placeholderBuffer);
         }
     }
 
     initTextures();
     _chunkLodIndicesSet.clear();
     _chunkLodIndicesSkirtSet.clear();
+    _placeholderIndices = ChunkIndices();
 }
 
 void Terrain::Chunk::finish()
@@ -909,23 +1392,38 @@ void Terrain::Chunk::finish()
 
     _buffer->updateData(&_originalVertices[0], sizeof(TerrainVertexData) * _originalVertices.size());
 
-    calculateSlope();
-
-    for (int i = 0; i < 4; ++i)
-    {
-        int step = 1 << _currentLod;
-        // reserve the indices size, the first part is the core part of the chunk, the second part & third part is for
-        // fix crack
-        int indicesAmount = (_terrain->_chunkSize.width / step + 1) * (_terrain->_chunkSize.height / step + 1) * 6 +
-                            (_terrain->_chunkSize.height / step) * 6 + (_terrain->_chunkSize.width / step) * 6;
-        _lod[i]._indices.reserve(indicesAmount);
-    }
     _oldLod = -1;
 }
 
+static bool consumeFrameBudget(int budget, int& used)
+{
+    if (budget > 0 && used >= budget)
+        return false;
+    ++used;
+    return true;
+}
+
 void Terrain::Chunk::bindAndDraw()
 {
-    if (_terrain->_isCameraViewChanged || _oldLod < 0)
+    if (!_buffer)
+    {
+        // stream the chunks in progressively, the nearest ones can't wait
+        if (_currentLod == 0)
+            _terrain->waitChunkGenerated(this);
+        else if (!_terrain->isChunkGenerated(this) ||
+                 !consumeFrameBudget(_terrain->_chunkUploadBudget, _terrain->_chunkUploadsThisFrame))
+        {
+            drawPlaceholder();
+            return;
+        }
+        finish();
+        AX_SAFE_RELEASE_NULL(_placeholderBuffer);
+        --_terrain->_pendingChunkCount;
+    }
+
+    // a chunk without valid indices must be updated, the others can keep their previous LOD for a while
+    if (_oldLod < 0 || !_chunkIndices._indexBuffer ||
+        (_lodDirty && consumeFrameBudget(_terrain->_lodUpdateBudget, _terrain->_lodUpdatesThisFrame)))
     {
         switch (_terrain->_crackFixedType)
         {
@@ -940,6 +1438,7 @@ void Terrain::Chunk::bindAndDraw()
         default:
             break;
         }
+        _lodDirty = false;
     }
 
     auto* renderer = Director::getInstance()->getRenderer();
@@ -952,10 +1451,38 @@ void Terrain::Chunk::bindAndDraw()
     AX_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, _chunkIndices._size);
 }
 
+void Terrain::Chunk::drawPlaceholder()
+{
+    if (!_placeholderBuffer)
+    {
+        // the corners come from the height field, so they are there before the chunk is generated
+        int imgWidth = _terrain->_imageWidth;
+        int top      = _size.height * _posY;
+        int bottom   = std::min<int>(_size.height * (_posY + 1), _terrain->_imageHeight - 1);
+        int left     = _size.width * _posX;
+        int right    = std::min<int>(_size.width * (_posX + 1), imgWidth - 1);
+
+        const TerrainVertexData vertices[] = {
+            _terrain->_vertices[top * imgWidth + left], _terrain->_vertices[top * imgWidth + right],
+            _terrain->_vertices[bottom * imgWidth + left], _terrain->_vertices[bottom * imgWidth + right]};
+        _placeholderBuffer =
+            axdrv->createBuffer(sizeof(vertices), rhi::BufferType::VERTEX, rhi::BufferUsage::STATIC);
+        _placeholderBuffer->updateData(vertices, sizeof(vertices));
+    }
+
+    auto& indices  = _terrain->getPlaceholderIndices();
+    auto* renderer = Director::getInstance()->getRenderer();
+    _command.setIndexBuffer(indices._indexBuffer, rhi::IndexFormat::U_SHORT);
+    _command.setVertexBuffer(_placeholderBuffer);
+    _command.setWeakPSVL(_terrain->_programState, _terrain->_vertexLayout);
+    _command.setIndexDrawInfo(0, indices._size);
+    renderer->addCommand(&_command);
+    AX_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, indices._size);
+}
+
 void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const unsigned char* /*data*/)
 {
-    _posY = m;
-    _posX = n;
+    // _posX and _posY are set before generating, the main thread may read them meanwhile
     switch (_terrain->_crackFixedType)
     {
     case CrackFixedType::SKIRT:
@@ -976,7 +1503,7 @@ void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const un
 
         float skirtHeight = _terrain->_skirtRatio * _terrain->_terrainData._mapScale * 8;
         // #1
-        _terrain->_skirtVerticesOffset[0] = (int)_originalVertices.size();
+        _skirtVerticesOffset[0] = (int)_originalVertices.size();
         for (int i = _size.height * m; i <= _size.height * (m + 1); ++i)
         {
             auto v = _terrain->_vertices[i * imgWidth + _size.width * (n + 1)];
@@ -985,7 +1512,7 @@ void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const un
         }
 
         // #2
-        _terrain->_skirtVerticesOffset[1] = (int)_originalVertices.size();
+        _skirtVerticesOffset[1] = (int)_originalVertices.size();
         for (int j = _size.width * n; j <= _size.width * (n + 1); j++)
         {
             auto v = _terrain->_vertices[_size.height * (m + 1) * imgWidth + j];
@@ -994,7 +1521,7 @@ void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const un
         }
 
         // #3
-        _terrain->_skirtVerticesOffset[2] = (int)_originalVertices.size();
+        _skirtVerticesOffset[2] = (int)_originalVertices.size();
         for (int i = _size.height * m; i <= _size.height * (m + 1); ++i)
         {
             auto v = _terrain->_vertices[i * imgWidth + _size.width * n];
@@ -1003,7 +1530,7 @@ void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const un
         }
 
         // #4
-        _terrain->_skirtVerticesOffset[3] = (int)_originalVertices.size();
+        _skirtVerticesOffset[3] = (int)_originalVertices.size();
         for (int j = _size.width * n; j <= _size.width * (n + 1); j++)
         {
             auto v = _terrain->_vertices[_size.height * m * imgWidth + j];
@@ -1048,8 +1575,17 @@ void Terrain::Chunk::generate(int imgWidth, int imageHei, int m, int n, const un
         }
     }
 
-    calculateAABB();
-    finish();
+    calculateSlope();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int step = 1 << i;
+        // reserve the indices size, the first part is the core part of the chunk, the second part & third part is for
+        // fix crack
+        int indicesAmount = (_terrain->_chunkSize.width / step + 1) * (_terrain->_chunkSize.height / step + 1) * 6 +
+                            (_terrain->_chunkSize.height / step) * 6 + (_terrain->_chunkSize.width / step) * 6;
+        _lod[i]._indices.reserve(indicesAmount);
+    }
 }
 
 Terrain::Chunk::Chunk(Terrain* terrain)
@@ -1124,199 +1660,49 @@ void Terrain::Chunk::updateIndicesLOD()
         return;
     }
     memcpy(_neighborOldLOD, currentNeighborLOD, sizeof(currentNeighborLOD));
-    _oldLod   = _currentLod;
-    int gridY = static_cast<int>(_size.height);
-    int gridX = static_cast<int>(_size.width);
-
-    int step = 1 << _currentLod;
-    if ((_left && _left->_currentLod > _currentLod) || (_right && _right->_currentLod > _currentLod) ||
-        (_back && _back->_currentLod > _currentLod) || (_front && _front->_currentLod > _currentLod))
-    // need update indices.
-    {
-        // t-junction inner
-        _lod[_currentLod]._indices.clear();
-        for (int i = step; i < gridY - step; i += step)
-        {
-            for (int j = step; j < gridX - step; j += step)
-            {
-                int nLocIndex = i * (gridX + 1) + j;
-                _lod[_currentLod]._indices.emplace_back(nLocIndex);
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
-            }
-        }
-        // fix T-crack
-        int next_step = 1 << (_currentLod + 1);
-        if (_left && _left->_currentLod > _currentLod)  // left
-        {
-            for (int i = 0; i < gridY; i += next_step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + step);
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1));
-
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + step);
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + step);
-
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + step);
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1) + step);
-            }
-        }
-        else
-        {
-            int start = 0;
-            int end   = gridY;
-            if (_front && _front->_currentLod > _currentLod)
-                end -= step;
-            if (_back && _back->_currentLod > _currentLod)
-                start += step;
-            for (int i = start; i < end; i += step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + step);
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1));
-
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + step);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + step);
-            }
-        }
-
-        if (_right && _right->_currentLod > _currentLod)  // LEFT
-        {
-            for (int i = 0; i < gridY; i += next_step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX);
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX - step);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
-
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1) + gridX - step);
-
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX);
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1) + gridX - step);
-                _lod[_currentLod]._indices.emplace_back((i + next_step) * (gridX + 1) + gridX);
-            }
-        }
-        else
-        {
-            int start = 0;
-            int end   = gridY;
-            if (_front && _front->_currentLod > _currentLod)
-                end -= step;
-            if (_back && _back->_currentLod > _currentLod)
-                start += step;
-            for (int i = start; i < end; i += step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX);
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX - step);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
-
-                _lod[_currentLod]._indices.emplace_back(i * (gridX + 1) + gridX);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + gridX - step);
-                _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1) + gridX);
-            }
-        }
-        if (_front && _front->_currentLod > _currentLod)  // front
-        {
-            for (int i = 0; i < gridX; i += next_step)
-            {
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
-
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i + next_step);
-
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i + next_step);
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + next_step);
-            }
-        }
-        else
-        {
-            for (int i = step; i < gridX - step; i += step)
-            {
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
-
-                _lod[_currentLod]._indices.emplace_back((gridY - step) * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(gridY * (gridX + 1) + i + step);
-            }
-        }
-        if (_back && _back->_currentLod > _currentLod)  // back
-        {
-            for (int i = 0; i < gridX; i += next_step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + step);
-
-                _lod[_currentLod]._indices.emplace_back(i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(i + next_step);
-
-                _lod[_currentLod]._indices.emplace_back(i + next_step);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + next_step);
-            }
-        }
-        else
-        {
-            for (int i = step; i < gridX - step; i += step)
-            {
-                _lod[_currentLod]._indices.emplace_back(i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + step);
-
-                _lod[_currentLod]._indices.emplace_back(i);
-                _lod[_currentLod]._indices.emplace_back(step * (gridX + 1) + i + step);
-                _lod[_currentLod]._indices.emplace_back(i + step);
-            }
-        }
+    _oldLod = _currentLod;
 
-        _chunkIndices = _terrain->insertIndicesLOD(currentNeighborLOD, _currentLod, &_lod[_currentLod]._indices[0],
-                                                   (int)_lod[_currentLod]._indices.size());
-    }
-    else
+    // the patterns built on the job system during init cover every chunk of the full size
+    bool left  = _left && _left->_currentLod > _currentLod;
+    bool right = _right && _right->_currentLod > _currentLod;
+    bool back  = _back && _back->_currentLod > _currentLod;
+    bool front = _front && _front->_currentLod > _currentLod;
+    auto indices =
+        _terrain->findLODIndexPattern(_currentLod, (left ? 1 : 0) | (right ? 2 : 0) | (back ? 4 : 0) | (front ? 8 : 0));
+    if (!indices)
     {
-        // No lod difference, use simple method
-        _lod[_currentLod]._indices.clear();
-        for (int i = 0; i < gridY; i += step)
-        {
-            for (int j = 0; j < gridX; j += step)
-            {
-
-                int nLocIndex = i * (gridX + 1) + j;
-                _lod[_currentLod]._indices.emplace_back(nLocIndex);
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-                _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
-            }
-        }
-        _chunkIndices = _terrain->insertIndicesLOD(currentNeighborLOD, _currentLod, &_lod[_currentLod]._indices[0],
-                                                   (int)_lod[_currentLod]._indices.size());
+        buildIndicesLOD(_currentLod, left, right, back, front, static_cast<int>(_size.width),
+                        static_cast<int>(_size.height), _lod[_currentLod]._indices);
+        indices = &_lod[_currentLod]._indices;
     }
+    _chunkIndices =
+        _terrain->insertIndicesLOD(currentNeighborLOD, _currentLod, indices->data(), static_cast<int>(indices->size()));
 }
 
 void Terrain::Chunk::calculateAABB()
 {
+    // the same vertices generate() copies, the skirts hang below the border ones
+    int imgWidth      = _terrain->_imageWidth;
+    int imageHei      = _terrain->_imageHeight;
+    float skirtHeight = _terrain->_crackFixedType == CrackFixedType::SKIRT
+                            ? _terrain->_skirtRatio * _terrain->_terrainData._mapScale * 8
+                            : 0.0f;
+    int top           = _size.height * _posY;
+    int bottom        = _size.height * (_posY + 1);
+    int left          = _size.width * _posX;
+    int right         = _size.width * (_posX + 1);
+
     tlx::pod_vector<Vec3> pos;
-    tlx::resize_and_transform(_originalVertices.begin(), _originalVertices.end(), pos,
-                              [](const auto& it) { return it._position; });
+    for (int i = top; i <= bottom && i < imageHei; ++i)
+    {
+        for (int j = left; j <= right && j < imgWidth; j++)
+        {
+            auto& position = _terrain->_vertices[i * imgWidth + j]._position;
+            pos.emplace_back(position);
+            if (skirtHeight != 0.0f && (i == top || i == bottom || j == left || j == right))
+                pos.emplace_back(position.x, position.y - skirtHeight, position.z);
+        }
+    }
     _aabb.updateMinMax(&pos[0], pos.size());
 }
 
@@ -1408,6 +1794,7 @@ void Terrain::Chunk::updateVerticesForLOD()
 Terrain::Chunk::~Chunk()
 {
     AX_SAFE_RELEASE_NULL(_buffer);
+    AX_SAFE_RELEASE_NULL(_placeholderBuffer);
 }
 
 void Terrain::Chunk::updateIndicesLODSkirt()
@@ -1420,79 +1807,14 @@ void Terrain::Chunk::updateIndicesLODSkirt()
     if (isOk)
         return;
 
-    int gridY = _size.height;
-    int gridX = _size.width;
-    int step  = 1 << _currentLod;
-    int k     = 0;
-    for (int i = 0; i < gridY; i += step, k += step)
-    {
-        for (int j = 0; j < gridX; j += step)
-        {
-            int nLocIndex = i * (gridX + 1) + j;
-            _lod[_currentLod]._indices.emplace_back(nLocIndex);
-            _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-            _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-
-            _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-            _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-            _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1) + step);
-        }
-    }
-    // add skirt
-    // #1
-    for (int i = 0; i < gridY; i += step)
+    auto indices = _terrain->findLODIndexPatternSkirt(_currentLod, _skirtVerticesOffset);
+    if (!indices)
     {
-        int nLocIndex = i * (gridX + 1) + gridX;
-        _lod[_currentLod]._indices.emplace_back(nLocIndex);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-        _lod[_currentLod]._indices.emplace_back((gridY + 1) * (gridX + 1) + i);
-
-        _lod[_currentLod]._indices.emplace_back((gridY + 1) * (gridX + 1) + i);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step * (gridX + 1));
-        _lod[_currentLod]._indices.emplace_back((gridY + 1) * (gridX + 1) + i + step);
+        buildIndicesLODSkirt(_currentLod, _skirtVerticesOffset, static_cast<int>(_size.width),
+                             static_cast<int>(_size.height), _lod[_currentLod]._indices);
+        indices = &_lod[_currentLod]._indices;
     }
-
-    // #2
-    for (int j = 0; j < gridX; j += step)
-    {
-        int nLocIndex = (gridY) * (gridX + 1) + j;
-        _lod[_currentLod]._indices.emplace_back(nLocIndex);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[1] + j);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[1] + j);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[1] + j + step);
-    }
-
-    // #3
-    for (int i = 0; i < gridY; i += step)
-    {
-        int nLocIndex = i * (gridX + 1);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[2] + i);
-        _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1));
-
-        _lod[_currentLod]._indices.emplace_back((i + step) * (gridX + 1));
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[2] + i);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[2] + i + step);
-    }
-
-    // #4
-    for (int j = 0; j < gridX; j += step)
-    {
-        int nLocIndex = j;
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[3] + j);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex);
-
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[3] + j + step);
-        _lod[_currentLod]._indices.emplace_back(_terrain->_skirtVerticesOffset[3] + j);
-        _lod[_currentLod]._indices.emplace_back(nLocIndex + step);
-    }
-
-    _chunkIndices = _terrain->insertIndicesLODSkirt(_currentLod, &_lod[_currentLod]._indices[0],
-                                                    (int)_lod[_currentLod]._indices.size());
+    _chunkIndices = _terrain->insertIndicesLODSkirt(_currentLod, indices->data(), static_cast<int>(indices->size()));
 }
 
 Terrain::QuadTree::QuadTree(int x, int y, int w, int h, Terrain* terrain)
@@ -1533,11 +1855,7 @@ Terrain::QuadTree::QuadTree(int x, int y, int w, int h, Terrain* terrain)
         _isTerminal     = true;
         _localAABB      = _chunk->_aabb;
         _chunk->_parent = this;
-
-        for (auto&& triangle : _chunk->_trianglesList)
-        {
-            triangle.transform(_terrain->getNodeToWorldTransform());
-        }
+        // the triangles are transformed when the chunk is generated, see Terrain::generateChunks
     }
     _worldSpaceAABB = _localAABB;
     _worldSpaceAABB.transform(_terrain->getNodeToWorldTransform());
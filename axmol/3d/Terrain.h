@@ -25,6 +25,8 @@ THE SOFTWARE.
 ****************************************************************************/
 #pragma once
 
+#include <memory>
+#include <span>
 #include <vector>
 
 #include "axmol/2d/Node.h"
@@ -234,6 +236,8 @@ private:
     };
 
     struct AX_DLL QuadTree;
+    struct ChunkGenerateTask;
+    struct LODIndexPatterns;
     /*
      *the terminal node of quad, use to subdivision terrain mesh and LOD
      **/
@@ -255,13 +259,15 @@ private:
         LOD _lod[4];
         /**AABB in local space*/
         AABB _aabb;
-        /**setup Chunk data*/
+        /**setup Chunk data, CPU side only, safe to run on a worker thread*/
         void generate(int map_width, int map_height, int m, int n, const unsigned char* data);
-        /**calculateAABB*/
+        /**calculateAABB from the height field, so it's known before the chunk is generated*/
         void calculateAABB();
         /**internal use draw function*/
         void bindAndDraw();
-        /**finish opengl setup*/
+        /**draw one quad through the chunk corners until the chunk is uploaded*/
+        void drawPlaceholder();
+        /**finish opengl setup, upload the generated vertices to GPU*/
         void finish();
         /*use linear-sample vertices for LOD mesh*/
         void updateVerticesForLOD();
@@ -280,6 +286,9 @@ private:
 
         int _oldLod;
 
+        /**whether the LOD indices need to be rebuilt*/
+        bool _lodDirty = true;
+
         int _neighborOldLOD[4];
         /*the left,right,front,back neighbors*/
         Chunk* _left;
@@ -303,7 +312,14 @@ private:
 
         std::vector<Triangle> _trianglesList;
 
-        rhi::Buffer* _buffer = nullptr;
+        /**the skirt vertices offset of each side, only used when terrain use skirt to fix crack*/
+        int _skirtVerticesOffset[4];
+
+        /**the index of the chunk in the generate task*/
+        size_t _generateIndex = 0;
+
+        rhi::Buffer* _buffer            = nullptr;
+        rhi::Buffer* _placeholderBuffer = nullptr;
         MeshCommand _command;
     };
 
@@ -469,6 +485,26 @@ public:
      */
     QuadTree* getQuadTree();
 
+    /**
+     * Set the maximum amount of chunks uploaded to GPU per frame, 0 means unlimited.
+     * @Note chunks in the nearest LOD level are always uploaded immediately, the others are streamed in when visible.
+     * A visible chunk which isn't generated or uploaded yet draws one quad through its corners instead.
+     */
+    void setChunkUploadBudget(int budget) { _chunkUploadBudget = budget; }
+    int getChunkUploadBudget() const { return _chunkUploadBudget; }
+
+    /**
+     * Set the maximum amount of chunk LOD index updates per frame, 0 means unlimited.
+     * @Note a deferred chunk keeps drawing with its previous LOD until it's updated.
+     */
+    void setLODUpdateBudget(int budget) { _lodUpdateBudget = budget; }
+    int getLODUpdateBudget() const { return _lodUpdateBudget; }
+
+    /**
+     * get the amount of chunks which haven't been uploaded to GPU yet.
+     */
+    int getPendingChunkCount() const { return _pendingChunkCount; }
+
     void reload();
 
     /**
@@ -492,6 +528,31 @@ protected:
      **/
     void setChunksLOD(const Vec3& cameraPos);
 
+    /**
+     * generate the chunks geometry and the LOD index patterns on the job system, returns immediately.
+     * A chunk needed before its job ran is generated on the calling thread.
+     **/
+    void generateChunks(std::span<Chunk*> chunks);
+
+    /**
+     * make sure the chunk is generated, generates it on the calling thread or waits for the worker doing it.
+     **/
+    void waitChunkGenerated(Chunk* chunk) const;
+
+    bool isChunkGenerated(const Chunk* chunk) const;
+
+    /**
+     * cancel the chunks which haven't been generated yet and wait for the ones being generated.
+     **/
+    void cancelChunkGeneration();
+
+    /**
+     * the indices built during init for the LOD and the neighbors with a higher LOD, nullptr if not built yet.
+     **/
+    const std::vector<uint16_t>* findLODIndexPattern(int selfLod, int higherNeighborMask) const;
+
+    const std::vector<uint16_t>* findLODIndexPatternSkirt(int selfLod, const int skirtVerticesOffset[4]) const;
+
     /**
      * load Vertices from height filed for the whole terrain.
      **/
@@ -515,9 +576,11 @@ protected:
 
     ChunkIndices lookForIndicesLOD(int neighborLod[4], int selfLod, bool* result);
 
-    ChunkIndices insertIndicesLOD(int neighborLod[4], int selfLod, uint16_t* indices, int size);
+    ChunkIndices insertIndicesLOD(int neighborLod[4], int selfLod, const uint16_t* indices, int size);
+
+    ChunkIndices insertIndicesLODSkirt(int selfLod, const uint16_t* indices, int size);
 
-    ChunkIndices insertIndicesLODSkirt(int selfLod, uint16_t* indices, int size);
+    const ChunkIndices& getPlaceholderIndices();
 
     Chunk* getChunkByIndex(int x, int y) const;
 
@@ -557,7 +620,15 @@ protected:
     float _minHeight;
     CrackFixedType _crackFixedType;
     float _skirtRatio;
-    int _skirtVerticesOffset[4];
+    int _chunkUploadBudget     = 8;
+    int _lodUpdateBudget       = 0;
+    int _chunkUploadsThisFrame = 0;
+    int _lodUpdatesThisFrame   = 0;
+    unsigned int _budgetFrame  = 0;
+    int _pendingChunkCount     = 0;
+    std::shared_ptr<ChunkGenerateTask> _generateTask;
+    std::shared_ptr<LODIndexPatterns> _lodIndexPatterns;
+    ChunkIndices _placeholderIndices;
     struct StateBlock
     {
         // bool blend;
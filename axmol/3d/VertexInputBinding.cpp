@@ -116,7 +116,7 @@ bool VertexInputBinding::init(MeshIndexData* meshIndexData, Pass* pass, MeshComm
     {
         auto meshattribute = meshVertexData->getMeshVertexAttrib(k);
         setVertexInputPointer(desc, shaderinfos::getAttributeName(meshattribute.vertexAttrib), meshattribute.type,
-                              false, offset, 1 << k);
+                              meshattribute.normalized, offset, 1 << k);
         offset += meshattribute.getAttribSizeBytes();
     }
 
@@ -28,6 +28,7 @@
 #include <thread>
 #include "axmol/base/Director.h"
 #include "axmol/base/Scheduler.h"
+#include "axmol/platform/FileUtils.h"
 
 #include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/audio/AudioDecoder.h"
@@ -50,6 +51,10 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _compressed(false)
+    , _compressedBytes(0)
+    , _pcmBytes(0)
+    , _lastUsed(0)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -102,6 +107,9 @@ AudioCache::~AudioCache()
             free(_queBuffers[index]);
         }
     }
+
+    if (_compressedBytes > 0)
+        AudioDecoderManager::removeResidentData(_fileFullPath);
     AXLOGV("~AudioCache() {}, id={}, end", fmt::ptr(this), _id);
     _readDataTaskMutex.unlock();
 }
@@ -114,6 +122,17 @@ void AudioCache::readDataTask(unsigned int selfId)
     _readDataTaskMutex.lock();
     _state = State::LOADING;
 
+    // in compressed mode the decoders of this cache and of its players read the file from memory
+    std::shared_ptr<std::vector<char>> compressedData;
+    if (_compressed)
+    {
+        compressedData = std::make_shared<std::vector<char>>();
+        if (FileUtils::getInstance()->getContents(_fileFullPath, compressedData.get()) == FileUtils::Status::OK)
+            AudioDecoderManager::addResidentData(_fileFullPath, compressedData);
+        else
+            compressedData.reset();
+    }
+
     AudioDecoder* decoder = AudioDecoderManager::createDecoder(_fileFullPath);
     do
     {
@@ -165,7 +184,12 @@ void AudioCache::readDataTask(unsigned int selfId)
         _duration    = 1.0f * totalFrames / sampleRate;
         _totalFrames = totalFrames;
 
-        if (dataSize <= PCMDATA_CACHEMAXSIZE)
+        // a compressed cache streams every sound which doesn't fit into the primed queue buffers
+        const bool streamFromMemory =
+            compressedData &&
+            totalFrames > static_cast<uint32_t>(sampleRate * QUEUEBUFFER_TIME_STEP) * QUEUEBUFFER_NUM;
+
+        if (dataSize <= PCMDATA_CACHEMAXSIZE && !streamFromMemory)
         {
             uint32_t framesRead = 0;
             const uint32_t framesToReadOnce =
@@ -280,7 +304,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
-            _state = State::READY;
+            _pcmBytes = dataSize;
+            _state    = State::READY;
         }
         else
         {
@@ -297,6 +322,10 @@ void AudioCache::readDataTask(unsigned int selfId)
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
 
+            // long sounds keep streaming from disk, only short ones are worth keeping resident
+            if (streamFromMemory && dataSize <= PCMDATA_CACHEMAXSIZE)
+                _compressedBytes = static_cast<uint32_t>(compressedData->size());
+
             _state = State::READY;
         }
 
@@ -304,6 +333,9 @@ void AudioCache::readDataTask(unsigned int selfId)
 
     AudioDecoderManager::destroyDecoder(decoder);
 
+    if (compressedData && _compressedBytes == 0)
+        AudioDecoderManager::removeResidentData(_fileFullPath);
+
     if (_state != State::READY)
     {
         _state = State::FAILED;
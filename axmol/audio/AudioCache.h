@@ -86,6 +86,17 @@ protected:
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames;
 
+    /* Compressed cache related stuff
+     *  Keep the encoded file resident and stream it from memory instead of caching decoded pcm data
+     */
+    bool _compressed;
+    uint32_t _compressedBytes;
+
+    // size of the decoded pcm data held by _alBufferId
+    uint32_t _pcmBytes;
+    // use tick of the cache, for LRU eviction of pcm data
+    uint64_t _lastUsed;
+
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
 
@@ -26,6 +26,7 @@
 
 #include "axmol/audio/AudioDecoderEXT.h"
 #include "axmol/audio/AudioMacros.h"
+#include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/platform/FileUtils.h"
 
 #import <Foundation/Foundation.h>
@@ -51,7 +52,7 @@ bool AudioDecoderEXT::open(std::string_view fullPath)
     {
         BREAK_IF_ERR_LOG(fullPath.empty(), "Invalid path!");
 
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = AudioDecoderManager::openFileStream(fullPath);
         BREAK_IF_ERR_LOG(_fileStream == nullptr, "FileUtils::openFileStream FAILED for file: {}", fullPath);
         if (_fileStream)
         {
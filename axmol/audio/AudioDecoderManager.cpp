@@ -40,9 +40,75 @@ THE SOFTWARE.
 
 #include "yasio/tlx/string_view.hpp"
 
+#include <mutex>
+
 namespace ax
 {
 
+namespace
+{
+// Read only stream over resident audio data, it shares the data so an opened decoder stays valid after
+// the data was removed from the registry
+class ResidentAudioStream : public IFileStream
+{
+public:
+    explicit ResidentAudioStream(std::shared_ptr<const std::vector<char>> data) : _data(std::move(data)) {}
+
+    bool open(std::string_view /*path*/, IFileStream::Mode /*mode*/) override { return false; }
+
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        if (!_data)
+            return -1;
+
+        int64_t base = 0;
+        if (origin == SEEK_CUR)
+            base = _offset;
+        else if (origin == SEEK_END)
+            base = size();
+
+        const auto position = base + offset;
+        if (position < 0 || position > size())
+            return -1;
+
+        _offset = position;
+        return position;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_data)
+            return -1;
+
+        const auto bytesToRead = static_cast<size_t>((std::min)(static_cast<int64_t>(size), this->size() - _offset));
+        memcpy(buf, _data->data() + _offset, bytesToRead);
+        _offset += bytesToRead;
+        return static_cast<int>(bytesToRead);
+    }
+
+    int write(const void* /*buf*/, unsigned int /*size*/) const override { return -1; }
+
+    int64_t tell() const override { return _data ? _offset : -1; }
+
+    int64_t size() const override { return _data ? static_cast<int64_t>(_data->size()) : -1; }
+
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const std::vector<char>> _data;
+    mutable int64_t _offset{0};
+};
+
+std::mutex s_residentDataMutex;
+tlx::string_map<std::shared_ptr<const std::vector<char>>> s_residentData;
+}  // namespace
+
 bool AudioDecoderManager::init()
 {
 #if !defined(__APPLE__)
@@ -67,7 +133,7 @@ AudioDecoder* AudioDecoderManager::createDecoder(std::string_view path)
         constexpr int OGG_CODEC_SIGN_OFFSET = 28;
         constexpr int OGG_CODEC_SIGN_SIZE   = 8;
 
-        auto stream = FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+        auto stream = openFileStream(path);
         if (!stream)
             return nullptr;
         if (stream->size() < OGG_CODEC_SIGN_OFFSET + OGG_CODEC_SIGN_SIZE)
@@ -121,4 +187,28 @@ void AudioDecoderManager::destroyDecoder(AudioDecoder* decoder)
     delete decoder;
 }
 
+std::unique_ptr<IFileStream> AudioDecoderManager::openFileStream(std::string_view path)
+{
+    {
+        std::lock_guard<std::mutex> lck(s_residentDataMutex);
+        auto it = s_residentData.find(path);
+        if (it != s_residentData.end())
+            return std::make_unique<ResidentAudioStream>(it->second);
+    }
+
+    return FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+}
+
+void AudioDecoderManager::addResidentData(std::string_view path, std::shared_ptr<const std::vector<char>> data)
+{
+    std::lock_guard<std::mutex> lck(s_residentDataMutex);
+    s_residentData[path] = std::move(data);
+}
+
+void AudioDecoderManager::removeResidentData(std::string_view path)
+{
+    std::lock_guard<std::mutex> lck(s_residentDataMutex);
+    s_residentData.erase(path);
+}
+
 }  // namespace ax
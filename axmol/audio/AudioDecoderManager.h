@@ -26,8 +26,11 @@ THE SOFTWARE.
 
 #pragma once
 #include <string>
+#include <memory>
+#include <vector>
 
 #include "axmol/platform/PlatformMacros.h"
+#include "axmol/platform/IFileStream.h"
 
 namespace ax
 {
@@ -41,6 +44,16 @@ public:
     static void destroy();
     static AudioDecoder* createDecoder(std::string_view path);
     static void destroyDecoder(AudioDecoder* decoder);
+
+    /**
+     * Opens a read stream for the decoders, served from the resident data of the path if there is any,
+     * otherwise from FileUtils. It may be called from any thread.
+     */
+    static std::unique_ptr<IFileStream> openFileStream(std::string_view path);
+
+    /** Keeps the encoded bytes of an audio file resident, so decoders don't touch the disk for it. */
+    static void addResidentData(std::string_view path, std::shared_ptr<const std::vector<char>> data);
+    static void removeResidentData(std::string_view path);
 };
 
 }  // namespace ax
@@ -26,6 +26,7 @@
 
 #include "axmol/audio/AudioDecoderMp3.h"
 #include "axmol/audio/AudioMacros.h"
+#include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/platform/FileUtils.h"
 
 #include "axmol/base/Logging.h"
@@ -130,7 +131,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !AX_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = AudioDecoderManager::openFileStream(fullPath);
         if (!_fileStream)
         {
             AXLOGE("Trouble with minimp3(1): {}\n", strerror(errno));
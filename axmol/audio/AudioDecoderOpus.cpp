@@ -32,6 +32,7 @@
 
 #    include "axmol/audio/AudioDecoderOpus.h"
 #    include "axmol/audio/AudioMacros.h"
+#    include "axmol/audio/AudioDecoderManager.h"
 #    include "axmol/platform/FileUtils.h"
 
 #    include "opus/opusfile.h"
@@ -102,7 +103,7 @@ bool AudioDecoderOpus::open(std::string_view fullPath)
 {
     if (_isOpened)
         return true;
-    auto stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto stream = AudioDecoderManager::openFileStream(fullPath).release();
     if (!stream)
     {
         AXLOGE("Trouble with ogg(1): {}\n", strerror(errno));
@@ -26,6 +26,7 @@
 
 #include "axmol/audio/AudioDecoderVorbis.h"
 #include "axmol/audio/AudioMacros.h"
+#include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/platform/FileUtils.h"
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
@@ -72,7 +73,7 @@ bool AudioDecoderVorbis::open(std::string_view fullPath)
 {
     if (_isOpened)
         return true;
-    auto stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto stream = AudioDecoderManager::openFileStream(fullPath).release();
     if (!stream)
     {
         AXLOGE("Trouble with ogg(1): {}\n", strerror(errno));
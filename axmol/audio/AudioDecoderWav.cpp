@@ -27,6 +27,7 @@
 #include <assert.h>
 #include "axmol/audio/AudioDecoderWav.h"
 #include "axmol/audio/AudioMacros.h"
+#include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/platform/FileUtils.h"
 
 namespace ax
@@ -80,7 +81,7 @@ static bool wav_scan_chunk(WAV_FILE* wavf, uint32_t chunkID, void* header, void*
 }
 static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
 {
-    wavf->Stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+    wavf->Stream = AudioDecoderManager::openFileStream(fullPath);
     if (!wavf->Stream)
         return false;
 
@@ -53,6 +53,9 @@ tlx::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 tlx::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
 unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+unsigned int AudioEngine::_maxRealVoices                       = MAX_AUDIOINSTANCES;
+bool AudioEngine::_compressedCacheEnabled                      = false;
+size_t AudioEngine::_pcmCacheBudget                            = 0;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
@@ -165,7 +168,7 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath,
             volume = 1.0f;
         }
 
-        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time);
+        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time, settings.priority);
         if (ret != INVALID_AUDIO_ID)
         {
             _audioPathIDMap[filePath.data()].emplace_back(ret);
@@ -264,7 +267,7 @@ AUDIO_ID AudioEngine::play3d(std::string_view filePath,
         }
 
         ret = _audioEngineImpl->play3d(filePath, settings.position, settings.distanceScale, settings.loop, volume,
-                                       settings.time);
+                                       settings.time, settings.priority);
         if (ret != INVALID_AUDIO_ID)
         {
             _audioPathIDMap[filePath.data()].emplace_back(ret);
@@ -523,7 +526,7 @@ void AudioEngine::setFinishCallback(AUDIO_ID audioID, const std::function<void(A
 
 bool AudioEngine::setMaxAudioInstance(int maxInstances)
 {
-    if (maxInstances > 0 && maxInstances <= MAX_AUDIOINSTANCES)
+    if (maxInstances > 0 && maxInstances <= MAX_VIRTUAL_AUDIOINSTANCES)
     {
         _maxInstances = maxInstances;
         return true;
@@ -532,6 +535,27 @@ bool AudioEngine::setMaxAudioInstance(int maxInstances)
     return false;
 }
 
+bool AudioEngine::setMaxRealVoices(int maxRealVoices)
+{
+    if (maxRealVoices > 0 && maxRealVoices <= MAX_AUDIOINSTANCES)
+    {
+        _maxRealVoices = maxRealVoices;
+        return true;
+    }
+
+    return false;
+}
+
+bool AudioEngine::isVirtual(AUDIO_ID audioID)
+{
+    if (!_audioEngineImpl || _audioIDInfoMap.find(audioID) == _audioIDInfoMap.end())
+    {
+        return false;
+    }
+
+    return _audioEngineImpl->isVirtual(audioID);
+}
+
 bool AudioEngine::isLoop(AUDIO_ID audioID)
 {
     auto tmpIterator = _audioIDInfoMap.find(audioID);
@@ -737,4 +761,23 @@ void AudioEngine::setReverbProperties(int audioId, const ReverbProperties* rever
 
     return _audioEngineImpl->setReverbProperties(audioId, reverbProperties);
 }
+
+bool AudioEngine::getStreamStats(int audioId, AudioStreamStats& stats)
+{
+    if (!_audioEngineImpl)
+    {
+        return false;
+    }
+
+    return _audioEngineImpl->getStreamStats(audioId, stats);
+}
+
+void AudioEngine::getCacheStats(AudioCacheStats& stats)
+{
+    stats = AudioCacheStats{};
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->getCacheStats(stats);
+    }
+}
 }  // namespace ax
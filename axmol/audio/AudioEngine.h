@@ -58,6 +58,34 @@ struct AX_DLL AudioPlayerSettings
     float time   = 0.0f;         // The initial time offset when play audio
     Vec3 position{};             // position of audio in 3d space relative to listener
     static float distanceScale;  // scale used for distance calculations. Must be greater than 0, and defaults to 1.0f.
+    int priority = 0;            // Voices with higher priority keep their OpenAL source when voices are stolen.
+};
+
+/**
+ * @struct AudioStreamStats
+ *
+ * @brief Runtime statistics of a streaming audio instance.
+ */
+struct AX_DLL AudioStreamStats
+{
+    unsigned int underruns     = 0;  // Times the source ran out of queued buffers and had to be restarted.
+    unsigned int buffersQueued = 0;  // Number of decoded buffers handed to OpenAL.
+    double decodeTimeMs        = 0;  // Total time spent decoding, in milliseconds.
+    double maxDecodeTimeMs     = 0;  // Longest single buffer decode, in milliseconds.
+};
+
+/**
+ * @struct AudioCacheStats
+ *
+ * @brief Memory statistics of the audio caches.
+ */
+struct AX_DLL AudioCacheStats
+{
+    size_t pcmBytes               = 0;  // Decoded pcm data held by the caches.
+    size_t compressedBytes        = 0;  // Encoded file data kept resident by compressed caches.
+    unsigned int pcmCaches        = 0;  // Number of caches holding decoded pcm data.
+    unsigned int compressedCaches = 0;  // Number of caches streaming from resident encoded data.
+    unsigned int evictions        = 0;  // Caches evicted to stay within the pcm cache budget.
 };
 
 /**
@@ -320,6 +348,29 @@ public:
      */
     static bool setMaxAudioInstance(int maxInstances);
 
+    /**
+     * Gets the maximum number of audio instances that play on a real OpenAL source at the same time.
+     */
+    static int getMaxRealVoices() { return _maxRealVoices; }
+
+    /**
+     * Sets the maximum number of audio instances that play on a real OpenAL source at the same time.
+     *
+     * Audio instances beyond this budget become virtual voices: they keep tracking their time, volume and position
+     * without a source, and every update the highest priority, then loudest, voices are promoted to real sources.
+     * Use it together with setMaxAudioInstance to fire more sounds than the mixer can play.
+     *
+     * @param maxRealVoices The number of real voices, from 1 to MAX_AUDIOINSTANCES.
+     */
+    static bool setMaxRealVoices(int maxRealVoices);
+
+    /**
+     * Returns whether an audio instance is currently a virtual voice without an OpenAL source.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     */
+    static bool isVirtual(AUDIO_ID audioID);
+
     /**
      * Uncache the audio data from internal buffer.
      * AudioEngine cache audio data on ios,mac, and win32 platform.
@@ -452,6 +503,38 @@ public:
      */
     static void setReverbProperties(AUDIO_ID audioId, const ReverbProperties* reverbProperties);
 
+    /**
+     * Gets the streaming statistics of an audio instance.
+     *
+     * @param audioId   An audioID returned by the play2d function.
+     * @param stats     Receives the statistics.
+     * @return false if the audio instance doesn't exist or isn't streamed from disk.
+     */
+    static bool getStreamStats(AUDIO_ID audioId, AudioStreamStats& stats);
+
+    /**
+     * Whether audio files cached from now on keep their encoded bytes in memory instead of decoded pcm data.
+     *
+     * A compressed cache decodes into the small streaming queue buffers at play time, trading some decoding work
+     * for a much smaller memory footprint. Sounds shorter than the primed queue buffers are still decoded.
+     * Default is false.
+     */
+    static void setCompressedCacheEnabled(bool enabled) { _compressedCacheEnabled = enabled; }
+    static bool isCompressedCacheEnabled() { return _compressedCacheEnabled; }
+
+    /**
+     * Sets the memory budget of the decoded pcm caches, in bytes, 0 means unlimited.
+     *
+     * When the budget is exceeded, the least recently used caches which no audio instance plays are uncached.
+     */
+    static void setPcmCacheBudget(size_t budget) { _pcmCacheBudget = budget; }
+    static size_t getPcmCacheBudget() { return _pcmCacheBudget; }
+
+    /**
+     * Gets the memory statistics of the loaded audio caches.
+     */
+    static void getCacheStats(AudioCacheStats& stats);
+
 protected:
     static void addTask(const std::function<void()>& task);
     static void remove(AUDIO_ID audioID);
@@ -499,6 +582,12 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static unsigned int _maxRealVoices;
+
+    static bool _compressedCacheEnabled;
+
+    static size_t _pcmCacheBudget;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
@@ -27,6 +27,7 @@
 #include "axmol/audio/AudioEngineImpl.h"
 #include "axmol/audio/AudioDecoderManager.h"
 #include "axmol/audio/AudioEngine.h"
+#include "axmol/audio/AudioStreamService.h"
 #include "axmol/platform/FileUtils.h"
 #include "axmol/base/Director.h"
 #include "axmol/base/Scheduler.h"
@@ -313,9 +314,10 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
     for (const auto& e : s_instance->_audioPlayers)
     {
         player = e.second;
-        if (player->_alSource == sid && player->_streamingSource)
+        if (player->_alSource == sid && player->_streamService)
         {
-            player->wakeupRotateThread();
+            player->_streamService->wakeup();
+            break;
         }
     }
     s_instance->_threadMutex.unlock();
@@ -337,6 +339,8 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    AudioStreamService::destroyInstance();
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -504,9 +508,12 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     auto it = _audioCaches.find(filePath);
     if (it == _audioCaches.end())
     {
+        _trimPcmCaches();
+
         audioCache = new AudioCache();
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
         audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_compressed   = AudioEngine::_compressedCacheEnabled;
         unsigned int cacheId      = audioCache->_id;
         auto isCacheDestroyed     = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
@@ -523,6 +530,7 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     {
         audioCache = it->second.get();
     }
+    audioCache->_lastUsed = ++_cacheUseTick;
 
     if (audioCache && callback)
     {
@@ -531,18 +539,15 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
-AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
+AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time, int priority)
 {
     if (s_ALDevice == nullptr)
     {
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    ALuint alSource = findValidSource();
-    if (alSource == AL_INVALID)
-    {
-        return AudioEngine::INVALID_AUDIO_ID;
-    }
+    // beyond the real voice budget the audio starts as a virtual voice, see _updateVoices
+    ALuint alSource = getRealVoiceCount() < AudioEngine::_maxRealVoices ? findValidSource() : AL_INVALID;
 
     auto player = new AudioPlayer();
     if (player == nullptr)
@@ -550,10 +555,14 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    player->_alSource = alSource;
+    if (alSource != AL_INVALID)
+        player->_alSource = alSource;
+    else
+        player->_virtual = true;
     player->_loop     = loop;
     player->_volume   = volume;
     player->_pitch    = 1.0f;
+    player->_priority = priority;
     if (time > 0.0f)
     {
         player->_currTime  = time;
@@ -563,6 +572,8 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr)
     {
+        if (!player->_virtual)
+            _unusedSourcesPool.push(alSource);
         delete player;
         return AudioEngine::INVALID_AUDIO_ID;
     }
@@ -588,18 +599,16 @@ int AudioEngineImpl::play3d(std::string_view filePath,
                             float distanceScale,
                             bool loop,
                             float volume,
-                            float time)
+                            float time,
+                            int priority)
 {
     if (s_ALDevice == nullptr)
     {
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    ALuint alSource = findValidSource();
-    if (alSource == AL_INVALID)
-    {
-        return AudioEngine::INVALID_AUDIO_ID;
-    }
+    // beyond the real voice budget the audio starts as a virtual voice, see _updateVoices
+    ALuint alSource = getRealVoiceCount() < AudioEngine::_maxRealVoices ? findValidSource() : AL_INVALID;
 
     auto player = new AudioPlayer;
     if (player == nullptr)
@@ -607,12 +616,17 @@ int AudioEngineImpl::play3d(std::string_view filePath,
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    player->_alSource = alSource;
+    if (alSource != AL_INVALID)
+        player->_alSource = alSource;
+    else
+        player->_virtual = true;
     player->_loop     = loop;
     player->_volume   = volume;
     player->_pitch    = 1.0f;
+    player->_priority = priority;
     player->_sourcePosition.set(position);
     player->_distanceScale = distanceScale;
+    player->_is3d          = true;
     if (time > 0.0f)
     {
         player->_currTime  = time;
@@ -622,6 +636,8 @@ int AudioEngineImpl::play3d(std::string_view filePath,
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr)
     {
+        if (!player->_virtual)
+            _unusedSourcesPool.push(alSource);
         delete player;
         return AudioEngine::INVALID_AUDIO_ID;
     }
@@ -653,7 +669,14 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     // Note: It maybe in sub thread or main thread :(
     if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY)
     {
-        if (player->play2d())
+        // virtual voices start to play once _updateVoices promotes them
+        bool started = true;
+        if (player->_virtual)
+            player->_ready = true;
+        else
+            started = player->play2d();
+
+        if (started)
         {
             _scheduler->runOnAxmolThread([audioID]() {
                 if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
@@ -681,7 +704,14 @@ void AudioEngineImpl::_play3d(AudioCache* cache, int audioID)
     // Note: It maybe in sub thread or main thread :(
     if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY)
     {
-        if (player->play3d())
+        // virtual voices start to play once _updateVoices promotes them
+        bool started = true;
+        if (player->_virtual)
+            player->_ready = true;
+        else
+            started = player->play3d();
+
+        if (started)
         {
             _scheduler->runOnAxmolThread([audioID]() {
                 if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
@@ -710,6 +740,160 @@ ALuint AudioEngineImpl::findValidSource()
     return sourceId;
 }
 
+void AudioEngineImpl::_updateVoices(float dt)
+{
+    const auto maxRealVoices = AudioEngine::_maxRealVoices;
+    if (getRealVoiceCount() <= maxRealVoices &&
+        std::none_of(_audioPlayers.begin(), _audioPlayers.end(), [](auto&& e) { return e.second->_virtual; }))
+        return;
+
+    Vec3 listener;
+    alGetListener3f(AL_POSITION, &listener.x, &listener.y, &listener.z);
+
+    // real sources whose audio isn't playing yet can't be stolen
+    unsigned int busySources = 0;
+    _voiceRanking.clear();
+    for (auto&& e : _audioPlayers)
+    {
+        auto player = e.second;
+        if (player->_removeByAudioEngine)
+            continue;
+
+        if (player->_virtual)
+        {
+            if (!player->_ready || player->_virtualFinished)
+                continue;
+
+            if (!player->_paused)
+            {
+                const float duration = player->_audioCache->_duration;
+                player->_currTime += dt * player->_pitch;
+                if (player->_currTime >= duration)
+                {
+                    if (!player->_loop || duration <= 0.0f)
+                    {
+                        player->_virtualFinished = true;
+                        continue;
+                    }
+                    player->_currTime = std::fmod(player->_currTime, duration);
+                }
+            }
+        }
+        else if (!player->_ready || player->isFinished())
+        {
+            ++busySources;
+            continue;
+        }
+
+        float audibility = player->_volume;
+        if (player->_is3d)
+        {
+            // matches OpenAL's default AL_INVERSE_DISTANCE_CLAMPED model with a rolloff factor of 1
+            const float distance = player->_sourcePosition.distance(listener);
+            if (distance > player->_distanceScale && player->_distanceScale > 0.0f)
+                audibility *= player->_distanceScale / distance;
+        }
+        _voiceRanking.push_back(VoiceRank{e.first, player, audibility});
+    }
+
+    std::stable_sort(_voiceRanking.begin(), _voiceRanking.end(), [](const VoiceRank& lhs, const VoiceRank& rhs) {
+        if (lhs.player->_paused != rhs.player->_paused)
+            return !lhs.player->_paused;
+        if (lhs.player->_priority != rhs.player->_priority)
+            return lhs.player->_priority > rhs.player->_priority;
+        if (lhs.audibility != rhs.audibility)
+            return lhs.audibility > rhs.audibility;
+        // on a tie keep the voice which already owns a source, so equal voices don't swap every update
+        return !lhs.player->_virtual && rhs.player->_virtual;
+    });
+
+    const size_t realSlots = busySources < maxRealVoices ? maxRealVoices - busySources : 0;
+
+    // demote first, the released sources are reused by the promoted voices
+    for (size_t index = realSlots; index < _voiceRanking.size(); ++index)
+    {
+        auto& rank = _voiceRanking[index];
+        if (!rank.player->_virtual)
+            rank.player = _demoteVoice(rank.audioID, rank.player);
+    }
+
+    for (size_t index = 0; index < realSlots && index < _voiceRanking.size(); ++index)
+    {
+        auto player = _voiceRanking[index].player;
+        if (!player->_virtual || player->_paused)
+            continue;
+
+        ALuint alSource = findValidSource();
+        if (alSource == AL_INVALID)
+            break;
+        _promoteVoice(player, alSource);
+    }
+}
+
+void AudioEngineImpl::_promoteVoice(AudioPlayer* player, ALuint alSource)
+{
+    player->_alSource  = alSource;
+    player->_virtual   = false;
+    player->_ready     = false;
+    player->_timeDirty = player->_currTime > 0.0f;
+
+    // the player removes itself through _removeByAudioEngine on failure, which also returns the source
+    if (!(player->_is3d ? player->play3d() : player->play2d()))
+        return;
+
+    if (player->_pitch != 1.0f)
+        alSourcef(alSource, AL_PITCH, player->_pitch);
+    if (player->_panned)
+        _applyPan(player);
+#if AX_USE_ALSOFT
+    if (player->_hasReverb)
+        player->setReverbProperties(&player->_reverbProperties);
+#endif
+}
+
+AudioPlayer* AudioEngineImpl::_demoteVoice(AUDIO_ID audioID, AudioPlayer* player)
+{
+    // a stopped AudioPlayer can't be restarted, so the state moves to a new virtual one
+    auto voice = new AudioPlayer();
+    voice->setCache(player->_audioCache);
+    voice->_virtual        = true;
+    voice->_ready          = true;
+    voice->_paused         = player->_paused;
+    voice->_volume         = player->_volume;
+    voice->_pitch          = player->_pitch;
+    voice->_loop           = player->_loop;
+    voice->_pan            = player->_pan;
+    voice->_panned         = player->_panned;
+    voice->_sourcePosition = player->_sourcePosition;
+    voice->_distanceScale  = player->_distanceScale;
+    voice->_is3d           = player->_is3d;
+    voice->_priority       = player->_priority;
+    voice->_finishCallbak  = std::move(player->_finishCallbak);
+#if AX_USE_ALSOFT
+    voice->_hasReverb        = player->_hasReverb;
+    voice->_reverbProperties = player->_reverbProperties;
+#endif
+
+    if (player->_streamingSource)
+        voice->_currTime = player->getTime();
+    else
+        alGetSourcef(player->_alSource, AL_SEC_OFFSET, &voice->_currTime);
+
+    auto alSource = player->_alSource;
+    delete player;
+    _unusedSourcesPool.push(alSource);
+
+    _audioPlayers[audioID] = voice;
+    return voice;
+}
+
+bool AudioEngineImpl::isVirtual(AUDIO_ID audioID)
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioID);
+    return iter != _audioPlayers.end() && iter->second->_virtual;
+}
+
 void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
@@ -722,7 +906,7 @@ void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
 
     player->_volume = volume;
 
-    if (player->_ready)
+    if (player->_ready && !player->_virtual)
     {
         alSourcef(player->_alSource, AL_GAIN, volume);
 
@@ -746,7 +930,7 @@ void AudioEngineImpl::setPitch(AUDIO_ID audioID, float pitch)
 
     player->_pitch = pitch;
 
-    if (player->_ready)
+    if (player->_ready && !player->_virtual)
     {
         alSourcef(player->_alSource, AL_PITCH, pitch);
 
@@ -769,7 +953,7 @@ void AudioEngineImpl::setLoop(AUDIO_ID audioID, bool loop)
 
     lck.unlock();
 
-    if (player->_ready)
+    if (player->_ready && !player->_virtual)
     {
         if (player->_streamingSource)
         {
@@ -810,6 +994,12 @@ bool AudioEngineImpl::pause(AUDIO_ID audioID)
 
     lck.unlock();
 
+    if (player->_virtual)
+    {
+        player->_paused = true;
+        return true;
+    }
+
     bool ret = true;
     alSourcePause(player->_alSource);
 
@@ -819,6 +1009,10 @@ bool AudioEngineImpl::pause(AUDIO_ID audioID)
         ret = false;
         AXLOGE("{}: audio id = {}, error = {:#x}\n", __FUNCTION__, audioID, error);
     }
+    else
+    {
+        player->_paused = true;
+    }
 
     return ret;
 }
@@ -834,6 +1028,12 @@ bool AudioEngineImpl::resume(AUDIO_ID audioID)
     auto player = iter->second;
     lck.unlock();
 
+    if (player->_virtual)
+    {
+        player->_paused = false;
+        return true;
+    }
+
     alSourcePlay(player->_alSource);
 
     auto error = alGetError();
@@ -842,6 +1042,10 @@ bool AudioEngineImpl::resume(AUDIO_ID audioID)
         ret = false;
         AXLOGE("{}: audio id = {}, error = {:#x}\n", __FUNCTION__, audioID, error);
     }
+    else
+    {
+        player->_paused = false;
+    }
 
     return ret;
 }
@@ -905,7 +1109,7 @@ float AudioEngineImpl::getCurrentTime(AUDIO_ID audioID)
     auto player = it->second;
     if (player->_ready)
     {
-        if (player->_streamingSource)
+        if (player->_streamingSource || player->_virtual)
         {
             ret = player->getTime();
         }
@@ -946,7 +1150,7 @@ bool AudioEngineImpl::setCurrentTime(AUDIO_ID audioID, float time)
             break;
         }
 
-        if (player->_streamingSource)
+        if (player->_streamingSource || player->_virtual)
         {
             ret = player->setTime(time);
             break;
@@ -988,10 +1192,12 @@ void AudioEngineImpl::setFinishCallback(AUDIO_ID audioID,
     player->_finishCallbak = callback;
 }
 
-void AudioEngineImpl::update(float /*dt*/)
+void AudioEngineImpl::update(float dt)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    _updateVoices(dt);
     _updatePlayers(false);
+    _trimPcmCaches();
 }
 
 void AudioEngineImpl::setPan(AUDIO_ID audioId, float value, float distance)
@@ -1005,18 +1211,27 @@ void AudioEngineImpl::setPan(AUDIO_ID audioId, float value, float distance)
     lck.unlock();
 
     player->_sourcePosition.set(value, 0.0f, distance);
-    player->_pan = value;
+    player->_pan    = value;
+    player->_panned = true;
+
+    if (!player->_virtual)
+        _applyPan(player);
+}
+
+void AudioEngineImpl::_applyPan(AudioPlayer* player)
+{
+    const auto& position = player->_sourcePosition;
 
     alSourcei(player->_alSource, AL_SOURCE_RELATIVE, AL_TRUE);  // relative to listener
-    alSource3f(player->_alSource, AL_POSITION, value, 0.0f, distance);
+    alSource3f(player->_alSource, AL_POSITION, position.x, 0.0f, position.z);
     if (_stereoExtension)
     {
         // pan between -60 degrees when fully left (-1) and 60 degrees when fully right (1)
         auto angle = static_cast<float>(M_PI) / 6.f;
 
         float panAngles[2];
-        panAngles[0] = (1.0f - value) * angle;
-        panAngles[1] = (1.0f + value) * -angle;
+        panAngles[0] = (1.0f - player->_pan) * angle;
+        panAngles[1] = (1.0f + player->_pan) * -angle;
 
         alSourcefv(player->_alSource, AL_STEREO_ANGLES, panAngles);
     }
@@ -1060,7 +1275,8 @@ void AudioEngineImpl::setSourcePosition(int audioId, const ax::Vec3& position)
 
     player->_sourcePosition.set(position);
 
-    alSource3f(player->_alSource, AL_POSITION, position.x, position.y, position.z);
+    if (!player->_virtual)
+        alSource3f(player->_alSource, AL_POSITION, position.x, position.y, position.z);
 }
 
 void AudioEngineImpl::setListenerPosition(const ax::Vec3& position)
@@ -1090,6 +1306,87 @@ void AudioEngineImpl::setReverbProperties(AUDIO_ID audioId, const ReverbProperti
     player->setReverbProperties(reverbProperties);
 }
 
+bool AudioEngineImpl::getStreamStats(AUDIO_ID audioId, AudioStreamStats& stats)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioId);
+    if (iter == _audioPlayers.end())
+        return false;
+
+    auto player = iter->second;
+    if (!player->_streamingSource)
+        return false;
+
+    player->getStreamStats(stats);
+    return true;
+}
+
+void AudioEngineImpl::getCacheStats(AudioCacheStats& stats)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    for (auto&& item : _audioCaches)
+    {
+        auto cache = item.second.get();
+        if (cache->_state != AudioCache::State::READY)
+            continue;
+
+        if (cache->_pcmBytes > 0)
+        {
+            stats.pcmBytes += cache->_pcmBytes;
+            ++stats.pcmCaches;
+        }
+        if (cache->_compressedBytes > 0)
+        {
+            stats.compressedBytes += cache->_compressedBytes;
+            ++stats.compressedCaches;
+        }
+    }
+    stats.evictions = _pcmCacheEvictions;
+}
+
+void AudioEngineImpl::_trimPcmCaches()
+{
+    const auto budget = AudioEngine::_pcmCacheBudget;
+    if (budget == 0)
+        return;
+
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+
+    size_t pcmBytes = 0;
+    for (auto&& item : _audioCaches)
+    {
+        if (item.second->_state == AudioCache::State::READY)
+            pcmBytes += item.second->_pcmBytes;
+    }
+
+    while (pcmBytes > budget)
+    {
+        auto victim = _audioCaches.end();
+        for (auto it = _audioCaches.begin(); it != _audioCaches.end(); ++it)
+        {
+            auto cache = it->second.get();
+            // caches whose preload callbacks are still pending on the axmol thread are kept
+            if (cache->_state != AudioCache::State::READY || cache->_pcmBytes == 0 || !cache->_loadCallbacks.empty())
+                continue;
+            if (victim != _audioCaches.end() && victim->second->_lastUsed <= cache->_lastUsed)
+                continue;
+
+            auto inUse = std::any_of(_audioPlayers.begin(), _audioPlayers.end(),
+                                     [cache](const auto& player) { return player.second->_audioCache == cache; });
+            if (!inUse)
+                victim = it;
+        }
+
+        if (victim == _audioCaches.end())
+            break;
+
+        AXLOGV("Evict audio cache: {}, pcm bytes: {}", victim->second->_fileFullPath, victim->second->_pcmBytes);
+        pcmBytes -= victim->second->_pcmBytes;
+        ++_pcmCacheEvictions;
+        _audioCaches.erase(victim);
+    }
+}
+
 bool AudioEngineImpl::isExtensionPresent(const char* extensionId)
 {
     return alIsExtensionPresent(extensionId);
@@ -1118,8 +1415,9 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
             AudioEngine::remove(audioID);
 
             it = _audioPlayers.erase(it);
+            if (!player->_virtual)
+                _unusedSourcesPool.push(alSource);
             delete player;
-            _unusedSourcesPool.push(alSource);
         }
         else if (player->_ready && player->isFinished())
         {
@@ -1146,8 +1444,9 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
             }
             // clear cache when audio player finsihed properly
             player->setCache(nullptr);
+            if (!player->_virtual)
+                _unusedSourcesPool.push(alSource);
             delete player;
-            _unusedSourcesPool.push(alSource);
         }
         else
         {
@@ -47,13 +47,14 @@ public:
     ~AudioEngineImpl();
 
     bool init();
-    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time);
+    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time, int priority);
     AUDIO_ID play3d(std::string_view fileFullPath,
                     const Vec3& position,
                     float distanceScale,
                     bool loop,
                     float volume,
-                    float time);
+                    float time,
+                    int priority);
     void setVolume(AUDIO_ID audioID, float volume);
     void setPitch(AUDIO_ID audioID, float pitch);
     void setLoop(AUDIO_ID audioID, bool loop);
@@ -72,6 +73,9 @@ public:
     void setListenerPosition(const ax::Vec3& position);
     ax::Vec3 getListenerPosition();
     void setReverbProperties(AUDIO_ID audioId, const ReverbProperties* reverbProperties);
+    bool getStreamStats(AUDIO_ID audioId, AudioStreamStats& stats);
+    void getCacheStats(AudioCacheStats& stats);
+    bool isVirtual(AUDIO_ID audioID);
 
     void uncache(std::string_view filePath);
     void uncacheAll();
@@ -88,6 +92,19 @@ private:
     void _play3d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
     ALuint findValidSource();
+    unsigned int getRealVoiceCount() const
+    {
+        return static_cast<unsigned int>(MAX_AUDIOINSTANCES - _unusedSourcesPool.size());
+    }
+
+    // keeps the highest priority, then loudest, voices on real sources within AudioEngine::_maxRealVoices
+    void _updateVoices(float dt);
+    void _promoteVoice(AudioPlayer* player, ALuint alSource);
+    AudioPlayer* _demoteVoice(AUDIO_ID audioID, AudioPlayer* player);
+    void _applyPan(AudioPlayer* player);
+
+    // uncaches the least recently used pcm caches no player uses until AudioEngine::_pcmCacheBudget is met
+    void _trimPcmCaches();
 #if defined(__APPLE__) && !AX_USE_ALSOFT
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
 #endif
@@ -106,6 +123,17 @@ private:
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
+    struct VoiceRank
+    {
+        AUDIO_ID audioID;
+        AudioPlayer* player;
+        float audibility;
+    };
+    std::vector<VoiceRank> _voiceRanking;
+
+    uint64_t _cacheUseTick{0};
+    unsigned int _pcmCacheEvictions{0};
+
     bool _scheduled;
 
     AUDIO_ID _currentAudioID;
@@ -28,13 +28,14 @@
 #include "axmol/audio/AudioCache.h"
 #include "axmol/audio/AudioDecoder.h"
 #include "axmol/audio/AudioDecoderManager.h"
+#include "axmol/audio/AudioStreamService.h"
 #include "axmol/platform/FileUtils.h"
 
 #if AX_USE_ALSOFT
 #    include "axmol/audio/AudioEffectsExtension.h"
 #endif
 
-#include "yasio/thread_name.hpp"
+#include <chrono>
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS && !AX_USE_ALSOFT
 extern bool __axmolAudioSessionInterrupted;
@@ -48,12 +49,7 @@ namespace
 unsigned int __playerIdIndex = 0;
 }
 
-AudioPlayer::AudioPlayer()
-    : _id(++__playerIdIndex)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
-{}
+AudioPlayer::AudioPlayer() : _id(++__playerIdIndex) {}
 
 AudioPlayer::~AudioPlayer()
 {
@@ -94,22 +90,11 @@ void AudioPlayer::stop()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
+            if (_streamService != nullptr)
             {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                AXLOGV("{}", "rotateBufferThread exited!");
+                _streamService->removePlayer(this);
+                _streamService = nullptr;
+                AXLOGV("{}", "stream removed from audio stream service!");
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS && !AX_USE_ALSOFT
                 // some specific OpenAL implement defects existed on iOS platform
@@ -153,14 +138,17 @@ void AudioPlayer::stop()
         }
     } while (false);
 
-    clearEffects();
+    if (!_virtual)
+    {
+        clearEffects();
 
-    AXLOGV("{}", "Before alSourceStop");
-    alSourceStop(_alSource);
-    CHECK_AL_ERROR_DEBUG();
-    AXLOGV("{}", "Before alSourcei");
-    alSourcei(_alSource, AL_BUFFER, 0);
-    CHECK_AL_ERROR_DEBUG();
+        AXLOGV("{}", "Before alSourceStop");
+        alSourceStop(_alSource);
+        CHECK_AL_ERROR_DEBUG();
+        AXLOGV("{}", "Before alSourcei");
+        alSourcei(_alSource, AL_BUFFER, 0);
+        CHECK_AL_ERROR_DEBUG();
+    }
 
     _removeByAudioEngine = true;
 
@@ -232,27 +220,23 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_stopping)
-                break;
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+            _streamOffsetFrame = _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1;
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
+        }
 
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
+        alSourcePlay(_alSource);
 
-            alSourcePlay(_alSource);
-        }
+        if (_streamingSource)
+            AudioStreamService::getInstance()->addPlayer(this);
 
         auto alError = alGetError();
         if (alError != AL_NO_ERROR)
@@ -354,27 +338,23 @@ bool AudioPlayer::play3d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_stopping)
-                break;
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+            _streamOffsetFrame = _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1;
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
+        }
 
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
+        alSourcePlay(_alSource);
 
-            alSourcePlay(_alSource);
-        }
+        if (_streamingSource)
+            AudioStreamService::getInstance()->addPlayer(this);
 
         auto alError = alGetError();
         if (alError != AL_NO_ERROR)
@@ -434,158 +414,164 @@ void AudioPlayer::clearEffects()
 #endif
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+bool AudioPlayer::openStream()
 {
-    yasio::set_thread_name("axmol-audio");
+    if (_streamDecoder != nullptr)
+        return true;
 
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+    if (_isStreamFinished)
+        return false;
+
+    auto& fullPath = _audioCache->_fileFullPath;
+    _streamDecoder = AudioDecoderManager::createDecoder(fullPath);
+    if (_streamDecoder == nullptr || !_streamDecoder->open(fullPath))
+        return false;
+
+    const uint32_t bufferSize = _streamDecoder->framesToBytes(_audioCache->_queBufferFrames);
+    _streamBuffer             = (char*)malloc(bufferSize);
+    memset(_streamBuffer, 0, bufferSize);
+
+    if (_streamOffsetFrame != 0)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
+        _streamDecoder->seek(_streamOffsetFrame);
+    }
+
+    return true;
+}
 
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
+// updateStream is used to rotate alBufferData for _alSource when playing big audio file, returns false once the
+// stream is finished
+bool AudioPlayer::updateStream(ALint bufferProcessed)
+{
+    auto decoder                = _streamDecoder;
+    const uint32_t framesToRead = _audioCache->_queBufferFrames;
 #if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
+    const auto sourceFormat = decoder->getSourceFormat();
 #endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
 
-        if (offsetFrame != 0)
-        {
-            decoder->seek(offsetFrame);
-        }
+    ALint sourceState;
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PAUSED)
+        return true;
 
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
+    /* Make sure the source hasn't underrun */
+    bool needToRestart = false;
+    if (sourceState != AL_PLAYING)
+    {
+        ALint queued;
 
-        while (!_stopping)
-        {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
-            {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
-                {
-                    bufferProcessed--;
-                    if (_timeDirty)
-                    {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
-                        decoder->seek(offsetFrame);
-                    }
-                    else
-                    {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
+        /* If no buffers are queued, playback is finished */
+        alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+            return false;
 
-                    auto framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
+        ++_streamStats.underruns;
+        needToRestart = true;
+    }
 
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
-                }
-            }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
+    while (bufferProcessed > 0)
+    {
+        bufferProcessed--;
+        if (_timeDirty)
+        {
+            _timeDirty         = false;
+            _streamOffsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
+            decoder->seek(_streamOffsetFrame);
+        }
+        else
+        {
+            _currTime += QUEUEBUFFER_TIME_STEP;
+            if (_currTime > _audioCache->_duration)
             {
-                ALint queued;
-
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
+                if (_loop)
                 {
-                    needToExitThread = true;
+                    _currTime = 0.0f;
                 }
                 else
                 {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        AXLOGE("{}", "Error restarting playback!");
-                        needToExitThread = true;
-                    }
+                    _currTime = _audioCache->_duration;
                 }
             }
+        }
 
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_stopping || needToExitThread)
+        auto decodeStart = std::chrono::steady_clock::now();
+        auto framesRead  = decoder->readFixedFrames(framesToRead, _streamBuffer);
+
+        if (framesRead == 0)
+        {
+            if (_loop)
             {
-                break;
+                decoder->seek(0);
+                framesRead = decoder->readFixedFrames(framesToRead, _streamBuffer);
             }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
+            else
             {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+                return false;
             }
+        }
 
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+        auto decodeTimeMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+        _streamStats.decodeTimeMs += decodeTimeMs;
+        if (decodeTimeMs > _streamStats.maxDecodeTimeMs)
+            _streamStats.maxDecodeTimeMs = decodeTimeMs;
+
+        /*
+         While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+         already played. Those buffers can then be filled with new data or discarded. New or refilled
+         buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+         always a new buffer to play in the queue, the source will continue to play.
+         */
+        ALuint bid;
+        alSourceUnqueueBuffers(_alSource, 1, &bid);
+#if AX_USE_ALSOFT
+        if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+            alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
 #endif
+        alBufferData(bid, _audioCache->_format, _streamBuffer, decoder->framesToBytes(framesRead),
+                     decoder->getSampleRate());
+        alSourceQueueBuffers(_alSource, 1, &bid);
+        ++_streamStats.buffersQueued;
+    }
+
+    // restart only after the consumed buffers were refilled, otherwise the stale ones would be played again
+    if (needToRestart)
+    {
+        alSourcePlay(_alSource);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            AXLOGE("{}", "Error restarting playback!");
+            return false;
         }
+    }
 
-    } while (false);
+    return true;
+}
 
-    AXLOGV("{}", "Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+void AudioPlayer::closeStream()
+{
+    AXLOGV("Close audio stream, player id={}", _id);
+    AudioDecoderManager::destroyDecoder(_streamDecoder);
+    _streamDecoder = nullptr;
+    free(_streamBuffer);
+    _streamBuffer     = nullptr;
+    _isStreamFinished = true;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::getStreamStats(AudioStreamStats& stats)
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    if (_streamService != nullptr)
+        _streamService->runLocked([&] { stats = _streamStats; });
+    else
+        stats = _streamStats;
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
+    if (_virtual)
+        return _virtualFinished;
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _isStreamFinished;
     else
     {
         ALint sourceState;
@@ -597,6 +583,15 @@ bool AudioPlayer::isFinished() const
 void AudioPlayer::setReverbProperties(const ReverbProperties* reverbProperties)
 {
 #if AX_USE_ALSOFT
+    _hasReverb = reverbProperties != nullptr;
+    if (_virtual)
+    {
+        // applied when the voice is promoted to a real source
+        if (reverbProperties)
+            _reverbProperties = *reverbProperties;
+        return;
+    }
+
     auto&& efx = AudioEffectsExtension::getInstance();
 
     if (!efx->isAvailable())
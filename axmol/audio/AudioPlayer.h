@@ -27,24 +27,26 @@
 #pragma once
 
 #include <string>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
 #include <atomic>
 
 #include "axmol/audio/AudioMacros.h"
 #include "axmol/audio/AudioEffects.h"
+#include "axmol/audio/AudioEngine.h"
 #include "axmol/math/Vec3.h"
 
 namespace ax
 {
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
+class AudioStreamService;
 
 class AX_DLL AudioPlayer
 {
     friend class AudioEngineImpl;
+    friend class AudioStreamService;
 
 public:
     AudioPlayer();
@@ -61,16 +63,19 @@ public:
 
     void setReverbProperties(const ReverbProperties* reverbProperties);
 
+    void getStreamStats(AudioStreamStats& stats);
+
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
     bool play3d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
     void clearEffects();
 
+    // streaming helpers, only called by AudioStreamService with its lock held
+    bool openStream();
+    bool updateStream(ALint bufferProcessed);
+    void closeStream();
+
     AudioCache* _audioCache{nullptr};
 
     float _volume{1.0f};
@@ -95,20 +100,28 @@ protected:
 
     bool _streamingSource{false};
     bool _timeDirty{false};
-    bool _isRotateThreadExited{false};
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    std::atomic_bool _isStreamFinished{false};
+
+    // virtual voices track their state without an OpenAL source until AudioEngineImpl promotes them
+    bool _virtual{false};
+    bool _virtualFinished{false};
+    bool _paused{false};
+    bool _panned{false};
+    bool _is3d{false};
+    int _priority{0};
 
 #if AX_USE_ALSOFT
     ReverbProperties _reverbProperties;
+    bool _hasReverb{false};
 #endif
     uint32_t _reverbSlot{};
     uint32_t _reverbEffect{};
 
-    std::thread* _rotateBufferThread{nullptr};
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    AudioStreamService* _streamService{nullptr};
+    AudioDecoder* _streamDecoder{nullptr};
+    char* _streamBuffer{nullptr};
+    int _streamOffsetFrame{0};
+    AudioStreamStats _streamStats;
 
     std::mutex _play2dMutex;
     std::function<void(AUDIO_ID, std::string_view)> _finishCallbak;
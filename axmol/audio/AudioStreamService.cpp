@@ -0,0 +1,155 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "axmol/audio/AudioStreamService.h"
+#include "axmol/audio/AudioPlayer.h"
+
+#include <algorithm>
+
+#include "yasio/thread_name.hpp"
+
+namespace ax
+{
+
+static AudioStreamService* s_streamService = nullptr;
+
+AudioStreamService* AudioStreamService::getInstance()
+{
+    if (!s_streamService)
+        s_streamService = new AudioStreamService();
+    return s_streamService;
+}
+
+void AudioStreamService::destroyInstance()
+{
+    delete s_streamService;
+    s_streamService = nullptr;
+}
+
+AudioStreamService::~AudioStreamService()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _exitRequested = true;
+    }
+    _wakeupCondition.notify_one();
+
+    if (_thread.joinable())
+        _thread.join();
+
+    // players still registered here were never stopped, release their decoders while the AL context is alive
+    for (auto player : _players)
+    {
+        player->closeStream();
+        player->_streamService = nullptr;
+    }
+    _players.clear();
+}
+
+void AudioStreamService::addPlayer(AudioPlayer* player)
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _players.emplace_back(player);
+        player->_streamService = this;
+
+        if (!_thread.joinable())
+            _thread = std::thread(&AudioStreamService::serviceThread, this);
+    }
+    wakeup();
+}
+
+void AudioStreamService::removePlayer(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    auto it = std::find(_players.begin(), _players.end(), player);
+    if (it != _players.end())
+    {
+        _players.erase(it);
+        player->closeStream();
+    }
+}
+
+void AudioStreamService::wakeup()
+{
+    _wakeupRequested = true;
+    _wakeupCondition.notify_one();
+}
+
+void AudioStreamService::serviceThread()
+{
+    yasio::set_thread_name("axmol-audio");
+
+    const auto sleepTime = std::chrono::milliseconds(static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2);
+
+    std::unique_lock<std::mutex> lck(_mutex);
+    while (!_exitRequested)
+    {
+        _refillQueue.clear();
+        for (auto it = _players.begin(); it != _players.end();)
+        {
+            auto player = *it;
+            if (!player->_stopping && player->openStream())
+            {
+                ALint bufferProcessed = 0;
+                alGetSourcei(player->_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+                _refillQueue.emplace_back(bufferProcessed, player);
+                ++it;
+            }
+            else
+            {
+                player->closeStream();
+                it = _players.erase(it);
+            }
+        }
+
+        // the most drained sources are the closest to an underrun, refill them first
+        std::stable_sort(_refillQueue.begin(), _refillQueue.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+        for (auto&& item : _refillQueue)
+        {
+            auto player = item.second;
+            if (!player->_stopping && player->updateStream(item.first))
+                continue;
+
+            player->closeStream();
+            _players.erase(std::find(_players.begin(), _players.end(), player));
+        }
+
+        if (_exitRequested)
+            break;
+
+        if (_players.empty())
+            _wakeupCondition.wait(lck, [this] { return _exitRequested || !_players.empty(); });
+        else if (!_wakeupRequested)
+            _wakeupCondition.wait_for(lck, sleepTime);
+
+        _wakeupRequested = false;
+    }
+
+    AXLOGV("{}", "Exit audio stream service thread ...");
+}
+
+}  // namespace ax
@@ -0,0 +1,87 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "axmol/audio/oal_port.h"
+
+namespace ax
+{
+
+class AudioPlayer;
+
+/**
+ * Refills the queued OpenAL buffers of every streaming AudioPlayer from a single thread.
+ *
+ * Each pass asks all registered sources how many buffers they have consumed and services the most
+ * drained ones first, so a source that is about to underrun is never starved by a busy neighbour.
+ * Decode-ahead is bounded by QUEUEBUFFER_NUM buffers per stream.
+ */
+class AudioStreamService
+{
+public:
+    static AudioStreamService* getInstance();
+    static void destroyInstance();
+
+    void addPlayer(AudioPlayer* player);
+
+    /** Unregisters the player and waits for any pass that is still servicing it. */
+    void removePlayer(AudioPlayer* player);
+
+    /** Wakes the service before its next scheduled pass, e.g. from a buffer processed notification. */
+    void wakeup();
+
+    /** Runs a callable while no pass is in progress, used to read the stream stats consistently. */
+    template <typename _Fty>
+    void runLocked(const _Fty& func)
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        func();
+    }
+
+private:
+    AudioStreamService() = default;
+    ~AudioStreamService();
+
+    void serviceThread();
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _wakeupCondition;
+    std::atomic_bool _wakeupRequested{false};
+    bool _exitRequested{false};
+
+    std::vector<AudioPlayer*> _players;
+    // processed buffer count, player; rebuilt each pass
+    std::vector<std::pair<ALint, AudioPlayer*>> _refillQueue;
+};
+
+}  // namespace ax
@@ -67,6 +67,11 @@
 #    define MAX_AUDIOINSTANCES 128
 #endif
 
+// upper bound of audio instances including virtual voices which don't hold an OpenAL source
+#ifndef MAX_VIRTUAL_AUDIOINSTANCES
+#    define MAX_VIRTUAL_AUDIOINSTANCES 1024
+#endif
+
 #if !AX_USE_ALSOFT
 
 // define dummy efx macros and consts used in axmol audio effect implementation
@@ -1131,12 +1131,13 @@ void Director::reset()
     // purge all managed caches
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
+    // before FileUtils, its last commit may still be written
+    UserDefault::destroyInstance();
     FileUtils::destroyInstance();
 
     ProgramStateRegistry::destroyInstance();
 
     // axmol specific data structures
-    UserDefault::destroyInstance();
     resetMatrixStack();
 
     destroyTextureCache();
@@ -102,12 +102,16 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /** The number of worker threads, 0 when the tasks run on the calling thread. */
+    int getThreadCount() const { return _threadCount; }
+
 protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
 private:
     JobExecutor* _executor{nullptr};
     JobThreadData* _mainThreadData{nullptr};
+    int _threadCount{0};
 };
 
 }  // namespace ax
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #if defined(_WIN32)
 #    include <io.h>
 #    include <direct.h>
+#    include "ntcvt/ntcvt.hpp"
 #else
 #    include <unistd.h>
 #    include <errno.h>
@@ -52,14 +53,28 @@ THE SOFTWARE.
 #include "axmol/base/Utils.h"
 
 #include "axmol/tlx/format.hpp"
+#include "yasio/thread_name.hpp"
+#include "xxhash/xxhash.h"
 
 #define USER_DEFAULT_PLAIN_MODE 0
 
+// the storage is UD_HEADER followed by commits, each a frame of ops: payload length, XXH32 of the payload, payload
+#define UD_HEADER_SIZE       8
+#define UD_FRAME_HEADER_SIZE 8
+
 typedef int32_t udflen_t;
 
 namespace ax
 {
 
+static const char UD_HEADER[UD_HEADER_SIZE] = {'A', 'X', 'U', 'D', 0, 0, 0, 2};
+
+enum UDOp : uint8_t
+{
+    UD_OP_SET = 1,
+    UD_OP_DELETE,
+};
+
 /**
  * implements of UserDefault
  */
@@ -84,15 +99,6 @@ static void ud_setkey(std::string& lhs, const std::string_view& rhs)
         lhs.assign(keyLen, '\0');
 }
 
-static void ud_write_v_s(UserDefault* ud, yasio::obstream& obs, const std::string_view value)
-{
-    size_t value_offset = obs.length();
-    obs.write_v(value);
-    value_offset += (obs.length() - value_offset - value.length());
-    if (!value.empty())
-        ud->encrypt(obs.data() + value_offset, value.length(), AES_ENCRYPT);
-}
-
 void UserDefault::setEncryptEnabled(bool enabled, std::string_view key, std::string_view iv)
 {
     _encryptEnabled = enabled;
@@ -126,18 +132,24 @@ void UserDefault::encrypt(char* inout, size_t size, int enc)
 
 UserDefault::~UserDefault()
 {
-    closeFileMapping();
+    // an unfinished transaction is all or none, drop it rather than persist part of it
+    if (_transactionDepth > 0)
+        _pendingOps.clear();
+    else
+        commit();
+    stopWriter();
+    closeStorage();
 }
 
 UserDefault::UserDefault() {}
 
-void UserDefault::closeFileMapping()
+void UserDefault::closeStorage()
 {
-    _rwmmap.reset();
 #if !USER_DEFAULT_PLAIN_MODE
     if (_fileStream.isOpen())
         _fileStream.close();
 #endif
+    _persistent = false;
 }
 
 bool UserDefault::getBoolForKey(const char* pKey)
@@ -148,10 +160,20 @@ bool UserDefault::getBoolForKey(const char* pKey)
 bool UserDefault::getBoolForKey(const char* pKey, bool defaultValue)
 {
     auto pValue = getValueForKey(pKey);
-    if (pValue)
-        return *pValue == "true";
+    if (!pValue)
+        return defaultValue;
 
-    return defaultValue;
+    switch (pValue->type)
+    {
+    case ValueType::Bool:
+        return pValue->boolValue;
+    case ValueType::Integer:
+        return pValue->intValue != 0;
+    case ValueType::Double:
+        return pValue->doubleValue != 0;
+    default:
+        return pValue->stringValue == "true";
+    }
 }
 
 int UserDefault::getIntegerForKey(const char* pKey)
@@ -162,10 +184,20 @@ int UserDefault::getIntegerForKey(const char* pKey)
 int UserDefault::getIntegerForKey(const char* pKey, int defaultValue)
 {
     auto pValue = getValueForKey(pKey);
-    if (pValue)
-        return atoi(pValue->c_str());
+    if (!pValue)
+        return defaultValue;
 
-    return defaultValue;
+    switch (pValue->type)
+    {
+    case ValueType::Bool:
+        return pValue->boolValue;
+    case ValueType::Integer:
+        return static_cast<int>(pValue->intValue);
+    case ValueType::Double:
+        return static_cast<int>(pValue->doubleValue);
+    default:
+        return atoi(pValue->stringValue.c_str());
+    }
 }
 
 int64_t UserDefault::getLargeIntForKey(const char* key)
@@ -176,10 +208,20 @@ int64_t UserDefault::getLargeIntForKey(const char* key)
 int64_t UserDefault::getLargeIntForKey(const char* key, int64_t defaultValue)
 {
     auto pValue = getValueForKey(key);
-    if (pValue)
-        return std::stoll(pValue->c_str());
+    if (!pValue)
+        return defaultValue;
 
-    return defaultValue;
+    switch (pValue->type)
+    {
+    case ValueType::Bool:
+        return pValue->boolValue;
+    case ValueType::Integer:
+        return pValue->intValue;
+    case ValueType::Double:
+        return static_cast<int64_t>(pValue->doubleValue);
+    default:
+        return strtoll(pValue->stringValue.c_str(), nullptr, 10);
+    }
 }
 
 float UserDefault::getFloatForKey(const char* pKey)
@@ -200,10 +242,20 @@ double UserDefault::getDoubleForKey(const char* pKey)
 double UserDefault::getDoubleForKey(const char* pKey, double defaultValue)
 {
     auto pValue = getValueForKey(pKey);
-    if (pValue)
-        return utils::atof(*pValue);
+    if (!pValue)
+        return defaultValue;
 
-    return defaultValue;
+    switch (pValue->type)
+    {
+    case ValueType::Bool:
+        return pValue->boolValue;
+    case ValueType::Integer:
+        return static_cast<double>(pValue->intValue);
+    case ValueType::Double:
+        return pValue->doubleValue;
+    default:
+        return utils::atof(pValue->stringValue);
+    }
 }
 
 std::string_view UserDefault::getStringForKey(const char* pKey)
@@ -215,26 +267,53 @@ std::string_view UserDefault::getStringForKey(const char* pKey, std::string_view
 {
     auto pValue = getValueForKey(pKey);
     if (pValue)
-        return *pValue;
+        return getValueText(*pValue);
 
     return defaultValue;
 }
 
-const std::string* UserDefault::getValueForKey(std::string_view key)
+std::string_view UserDefault::getValueText(Value& value)
+{
+    if (value.type != ValueType::String && value.stringValue.empty())
+    {
+        switch (value.type)
+        {
+        case ValueType::Bool:
+            value.stringValue = value.boolValue ? "true" : "false";
+            break;
+        case ValueType::Integer:
+            value.stringValue = fmt::format("{}", value.intValue);
+            break;
+        default:
+            value.stringValue = fmt::format("{}", value.doubleValue);
+        }
+    }
+    return value.stringValue;
+}
+
+UserDefault::Value* UserDefault::getValueForKey(std::string_view key)
 {
     // do lazyInit at here to make sure _encryptEnabled works well,
     lazyInit();
 
     auto it = this->_values.find(key);
     if (it != this->_values.end())
-        return &it->second;
+        return &it.value();
     return nullptr;
 }
 
 void UserDefault::setBoolForKey(const char* pKey, bool value)
 {
-    // save bool value as string
-    setStringForKey(pKey, value ? "true" : "false");
+    // check key
+    if (!pKey)
+    {
+        return;
+    }
+
+    Value v;
+    v.type      = ValueType::Bool;
+    v.boolValue = value;
+    setValueForKey(pKey, std::move(v));
 }
 
 void UserDefault::setIntegerForKey(const char* pKey, int value)
@@ -245,25 +324,24 @@ void UserDefault::setIntegerForKey(const char* pKey, int value)
         return;
     }
 
-    // format the value
-    char tmp[50];
-    auto svalue = fmt::format_to_z(tmp, "{}", value);
-
-    setStringForKey(pKey, svalue);
+    Value v;
+    v.type     = ValueType::Integer;
+    v.intValue = value;
+    setValueForKey(pKey, std::move(v));
 }
 
 void UserDefault::setLargeIntForKey(const char* pKey, int64_t value)
-{  // check key
+{
+    // check key
     if (!pKey)
     {
         return;
     }
 
-    // format the value
-    char tmp[96];
-    auto svalue = fmt::format_to_z(tmp, "{}", value);
-
-    setStringForKey(pKey, svalue);
+    Value v;
+    v.type     = ValueType::Integer;
+    v.intValue = value;
+    setValueForKey(pKey, std::move(v));
 }
 
 void UserDefault::setFloatForKey(const char* pKey, float value)
@@ -279,72 +357,305 @@ void UserDefault::setDoubleForKey(const char* pKey, double value)
         return;
     }
 
-    // format the value
-    char tmp[50];
-    auto svalue = fmt::format_to_z(tmp, "{}", value);
-
-    setStringForKey(pKey, svalue);
+    Value v;
+    v.type        = ValueType::Double;
+    v.doubleValue = value;
+    setValueForKey(pKey, std::move(v));
 }
 
 void UserDefault::setStringForKey(const char* pKey, std::string_view value)
 {
-    // ignore empty key
-    if (!pKey || !*pKey)
+    // check key
+    if (!pKey)
     {
         return;
     }
 
-    setValueForKey(pKey, value);
+    Value v;
+    v.stringValue = value;
+    setValueForKey(pKey, std::move(v));
+}
+
+void UserDefault::setValueForKey(std::string_view key, Value&& value)
+{
+    // ignore empty key
+    if (key.empty())
+        return;
+
+    // do lazyInit at here to make sure _encryptEnabled works well
+    lazyInit();
 
+    writeOp(UD_OP_SET, key, &value);
+    updateValueForKey(key, std::move(value));
+    commit();
+}
+
+void UserDefault::updateValueForKey(std::string_view key, Value&& value)
+{
+    auto it = _values.find(key);
+    if (it != _values.end())
+        it.value() = std::move(value);
+    else
+        _values.emplace(key, std::move(value));
+}
+
+void UserDefault::beginTransaction()
+{
+    ++_transactionDepth;
+}
+
+void UserDefault::commitTransaction()
+{
+    AXASSERT(_transactionDepth > 0, "UserDefault::commitTransaction without beginTransaction");
+    if (_transactionDepth > 0 && --_transactionDepth == 0)
+        commit();
+}
+
+void UserDefault::writeOp(uint8_t op, std::string_view key, const Value* value)
+{
 #if !USER_DEFAULT_PLAIN_MODE
-    if (_rwmmap)
+    if (!_persistent)
+        return;
+
+    if (_pendingOps.empty())
+        _pendingOps.fill_bytes(UD_FRAME_HEADER_SIZE);
+
+    _pendingOps.write<uint8_t>(op);
+    _pendingOps.write_v(key);
+    if (value)
     {
-        yasio::obstream obs;
-        if (_encryptEnabled)
+        _pendingOps.write<uint8_t>(static_cast<uint8_t>(value->type));
+        switch (value->type)
         {
-            ud_write_v_s(this, obs, pKey);
-            ud_write_v_s(this, obs, value);
+        case ValueType::Bool:
+            _pendingOps.write<uint8_t>(value->boolValue);
+            break;
+        case ValueType::Integer:
+            _pendingOps.write<int64_t>(value->intValue);
+            break;
+        case ValueType::Double:
+            _pendingOps.write<double>(value->doubleValue);
+            break;
+        default:
+            _pendingOps.write_v(value->stringValue);
         }
-        else
+    }
+#else
+    // the xml is rewritten on commit, just mark it dirty
+    _pendingOps.write<uint8_t>(op);
+#endif
+}
+
+void UserDefault::commit()
+{
+    if (_transactionDepth > 0 || _pendingOps.empty())
+        return;
+
+#if !USER_DEFAULT_PLAIN_MODE
+    auto frame = finishFrame();
+    ++_stats.commits;
+    _stats.journalSize += frame.size();
+
+    // once the journal is mostly overwritten history, replace it with the live values
+    WriteJob job{std::move(frame), false};
+    if (_stats.journalSize > _compactThreshold && _stats.journalSize > 2 * _snapshotSize)
+    {
+        job.commit         = std::move(job.data);
+        job.data           = makeSnapshot();
+        job.snapshot       = true;
+        _snapshotSize      = UD_HEADER_SIZE + job.data.size();
+        _stats.journalSize = _snapshotSize;
+        ++_stats.compactions;
+    }
+    queueWrite(std::move(job));
+#else
+    _pendingOps.clear();
+
+    pugi::xml_document doc;
+    doc.load_string(R"(<?xml version="1.0" ?>
+<r />)");
+    auto r = doc.document_element();
+    for (auto it = _values.begin(); it != _values.end(); ++it)
+        r.append_child(it->first.c_str())
+            .append_child(pugi::xml_node_type::node_pcdata)
+            .set_value(getValueText(it.value()).data());
+
+    FileUtils::getInstance()->writeXmlDocToFile(doc, _filePath);
+#endif
+}
+
+tlx::sbyte_buffer UserDefault::finishFrame()
+{
+    auto payload     = _pendingOps.data() + UD_FRAME_HEADER_SIZE;
+    auto payloadSize = _pendingOps.length() - UD_FRAME_HEADER_SIZE;
+    if (_encryptEnabled)
+        encrypt(payload, payloadSize, AES_ENCRYPT);
+    _pendingOps.pwrite(0, static_cast<uint32_t>(payloadSize));
+    _pendingOps.pwrite(4, static_cast<uint32_t>(XXH32(payload, payloadSize, 0)));
+
+    tlx::sbyte_buffer frame = std::move(_pendingOps.buffer());
+    _pendingOps.clear();
+    return frame;
+}
+
+tlx::sbyte_buffer UserDefault::makeSnapshot()
+{
+    _pendingOps.fill_bytes(UD_FRAME_HEADER_SIZE);
+    for (auto&& item : _values)
+        writeOp(UD_OP_SET, item.first, &item.second);
+    return finishFrame();
+}
+
+void UserDefault::queueWrite(WriteJob&& job)
+{
+    if (!_writeBehindEnabled)
+    {
+        std::vector<WriteJob> jobs;
+        jobs.emplace_back(std::move(job));
+        writeJobs(jobs);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(_writeMtx);
+        _writeQueue.emplace_back(std::move(job));
+        if (!_writer.joinable())
+            _writer = std::thread(&UserDefault::writerThread, this);
+    }
+    _writeCondition.notify_one();
+}
+
+void UserDefault::writeJobs(std::vector<WriteJob>& jobs)
+{
+    // a snapshot already contains every commit queued before it, the latest one is tried first
+    auto it = jobs.begin();
+    for (auto snapshot = jobs.rbegin(); snapshot != jobs.rend(); ++snapshot)
+    {
+        if (snapshot->snapshot)
         {
-            obs.write_v(pKey);
-            obs.write_v(value);
+            it = std::prev(snapshot.base());
+            break;
         }
+    }
 
-        if ((_realSize + obs.length() + sizeof(udflen_t)) < _curMapSize)
-        {  // fast append entity without flush
-            // increase entities count
-            yasio::obstream::swrite(_rwmmap->data(), 1 + yasio::ibstream::sread<udflen_t>(_rwmmap->data()));
-
-            // append entity
-            ::memcpy(_rwmmap->data() + sizeof(udflen_t) + _realSize, obs.data(), obs.length());
-            _realSize += static_cast<int>(obs.length());
+    for (; it != jobs.end(); ++it)
+    {
+        if (!it->snapshot)
+        {
+            appendFrame(it->data);
         }
-        else
+        else if (!writeSnapshotFile(it->data))
         {
-            flush();
+            // the journal wasn't replaced, so the commits the snapshot stood for must still reach it
+            for (auto skipped = jobs.begin(); skipped != it; ++skipped)
+                appendFrame(skipped->snapshot ? skipped->commit : skipped->data);
+            appendFrame(it->commit);
         }
     }
+}
+
+void UserDefault::appendFrame(const tlx::sbyte_buffer& data)
+{
+    if (!_fileStream.isOpen())
+        return;
+
+    auto size = static_cast<unsigned int>(data.size());
+    _fileStream.seek(0, SEEK_END);
+    if (_fileStream.write(data.data(), size) != static_cast<int>(size))
+        AXLOGW("UserDefault::flush failed to append to '{}'.", _filePath);
+}
+
+// the writer thread may outlive FileUtils, see Director::reset, so the snapshot is renamed without it
+static bool ud_replaceFile(const std::string& from, const std::string& to)
+{
+#if defined(_WIN32)
+    return ::MoveFileExW(ntcvt::from_chars(from).c_str(), ntcvt::from_chars(to).c_str(),
+                         MOVEFILE_REPLACE_EXISTING) != FALSE;
 #else
-    flush();
+    return ::rename(from.c_str(), to.c_str()) == 0;
 #endif
 }
 
-void UserDefault::setValueForKey(std::string_view key, std::string_view value)
+bool UserDefault::writeSnapshotFile(const tlx::sbyte_buffer& data)
 {
-    // do lazyInit at here to make sure _encryptEnabled works well
-    lazyInit();
+    // written aside then renamed over the journal, so a crash leaves either one of them complete
+    auto tmpPath = _filePath + ".tmp";
+    auto size    = static_cast<unsigned int>(data.size());
+
+    FileStream fs;
+    if (!fs.open(tmpPath, IFileStream::Mode::WRITE))
+    {
+        AXLOGW("UserDefault::flush failed to create '{}'.", tmpPath);
+        return false;
+    }
+    bool written =
+        fs.write(UD_HEADER, UD_HEADER_SIZE) == UD_HEADER_SIZE && fs.write(data.data(), size) == static_cast<int>(size);
+    fs.close();
+    if (!written)
+    {
+        AXLOGW("UserDefault::flush failed to write '{}'.", tmpPath);
+        ::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // some platforms can't replace a file held open
+    if (_fileStream.isOpen())
+        _fileStream.close();
+    bool replaced = ud_replaceFile(tmpPath, _filePath);
+    if (!replaced)
+    {
+        AXLOGW("UserDefault::flush failed to replace '{}'.", _filePath);
+        ::remove(tmpPath.c_str());
+    }
+    if (!_fileStream.open(_filePath, IFileStream::Mode::OVERLAPPED))
+        AXLOGW("UserDefault::flush failed to reopen '{}'.", _filePath);
+    return replaced;
+}
+
+void UserDefault::writerThread()
+{
+    yasio::set_thread_name("axmol-userdefault");
+
+    std::vector<WriteJob> jobs;
+    std::unique_lock<std::mutex> lck(_writeMtx);
+    for (;;)
+    {
+        _writeCondition.wait(lck, [this] { return _writerExit || !_writeQueue.empty(); });
+        if (_writeQueue.empty())
+            break;
+
+        jobs.swap(_writeQueue);
+        _writing = true;
+        lck.unlock();
 
-    updateValueForKey(key, value);
+        writeJobs(jobs);
+        jobs.clear();
+
+        lck.lock();
+        _writing = false;
+        _drainedCondition.notify_all();
+    }
 }
 
-void UserDefault::updateValueForKey(std::string_view key, std::string_view value)
+void UserDefault::stopWriter()
 {
-    auto it = _values.find(key);
-    if (it != _values.end())
-        it->second = value;
-    else
-        _values.emplace(key, value);
+    if (!_writer.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lck(_writeMtx);
+        _writerExit = true;
+    }
+    _writeCondition.notify_one();
+    _writer.join();
+    _writerExit = false;
+}
+
+void UserDefault::setWriteBehindEnabled(bool enabled)
+{
+    if (!enabled)
+        stopWriter();
+    _writeBehindEnabled = enabled;
 }
 
 UserDefault* UserDefault::getInstance()
@@ -374,66 +685,50 @@ void UserDefault::lazyInit()
         return;
 
 #if !USER_DEFAULT_PLAIN_MODE
-    _filePath = FileUtils::getInstance()->getNativeWritableAbsolutePath() + _userDefaultFileName;
+    auto fileUtils = FileUtils::getInstance();
+    _filePath      = fileUtils->getNativeWritableAbsolutePath() + _userDefaultFileName;
+
+    // a snapshot was being renamed over the journal, it's complete if the journal is already gone
+    auto tmpPath = _filePath + ".tmp";
+    if (fileUtils->isFileExist(tmpPath))
+    {
+        if (fileUtils->isFileExist(_filePath))
+            fileUtils->removeFile(tmpPath);
+        else
+            fileUtils->renameFile(tmpPath, _filePath);
+    }
 
-    // construct file mapping
     if (!_fileStream.open(_filePath, IFileStream::Mode::OVERLAPPED))
     {
         AXLOGW("UserDefault::init open storage file '{}' failed!", _filePath);
         return;
     }
 
-    int filesize = static_cast<int>(_fileStream.size());
+    tlx::sbyte_buffer data;
+    auto size = static_cast<unsigned int>(_fileStream.size());
+    data.resize(size);
+    if (size > 0 && _fileStream.read(data.data(), size) != static_cast<int>(size))
+    {
+        closeStorage();
+        AXLOGW("UserDefault::init read storage file '{}' failed!", _filePath);
+        return;
+    }
 
-    if (filesize < _curMapSize)
-    {  // construct a empty file mapping
-        if (!_fileStream.resize(_curMapSize))
-        {
-            AXLOGW("UserDefault::init failed to truncate '{}'.", _filePath);
-            return;
-        }
-        _rwmmap = std::make_shared<mio::mmap_sink>(_fileStream.nativeHandle(), 0, _curMapSize);
+    _persistent = true;
+    if (data.size() >= UD_HEADER_SIZE && memcmp(data.data(), UD_HEADER, UD_HEADER_SIZE) == 0)
+    {
+        loadJournal(data.data(), data.size());
     }
     else
-    {  /// load to memory _values
-        _rwmmap = std::make_shared<mio::mmap_sink>(_fileStream.nativeHandle(), 0, mio::map_entire_file);
-        if (_rwmmap->is_mapped())
-        {  // no error
-            yasio::ibstream_view ibs(_rwmmap->data(), _rwmmap->length());
-
-            if (ibs.length() > 0)
-            {
-                // read count of keyvals.
-                int count = ibs.read<int>();
-                for (auto i = 0; i < count; ++i)
-                {
-                    if (_encryptEnabled)
-                    {
-                        std::string key(ibs.read_v());
-                        std::string value(ibs.read_v());
-                        this->encrypt(key, AES_DECRYPT);
-                        this->encrypt(value, AES_DECRYPT);
-                        updateValueForKey(key, value);
-                    }
-                    else
-                    {
-                        std::string_view key(ibs.read_v());
-                        std::string_view value(ibs.read_v());
-                        updateValueForKey(key, value);
-                    }
-                }
-                _realSize = static_cast<int>(ibs.seek(0, SEEK_CUR) - sizeof(udflen_t));
-            }
-        }
-        else
-        {
-            closeFileMapping();
-            ::remove(_filePath.c_str());
-            AXLOGW(
-                "UserDefault::init map file '{}' failed, we can't save data persisit this time, next time "
-                "we will retry!",
-                _filePath);
-        }
+    {
+        // a new storage, or one in the format of the file mapping implementation to convert
+        if (!data.empty() && !loadLegacyFile(data.data(), data.size()))
+            AXLOGW("UserDefault::init '{}' is corrupted, we start over with an empty storage!", _filePath);
+
+        auto snapshot      = makeSnapshot();
+        _snapshotSize      = UD_HEADER_SIZE + snapshot.size();
+        _stats.journalSize = _snapshotSize;
+        writeSnapshotFile(snapshot);
     }
 #else
     pugi::xml_document doc;
@@ -447,7 +742,11 @@ void UserDefault::lazyInit()
         if (ret)
         {
             for (auto&& elem : doc.document_element())
-                updateValueForKey(elem.name(), elem.text().as_string());
+            {
+                Value value;
+                value.stringValue = elem.text().as_string();
+                updateValueForKey(elem.name(), std::move(value));
+            }
         }
         else
         {
@@ -460,68 +759,117 @@ void UserDefault::lazyInit()
     _initialized = true;
 }
 
-void UserDefault::flush()
+void UserDefault::loadJournal(const char* data, size_t size)
 {
-#if !USER_DEFAULT_PLAIN_MODE
-    if (_rwmmap)
+    tlx::sbyte_buffer payload;
+    size_t offset = UD_HEADER_SIZE;
+    while (offset + UD_FRAME_HEADER_SIZE <= size)
     {
-        yasio::obstream obs;
-        obs.write<int>(static_cast<int>(this->_values.size()));
-        for (auto&& item : this->_values)
+        auto payloadSize = yasio::ibstream::sread<uint32_t>(data + offset);
+        auto checksum    = yasio::ibstream::sread<uint32_t>(data + offset + 4);
+        auto first       = data + offset + UD_FRAME_HEADER_SIZE;
+        // stop at the first commit torn by a crash, the ones before it are intact
+        if (payloadSize > size - offset - UD_FRAME_HEADER_SIZE || XXH32(first, payloadSize, 0) != checksum)
+            break;
+
+        payload.assign(first, first + payloadSize);
+        if (_encryptEnabled)
+            encrypt(payload.data(), payload.size(), AES_DECRYPT);
+
+        try
         {
-            if (_encryptEnabled)
+            yasio::ibstream_view ibs(payload.data(), payload.size());
+            while (ibs.tell() < static_cast<ptrdiff_t>(payload.size()))
             {
-                ud_write_v_s(this, obs, item.first);
-                ud_write_v_s(this, obs, item.second);
-            }
-            else
-            {
-                obs.write_v(item.first);
-                obs.write_v(item.second);
+                auto op  = ibs.read<uint8_t>();
+                auto key = ibs.read_v();
+                if (op == UD_OP_DELETE)
+                {
+                    _values.erase(std::string{key});
+                    continue;
+                }
+
+                Value value;
+                value.type = static_cast<ValueType>(ibs.read<uint8_t>());
+                switch (value.type)
+                {
+                case ValueType::Bool:
+                    value.boolValue = ibs.read<uint8_t>() != 0;
+                    break;
+                case ValueType::Integer:
+                    value.intValue = ibs.read<int64_t>();
+                    break;
+                case ValueType::Double:
+                    value.doubleValue = ibs.read<double>();
+                    break;
+                default:
+                    value.stringValue = ibs.read_v();
+                }
+                updateValueForKey(key, std::move(value));
             }
         }
-
-        std::error_code error;
-        if (obs.length() > _curMapSize)
+        catch (const std::exception& ex)
         {
-            _rwmmap->unmap();
-            while (obs.length() > _curMapSize)
-                _curMapSize <<= 1;  // X2
+            AXLOGW("UserDefault::init malformed commit in '{}', {}", _filePath, ex.what());
+            break;
+        }
+        offset += UD_FRAME_HEADER_SIZE + payloadSize;
+    }
 
-            if (!_fileStream.resize(_curMapSize))
-                AXLOGW("UserDefault::flush failed to truncate '{}'.", _filePath);
+    if (offset < size)
+    {
+        AXLOGW("UserDefault::init discard {} bytes of incomplete commits in '{}'", size - offset, _filePath);
+        _fileStream.resize(static_cast<int64_t>(offset));
+    }
+    _snapshotSize      = offset;
+    _stats.journalSize = offset;
+}
 
-            _rwmmap->map(_fileStream.nativeHandle(), 0, _curMapSize, error);
-        }
+bool UserDefault::loadLegacyFile(const char* data, size_t size)
+{
+    try
+    {
+        yasio::ibstream_view ibs(data, size);
 
-        if (!error && _rwmmap->is_mapped())
-        {  // mapping status is good
-            ::memcpy(_rwmmap->data(), obs.data(), obs.length());
-            _realSize = static_cast<int>(obs.length() - sizeof(udflen_t));
-        }
-        else
+        // read count of keyvals.
+        int count = ibs.read<int>();
+        for (auto i = 0; i < count; ++i)
         {
-            // close file mapping and do a simple workaround fix to don't do persist later at this time
-            closeFileMapping();
-            ::remove(_filePath.c_str());
+            Value value;
+            std::string key(ibs.read_v());
+            value.stringValue = ibs.read_v();
+            if (_encryptEnabled)
+            {
+                this->encrypt(key, AES_DECRYPT);
+                this->encrypt(value.stringValue, AES_DECRYPT);
+            }
+            updateValueForKey(key, std::move(value));
         }
     }
-#else
-    pugi::xml_document doc;
-    doc.load_string(R"(<?xml version="1.0" ?>
-<r />)");
-    auto r = doc.document_element();
-    for (auto&& kv : _values)
-        r.append_child(kv.first.c_str()).append_child(pugi::xml_node_type::node_pcdata).set_value(kv.second.c_str());
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return true;
+}
 
-    FileUtils::getInstance()->writeXmlDocToFile(doc, _filePath);
-#endif
+void UserDefault::flush()
+{
+    commit();
+
+    std::unique_lock<std::mutex> lck(_writeMtx);
+    _drainedCondition.wait(lck, [this] { return _writeQueue.empty() && !_writing; });
 }
 
 void UserDefault::deleteValueForKey(const char* key)
 {
+    lazyInit();
+
     if (this->_values.erase(key) > 0)
-        flush();
+    {
+        writeOp(UD_OP_DELETE, key, nullptr);
+        commit();
+    }
 }
 
 void UserDefault::setFileName(std::string_view nameFile)
@@ -27,11 +27,16 @@ THE SOFTWARE.
 #pragma once
 
 #include "axmol/platform/PlatformMacros.h"
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
-#include "mio/mio.hpp"
+#include <vector>
+#include "yasio/obstream.hpp"
 #include "axmol/platform/FileStream.h"
+#include "axmol/tlx/hlookup.hpp"
 
 /**
  * @addtogroup base
@@ -48,8 +53,16 @@ namespace ax
  * It supports the following base types:
  * bool, int, float, double, string
  *
- * @warning: On windows, linux, use XML to store data, which means there are some limitations of
- * the key string, for example, `/` is not valid.
+ * Values are kept typed in memory and persisted in binary to an append-only journal: every set or
+ * delete is a checksummed commit, so a commit torn by a crash is discarded on the next load and the
+ * previous ones survive. The journal is compacted into a snapshot once it grows enough, and the
+ * writes are done on a background thread by default.
+ *
+ * With write-behind, a set returns before its commit reaches the storage file, and a crash of the process
+ * in that window loses it. Call flush() after the values that must survive a crash. The file isn't synced
+ * to the disk, so a power loss can still lose the latest commits.
+ *
+ * Wrap many sets in beginTransaction()/commitTransaction() to persist them as a single commit.
  */
 class AX_DLL UserDefault
 {
@@ -188,11 +201,44 @@ public:
     virtual void setStringForKey(const char* key, std::string_view value);
 
     /**
-     * Since we reimplement UserDefault with file mapping io,
-     * you don't needs call this function manually
+     * Waits until every commit is written to the storage file, values are persisted without it but
+     * may be lost if the process crashes before the background thread writes them.
+     * A transaction still open is not committed.
      */
     virtual void flush();
 
+    /**
+     * Batches the sets and deletes until the matching commitTransaction() into one journal commit,
+     * so they are written together and either all or none of them survive a crash.
+     * Transactions nest, only the outermost commit writes. With write-behind, commitTransaction() returns
+     * before the commit is written, call flush() when it must have reached the storage file.
+     * A transaction still open when the UserDefault is destroyed is discarded.
+     */
+    void beginTransaction();
+    void commitTransaction();
+
+    /**
+     * Writes the journal on a background thread, so sets never wait on the storage, but a set that
+     * returned isn't written yet and a process crash can lose it until flush() is called.
+     * Enabled by default except on wasm, disabling it waits for the pending writes.
+     */
+    void setWriteBehindEnabled(bool enabled);
+    bool isWriteBehindEnabled() const { return _writeBehindEnabled; }
+
+    /**
+     * The journal is rewritten as a snapshot of the live values when it exceeds this size
+     * and twice the size of the previous snapshot, 64KB by default.
+     */
+    void setCompactThreshold(size_t bytes) { _compactThreshold = bytes; }
+
+    struct Stats
+    {
+        uint64_t commits{0};
+        uint64_t compactions{0};
+        size_t journalSize{0};  // size of the storage file once every commit is written
+    };
+    const Stats& getStats() const { return _stats; }
+
     /**
      * delete any value by key,
      * @param key The key to delete value.
@@ -244,31 +290,96 @@ protected:
     UserDefault();
     virtual ~UserDefault();
 
+    enum class ValueType : uint8_t
+    {
+        String,
+        Bool,
+        Integer,
+        Double,
+    };
+
+    struct Value
+    {
+        ValueType type{ValueType::String};
+        union
+        {
+            bool boolValue;
+            int64_t intValue{0};
+            double doubleValue;
+        };
+        std::string stringValue;  // the value of strings, the text of other types once requested
+    };
+
+    // a batch of journal data for the writer, a snapshot replaces the whole storage file
+    struct WriteJob
+    {
+        tlx::sbyte_buffer data;
+        bool snapshot;
+        tlx::sbyte_buffer commit;  // the commit a snapshot replaced, appended instead if the snapshot fails
+    };
+
     void lazyInit();
 
-    void closeFileMapping();
+    void closeStorage();
 
     // The low level API of all getXXXForKey
-    const std::string* getValueForKey(std::string_view key);
+    Value* getValueForKey(std::string_view key);
 
     // The low level API of all setXXXForKey
-    void setValueForKey(std::string_view key, std::string_view value);
+    void setValueForKey(std::string_view key, Value&& value);
 
     // Update value without lazyInit
-    void updateValueForKey(std::string_view key, std::string_view value);
+    void updateValueForKey(std::string_view key, Value&& value);
+
+    // the text of a value, cached for the non-string types
+    static std::string_view getValueText(Value& value);
+
+    void loadJournal(const char* data, size_t size);
+    bool loadLegacyFile(const char* data, size_t size);
+
+    void writeOp(uint8_t op, std::string_view key, const Value* value);
+    void commit();
+    tlx::sbyte_buffer finishFrame();
+    tlx::sbyte_buffer makeSnapshot();
+
+    void queueWrite(WriteJob&& job);
+    void writeJobs(std::vector<WriteJob>& jobs);
+    bool writeSnapshotFile(const tlx::sbyte_buffer& data);
+    void appendFrame(const tlx::sbyte_buffer& data);
+    void writerThread();
+    void stopWriter();
 
 protected:
-    tlx::string_map<std::string> _values;
+    tlx::string_map<Value> _values;
 
     static UserDefault* _userDefault;
     static std::string _userDefaultFileName;
 
     std::string _filePath;
-    FileStream _fileStream;  // the file handle for data persistence
-    std::shared_ptr<mio::mmap_sink> _rwmmap;
-    int _curMapSize   = 4096;  // init mapsize is 4K
-    int _realSize     = 0;     // real data size without key/value entities count field
+    FileStream _fileStream;  // the file handle for data persistence, owned by the writer once started
     bool _initialized = false;
+    bool _persistent  = false;  // the storage file is usable
+
+    // the ops of the commit in progress, behind a reserved frame header
+    yasio::obstream _pendingOps;
+    int _transactionDepth    = 0;
+    size_t _snapshotSize     = 0;
+    size_t _compactThreshold = 64 * 1024;
+    Stats _stats;
+
+    // write-behind
+#if defined(__EMSCRIPTEN__)
+    bool _writeBehindEnabled = false;
+#else
+    bool _writeBehindEnabled = true;
+#endif
+    std::thread _writer;
+    std::mutex _writeMtx;
+    std::condition_variable _writeCondition;
+    std::condition_variable _drainedCondition;
+    std::vector<WriteJob> _writeQueue;
+    bool _writing    = false;
+    bool _writerExit = false;
 
     // encrpyt args
     bool _encryptEnabled = false;
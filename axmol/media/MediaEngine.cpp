@@ -24,6 +24,8 @@
 
 #include "axmol/media/MediaEngine.h"
 
+#include <algorithm>
+
 #if defined(WINAPI_FAMILY)
 #    if WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP && !defined(AXME_USE_IMFME)
 #        include "axmol/media/WmfMediaEngine.h"
@@ -61,6 +63,65 @@ std::unique_ptr<T> static_pointer_cast(std::unique_ptr<U>&& r)
 namespace ax
 {
 
+std::shared_ptr<MEFrameBuffer> MEFramePool::acquire(size_t size)
+{
+    std::shared_ptr<MEFrameBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        // a use count of 1 means only the pool references it, nobody else can take a new reference
+        auto it = std::find_if(_buffers.begin(), _buffers.end(), [](auto& item) { return item.use_count() == 1; });
+        if (it != _buffers.end())
+            buffer = *it;
+        else
+            buffer = _buffers.emplace_back(std::make_shared<MEFrameBuffer>());
+    }
+
+    if (buffer->_data.capacity() < size)
+        ++_allocations;
+    buffer->_data.resize(size);
+    buffer->_cbcrOffset = 0;
+    return buffer;
+}
+
+void MEFramePool::clear()
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _buffers.clear();
+}
+
+void MEFrameQueue::push(std::shared_ptr<MEFrameBuffer> frame)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (_frames.size() >= _capacity)
+    {
+        _frames.erase(_frames.begin());
+        ++_dropped;
+    }
+    _frames.emplace_back(std::move(frame));
+    _size = _frames.size();
+    ++_pushed;
+}
+
+std::shared_ptr<MEFrameBuffer> MEFrameQueue::popLatest()
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (_frames.empty())
+        return nullptr;
+
+    auto frame = std::move(_frames.back());
+    _dropped += _frames.size() - 1;
+    _frames.clear();
+    _size = 0;
+    return frame;
+}
+
+void MEFrameQueue::clear()
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _frames.clear();
+    _size = 0;
+}
+
 std::unique_ptr<MediaEngineFactory> MediaEngineFactory::create()
 {
 #if defined(WINAPI_FAMILY)
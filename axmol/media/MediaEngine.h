@@ -44,6 +44,9 @@
 #include <functional>
 #include <memory>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 #include "yasio/tlx/string_view.hpp"
 #include "axmol/tlx/byte_buffer.hpp"
@@ -159,6 +162,69 @@ struct MEVideoPixelDesc
     }
 };
 
+/*
+ * A decoded frame owned by a MEFramePool, the pool hands it out again once the last reference
+ * (the frame queue, or a consumer still uploading it) has been released.
+ */
+struct MEFrameBuffer
+{
+    tlx::byte_buffer _data;
+    size_t _cbcrOffset{0};  // offset of the chroma plane in _data, 0 for packed formats
+    MEVideoPixelDesc _vpd;
+    MEIntPoint _videoDim;
+};
+
+/*
+ * Recycles frame buffers between the decoder and the consumer, so steady-state playback
+ * doesn't allocate: only the first few frames, or a frame larger than any seen before do.
+ */
+class MEFramePool
+{
+public:
+    std::shared_ptr<MEFrameBuffer> acquire(size_t size);
+    void clear();
+
+    uint64_t getAllocations() const { return _allocations; }
+
+private:
+    std::mutex _mtx;
+    std::vector<std::shared_ptr<MEFrameBuffer>> _buffers;
+    std::atomic<uint64_t> _allocations{0};
+};
+
+/*
+ * Bounded hand-off of decoded frames to the render thread. The decoder never waits on the consumer:
+ * when the queue is full the oldest frame is dropped, and the consumer only presents the latest one.
+ */
+class MEFrameQueue
+{
+public:
+    explicit MEFrameQueue(size_t capacity = 3) : _capacity(capacity) {}
+
+    void push(std::shared_ptr<MEFrameBuffer> frame);
+    std::shared_ptr<MEFrameBuffer> popLatest();
+    void clear();
+
+    bool empty() const { return _size == 0; }
+    uint64_t getPushed() const { return _pushed; }
+    uint64_t getDropped() const { return _dropped; }
+
+private:
+    std::mutex _mtx;
+    std::vector<std::shared_ptr<MEFrameBuffer>> _frames;
+    size_t _capacity;
+    std::atomic<size_t> _size{0};
+    std::atomic<uint64_t> _pushed{0};
+    std::atomic<uint64_t> _dropped{0};
+};
+
+struct MEFrameStats
+{
+    uint64_t framesDecoded{0};
+    uint64_t framesDropped{0};      // decoded but superseded before they were transferred
+    uint64_t bufferAllocations{0};  // frame buffers allocated or grown by the engine
+};
+
 struct MEVideoFrame
 {
     MEVideoFrame(const uint8_t* data,
@@ -167,11 +233,22 @@ struct MEVideoFrame
                  const MEVideoPixelDesc& vpd,
                  const MEIntPoint& videoDim)
         : _vpd(vpd), _dataPointer(data), _cbcrDataPointer(cbcrData), _dataLen(len), _videoDim(videoDim) {};
+    explicit MEVideoFrame(std::shared_ptr<MEFrameBuffer> buffer)
+        : MEVideoFrame(buffer->_data.data(),
+                       buffer->_cbcrOffset ? buffer->_data.data() + buffer->_cbcrOffset : nullptr,
+                       buffer->_data.size(),
+                       buffer->_vpd,
+                       buffer->_videoDim)
+    {
+        _buffer = std::move(buffer);
+    }
     const uint8_t* _dataPointer;  // the video data
     const size_t _dataLen;        // the video data len
     const uint8_t* _cbcrDataPointer;
     MEVideoPixelDesc _vpd;  // the video pixel desc
     MEIntPoint _videoDim;   // the video size
+    // set when the frame comes from a MEFramePool, a consumer may keep it to read the data after the callback
+    std::shared_ptr<MEFrameBuffer> _buffer;
 #if !defined(_NDEBUG)
     YCbCrBiPlanarPixelInfo _ycbcrDesc{};
 #endif
@@ -200,6 +277,7 @@ public:
     virtual bool isPlaybackEnded() const                                             = 0;
     virtual MEMediaState getState() const                                            = 0;
     virtual bool transferVideoFrame()                                                = 0;
+    virtual MEFrameStats getFrameStats() const { return {}; }
 };
 
 class MediaEngineFactory
@@ -43,25 +43,29 @@ void* VlcMediaEngine::libvlc_video_lock(void* data, void** p_pixels)
 {
     VlcMediaEngine* mediaEngine = static_cast<VlcMediaEngine*>(data);
 
-    auto& bufferDim    = mediaEngine->_videoDim;
-    auto& outputBuffer = mediaEngine->_frameBuffer1;
-    mediaEngine->_frameBuffer1Mtx.lock();
+    // decode into a recycled buffer, the one being presented stays untouched so neither thread waits
+    auto& bufferDim = mediaEngine->_videoDim;
+    auto& frame     = mediaEngine->_decodingFrame;
     if constexpr (VLC_OUTPUT_FORMAT == ax::MEVideoPixelFormat::NV12)
     {
-        outputBuffer.resize(bufferDim.x * bufferDim.y + (bufferDim.x * bufferDim.y >> 1));  // NV12
-        p_pixels[0] = outputBuffer.data();
-        p_pixels[1] = outputBuffer.data() + (bufferDim.x * bufferDim.y);
+        // NV12
+        frame = mediaEngine->_framePool.acquire(bufferDim.x * bufferDim.y + (bufferDim.x * bufferDim.y >> 1));
+        frame->_cbcrOffset = bufferDim.x * bufferDim.y;
+        p_pixels[0]        = frame->_data.data();
+        p_pixels[1]        = frame->_data.data() + frame->_cbcrOffset;
     }
     else if constexpr (VLC_OUTPUT_FORMAT == ax::MEVideoPixelFormat::YUY2)
     {
-        outputBuffer.resize(bufferDim.x * bufferDim.y + ((bufferDim.x >> 1) * bufferDim.y * 4));  // YUY2
-        p_pixels[0] = outputBuffer.data();
+        frame = mediaEngine->_framePool.acquire(bufferDim.x * bufferDim.y + ((bufferDim.x >> 1) * bufferDim.y * 4));
+        p_pixels[0] = frame->_data.data();
     }
     else
     {
-        outputBuffer.resize(bufferDim.x * bufferDim.y * 4);  // RGBA32
-        p_pixels[0] = outputBuffer.data();
+        frame       = mediaEngine->_framePool.acquire(bufferDim.x * bufferDim.y * 4);  // RGBA32
+        p_pixels[0] = frame->_data.data();
     }
+    frame->_vpd      = ax::MEVideoPixelDesc{VLC_OUTPUT_FORMAT, bufferDim};
+    frame->_videoDim = bufferDim;
     return nullptr;
 }
 
@@ -69,7 +73,7 @@ void VlcMediaEngine::libvlc_video_unlock(void* data, void* id, void* const* p_pi
 {
     VlcMediaEngine* mediaEngine = static_cast<VlcMediaEngine*>(data);
 
-    mediaEngine->_frameBuffer1Mtx.unlock();
+    mediaEngine->_frameQueue.push(std::move(mediaEngine->_decodingFrame));
 
     ++mediaEngine->_frameIndex;
 
@@ -389,6 +393,7 @@ bool VlcMediaEngine::close()
 #    endif
         libvlc_media_list_remove_index(_ml, 0);
     }
+    _frameQueue.clear();
     _state = MEMediaState::Closed;
     return true;
 }
@@ -454,26 +459,23 @@ MEMediaState VlcMediaEngine::getState() const
 
 bool VlcMediaEngine::transferVideoFrame()
 {
-    if (_frameBuffer1.empty())
+    if (_frameQueue.empty())
         return false;
 
-    std::unique_lock<std::mutex> lck(_frameBuffer1Mtx);
-    if (AX_LIKELY(!_frameBuffer1.empty()))
-    {
-        _frameBuffer2.swap(_frameBuffer1);
-        lck.unlock();  // unlock immidiately before invoke user callback (maybe upload buffer to GPU)
-
-        auto& buffer = _frameBuffer2;
+    auto buffer = _frameQueue.popLatest();
+    if (AX_UNLIKELY(!buffer))
+        return false;
 
-        ax::MEVideoFrame frame{buffer.data(), buffer.data() + _videoDim.x * _videoDim.y, buffer.size(),
-                               ax::MEVideoPixelDesc{VLC_OUTPUT_FORMAT, _videoDim}, _videoDim};
-        // assert(static_cast<int>(frame._dataLen) >= frame._vpd._dim.x * frame._vpd._dim.y * 3 / 2);
-        _onVideoFrame(frame);
-        _frameBuffer2.clear();
-        return true;
-    }
+    // the consumer may keep frame._buffer to finish uploading it later, the pool won't reuse it meanwhile
+    ax::MEVideoFrame frame{std::move(buffer)};
+    // assert(static_cast<int>(frame._dataLen) >= frame._vpd._dim.x * frame._vpd._dim.y * 3 / 2);
+    _onVideoFrame(frame);
+    return true;
+}
 
-    return false;
+MEFrameStats VlcMediaEngine::getFrameStats() const
+{
+    return MEFrameStats{_frameQueue.getPushed(), _frameQueue.getDropped(), _framePool.getAllocations()};
 }
 
 }  // namespace ax
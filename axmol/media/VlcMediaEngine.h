@@ -44,6 +44,7 @@ public:
     bool isPlaybackEnded() const override { return _playbackEnded; }
     MEMediaState getState() const override;
     bool transferVideoFrame() override;
+    MEFrameStats getFrameStats() const override;
 
     void handleEvent(MEMediaEventType event);
 
@@ -92,9 +93,9 @@ private:
 
     std::string _videoCodecMimeType;
 
-    tlx::byte_buffer _frameBuffer1;  // for write
-    tlx::byte_buffer _frameBuffer2;  // for read
-    mutable std::mutex _frameBuffer1Mtx;
+    MEFramePool _framePool;
+    MEFrameQueue _frameQueue;
+    std::shared_ptr<MEFrameBuffer> _decodingFrame;  // between lock and unlock, only touched by the vlc thread
 };
 
 struct VlcMediaEngineFactory : public MediaEngineFactory
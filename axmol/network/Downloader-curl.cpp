@@ -29,6 +29,8 @@
 
 #    include <cinttypes>
 #    include <set>
+#    include <unordered_set>
+#    include <algorithm>
 
 #    include <curl/curl.h>
 #    include <thread>
@@ -225,6 +227,28 @@ public:
                 ::shutdown(this->_sockfd, SD_BOTH);
                 this->_sockfd = -1;
             }
+
+            // a paused transfer doesn't read the socket, unpause it to let curl abort
+            resume();
+        }
+    }
+
+    void resume() override
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        if (_paused)
+        {
+            // curl_easy_pause must be called on the thread driving the transfer
+            _paused          = false;
+            _resumeRequested = true;
+            if (_curlm)
+                curl_multi_wakeup(_curlm);
+        }
+        else if (_inDataSink)
+        {
+            // the consumer may refuse the chunk it's being handed, writeDataProc checks this before pausing
+            _resumePending = true;
         }
     }
 
@@ -270,6 +294,19 @@ public:
         return status;
     }
 
+    void attachMulti(CURLM* curlm)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _curlm = curlm;
+    }
+
+    void detachMulti()
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _curlm = nullptr;
+        _task  = nullptr;
+    }
+
     void setErrorDesc(int code, int codeInternal, std::string&& desc)
     {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
@@ -280,7 +317,7 @@ public:
 
     size_t writeDataProc(unsigned char* buffer, size_t size, size_t count)
     {
-        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        std::unique_lock<std::recursive_mutex> lock(_mutex);
         size_t ret = 0;
 
         auto bytes_transferred = size * count;
@@ -289,6 +326,39 @@ public:
         {
             ret = _fs->write(buffer, static_cast<unsigned int>(bytes_transferred));
         }
+        else if (_streaming)
+        {
+            if (_cancelled || !_task)
+                return 0;  // abort the transfer
+
+            // the sink may call resume() or cancel() from any thread, don't hold the lock while it runs
+            auto task      = _task;
+            _inDataSink    = true;
+            _resumePending = false;
+            lock.unlock();
+            bool accepted = owner.onTaskData(*task, buffer, bytes_transferred);
+            lock.lock();
+            _inDataSink = false;
+
+            if (_cancelled)
+                return 0;
+            if (!accepted)
+            {
+                // curl keeps the chunk and delivers it again once the transfer is unpaused
+                if (_resumePending)
+                {
+                    // resumed while the sink was running, let the transfer thread unpause right away
+                    _resumePending   = false;
+                    _resumeRequested = true;
+                    if (_curlm)
+                        curl_multi_wakeup(_curlm);
+                }
+                else
+                    _paused = true;
+                return CURL_WRITEFUNC_PAUSE;
+            }
+            ret = bytes_transferred;
+        }
         else
         {
             ret          = bytes_transferred;
@@ -329,9 +399,18 @@ private:
 
     curl_off_t _speed     = 0;
     CURL* _curl           = nullptr;
-    curl_socket_t _sockfd = -1;  // store the sockfd to support cancel download manually
+    CURLM* _curlm         = nullptr;  // the multi handle to wake up on resume, valid while the transfer runs
+    curl_socket_t _sockfd = -1;       // store the sockfd to support cancel download manually
     bool _cancelled       = false;
 
+    // streaming data task
+    const DownloadTask* _task = nullptr;
+    bool _streaming           = false;
+    bool _paused              = false;
+    bool _inDataSink          = false;  // onTaskData is running without the lock held
+    bool _resumePending       = false;  // resume() was called while onTaskData was running
+    std::atomic_bool _resumeRequested{false};
+
     // progress
     bool _alreadyDownloaded     = false;
     int64_t _transferOffset     = 0;
@@ -343,6 +422,9 @@ private:
     int _errCodeInternal = CURLE_OK;
     std::string _errDescription;
 
+    // the host:port the task connects to, for the per host task limit
+    std::string _host;
+
     // for saving data
     std::string _fileName;
     std::string _tempFileName;
@@ -370,14 +452,39 @@ public:
     //        : _thread(nullptr)
     {
         AXLOGD("Construct DownloaderCURL::Impl {}", fmt::ptr(this));
+
+        // the download thread exits when idle, keep the dns cache, tls sessions and idle connections in a share
+        // so the next batch of tasks doesn't set them up again
+        _share = curl_share_init();
+        curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, _lockShareProc);
+        curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, _unlockShareProc);
+        curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
+        _http2Supported = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
     }
 
-    ~Impl() { AXLOGD("Destruct DownloaderCURL::Impl {}", fmt::ptr(this)); }
+    ~Impl()
+    {
+        curl_share_cleanup(_share);
+        AXLOGD("Destruct DownloaderCURL::Impl {}", fmt::ptr(this));
+    }
 
     void addTask(std::shared_ptr<DownloadTask> task)
     {
         std::lock_guard<std::mutex> lock(_requestMutex);
-        _requestQueue.emplace_back(task);
+        // keep the queue sorted by priority, FIFO within a priority
+        auto it = std::find_if(_requestQueue.begin(), _requestQueue.end(),
+                               [&task](const auto& queued) { return queued->getPriority() < task->getPriority(); });
+        _requestQueue.insert(it, std::move(task));
+    }
+
+    void addWarmup(std::string_view url, std::string_view cacertPath)
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        _warmupQueue.emplace_back(url, cacertPath);
     }
 
     void run()
@@ -397,10 +504,11 @@ public:
 
     void stop()
     {  // make sure all task exit properly
-        if (!_requestQueue.empty())
+        if (!_requestQueue.empty() || !_warmupQueue.empty())
         {
             std::lock_guard<std::mutex> lock(_requestMutex);
             _requestQueue.clear();
+            _warmupQueue.clear();
         }
 
         if (!_processSet.empty())
@@ -443,6 +551,16 @@ public:
     }
 
 private:
+    static void _lockShareProc(CURL*, curl_lock_data data, curl_lock_access, void* userp)
+    {
+        static_cast<Impl*>(userp)->_shareMutexes[data].lock();
+    }
+
+    static void _unlockShareProc(CURL*, curl_lock_data data, void* userp)
+    {
+        static_cast<Impl*>(userp)->_shareMutexes[data].unlock();
+    }
+
     static size_t _outputDataCallbackProc(void* buffer, size_t size, size_t count, DownloadContextCURL* context)
     {
         // AXLOGD("    _outputDataCallbackProc: size({}), count({})", size, count);
@@ -565,11 +683,89 @@ private:
         curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
         curl_easy_setopt(handle, CURLOPT_MAXREDIRS, 5L);
 
-        context->_curl = handle;
+        _initConnectionProc(handle);
+        if (_http2Supported)
+        {
+            static const long weights[] = {1L, 16L, 256L};
+            curl_easy_setopt(handle, CURLOPT_STREAM_WEIGHT, weights[static_cast<int>(task->getPriority())]);
+        }
+
+        context->_curl      = handle;
+        context->_task      = task.get();
+        context->_streaming = task->_streaming;
 
         return CURLE_OK;
     }
 
+    // options shared by tasks and warmups, curl reuses a connection only for handles with the same settings
+    void _initConnectionProc(CURL* handle)
+    {
+        curl_easy_setopt(handle, CURLOPT_SHARE, _share);
+
+        if (_http2Supported)
+        {
+            // wait for a connection that may multiplex rather than opening one more to the same host
+            curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
+    }
+
+    CURL* _createWarmupHandleProc(const std::string& url, const std::string& cacertPath)
+    {
+        CURL* handle = curl_easy_init();
+        if (!handle)
+            return nullptr;
+
+        // a HEAD request resolves the host and leaves a connection in the share for the tasks to come
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(handle, CURLOPT_MAXREDIRS, 5L);
+        if (cacertPath.empty())
+        {
+            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0L);
+        }
+        else
+        {
+            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 1L);
+            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 2L);
+            curl_easy_setopt(handle, CURLOPT_CAINFO, cacertPath.c_str());
+        }
+        curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+        if (hints.timeoutInSeconds)
+            curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, hints.timeoutInSeconds);
+        _initConnectionProc(handle);
+        return handle;
+    }
+
+    // Gets the next queued task that may start, tasks of a host at its limit are skipped and only HIGH priority
+    // tasks start when all processing slots are taken
+    std::shared_ptr<DownloadTask> _popRequestProc(bool slotAvailable,
+                                                  const std::unordered_map<std::string, uint32_t>& hostTasks)
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        for (auto it = _requestQueue.begin(); it != _requestQueue.end(); ++it)
+        {
+            auto& task = *it;
+            if (!slotAvailable && task->getPriority() != DownloadTask::Priority::HIGH)
+                break;
+
+            if (hints.countOfMaxTasksPerHost)
+            {
+                auto context = static_cast<DownloadContextCURL*>(task->_context.get());
+                auto hostIt  = hostTasks.find(context->_host);
+                if (hostIt != hostTasks.end() && hostIt->second >= hints.countOfMaxTasksPerHost)
+                    continue;
+            }
+
+            auto ret = std::move(task);
+            _requestQueue.erase(it);
+            return ret;
+        }
+        return nullptr;
+    }
+
     void _threadProc()
     {
         yasio::set_thread_name("axmol-dl");
@@ -581,7 +777,12 @@ private:
         uint32_t countOfMaxProcessingTasks = this->hints.countOfMaxProcessingTasks;
         // init curl content
         CURLM* curlmHandle = curl_multi_init();
+        if (_http2Supported)
+            curl_multi_setopt(curlmHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
         std::unordered_map<CURL*, std::shared_ptr<DownloadTask>> taskMap;
+        std::unordered_set<CURL*> warmupHandles;
+        // running tasks per host, the keys are copies since a context may be freed while its host still counts
+        std::unordered_map<std::string, uint32_t> hostTasks;
         int runningHandles = 0;
         CURLMcode mcode    = CURLM_OK;
         int rc             = 0;  // select return code
@@ -609,8 +810,16 @@ private:
                 }
             }
 
-            if (!taskMap.empty())
+            if (!taskMap.empty() || !warmupHandles.empty())
             {
+                // unpause the streaming tasks whose consumer caught up
+                for (auto&& item : taskMap)
+                {
+                    auto context = static_cast<DownloadContextCURL*>(item.second->_context.get());
+                    if (context->_resumeRequested.exchange(false))
+                        curl_easy_pause(item.first, CURLPAUSE_CONT);
+                }
+
                 mcode = CURLM_CALL_MULTI_PERFORM;
                 while (CURLM_CALL_MULTI_PERFORM == mcode)
                 {
@@ -631,6 +840,14 @@ private:
                         CURL* curlHandle = m->easy_handle;
                         CURLcode errCode = m->data.result;
 
+                        if (warmupHandles.erase(curlHandle))
+                        {
+                            AXLOGD("    _threadProc warmup finished with errCode:{}", static_cast<int>(errCode));
+                            curl_multi_remove_handle(curlmHandle, curlHandle);
+                            curl_easy_cleanup(curlHandle);
+                            continue;
+                        }
+
                         auto task = taskMap[curlHandle];
 
                         /* clean underlaying execution
@@ -642,6 +859,7 @@ private:
                         // remove from multi-handle
                         curl_multi_remove_handle(curlmHandle, curlHandle);
                         auto context = static_cast<DownloadContextCURL*>(task->_context.get());
+                        context->detachMulti();
                         do
                         {
                             if (CURLE_OK != errCode)
@@ -677,6 +895,9 @@ private:
 
                         // remove from taskMap
                         taskMap.erase(curlHandle);
+                        auto hostIt = hostTasks.find(context->_host);
+                        if (hostIt != hostTasks.end() && --hostIt->second == 0)
+                            hostTasks.erase(hostIt);
 
                         // remove from _processSet
                         {
@@ -692,23 +913,29 @@ private:
                 } while (m);
             }
 
-            // process tasks in _requestList
-            while (true)
+            // start the requested warmups, they don't take task slots
             {
-                // Check for set task limit
-                if (countOfMaxProcessingTasks && taskMap.size() >= countOfMaxProcessingTasks)
-                    break;
-
-                // get task wrapper from request queue
-                std::shared_ptr<DownloadTask> task;
+                std::vector<std::pair<std::string, std::string>> warmups;
                 {
                     std::lock_guard<std::mutex> lock(_requestMutex);
-                    if (!_requestQueue.empty())
-                    {
-                        task = _requestQueue.front();
-                        _requestQueue.pop_front();
-                    }
+                    warmups.swap(_warmupQueue);
                 }
+                for (auto&& [url, cacertPath] : warmups)
+                {
+                    CURL* curlHandle = _createWarmupHandleProc(url, cacertPath);
+                    if (curlHandle && curl_multi_add_handle(curlmHandle, curlHandle) == CURLM_OK)
+                        warmupHandles.insert(curlHandle);
+                    else if (curlHandle)
+                        curl_easy_cleanup(curlHandle);
+                }
+            }
+
+            // process tasks in _requestList
+            while (true)
+            {
+                // get the next task that may start from request queue
+                bool slotAvailable = !countOfMaxProcessingTasks || taskMap.size() < countOfMaxProcessingTasks;
+                std::shared_ptr<DownloadTask> task = _popRequestProc(slotAvailable, hostTasks);
 
                 // if request queue is empty, the wrapper.first is nullptr
                 if (!task)
@@ -756,15 +983,24 @@ private:
                     continue;
                 }
 
+                context->attachMulti(curlmHandle);
                 AXLOGD("    _threadProc task create curl handle:{}", fmt::ptr(curlHandle));
                 taskMap[curlHandle] = task;
+                ++hostTasks[context->_host];
                 std::lock_guard<std::mutex> lock(_processMutex);
                 _processSet.insert(task);
             }
-        } while (!taskMap.empty());
+        } while (!taskMap.empty() || !warmupHandles.empty());
 
         _tasksFinished = true;
 
+        for (auto&& item : taskMap)
+            static_cast<DownloadContextCURL*>(item.second->_context.get())->detachMulti();
+        for (auto curlHandle : warmupHandles)
+        {
+            curl_multi_remove_handle(curlmHandle, curlHandle);
+            curl_easy_cleanup(curlHandle);
+        }
         curl_multi_cleanup(curlmHandle);
         AXLOGD("----DownloaderCURL::Impl::_threadProc end");
     }
@@ -785,6 +1021,8 @@ private:
     std::thread _thread;
     std::atomic_bool _tasksFinished{};
     std::deque<std::shared_ptr<DownloadTask>> _requestQueue;
+    // url, cacertPath
+    std::vector<std::pair<std::string, std::string>> _warmupQueue;
     std::set<std::shared_ptr<DownloadTask>> _processSet;
     std::deque<std::shared_ptr<DownloadTask>> _finishedQueue;
 
@@ -796,6 +1034,10 @@ private:
     // only access in download thread
     std::map<curl_socket_t, std::weak_ptr<IDownloadContext>> _contextMap;
 
+    CURLSH* _share       = nullptr;
+    bool _http2Supported = false;
+    std::mutex _shareMutexes[CURL_LOCK_DATA_LAST];
+
 public:
     DownloaderCURL* _owner = nullptr;
 };
@@ -824,6 +1066,7 @@ void DownloaderCURL::startTask(std::shared_ptr<DownloadTask>& task)
 {
     auto context   = std::make_shared<DownloadContextCURL>(*this);
     task->_context = context;
+    context->_host = _hostOfUrl(task->requestURL);
     if (context->init(task->storagePath, _impl->hints.tempFileNameSuffix))
     {
         AXLOGD("DownloaderCURL: startTask: Id({})", context->serialId);
@@ -844,6 +1087,23 @@ void DownloaderCURL::startTask(std::shared_ptr<DownloadTask>& task)
     }
 }
 
+void DownloaderCURL::warmup(std::string_view url, std::string_view cacertPath)
+{
+    _impl->addWarmup(url, cacertPath);
+    _impl->run();
+}
+
+std::string_view DownloaderCURL::_hostOfUrl(std::string_view url)
+{
+    auto start = url.find("://");
+    start      = start == std::string_view::npos ? 0 : start + 3;
+    auto host  = url.substr(start, url.find_first_of("/?#", start) - start);
+    auto at    = host.rfind('@');
+    if (at != std::string_view::npos)
+        host.remove_prefix(at + 1);
+    return host;
+}
+
 void DownloaderCURL::_lazyScheduleUpdate()
 {
     if (!_scheduler)
@@ -48,6 +48,8 @@ public:
 
     void startTask(std::shared_ptr<DownloadTask>& task) override;
 
+    void warmup(std::string_view url, std::string_view cacertPath) override;
+
 protected:
     class Impl;
     std::shared_ptr<Impl> _impl;
@@ -56,6 +58,9 @@ protected:
 
     static void _updateTaskProgressInfo(DownloadTask& task, int64_t totalExpected = -1);
 
+    // host:port of the url
+    static std::string_view _hostOfUrl(std::string_view url);
+
     // scheduler for update processing and finished task in main schedule
     void _onDownloadFinished(DownloadTask& task);
 
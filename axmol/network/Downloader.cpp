@@ -83,6 +83,12 @@ void DownloadTask::cancel()
         _context->cancel();
 }
 
+void DownloadTask::resume()
+{
+    if (_context)
+        _context->resume();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Implement Downloader
 Downloader::Downloader() : Downloader(DownloaderHints{6, 45, ".tmp"}) {}
@@ -98,6 +104,10 @@ Downloader::Downloader(const DownloaderHints& hints)
         }
     };
 
+    _impl->onTaskData = [this](const DownloadTask& task, const unsigned char* data, size_t size) {
+        return onTaskData ? onTaskData(task, data, size) : true;
+    };
+
     _impl->onTaskFinish = [this](const DownloadTask& task, int errorCode, int errorCodeInternal,
                                  std::string_view errorStr, std::vector<unsigned char>& data) {
         if (DownloadTask::ERROR_NO_ERROR != errorCode)
@@ -119,7 +129,13 @@ Downloader::Downloader(const DownloaderHints& hints)
         }
         else
         {
-            // data task
+            // data task, deliver the body in one chunk when the impl can't stream it
+            if (task._streaming && !data.empty())
+            {
+                if (onTaskData)
+                    onTaskData(task, data.data(), data.size());
+                data.clear();
+            }
             if (onDataTaskSuccess)
             {
                 onDataTaskSuccess(task, data);
@@ -134,9 +150,12 @@ Downloader::~Downloader()
 }
 
 std::shared_ptr<DownloadTask> Downloader::createDownloadDataTask(std::string_view srcUrl,
-                                                                 std::string_view identifier /* = ""*/)
+                                                                 std::string_view identifier /* = ""*/,
+                                                                 Priority priority)
 {
-    auto task = std::make_shared<DownloadTask>(srcUrl, identifier);
+    auto task        = std::make_shared<DownloadTask>(srcUrl, identifier);
+    task->_streaming = static_cast<bool>(onTaskData);
+    task->_priority  = priority;
 
     do
     {
@@ -160,9 +179,11 @@ std::shared_ptr<DownloadTask> Downloader::createDownloadFileTask(std::string_vie
                                                                  std::string_view identifier,
                                                                  std::string_view md5checksum,
                                                                  bool background,
-                                                                 std::string_view cacertPath)
+                                                                 std::string_view cacertPath,
+                                                                 Priority priority)
 {
     auto task = std::make_shared<DownloadTask>(srcUrl, storagePath, md5checksum, identifier, background, cacertPath);
+    task->_priority = priority;
     do
     {
         if (srcUrl.empty() || storagePath.empty())
@@ -180,6 +201,12 @@ std::shared_ptr<DownloadTask> Downloader::createDownloadFileTask(std::string_vie
     return task;
 }
 
+void Downloader::warmup(std::string_view url, std::string_view cacertPath)
+{
+    if (!url.empty())
+        _impl->warmup(url, cacertPath);
+}
+
 // std::string Downloader::getFileNameFromUrl(std::string_view srcUrl)
 //{
 //    // Find file name and file extension
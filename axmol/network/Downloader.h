@@ -58,6 +58,13 @@ public:
     const static int ERROR_CHECK_SUM_FAILED    = -8;
     const static int ERROR_ORIGIN_FILE_MISSING = -9;
 
+    enum class Priority
+    {
+        LOW,
+        NORMAL,
+        HIGH,  // starts even when countOfMaxProcessingTasks tasks are running, e.g. manifests and UI atlases
+    };
+
     std::string identifier;
     std::string requestURL;
     std::string storagePath;
@@ -88,13 +95,22 @@ public:
     // Cancel the download, it's useful for ios platform switch wifi to 4g
     void cancel();
 
+    // Resume a streaming data task paused by returning false from Downloader::onTaskData
+    void resume();
+
     std::string checksum;  // The MD5 checksum for check only when download finished.
     bool background;       // Does the task is background (all callback will invoke on downloader thread)
 
+    // Queued tasks start in priority order, FIFO within a priority. The priority is given to
+    // Downloader::createDownloadDataTask/createDownloadFileTask and only applies when the task is queued.
+    Priority getPriority() const { return _priority; }
+
 private:
     friend class Downloader;
     friend class DownloaderCURL;
     std::shared_ptr<IDownloadContext> _context{nullptr};
+    Priority _priority = Priority::NORMAL;
+    bool _streaming = false;  // the body is delivered through Downloader::onTaskData instead of being buffered
 };
 
 class AX_DLL DownloaderHints
@@ -103,17 +119,28 @@ public:
     uint32_t countOfMaxProcessingTasks;
     uint32_t timeoutInSeconds;
     std::string tempFileNameSuffix;
+    uint32_t countOfMaxTasksPerHost = 0;  // 0: unlimited, multiplexed HTTP/2 hosts rarely need a limit
 };
 
 class AX_DLL Downloader final
 {
 public:
+    using Priority = DownloadTask::Priority;
+
     Downloader();
     Downloader(const DownloaderHints& hints);
     ~Downloader();
 
     std::function<void(const DownloadTask& task, std::vector<unsigned char>& data)> onDataTaskSuccess;
 
+    /**
+     * Streams the body of data tasks created while it is set, instead of buffering it for onDataTaskSuccess,
+     * which then receives an empty vector. Invoked on the downloader thread as chunks arrive.
+     * Return false to pause the transfer without consuming the chunk, it is delivered again after
+     * DownloadTask::resume, so a slow consumer applies backpressure rather than growing a buffer.
+     */
+    std::function<bool(const DownloadTask& task, const unsigned char* data, size_t size)> onTaskData;
+
     std::function<void(const DownloadTask& task)> onFileTaskSuccess;
 
     std::function<void(const DownloadTask& task)> onTaskProgress;
@@ -126,6 +153,12 @@ public:
         onFileTaskSuccess = callback;
     };
 
+    void setOnTaskData(
+        const std::function<bool(const DownloadTask& task, const unsigned char* data, size_t size)>& callback)
+    {
+        onTaskData = callback;
+    };
+
     void setOnTaskProgress(const std::function<void(const DownloadTask& task)>& callback)
     {
         onTaskProgress = callback;
@@ -138,14 +171,24 @@ public:
         onTaskError = callback;
     };
 
-    std::shared_ptr<DownloadTask> createDownloadDataTask(std::string_view srcUrl, std::string_view identifier = "");
+    std::shared_ptr<DownloadTask> createDownloadDataTask(std::string_view srcUrl,
+                                                         std::string_view identifier = "",
+                                                         Priority priority           = Priority::NORMAL);
 
     std::shared_ptr<DownloadTask> createDownloadFileTask(std::string_view srcUrl,
                                                          std::string_view storagePath,
                                                          std::string_view identifier = "",
                                                          std::string_view checksum   = "",
                                                          bool background             = false,
-                                                         std::string_view cacertPath = "");
+                                                         std::string_view cacertPath = "",
+                                                         Priority priority           = Priority::NORMAL);
+
+    /**
+     * Resolves the host of the url and opens a connection to it ahead of the tasks that will need it, so the
+     * first of them doesn't wait for DNS, TCP and TLS setup. Pass the cacertPath the tasks will use, a
+     * connection is only reused by tasks with the same TLS settings. No effect on platforms without curl.
+     */
+    void warmup(std::string_view url, std::string_view cacertPath = "");
 
 private:
     std::unique_ptr<IDownloaderImpl> _impl;
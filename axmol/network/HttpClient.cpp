@@ -45,6 +45,11 @@ namespace network
 
 static HttpClient* _httpClient = nullptr;  // pointer to singleton
 
+static std::string makeHostKey(const Uri& uri)
+{
+    return fmt::format("{}://{}:{}", uri.getScheme(), uri.getHost(), uri.getPort());
+}
+
 template <typename _Cont, typename _Fty>
 static void __clearQueueUnsafe(_Cont& queue, _Fty pred)
 {
@@ -118,6 +123,9 @@ HttpClient::HttpClient()
     , _dispatchOnWorkThread(false)
     , _timeoutForConnect(30)
     , _timeoutForRead(60)
+    , _keepAliveEnabled(true)
+    , _idleConnectionTimeout(15)
+    , _decompressionEnabled(false)
     , _cookie(nullptr)
     , _clearResponsePredicate(nullptr)
 {
@@ -181,6 +189,9 @@ void HttpClient::tickInput()
 void HttpClient::handleNetworkStatusChanged()
 {
     _service->set_option(YOPT_S_DNS_DIRTY, 1);
+
+    // connections made over the previous network are likely dead
+    closeIdleConnections();
 }
 
 void HttpClient::setNameServers(std::string_view servers)
@@ -223,13 +234,23 @@ void HttpClient::processResponse(HttpResponse* response, int channelIndex)
     if (response->validateUri())
     {
         if (channelIndex == -1)
+        {
+            if (tryReuseConnection(response))
+                return;
             channelIndex = tryTakeAvailChannel();
+        }
 
         if (channelIndex != -1)
         {
             auto channelHandle     = _service->channel_at(channelIndex);
             auto& requestUri       = response->getRequestUri();
             channelHandle->ud_.ptr = response;
+
+            auto& connection     = _connections[channelIndex];
+            connection.hostKey   = makeHostKey(requestUri);
+            connection.transport = nullptr;
+            connection.reused    = false;
+
             _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
                                  (int)requestUri.getPort());
             if (requestUri.isSecure())
@@ -238,18 +259,95 @@ void HttpClient::processResponse(HttpResponse* response, int channelIndex)
                 _service->open(channelIndex, YCK_TCP_CLIENT);
         }
         else
+        {
             _pendingResponseQueue.emplace_back(response);
+
+            // all channels are busy, make room by closing an unused keep-alive connection
+            closeOldestIdleConnection();
+        }
     }
     else
         finishResponse(response);
 }
 
+bool HttpClient::tryReuseConnection(HttpResponse* response)
+{
+    if (!_keepAliveEnabled)
+        return false;
+
+    auto hostKey = makeHostKey(response->getRequestUri());
+
+    std::unique_lock<std::mutex> lck(_connectionMutex);
+    // prefer the most recently used connection, it's the least likely to be closed by the server
+    auto it = std::find_if(_idleConnections.rbegin(), _idleConnections.rend(),
+                           [this, &hostKey](int index) { return _connections[index].hostKey == hostKey; });
+    if (it == _idleConnections.rend())
+        return false;
+
+    int channelIndex = *it;
+    _idleConnections.erase(std::next(it).base());
+
+    _service->channel_at(channelIndex)->ud_.ptr = response;
+    _connections[channelIndex].reused           = true;
+    lck.unlock();
+
+    // write the request on the network thread like freshly opened connections do, unless the connection was
+    // closed meanwhile and the request is already retried over a new one
+    _service->schedule(std::chrono::microseconds(0), [this, response, channelIndex](io_service& s) {
+        if (_connections[channelIndex].reused && s.channel_at(channelIndex)->ud_.ptr == response)
+            sendRequest(response, channelIndex);
+        return true;
+    });
+    return true;
+}
+
+void HttpClient::closeOldestIdleConnection()
+{
+    std::lock_guard<std::mutex> lck(_connectionMutex);
+    if (!_idleConnections.empty())
+    {
+        int channelIndex = _idleConnections.front();
+        _idleConnections.pop_front();
+        _service->close(channelIndex);
+    }
+}
+
+void HttpClient::closeIdleConnections()
+{
+    std::lock_guard<std::mutex> lck(_connectionMutex);
+    for (auto channelIndex : _idleConnections)
+        _service->close(channelIndex);
+    _idleConnections.clear();
+}
+
+void HttpClient::setKeepAliveEnabled(bool enabled)
+{
+    _keepAliveEnabled = enabled;
+    if (!enabled)
+        closeIdleConnections();
+}
+
 void HttpClient::handleNetworkEvent(yasio::io_event* event)
 {
-    int channelIndex       = event->cindex();
-    auto channel           = _service->channel_at(event->cindex());
-    HttpResponse* response = (HttpResponse*)channel->ud_.ptr;
-    assert(response);
+    int channelIndex = event->cindex();
+    auto channel     = _service->channel_at(event->cindex());
+
+    HttpResponse* response = nullptr;
+    {
+        std::lock_guard<std::mutex> lck(_connectionMutex);
+        if (event->kind() == YEK_ON_CLOSE)
+            _idleConnections.erase(std::remove(_idleConnections.begin(), _idleConnections.end(), channelIndex),
+                                   _idleConnections.end());
+        response = (HttpResponse*)channel->ud_.ptr;
+    }
+
+    if (!response)
+    {
+        // an unused keep-alive connection was closed by the server, by its idle timeout or to make room
+        if (event->kind() == YEK_ON_CLOSE)
+            recycleChannel(channelIndex);
+        return;
+    }
 
     bool responseFinished = response->isFinished();
     switch (event->kind())
@@ -269,135 +367,170 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
         if (response->isFinished())
         {
             response->updateInternalCode(yasio::errc::eof);
-            _service->close(event->cindex());
+            if (_keepAliveEnabled && response->shouldKeepAlive())
+                handleNetworkKeepAlive(response, channel);
+            else
+                _service->close(event->cindex());
         }
         break;
     case YEK_ON_OPEN:
         if (event->status() == 0)
         {
-            obstream obs;
-            bool usePostData = false;
-            auto request     = response->getHttpRequest();
-            switch (request->getRequestType())
-            {
-            case HttpRequest::Type::GET:
-                obs.write_bytes("GET");
-                break;
-            case HttpRequest::Type::PATCH:
-                obs.write_bytes("PATCH");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::POST:
-                obs.write_bytes("POST");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::DELETE:
-                obs.write_bytes("DELETE");
-                break;
-            case HttpRequest::Type::PUT:
-                obs.write_bytes("PUT");
-                usePostData = true;
-                break;
-            default:
-                obs.write_bytes("GET");
-                break;
-            }
-            obs.write_bytes(" ");
+            _connections[channelIndex].transport = event->transport();
+            sendRequest(response, channelIndex);
+        }
+        else
+        {
+            handleNetworkEOF(response, channel, event->status());
+        }
+        break;
+    case YEK_ON_CLOSE:
+        // the server dropped the kept alive connection before it answered, retry over a new connection, but only
+        // when the request is idempotent and the close isn't ours from a read timeout
+        if (_connections[channelIndex].reused && !response->isDataReceived() &&
+            response->getInternalCode() != yasio::errc::read_timeout &&
+            response->getHttpRequest()->getRequestType() == HttpRequest::Type::GET)
+        {
+            channel->ud_.ptr = nullptr;
+            channel->get_user_timer().cancel();
+            processResponse(response, channelIndex);
+            response->release();
+            break;
+        }
+        response->handleConnectionClose();
+        handleNetworkEOF(response, channel, event->status());
+        break;
+    }
+}
+
+void HttpClient::sendRequest(HttpResponse* response, int channelIndex)
+{
+    auto channel = _service->channel_at(channelIndex);
+
+    obstream obs;
+    bool usePostData = false;
+    auto request     = response->getHttpRequest();
+    switch (request->getRequestType())
+    {
+    case HttpRequest::Type::GET:
+        obs.write_bytes("GET");
+        break;
+    case HttpRequest::Type::PATCH:
+        obs.write_bytes("PATCH");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::POST:
+        obs.write_bytes("POST");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::DELETE:
+        obs.write_bytes("DELETE");
+        break;
+    case HttpRequest::Type::PUT:
+        obs.write_bytes("PUT");
+        usePostData = true;
+        break;
+    default:
+        obs.write_bytes("GET");
+        break;
+    }
+    obs.write_bytes(" ");
 
-            auto& uri = response->getRequestUri();
-            obs.write_bytes(uri.getPathEtc());
+    auto& uri = response->getRequestUri();
+    obs.write_bytes(uri.getPathEtc());
 
-            obs.write_bytes(" HTTP/1.1\r\n");
+    obs.write_bytes(" HTTP/1.1\r\n");
 
-            obs.write_bytes("Host: ");
-            obs.write_bytes(uri.getHost());
+    obs.write_bytes("Host: ");
+    obs.write_bytes(uri.getHost());
+    obs.write_bytes("\r\n");
+
+    // process custom headers
+    struct HeaderFlag
+    {
+        enum
+        {
+            UESR_AGENT      = 1,
+            CONTENT_TYPE    = 1 << 1,
+            ACCEPT          = 1 << 2,
+            ACCEPT_ENCODING = 1 << 3,
+        };
+    };
+    int headerFlags = 0;
+    auto& headers   = request->getHeaders();
+    if (!headers.empty())
+    {
+        for (auto&& header : headers)
+        {
+            obs.write_bytes(header);
             obs.write_bytes("\r\n");
 
-            // process custom headers
-            struct HeaderFlag
-            {
-                enum
-                {
-                    UESR_AGENT   = 1,
-                    CONTENT_TYPE = 1 << 1,
-                    ACCEPT       = 1 << 2,
-                };
-            };
-            int headerFlags = 0;
-            auto& headers   = request->getHeaders();
-            if (!headers.empty())
-            {
-                for (auto&& header : headers)
-                {
-                    obs.write_bytes(header);
-                    obs.write_bytes("\r\n");
-
-                    if (tlx::ic::starts_with(std::string_view{header}, "User-Agent:"sv))
-                        headerFlags |= HeaderFlag::UESR_AGENT;
-                    else if (tlx::ic::starts_with(std::string_view{header}, "Content-Type:"sv))
-                        headerFlags |= HeaderFlag::CONTENT_TYPE;
-                    else if (tlx::ic::starts_with(std::string_view{header}, "Accept:"sv))
-                        headerFlags |= HeaderFlag::ACCEPT;
-                }
-            }
+            if (tlx::ic::starts_with(std::string_view{header}, "User-Agent:"sv))
+                headerFlags |= HeaderFlag::UESR_AGENT;
+            else if (tlx::ic::starts_with(std::string_view{header}, "Content-Type:"sv))
+                headerFlags |= HeaderFlag::CONTENT_TYPE;
+            else if (tlx::ic::starts_with(std::string_view{header}, "Accept:"sv))
+                headerFlags |= HeaderFlag::ACCEPT;
+            else if (tlx::ic::starts_with(std::string_view{header}, "Accept-Encoding:"sv))
+                headerFlags |= HeaderFlag::ACCEPT_ENCODING;
+        }
+    }
 
-            if (_cookie)
-            {
-                auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
-                if (!cookies.empty())
-                {
-                    obs.write_bytes("Cookie: ");
-                    obs.write_bytes(cookies);
-                }
-            }
+    if (_cookie)
+    {
+        auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
+        if (!cookies.empty())
+        {
+            obs.write_bytes("Cookie: ");
+            obs.write_bytes(cookies);
+        }
+    }
 
-            if (!(headerFlags & HeaderFlag::UESR_AGENT))
-                obs.write_bytes("User-Agent: yasio-http\r\n");
+    if (!(headerFlags & HeaderFlag::UESR_AGENT))
+        obs.write_bytes("User-Agent: yasio-http\r\n");
 
-            if (!(headerFlags & HeaderFlag::ACCEPT))
-                obs.write_bytes("Accept: */*;q=0.8\r\n");
+    if (!(headerFlags & HeaderFlag::ACCEPT))
+        obs.write_bytes("Accept: */*;q=0.8\r\n");
 
-            if (usePostData)
-            {
-                if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
-                    obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
-
-                auto requestData     = request->getRequestData();
-                auto requestDataSize = request->getRequestDataSize();
-                char buf[128];
-                auto strConentLen =
-                    fmt::format_to_z(buf, "Content-Length: {}\r\n\r\n", static_cast<int>(requestDataSize));
-                obs.write_bytes(strConentLen);
-
-                if (requestData && requestDataSize > 0)
-                    obs.write_bytes(std::string_view{requestData, static_cast<size_t>(requestDataSize)});
-            }
-            else
-            {
-                obs.write_bytes("\r\n");
-            }
+    // the body is only decoded when we asked for the encoding, otherwise it's up to the caller
+    bool contentDecoding = _decompressionEnabled && !(headerFlags & HeaderFlag::ACCEPT_ENCODING);
+    if (contentDecoding)
+        obs.write_bytes("Accept-Encoding: gzip, deflate\r\n");
+    response->setContentDecoding(contentDecoding);
 
-            _service->write(event->transport(), std::move(obs.buffer()));
+    if (!_keepAliveEnabled)
+        obs.write_bytes("Connection: close\r\n");
 
-            auto& timerForRead = channel->get_user_timer();
-            timerForRead.cancel();
-            timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
-            timerForRead.async_wait([=](io_service& s) {
-                response->updateInternalCode(yasio::errc::read_timeout);
-                s.close(channelIndex);  // timeout
-                return true;
-            });
-        }
-        else
-        {
-            handleNetworkEOF(response, channel, event->status());
-        }
-        break;
-    case YEK_ON_CLOSE:
-        response->handleConnectionClose();
-        handleNetworkEOF(response, channel, event->status());
-        break;
+    if (usePostData)
+    {
+        if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
+            obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
+
+        auto requestData     = request->getRequestData();
+        auto requestDataSize = request->getRequestDataSize();
+        char buf[128];
+        auto strConentLen = fmt::format_to_z(buf, "Content-Length: {}\r\n\r\n", static_cast<int>(requestDataSize));
+        obs.write_bytes(strConentLen);
+
+        if (requestData && requestDataSize > 0)
+            obs.write_bytes(std::string_view{requestData, static_cast<size_t>(requestDataSize)});
+    }
+    else
+    {
+        obs.write_bytes("\r\n");
     }
+
+    _service->write(_connections[channelIndex].transport, std::move(obs.buffer()));
+
+    auto& timerForRead = channel->get_user_timer();
+    timerForRead.cancel();
+    timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
+    timerForRead.async_wait([=](io_service& s) {
+        // record the reason before closing, a timed out request must not be retried on YEK_ON_CLOSE
+        response->updateInternalCode(yasio::errc::read_timeout);
+        s.close(channelIndex);  // timeout
+        return true;
+    });
 }
 
 void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode)
@@ -420,22 +553,82 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
         }
     default:
         finishResponse(response);
+        recycleChannel(channel->index());
+    }
+}
 
-        // try process pending response
-        auto lck = _pendingResponseQueue.get_lock();
-        if (!_pendingResponseQueue.unsafe_empty())
+void HttpClient::handleNetworkKeepAlive(HttpResponse* response, yasio::io_channel* channel)
+{
+    auto channelIndex = channel->index();
+
+    // arm the idle timeout before the connection can be taken by another request, which rearms the timer
+    auto& timerForIdle = channel->get_user_timer();
+    timerForIdle.cancel();
+    timerForIdle.expires_from_now(std::chrono::seconds(_idleConnectionTimeout));
+    timerForIdle.async_wait([this, channelIndex](io_service& s) {
+        std::lock_guard<std::mutex> lck(_connectionMutex);
+        auto it = std::find(_idleConnections.begin(), _idleConnections.end(), channelIndex);
+        if (it != _idleConnections.end())
         {
-            auto pendingResponse = _pendingResponseQueue.unsafe_front();
-            _pendingResponseQueue.unsafe_pop_front();
-            lck.unlock();
-
-            processResponse(pendingResponse, channel->index());
-            pendingResponse->release();
+            _idleConnections.erase(it);
+            s.close(channelIndex);
         }
-        else
-        {  // recycle channel
-            _availChannelQueue.push_front(channel->index());
+        return true;
+    });
+
+    {
+        std::lock_guard<std::mutex> lck(_connectionMutex);
+        channel->ud_.ptr = nullptr;
+        _idleConnections.emplace_back(channelIndex);
+    }
+
+    switch (response->getResponseCode())
+    {
+    case 301:
+    case 302:
+    case 307:
+        if (response->tryRedirect())
+        {
+            processResponse(response, -1);
+            response->release();
+            break;
         }
+    default:
+        finishResponse(response);
+        processPendingResponse();
+    }
+}
+
+void HttpClient::recycleChannel(int channelIndex)
+{
+    // try process pending response
+    auto lck = _pendingResponseQueue.get_lock();
+    if (!_pendingResponseQueue.unsafe_empty())
+    {
+        auto pendingResponse = _pendingResponseQueue.unsafe_front();
+        _pendingResponseQueue.unsafe_pop_front();
+        lck.unlock();
+
+        processResponse(pendingResponse, channelIndex);
+        pendingResponse->release();
+    }
+    else
+    {  // recycle channel
+        _availChannelQueue.push_front(channelIndex);
+    }
+}
+
+void HttpClient::processPendingResponse()
+{
+    auto lck = _pendingResponseQueue.get_lock();
+    if (!_pendingResponseQueue.unsafe_empty())
+    {
+        auto pendingResponse = _pendingResponseQueue.unsafe_front();
+        _pendingResponseQueue.unsafe_pop_front();
+        lck.unlock();
+
+        processResponse(pendingResponse, -1);
+        pendingResponse->release();
     }
 }
 
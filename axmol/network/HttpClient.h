@@ -149,6 +149,38 @@ public:
      */
     int getTimeoutForRead();
 
+    /**
+     * Enable reusing HTTP/1.1 keep-alive connections for subsequent requests to the same host, default is true.
+     *
+     * @param enabled whether finished connections go back to a per host pool instead of being closed.
+     */
+    void setKeepAliveEnabled(bool enabled);
+
+    bool isKeepAliveEnabled() const { return _keepAliveEnabled; }
+
+    /**
+     * Set how long an unused keep-alive connection stays open, default is 15 seconds.
+     *
+     * @param value the idle timeout in seconds.
+     */
+    void setIdleConnectionTimeout(int value) { _idleConnectionTimeout = value; }
+
+    int getIdleConnectionTimeout() const { return _idleConnectionTimeout; }
+
+    /**
+     * Close all unused keep-alive connections.
+     */
+    void closeIdleConnections();
+
+    /**
+     * Enable asking servers for gzip or deflate encoded responses, default is false.
+     * When enabled, every request without its own Accept-Encoding header advertises gzip and deflate and the
+     * response data is decoded transparently, so callers always see the identity body.
+     */
+    void setDecompressionEnabled(bool enabled) { _decompressionEnabled = enabled; }
+
+    bool isDecompressionEnabled() const { return _decompressionEnabled; }
+
     HttpCookie* getCookie() const { return _cookie; }
 
     std::recursive_mutex& getCookieFileMutex() { return _cookieFileMutex; }
@@ -204,10 +236,22 @@ private:
 
     int tryTakeAvailChannel();
 
+    bool tryReuseConnection(HttpResponse* response);
+
+    void closeOldestIdleConnection();
+
+    void sendRequest(HttpResponse* response, int channelIndex);
+
     void handleNetworkEvent(yasio::io_event* event);
 
     void handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode);
 
+    void handleNetworkKeepAlive(HttpResponse* response, yasio::io_channel* channel);
+
+    void recycleChannel(int channelIndex);
+
+    void processPendingResponse();
+
     void tickInput();
 
     void finishResponse(HttpResponse* response);
@@ -234,6 +278,22 @@ private:
 
     ConcurrentDeque<int> _availChannelQueue;
 
+    struct Connection
+    {
+        std::string hostKey;  // scheme://host:port, connections are only reused for the same key
+        yasio::transport_handle_t transport = nullptr;
+        bool reused                         = false;  // the current request went over a kept alive connection
+    };
+    Connection _connections[MAX_CHANNELS];
+
+    // channel indexes of the unused keep-alive connections, the least recently used first
+    std::deque<int> _idleConnections;
+    std::mutex _connectionMutex;
+
+    bool _keepAliveEnabled;
+    int _idleConnectionTimeout;
+    bool _decompressionEnabled;
+
     std::string _cookieFilename;
     std::recursive_mutex _cookieFileMutex;
 
@@ -233,6 +233,11 @@ public:
      *       will not accumulate data chunks automatically. You must handle all data
      *       storage/processing within the callback function.
      *
+     * @note The callback is invoked on the network thread as soon as each chunk is parsed, the
+     *       response code is already valid at that point. Bodies of redirects that are followed
+     *       are not passed to it. A slow callback delays reading from the socket, so the server is
+     *       throttled by TCP flow control rather than the response being buffered in memory.
+     *
      * @note The callback receives the following parameters:
      *       - HttpResponse* response: The response object containing request context
      *       - const char* data: Pointer to the received data chunk
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "axmol/network/HttpResponse.h"
+#include "yasio/tlx/string_view.hpp"
+#include "zlib.h"
+
+using namespace std::string_view_literals;
+
+namespace ax
+{
+
+namespace network
+{
+
+bool HttpResponse::beginContentDecoding()
+{
+    auto iter = _responseHeaders.find("content-encoding");
+    if (iter == _responseHeaders.end())
+        return true;
+
+    std::string_view encoding = iter->second;
+    if (!tlx::ic::iequals(encoding, "gzip"sv) && !tlx::ic::iequals(encoding, "x-gzip"sv) &&
+        !tlx::ic::iequals(encoding, "deflate"sv))
+        return true;
+
+    endContentDecoding();
+
+    auto stream = new z_stream{};
+    // 32: detect gzip or zlib header automatically
+    if (inflateInit2(stream, MAX_WBITS + 32) != Z_OK)
+    {
+        AXLOGW("HttpResponse: inflateInit2 failed, content encoding: {}", encoding);
+        delete stream;
+        return false;
+    }
+
+    _inflateStream = stream;
+    _rawDeflate    = false;
+    return true;
+}
+
+int HttpResponse::decodeBody(const char* at, size_t length)
+{
+    auto stream      = _inflateStream;
+    stream->next_in  = (Bytef*)at;
+    stream->avail_in = static_cast<uInt>(length);
+
+    char buffer[16384];
+    do
+    {
+        stream->next_out  = (Bytef*)buffer;
+        stream->avail_out = sizeof(buffer);
+
+        auto err = inflate(stream, Z_NO_FLUSH);
+        if (err == Z_DATA_ERROR && !_rawDeflate && stream->total_out == 0)
+        {
+            // 'deflate' without the zlib wrapper, restart the chunk as raw deflate data
+            _rawDeflate = true;
+            if (inflateReset2(stream, -MAX_WBITS) != Z_OK)
+                return -1;
+            return decodeBody(at, length);
+        }
+        if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+        {
+            AXLOGW("HttpResponse: inflate failed: {}", err);
+            return -1;
+        }
+
+        auto decodedBytes = sizeof(buffer) - stream->avail_out;
+        if (decodedBytes > 0)
+            appendBody(buffer, decodedBytes);
+
+        if (err == Z_STREAM_END)
+            break;
+    } while (stream->avail_in > 0 || stream->avail_out == 0);
+
+    return 0;
+}
+
+void HttpResponse::endContentDecoding()
+{
+    if (_inflateStream)
+    {
+        inflateEnd(_inflateStream);
+        delete _inflateStream;
+        _inflateStream = nullptr;
+    }
+}
+
+}  // namespace network
+
+}  // namespace ax
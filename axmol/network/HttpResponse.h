@@ -33,6 +33,8 @@
 #include "axmol/network/Uri.h"
 #include "llhttp.h"
 
+struct z_stream_s;
+
 /**
  * @addtogroup network
  * @{
@@ -76,6 +78,7 @@ public:
      */
     virtual ~HttpResponse()
     {
+        endContentDecoding();
         if (_pHttpRequest)
         {
             _pHttpRequest->release();
@@ -147,7 +150,55 @@ private:
      */
     bool isFinished() const { return _finished; }
 
-    llhttp_errno_t input(const char* d, size_t n) { return llhttp_execute(&_context, d, n); }
+    llhttp_errno_t input(const char* d, size_t n)
+    {
+        _dataReceived = true;
+        return llhttp_execute(&_context, d, n);
+    }
+
+    /**
+     * Whether any response data arrived, a kept alive connection closed before that can be retried safely.
+     */
+    bool isDataReceived() const { return _dataReceived; }
+
+    /**
+     * Whether the connection can serve another request after this response.
+     */
+    bool shouldKeepAlive() const { return llhttp_should_keep_alive(&_context) != 0; }
+
+    /**
+     * Decode gzip or deflate encoded bodies, set by HttpClient when it sent Accept-Encoding on its own.
+     */
+    void setContentDecoding(bool enabled) { _contentDecoding = enabled; }
+
+    // starts an inflate stream when the body is gzip or deflate encoded, returns false on failure
+    bool beginContentDecoding();
+    int decodeBody(const char* at, size_t length);
+    void endContentDecoding();
+
+    void appendBody(const char* at, size_t length)
+    {
+        auto& dataCallback = _pHttpRequest->getDataCallback();
+        if (!dataCallback)
+            _responseData.insert(_responseData.end(), at, at + length);
+        else if (!_redirecting)
+            dataCallback(this, at, length);
+    }
+
+    // whether tryRedirect will follow this response, its body isn't the requested content then
+    bool willRedirect() const
+    {
+        switch (_responseCode)
+        {
+        case 301:
+        case 302:
+        case 307:
+            return _redirectCount < HttpRequest::MAX_REDIRECT_COUNT &&
+                   _responseHeaders.find("location") != _responseHeaders.end();
+        default:
+            return false;
+        }
+    }
 
     bool tryRedirect()
     {
@@ -195,6 +246,9 @@ private:
             _statusText.clear();
             _responseCode = -1;
             _internalCode = 0;
+            _dataReceived = false;
+            _redirecting  = false;
+            endContentDecoding();
 
             /* Initialize user callbacks and settings */
             llhttp_settings_init(&_contextSettings);
@@ -233,6 +287,10 @@ private:
             llhttp_finish(&_context);
         else
             _internalCode = -1;
+
+        // the status was taken from the headers, a truncated response must not look successful
+        if (!_finished)
+            _responseCode = -1;
     }
 
     static int on_status(llhttp_t* context, const char* at, size_t length)
@@ -272,20 +330,24 @@ private:
     {
         auto thiz            = (HttpResponse*)context->data;
         thiz->_contentLength = context->content_length;
-        auto request         = thiz->getHttpRequest();
+        // the status is known before the first body chunk, so a data callback can tell content from an error page
+        thiz->_responseCode = context->status_code;
+        thiz->_redirecting  = thiz->willRedirect();
+        auto request        = thiz->getHttpRequest();
         if (!request->getDataCallback() && thiz->_contentLength > 0)
             thiz->_responseData.reserve(thiz->_contentLength);
+
+        if (thiz->_contentDecoding && !thiz->beginContentDecoding())
+            return -1;
         return 0;
     }
     static int on_body(llhttp_t* context, const char* at, size_t length)
     {
-        auto thiz         = (HttpResponse*)context->data;
-        auto request      = thiz->getHttpRequest();
-        auto dataCallback = request->getDataCallback();
-        if (!dataCallback)
-            thiz->_responseData.insert(thiz->_responseData.end(), at, at + length);
-        else
-            dataCallback(thiz, at, length);
+        auto thiz = (HttpResponse*)context->data;
+        if (thiz->_inflateStream)
+            return thiz->decodeBody(at, length);
+
+        thiz->appendBody(at, length);
         return 0;
     }
     static int on_complete(llhttp_t* context)
@@ -313,6 +375,11 @@ protected:
     std::string _statusText;
     llhttp_t _context;
     llhttp_settings_t _contextSettings;
+    bool _dataReceived         = false;
+    bool _redirecting          = false;  /// the body of a followed redirect isn't passed to the data callback
+    bool _contentDecoding      = false;
+    bool _rawDeflate           = false;    /// the deflate body has no zlib header, some servers send it that way
+    z_stream_s* _inflateStream = nullptr;  /// decodes a compressed body, see beginContentDecoding
 };
 
 }  // namespace network
@@ -44,6 +44,7 @@ class AX_DLL IDownloadContext
 public:
     virtual ~IDownloadContext() {}
     virtual void cancel() {}
+    virtual void resume() {}
 };
 
 class IDownloaderImpl
@@ -53,6 +54,8 @@ public:
 
     std::function<void(const DownloadTask& task)> onTaskProgress;
 
+    std::function<bool(const DownloadTask& task, const unsigned char* data, size_t size)> onTaskData;
+
     std::function<void(const DownloadTask& task,
                        int errorCode,
                        int errorCodeInternal,
@@ -61,6 +64,8 @@ public:
         onTaskFinish;
 
     virtual void startTask(std::shared_ptr<DownloadTask>& task) = 0;
+
+    virtual void warmup(std::string_view /*url*/, std::string_view /*cacertPath*/) {}
 };
 
 }  // namespace network
@@ -28,11 +28,20 @@
 #include "axmol/network/WebSocket.h"
 
 #include "axmol/tlx/format.hpp"
+#include "axmol/base/text_utils.h"
+
+#include "zlib.h"
 
 using namespace yasio;
 
 #define WS_MAX_PAYLOAD_LENGTH (1 << 24)  // 16M
 
+// shorter messages are sent uncompressed, deflate rarely pays off for them
+#define WS_DEFLATE_MIN_LENGTH 256
+
+// a batch is written before it grows past this size
+#define WS_SEND_BATCH_LIMIT (1 << 16)
+
 namespace ax
 {
 
@@ -162,13 +171,135 @@ enum class opcode : std::uint8_t
 }  // namespace detail
 }  // namespace ws
 
+/** permessage-deflate, see https://tools.ietf.org/html/rfc7692 */
+struct WebSocket::PerMessageDeflate
+{
+    z_stream inflater{};
+    z_stream deflater{};
+    bool inflaterReady           = false;
+    bool deflaterReady           = false;
+    bool clientNoContextTakeover = false;
+
+    tlx::sbyte_buffer inflated;  // network thread
+    tlx::sbyte_buffer deflated;  // Axmol thread
+
+    ~PerMessageDeflate()
+    {
+        if (inflaterReady)
+            inflateEnd(&inflater);
+        if (deflaterReady)
+            deflateEnd(&deflater);
+    }
+
+    // Parses the extension accepted by the server, e.g. "permessage-deflate; client_max_window_bits=10"
+    bool init(std::string_view extensions)
+    {
+        int clientWindowBits = 15;
+        bool accepted        = false;
+        while (!extensions.empty() && !accepted)
+        {
+            auto extension = extensions.substr(0, extensions.find(','));
+            extensions.remove_prefix((std::min)(extension.size() + 1, extensions.size()));
+
+            bool first = true;
+            while (!extension.empty())
+            {
+                auto param = extension.substr(0, extension.find(';'));
+                extension.remove_prefix((std::min)(param.size() + 1, extension.size()));
+                param = text_utils::trim(param);
+                if (first)
+                {
+                    first    = false;
+                    accepted = param == "permessage-deflate"sv;
+                    if (!accepted)
+                        break;
+                }
+                else if (param == "client_no_context_takeover"sv)
+                    clientNoContextTakeover = true;
+                else if (param.starts_with("client_max_window_bits="sv))
+                    clientWindowBits = atoi(std::string{param.substr(param.find('=') + 1)}.c_str());
+            }
+        }
+        if (!accepted)
+            return false;
+
+        // server_max_window_bits is at most 15, inflating with 15 handles any of them
+        inflaterReady = inflateInit2(&inflater, -MAX_WBITS) == Z_OK;
+
+        // zlib can't produce a raw deflate stream with an 8 bits window, send uncompressed messages then
+        if (clientWindowBits >= 9 && clientWindowBits <= 15)
+            deflaterReady =
+                deflateInit2(&deflater, Z_BEST_SPEED, Z_DEFLATED, -clientWindowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        return inflaterReady;
+    }
+
+    bool inflateMessage(tlx::sbyte_buffer& message)
+    {
+        // the sender strips the trailing empty stored block of the sync flush
+        static const char tail[] = {'\x00', '\x00', '\xff', '\xff'};
+        message.extend(std::begin(tail), std::end(tail));
+
+        inflated.clear();
+        inflater.next_in  = reinterpret_cast<Bytef*>(message.data());
+        inflater.avail_in = static_cast<uInt>(message.size());
+        int ret           = Z_OK;
+        do
+        {
+            auto used = inflated.size();
+            inflated.resize((std::max)(inflated.capacity(), used + (std::max)(message.size() * 4, size_t{4096})));
+            inflater.next_out  = reinterpret_cast<Bytef*>(inflated.data() + used);
+            inflater.avail_out = static_cast<uInt>(inflated.size() - used);
+            ret                = ::inflate(&inflater, Z_SYNC_FLUSH);
+            inflated.resize(inflated.size() - inflater.avail_out);
+            if (inflated.size() > WS_MAX_PAYLOAD_LENGTH)
+                return false;
+        } while (ret == Z_OK && inflater.avail_out == 0);
+
+        if (ret == Z_STREAM_END)
+            inflateReset(&inflater);
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return false;
+        return true;
+    }
+
+    bool deflateMessage(const char* data, size_t len)
+    {
+        if (!deflaterReady)
+            return false;
+
+        deflated.resize(deflateBound(&deflater, static_cast<uLong>(len)) + 16);
+        deflater.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        deflater.avail_in  = static_cast<uInt>(len);
+        deflater.next_out  = reinterpret_cast<Bytef*>(deflated.data());
+        deflater.avail_out = static_cast<uInt>(deflated.size());
+        if (::deflate(&deflater, Z_SYNC_FLUSH) != Z_OK || deflater.avail_in != 0 || deflater.avail_out == 0)
+        {
+            // nothing of this message reaches the server, start over without the context it may reference
+            deflateReset(&deflater);
+            return false;
+        }
+
+        // the message still goes out compressed when it didn't shrink, the server's window must see it
+        auto size = deflated.size() - deflater.avail_out;
+        if (size >= 4 && memcmp(deflated.data() + size - 4, "\x00\x00\xff\xff", 4) == 0)
+            size -= 4;
+        deflated.resize(size);
+
+        if (clientNoContextTakeover)
+            deflateReset(&deflater);
+        return true;
+    }
+};
+
 struct WebSocketProtocol
 {
-    static int sendFrame(WebSocket& ws,
-                         const char* buf,
-                         size_t len,
-                         ws::detail::opcode opcode /* = WS_OPCODE_BINARY */,
-                         bool fin = true)
+    // Appends a masked frame to buffer, returns the frame size
+    static size_t buildFrame(tlx::sbyte_buffer& buffer,
+                             const char* buf,
+                             size_t len,
+                             ws::detail::opcode opcode,
+                             bool fin,
+                             bool compressed)
     {
         int flags = (int)opcode;
 
@@ -183,11 +314,78 @@ struct WebSocketProtocol
 
         if (fin)
             flags |= WS_FIN;
+        if (compressed)
+            flags |= WS_RSV1;
         auto frame_size = websocket_calc_frame_size((websocket_flags)flags, len);
-        tlx::sbyte_buffer sb;
-        sb.resize(frame_size);
-        websocket_build_frame(sb.data(), (websocket_flags)flags, mask, buf, len);
-        return ws._service->write(ws._transport, std::move(sb));  // write(sendbuf_.base, frame_size);
+        auto offset     = buffer.size();
+        buffer.resize(offset + frame_size);
+        websocket_build_frame(buffer.data() + offset, (websocket_flags)flags, mask, buf, len);
+        return frame_size;
+    }
+
+    // Forwards a pooled buffer to the transport without copying it, the buffer returns to the pool once written
+    static int forward(WebSocket& ws, tlx::sbyte_buffer* buffer)
+    {
+        WebSocket* thiz = &ws;
+        int ret         = ws._service->forward(ws._transport, buffer->data(), buffer->size(),
+                                               [thiz, buffer](int, size_t) { thiz->releaseSendBuffer(buffer); });
+        if (ret < 0)
+            ws.releaseSendBuffer(buffer);
+        return ret;
+    }
+
+    static int sendFrame(WebSocket& ws,
+                         const char* buf,
+                         size_t len,
+                         ws::detail::opcode opcode /* = WS_OPCODE_BINARY */,
+                         bool fin        = true,
+                         bool compressed = false)
+    {
+        auto buffer   = ws.acquireSendBuffer();
+        auto capacity = buffer->capacity();
+        buildFrame(*buffer, buf, len, opcode, fin, compressed);
+        if (buffer->capacity() != capacity)
+            ws.countAllocation();
+        return forward(ws, buffer);
+    }
+
+    static void sendMessage(WebSocket& ws, const char* buf, size_t len, ws::detail::opcode opcode)
+    {
+        bool compressed = false;
+        if (ws._deflate && len >= WS_DEFLATE_MIN_LENGTH)
+        {
+            auto capacity = ws._deflate->deflated.capacity();
+            compressed    = ws._deflate->deflateMessage(buf, len);
+            if (ws._deflate->deflated.capacity() != capacity)
+                ws.countAllocation();
+            if (compressed)
+            {
+                buf = ws._deflate->deflated.data();
+                len = ws._deflate->deflated.size();
+            }
+        }
+
+        size_t frameSize = 0;
+        if (ws._sendBatching)
+        {
+            if (!ws._sendBatch)
+                ws._sendBatch = ws.acquireSendBuffer();
+            auto capacity = ws._sendBatch->capacity();
+            frameSize     = buildFrame(*ws._sendBatch, buf, len, opcode, true, compressed);
+            if (ws._sendBatch->capacity() != capacity)
+                ws.countAllocation();
+            if (ws._sendBatch->size() >= WS_SEND_BATCH_LIMIT)
+                ws.flushSendBatch();
+        }
+        else
+        {
+            frameSize = websocket_calc_frame_size((websocket_flags)(WS_HAS_MASK), len);
+            sendFrame(ws, buf, len, opcode, true, compressed);
+        }
+
+        std::lock_guard<std::mutex> lck(ws._statsMtx);
+        ++ws._stats.messagesSent;
+        ws._stats.bytesSent += frameSize;
     }
 };
 
@@ -214,6 +412,8 @@ WebSocket::WebSocket() : _isDestroyed(std::make_shared<std::atomic<bool>>(false)
 WebSocket::~WebSocket()
 {
     Director::getInstance()->getEventDispatcher()->removeEventListener(_resetDirectorListener);
+    if (_afterUpdateListener)
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterUpdateListener);
     *_isDestroyed = true;
 
     delete _service;
@@ -237,6 +437,16 @@ bool WebSocket::open(Delegate* delegate, std::string_view url, std::string_view
     _closeCode   = ws::detail::close_code::none;
     _closeReason = "";
 
+    _deflate.reset();
+    _deflateActive = false;
+    _compressed    = false;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_receivedDataMtx);
+        _inbox.bytes.clear();
+        _inbox.entries.clear();
+        _hasInbound = false;
+    }
+
     setupParsers();
     generateHandshakeSecKey();
 
@@ -266,11 +476,19 @@ void WebSocket::purgePendingEvents()
 
 void WebSocket::dispatchEvents()
 {
-    if (_eventQueue.unsafe_empty())
+    if (_eventQueue.unsafe_empty() && !_hasInbound)
         return;
     if (_delegate)
     {
         auto lck = _eventQueue.get_lock();
+
+        // the queued events are locked first, so every message received before a close or an error is in the inbox
+        {
+            std::lock_guard<std::recursive_mutex> inboxLck(_receivedDataMtx);
+            std::swap(_inbox, _dispatching);
+            _hasInbound = false;
+        }
+
         while (!_eventQueue.empty())
         {
             auto event = _eventQueue.front();
@@ -282,9 +500,11 @@ void WebSocket::dispatchEvents()
                 _delegate->onOpen(this);
                 break;
             case Event::Type::ON_CLOSE:
+                dispatchMessages(_dispatching);
                 _delegate->onClose(this, _closeCode, _closeReason);
                 break;
             case Event::Type::ON_ERROR:
+                dispatchMessages(_dispatching);
                 _delegate->onError(this, static_cast<ErrorEvent*>(event)->getErrorCode());
                 break;
             case Event::Type::ON_MESSAGE:
@@ -294,9 +514,110 @@ void WebSocket::dispatchEvents()
 
             event->release();
         }
+
+        dispatchMessages(_dispatching);
     }
 }
 
+void WebSocket::dispatchMessages(InboundMessages& messages)
+{
+    if (messages.entries.empty())
+        return;
+
+    _dispatchViews.clear();
+    for (auto&& entry : messages.entries)
+        _dispatchViews.emplace_back(messages.bytes.data() + entry.offset, entry.len, entry.isBinary);
+
+    // keep the capacity, the buffers are swapped back in as the next inbox
+    messages.bytes.clear();
+    messages.entries.clear();
+
+    _delegate->onMessages(this, _dispatchViews);
+}
+
+void WebSocket::handleMessage(const char* bytes, size_t len, bool isBinary)
+{
+    if (_networkThreadHandler)
+    {
+        _networkThreadHandler(this, Data{bytes, len, isBinary});
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lck(_receivedDataMtx);
+    auto capacity = _inbox.bytes.capacity();
+    auto offset   = _inbox.bytes.size();
+    _inbox.bytes.extend(bytes, bytes + len);
+    _inbox.entries.push_back(InboundMessages::Entry{offset, len, isBinary});
+    if (_inbox.bytes.capacity() != capacity)
+        countAllocation();
+    _hasInbound = true;
+}
+
+tlx::sbyte_buffer* WebSocket::acquireSendBuffer()
+{
+    std::lock_guard<std::mutex> lck(_sendBuffersMtx);
+    if (_freeSendBuffers.empty())
+    {
+        countAllocation();
+        return _sendBuffers.emplace_back(std::make_unique<tlx::sbyte_buffer>()).get();
+    }
+    auto buffer = _freeSendBuffers.back();
+    _freeSendBuffers.pop_back();
+    return buffer;
+}
+
+void WebSocket::releaseSendBuffer(tlx::sbyte_buffer* buffer)
+{
+    buffer->clear();
+    std::lock_guard<std::mutex> lck(_sendBuffersMtx);
+    _freeSendBuffers.emplace_back(buffer);
+}
+
+void WebSocket::countAllocation()
+{
+    std::lock_guard<std::mutex> lck(_statsMtx);
+    ++_stats.bufferAllocations;
+}
+
+WebSocket::Stats WebSocket::getStats() const
+{
+    std::lock_guard<std::mutex> lck(_statsMtx);
+    return _stats;
+}
+
+void WebSocket::setSendBatchingEnabled(bool enabled)
+{
+    if (_sendBatching == enabled)
+        return;
+
+    _sendBatching   = enabled;
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    if (enabled)
+    {
+        _afterUpdateListener = dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE,
+                                                                  [this](EventCustom*) { flushSendBatch(); });
+    }
+    else
+    {
+        flushSendBatch();
+        dispatcher->removeEventListener(_afterUpdateListener);
+        _afterUpdateListener = nullptr;
+    }
+}
+
+void WebSocket::flushSendBatch()
+{
+    if (!_sendBatch)
+        return;
+
+    auto batch = _sendBatch;
+    _sendBatch = nullptr;
+    if (_transport && !batch->empty())
+        WebSocketProtocol::forward(*this, batch);
+    else
+        releaseSendBuffer(batch);
+}
+
 void WebSocket::setupParsers()
 {
     /// http parser for handshake
@@ -335,22 +656,27 @@ int WebSocket::on_frame_header(websocket_parser* parser)
     WebSocket* ws = static_cast<WebSocket*>(parser->data);
     int opcode    = parser->flags & WS_OP_MASK;
 
-    std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
-    auto& message = ws->_receivedData;
+    // control frames may arrive between the fragments of a message, they are assembled apart
+    ws->_frameOpcode = opcode;
+    if (opcode & 0x8)
+    {
+        ws->_controlData.clear();
+        return 0;
+    }
 
+    auto& message = ws->_receivedData;
     if (opcode != WS_OP_CONTINUE)
-        ws->_opcode = opcode;
-    auto length         = parser->length;
-    auto reserve_length = (std::min)(length + 1, static_cast<size_t>(WS_MAX_PAYLOAD_LENGTH));
-    if (reserve_length > ws->_receivedData.capacity())
     {
-        message.reserve(reserve_length);
+        ws->_opcode     = opcode;
+        ws->_compressed = ws->_deflate && (parser->flags & WS_RSV1);
+        message.clear();
     }
-    switch (ws->_frameState)
+
+    auto reserve_length = (std::min)(message.size() + parser->length + 1, static_cast<size_t>(WS_MAX_PAYLOAD_LENGTH));
+    if (reserve_length > message.capacity())
     {
-    case FrameState::BEGIN:
-    case FrameState::FIN:
-        message.clear();
+        message.reserve(reserve_length);
+        ws->countAllocation();
     }
     ws->_frameState = FrameState::HEADER;
     return 0;
@@ -363,8 +689,10 @@ int WebSocket::on_frame_body(websocket_parser* parser, const char* at, size_t le
     if (parser->flags & WS_HAS_MASK)
         websocket_parser_decode(const_cast<char*>(at), at, length, parser);
 
-    std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
-    ws->_receivedData.extend(at, at + length);
+    if (ws->_frameOpcode & 0x8)
+        ws->_controlData.extend(at, at + length);
+    else
+        ws->_receivedData.extend(at, at + length);
     return 0;
 }
 
@@ -373,40 +701,60 @@ int WebSocket::on_frame_end(websocket_parser* parser)
     WebSocket* ws = static_cast<WebSocket*>(parser->data);
 
     ws->_frameState = FrameState::END;
-    if (parser->flags & WS_FIN)
-    {
-        ws->_frameState = FrameState::FIN;
+    if (!(parser->flags & WS_FIN))
+        return 0;
+
+    ws->_frameState = FrameState::FIN;
 
-        std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
-        switch (ws->_opcode)
+    auto& control = ws->_controlData;
+    switch (ws->_frameOpcode)
+    {
+    case WS_OP_TEXT:
+    case WS_OP_BINARY:
+    case WS_OP_CONTINUE:
+        if (ws->_compressed)
         {
-        case WS_OP_TEXT:
-        case WS_OP_BINARY:
-            AX_ASSERT(!ws->_receivedData.empty());
-            ws->_eventQueue.emplace_back(new MessageEvent{std::move(ws->_receivedData), ws->_opcode == WS_OP_BINARY});
-            break;
-        case WS_OP_CLOSE:
-            AXLOGD("WS: control frame: CLOSE");
-            if (ws->_receivedData.size() > 1)
+            auto capacity = ws->_deflate->inflated.capacity();
+            if (!ws->_deflate->inflateMessage(ws->_receivedData))
             {
-                if (ws->_closeCode == 0)
-                    ws->_closeCode = ((uint16_t)ws->_receivedData.data()[0]) << 8 | ws->_receivedData.data()[1];
-
-                if (ws->_receivedData.size() > 2 && ws->_closeReason.empty())
-                    ws->_closeReason = std::string(ws->_receivedData.data()[3], ws->_receivedData.size() - 2);
+                AXLOGE("WS: invalid compressed message");
+                ws->_closeCode   = ws::detail::close_code::bad_payload;
+                ws->_closeReason = "Invalid compressed message";
+                ws->_service->close(0);
+                return 1;
             }
-            break;
-        case WS_OP_PING:
-            AXLOGD("WS: control frame: PING");
-            WebSocketProtocol::sendFrame(*ws, ws->_receivedData.data(), ws->_receivedData.size(),
-                                         ws::detail::opcode::pong);
-            break;
-        case WS_OP_PONG:
-            AXLOGD("WS: control frame: PONG");
-            if (ws->_receivedData.size() != 4 || 0 != memcmp(ws->_receivedData.data(), "WSWS", 4))
-                AXLOGD("WS: Unsolicited PONG frame from server (possible keep-alive)\n\n");
-            break;
+            if (ws->_deflate->inflated.capacity() != capacity)
+                ws->countAllocation();
+            auto& inflated = ws->_deflate->inflated;
+            ws->handleMessage(inflated.data(), inflated.size(), ws->_opcode == WS_OP_BINARY);
+        }
+        else
+            ws->handleMessage(ws->_receivedData.data(), ws->_receivedData.size(), ws->_opcode == WS_OP_BINARY);
+        {
+            std::lock_guard<std::mutex> lck(ws->_statsMtx);
+            ++ws->_stats.messagesReceived;
+        }
+        break;
+    case WS_OP_CLOSE:
+        AXLOGD("WS: control frame: CLOSE");
+        if (control.size() > 1)
+        {
+            if (ws->_closeCode == 0)
+                ws->_closeCode = ((uint16_t)(uint8_t)control.data()[0]) << 8 | (uint8_t)control.data()[1];
+
+            if (control.size() > 2 && ws->_closeReason.empty())
+                ws->_closeReason = std::string(control.data() + 2, control.size() - 2);
         }
+        break;
+    case WS_OP_PING:
+        AXLOGD("WS: control frame: PING");
+        WebSocketProtocol::sendFrame(*ws, control.data(), control.size(), ws::detail::opcode::pong);
+        break;
+    case WS_OP_PONG:
+        AXLOGD("WS: control frame: PONG");
+        if (control.size() != 4 || 0 != memcmp(control.data(), "WSWS", 4))
+            AXLOGD("WS: Unsolicited PONG frame from server (possible keep-alive)\n\n");
+        break;
     }
 
     return 0;
@@ -422,7 +770,7 @@ void WebSocket::send(std::string_view message)
 {
     if (!_transport || message.empty())
         return;
-    WebSocketProtocol::sendFrame(*this, message.data(), message.length(), ws::detail::opcode::text);
+    WebSocketProtocol::sendMessage(*this, message.data(), message.length(), ws::detail::opcode::text);
 }
 
 /**
@@ -436,7 +784,7 @@ void WebSocket::send(const void* data, unsigned int len)
 {
     if (!_transport || len == 0)
         return;
-    WebSocketProtocol::sendFrame(*this, static_cast<const char*>(data), len, ws::detail::opcode::binary);
+    WebSocketProtocol::sendMessage(*this, static_cast<const char*>(data), len, ws::detail::opcode::binary);
 }
 
 /**
@@ -458,6 +806,8 @@ void WebSocket::close(uint16_t code, std::string_view reason)
             obs.write(_closeCode);
             obs.write_bytes(reason);
 
+            flushSendBatch();
+
             WebSocketProtocol::sendFrame(*this, obs.data(), obs.length(), ws::detail::opcode::close);
 
             _service->close(0);
@@ -543,6 +893,20 @@ void WebSocket::handleNetworkEvent(yasio::io_event* event)
                 else
                     error = ErrorCode::UPGRADE_FAILURE;
 
+                if (error == ErrorCode::OK && _deflateRequested)
+                {
+                    auto it = _responseHeaders.find("sec-websocket-extensions");
+                    if (it != _responseHeaders.end())
+                    {
+                        auto deflate = std::make_unique<PerMessageDeflate>();
+                        if (deflate->init(it->second))
+                        {
+                            _deflate       = std::move(deflate);
+                            _deflateActive = true;
+                        }
+                    }
+                }
+
                 if (error == ErrorCode::OK)
                 {
                     _state             = State::OPEN;
@@ -574,6 +938,10 @@ void WebSocket::handleNetworkEvent(yasio::io_event* event)
         else if (_state == State::OPEN)
         {
             auto&& pkt = event->packet_view();
+            {
+                std::lock_guard<std::mutex> lck(_statsMtx);
+                _stats.bytesReceived += pkt.size();
+            }
             websocket_parser_execute(&_wsParser, &_wsParserSettings, pkt.data(), pkt.size());
         }  // else unreachable
         break;
@@ -612,6 +980,9 @@ void WebSocket::handleNetworkEvent(yasio::io_event* event)
             obs.write_bytes(_handshakeSecKey);
             obs.write_bytes("\r\n");
 
+            if (_deflateRequested)
+                obs.write_bytes("Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n");
+
             if (!_protocols.empty())
             {
                 obs.write_bytes("Sec-WebSocket-Protocol: ");
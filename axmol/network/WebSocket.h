@@ -44,6 +44,8 @@
 #    include <atomic>
 #    include <condition_variable>
 #    include <future>
+#    include <functional>
+#    include <span>
 
 #    include "axmol/platform/PlatformMacros.h"
 #    include "axmol/platform/StdC.h"
@@ -184,12 +186,33 @@ public:
             , issued(0)
             , ext(nullptr)
         {}
+        Data(const char* bytes_, size_t len_, bool isBinary_)
+            : bytes(bytes_), len(len_), issued(0), isBinary(isBinary_), ext(nullptr)
+        {}
         const char* bytes;
         size_t len, issued;
         bool isBinary;
         void* ext;
     };
 
+    /**
+     * Counters of a connection. The bytes are counted on the wire, so compressed messages count their compressed
+     * size. bufferAllocations counts the buffers the WebSocket had to allocate or grow to send and receive messages.
+     */
+    struct Stats
+    {
+        uint64_t messagesSent      = 0;
+        uint64_t messagesReceived  = 0;
+        uint64_t bytesSent         = 0;
+        uint64_t bytesReceived     = 0;
+        uint64_t bufferAllocations = 0;
+    };
+
+    /**
+     * Handles a message on the network thread, see setNetworkThreadMessageHandler.
+     */
+    using MessageHandler = std::function<void(WebSocket* ws, const Data& data)>;
+
     /**
      * The delegate class is used to process websocket events.
      *
@@ -215,6 +238,18 @@ public:
          * @param data Data object for message.
          */
         virtual void onMessage(WebSocket* ws, const Data& data) = 0;
+        /**
+         * This function is called once per frame with the messages received since the previous frame, in order.
+         * The default implementation calls onMessage for each of them. The data is only valid during the call.
+         *
+         * @param ws The WebSocket object connected.
+         * @param messages The received messages.
+         */
+        virtual void onMessages(WebSocket* ws, std::span<const Data> messages)
+        {
+            for (auto&& data : messages)
+                onMessage(ws, data);
+        }
         /**
          * When the WebSocket object connected wants to close or the protocol won't get used at all and current
          * _readyState is State::CLOSING,this function is to be called.
@@ -271,6 +306,38 @@ public:
      */
     void send(const void* data, unsigned int len);
 
+    /**
+     *  @brief Offers the permessage-deflate extension (RFC 7692) in the handshake, must be set before open.
+     *         Messages shorter than a few hundred bytes are still sent uncompressed.
+     */
+    void setPerMessageDeflateEnabled(bool enabled) { _deflateRequested = enabled; }
+    bool isPerMessageDeflateEnabled() const { return _deflateRequested; }
+
+    /**
+     *  @brief Whether the server accepted permessage-deflate, valid once the connection is open.
+     */
+    bool isPerMessageDeflateActive() const { return _deflateActive; }
+
+    /**
+     *  @brief Coalesces the messages sent during a frame into one write issued after the scene update.
+     *         Fewer writes and syscalls for games sending many small messages, at the cost of sending them at the
+     *         end of the frame instead of right away.
+     */
+    void setSendBatchingEnabled(bool enabled);
+    bool isSendBatchingEnabled() const { return _sendBatching; }
+
+    /**
+     *  @brief Handles the text and binary messages on the network thread instead of the Axmol thread, the Delegate
+     *         doesn't receive them then. The data is only valid during the call, the handler must not block.
+     *         Must be set before open.
+     */
+    void setNetworkThreadMessageHandler(MessageHandler handler) { _networkThreadHandler = std::move(handler); }
+
+    /**
+     *  @brief Gets the message and buffer counters of this WebSocket.
+     */
+    Stats getStats() const;
+
     /**
      *  @brief Closes the connection to server synchronously.
      *  @note It's a synchronous method, it will not return until websocket thread exits.
@@ -324,8 +391,30 @@ public:
     const std::vector<std::string>& getHeaders() const { return _headers; }
 
 protected:
+    struct PerMessageDeflate;
+
+    // messages received on the network thread, waiting for dispatchEvents
+    struct InboundMessages
+    {
+        struct Entry
+        {
+            size_t offset;
+            size_t len;
+            bool isBinary;
+        };
+        tlx::sbyte_buffer bytes;
+        std::vector<Entry> entries;
+    };
+
     void purgePendingEvents();
     void dispatchEvents();
+    void dispatchMessages(InboundMessages& messages);
+    void flushSendBatch();
+    void handleMessage(const char* bytes, size_t len, bool isBinary);
+
+    tlx::sbyte_buffer* acquireSendBuffer();
+    void releaseSendBuffer(tlx::sbyte_buffer* buffer);
+    void countAllocation();
 
     void setupParsers();
     void generateHandshakeSecKey();
@@ -424,6 +513,8 @@ protected:
     };
     FrameState _frameState = FrameState::BEGIN;
     int _opcode            = 0;
+    int _frameOpcode       = 0;
+    bool _compressed       = false;  // the message being received has RSV1 set
 
     std::string _currentHeader;
     std::string _currentHeaderValue;
@@ -436,9 +527,31 @@ protected:
     uint16_t _closeCode;
     std::string _closeReason;
 
-    // for receiveData
+    // for receiveData, the message and control frame being assembled, only accessed on the network thread
     tlx::sbyte_buffer _receivedData;
+    tlx::sbyte_buffer _controlData;
     std::recursive_mutex _receivedDataMtx;
+    InboundMessages _inbox;        // guarded by _receivedDataMtx
+    InboundMessages _dispatching;  // swapped with _inbox by dispatchEvents
+    std::vector<Data> _dispatchViews;
+    std::atomic_bool _hasInbound{false};
+    MessageHandler _networkThreadHandler;
+
+    // permessage-deflate
+    bool _deflateRequested = false;
+    bool _deflateActive    = false;
+    std::unique_ptr<PerMessageDeflate> _deflate;
+
+    // frames are built in pooled buffers and forwarded to the transport, they return to the pool once written
+    std::vector<std::unique_ptr<tlx::sbyte_buffer>> _sendBuffers;
+    std::vector<tlx::sbyte_buffer*> _freeSendBuffers;
+    std::mutex _sendBuffersMtx;
+    bool _sendBatching            = false;
+    tlx::sbyte_buffer* _sendBatch = nullptr;
+    EventListenerCustom* _afterUpdateListener{};
+
+    Stats _stats;
+    mutable std::mutex _statsMtx;
 
     EventListenerCustom* _resetDirectorListener;
 
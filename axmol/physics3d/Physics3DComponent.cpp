@@ -70,11 +70,14 @@ void Physics3DComponent::setPhysics3DObject(Physics3DObject* physicsObj)
 {
     AX_SAFE_RETAIN(physicsObj);
     AX_SAFE_RELEASE(_physics3DObj);
-    _physics3DObj = physicsObj;
+    _physics3DObj  = physicsObj;
+    _physicsSynced = false;
 }
 
 Physics3DComponent::Physics3DComponent()
-    : _physics3DObj(nullptr), _syncFlag(Physics3DComponent::PhysicsSyncFlag::NODE_AND_NODE)
+    : _physics3DObj(nullptr)
+    , _syncFlag(Physics3DComponent::PhysicsSyncFlag::NODE_AND_NODE)
+    , _physicsSynced(false)
 {}
 
 void Physics3DComponent::setEnabled(bool b)
@@ -95,6 +98,7 @@ void Physics3DComponent::addToPhysicsWorld(Physics3DWorld* world)
     {
         _physics3DObj->setPhysicsWorld(world);
         world->addPhysics3DObject(_physics3DObj);
+        _physicsSynced = false;
         auto& components = world->_physicsComponents;
         auto it          = std::find(components.begin(), components.end(), this);
         if (it == components.end())
@@ -150,6 +154,11 @@ void Physics3DComponent::preSimulate()
 {
     if (((int)_syncFlag & (int)Physics3DComponent::PhysicsSyncFlag::NODE_TO_PHYSICS) && _physics3DObj && _owner)
     {
+        // the physics object is already where the last synchronization left the node, don't teleport it
+        auto world = _physics3DObj->getPhysicsWorld();
+        if (world && !isNodeChanged(world->getParentInverseTransform(_owner->getParent())))
+            return;
+
         syncNodeToPhysics();
     }
 }
@@ -158,7 +167,17 @@ void Physics3DComponent::postSimulate()
 {
     if (((int)_syncFlag & (int)Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE) && _physics3DObj && _owner)
     {
-        syncPhysicsToNode();
+        auto world = _physics3DObj->getPhysicsWorld();
+        if (!world)
+        {
+            syncPhysicsToNode();
+            return;
+        }
+
+        // moving a node with children changes the world transform of its descendants
+        if (syncPhysicsToNode(world->getParentInverseTransform(_owner->getParent())) &&
+            _owner->getChildrenCount() > 0)
+            world->_parentInverseCache.clear();
     }
 }
 
@@ -170,6 +189,7 @@ void Physics3DComponent::setTransformInPhysics(const ax::Vec3& translateInPhysic
     _transformInPhysics.m[14] = translateInPhysics.z;
 
     _invTransformInPhysics = _transformInPhysics.getInversed();
+    _physicsSynced         = false;
 }
 
 void Physics3DComponent::setSyncFlag(PhysicsSyncFlag syncFlag)
@@ -177,38 +197,75 @@ void Physics3DComponent::setSyncFlag(PhysicsSyncFlag syncFlag)
     _syncFlag = syncFlag;
 }
 
+bool Physics3DComponent::isNodeChanged(const ax::Mat4& parentInverse) const
+{
+    if (!_physicsSynced || _owner->getPosition3D() != _syncedPosition)
+        return true;
+
+    auto rotation = _owner->getRotationQuat();
+    return memcmp(&rotation, &_syncedRotation, sizeof(rotation)) != 0 ||
+           memcmp(parentInverse.m, _syncedParentInverse.m, sizeof(parentInverse.m)) != 0;
+}
+
 void Physics3DComponent::syncPhysicsToNode()
 {
-    if (_physics3DObj->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY ||
-        _physics3DObj->getObjType() == Physics3DObject::PhysicsObjType::COLLIDER)
-    {
-        Mat4 parentMat;
-        if (_owner->getParent())
-            parentMat = _owner->getParent()->getNodeToWorldTransform();
+    Mat4 parentInverse;
+    if (_owner->getParent())
+        parentInverse = _owner->getParent()->getNodeToWorldTransform().getInversed();
 
-        auto mat = parentMat.getInversed() * _physics3DObj->getWorldTransform();
-        // remove scale, no scale support for physics
-        float oneOverLen = 1.f / sqrtf(mat.m[0] * mat.m[0] + mat.m[1] * mat.m[1] + mat.m[2] * mat.m[2]);
-        mat.m[0] *= oneOverLen;
-        mat.m[1] *= oneOverLen;
-        mat.m[2] *= oneOverLen;
-        oneOverLen = 1.f / sqrtf(mat.m[4] * mat.m[4] + mat.m[5] * mat.m[5] + mat.m[6] * mat.m[6]);
-        mat.m[4] *= oneOverLen;
-        mat.m[5] *= oneOverLen;
-        mat.m[6] *= oneOverLen;
-        oneOverLen = 1.f / sqrtf(mat.m[8] * mat.m[8] + mat.m[9] * mat.m[9] + mat.m[10] * mat.m[10]);
-        mat.m[8] *= oneOverLen;
-        mat.m[9] *= oneOverLen;
-        mat.m[10] *= oneOverLen;
+    _physicsSynced = false;
+    syncPhysicsToNode(parentInverse);
+}
 
-        mat *= _transformInPhysics;
-        static Vec3 scale, translation;
-        static Quaternion quat;
-        mat.decompose(&scale, &quat, &translation);
-        _owner->setPosition3D(translation);
-        quat.normalize();
-        _owner->setRotationQuat(quat);
+bool Physics3DComponent::syncPhysicsToNode(const ax::Mat4& parentInverse)
+{
+    auto objType = _physics3DObj->getObjType();
+    if (objType != Physics3DObject::PhysicsObjType::RIGID_BODY && objType != Physics3DObject::PhysicsObjType::COLLIDER)
+        return false;
+
+    bool nodeChanged = isNodeChanged(parentInverse);
+    if (!nodeChanged && objType == Physics3DObject::PhysicsObjType::RIGID_BODY)
+    {
+        // sleeping and static bodies can't have moved during the simulation
+        auto body = static_cast<Physics3DRigidBody*>(_physics3DObj)->getRigidBody();
+        if (!body->isActive() || body->isStaticObject())
+            return false;
     }
+
+    auto physicsTransform = _physics3DObj->getWorldTransform();
+    if (!nodeChanged && memcmp(physicsTransform.m, _syncedPhysicsTransform.m, sizeof(physicsTransform.m)) == 0)
+        return false;
+
+    auto mat = parentInverse * physicsTransform;
+    // remove scale, no scale support for physics
+    float oneOverLen = 1.f / sqrtf(mat.m[0] * mat.m[0] + mat.m[1] * mat.m[1] + mat.m[2] * mat.m[2]);
+    mat.m[0] *= oneOverLen;
+    mat.m[1] *= oneOverLen;
+    mat.m[2] *= oneOverLen;
+    oneOverLen = 1.f / sqrtf(mat.m[4] * mat.m[4] + mat.m[5] * mat.m[5] + mat.m[6] * mat.m[6]);
+    mat.m[4] *= oneOverLen;
+    mat.m[5] *= oneOverLen;
+    mat.m[6] *= oneOverLen;
+    oneOverLen = 1.f / sqrtf(mat.m[8] * mat.m[8] + mat.m[9] * mat.m[9] + mat.m[10] * mat.m[10]);
+    mat.m[8] *= oneOverLen;
+    mat.m[9] *= oneOverLen;
+    mat.m[10] *= oneOverLen;
+
+    mat *= _transformInPhysics;
+    Vec3 scale, translation;
+    Quaternion quat;
+    mat.decompose(&scale, &quat, &translation);
+    quat.normalize();
+    _owner->setPosition3D(translation);
+    _owner->setRotationQuat(quat);
+
+    // read back what the node stored, so an untouched node compares equal next time
+    _syncedPhysicsTransform = physicsTransform;
+    _syncedParentInverse    = parentInverse;
+    _syncedPosition         = _owner->getPosition3D();
+    _syncedRotation         = _owner->getRotationQuat();
+    _physicsSynced          = true;
+    return true;
 }
 
 void Physics3DComponent::syncNodeToPhysics()
@@ -232,6 +289,7 @@ void Physics3DComponent::syncNodeToPhysics()
         mat.m[10] *= oneOverLen;
 
         mat *= _invTransformInPhysics;
+        _physicsSynced = false;
         if (_physics3DObj->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
         {
             auto body        = static_cast<Physics3DRigidBody*>(_physics3DObj)->getRigidBody();
@@ -131,11 +131,28 @@ protected:
 
     void postSimulate();
 
+    /**
+     * synchronize physics transformation to node, parentInverse is the inverse world transform of the owner's parent.
+     * The node is left untouched when neither the physics object nor the node changed since the last synchronization.
+     * @return true if the node transform was changed
+     */
+    bool syncPhysicsToNode(const ax::Mat4& parentInverse);
+
+    /** whether the owner was moved by someone else since the last synchronization */
+    bool isNodeChanged(const ax::Mat4& parentInverse) const;
+
     ax::Mat4 _transformInPhysics;  // transform in physics space
     ax::Mat4 _invTransformInPhysics;
 
     Physics3DObject* _physics3DObj;
     PhysicsSyncFlag _syncFlag;
+
+    // state of the last physics to node synchronization
+    ax::Mat4 _syncedPhysicsTransform;
+    ax::Mat4 _syncedParentInverse;
+    ax::Vec3 _syncedPosition;
+    ax::Quaternion _syncedRotation;
+    bool _physicsSynced;
 };
 
 // end of 3d group
@@ -26,16 +26,130 @@
 
 #include "axmol/physics3d/Physics3D.h"
 #include "axmol/renderer/Renderer.h"
+#include "axmol/2d/Node.h"
+
+#include <algorithm>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
+#    if BT_THREADSAFE
+#        include <atomic>
+#        include <mutex>
+#        include <condition_variable>
+#        include <thread>
+#        include "axmol/base/Director.h"
+#        include "axmol/base/JobSystem.h"
+#        include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#        include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#    endif
+
 namespace ax
 {
 
+#    if BT_THREADSAFE
+namespace
+{
+/** Runs bullet's parallel loops on the engine job system, the calling thread takes part so it never stalls. */
+class JobSystemTaskScheduler : public btITaskScheduler
+{
+public:
+    // any job system worker may pick up a range and get a bullet thread index, the per thread arrays bullet
+    // sizes from getNumThreads() must cover all of them plus the calling thread
+    JobSystemTaskScheduler()
+        : btITaskScheduler("axmol")
+        , _numThreads(Director::getInstance()->getJobSystem()->getThreadCount() + 1)
+        , _parallels(_numThreads)
+    {}
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return _numThreads; }
+    // only bounds how many ranges run at once, the threads that may run them are fixed by the job system
+    void setNumThreads(int numThreads) override { _parallels = std::clamp(numThreads, 1, _numThreads); }
+
+    bool isUsable() const { return _numThreads <= BT_MAX_THREAD_COUNT; }
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        run(iBegin, iEnd, grainSize, [&body](int b, int e) {
+            body.forLoop(b, e);
+            return btScalar(0);
+        });
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        return run(iBegin, iEnd, grainSize, [&body](int b, int e) { return body.sumLoop(b, e); });
+    }
+
+private:
+    struct RangeTask
+    {
+        std::function<btScalar(int, int)> func;
+        int begin;
+        int end;
+        int grainSize;
+        int count;
+        std::atomic<int> next{0};
+        int done{0};
+        btScalar sum{0};
+        std::mutex mtx;
+        std::condition_variable cv;
+
+        void execute()
+        {
+            for (int i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+            {
+                const int b = begin + i * grainSize;
+                auto value  = func(b, std::min(b + grainSize, end));
+
+                std::lock_guard<std::mutex> lck(mtx);
+                sum += value;
+                if (++done == count)
+                    cv.notify_one();
+            }
+        }
+    };
+
+    btScalar run(int iBegin, int iEnd, int grainSize, std::function<btScalar(int, int)> func)
+    {
+        if (iEnd <= iBegin)
+            return btScalar(0);
+
+        // late workers only touch the shared counters, the loop body is never called once all ranges are taken
+        auto task       = std::make_shared<RangeTask>();
+        task->func      = std::move(func);
+        task->begin     = iBegin;
+        task->end       = iEnd;
+        task->grainSize = std::max(grainSize, 1);
+        task->count     = (iEnd - iBegin + task->grainSize - 1) / task->grainSize;
+
+        auto jobSystem = Director::getInstance()->getJobSystem();
+        for (int i = 1, parallels = std::min(_parallels, task->count); i < parallels; ++i)
+            jobSystem->enqueue([task] { task->execute(); });
+        task->execute();
+
+        std::unique_lock<std::mutex> lck(task->mtx);
+        task->cv.wait(lck, [&task] { return task->done == task->count; });
+        return task->sum;
+    }
+
+    int _numThreads;
+    int _parallels;
+};
+
+JobSystemTaskScheduler* getJobSystemTaskScheduler()
+{
+    static JobSystemTaskScheduler scheduler;
+    return &scheduler;
+}
+}  // namespace
+#    endif
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _multiThreaded(false)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
@@ -85,21 +199,48 @@ bool Physics3DWorld::init(Physics3DWorldDes* info)
     _collisionConfiguration = new btDefaultCollisionConfiguration();
     //_collisionConfiguration->setConvexConvexMultipointIterations();
 
-    /// use the default collision dispatcher. For parallel processing you can use a different dispatcher (see
-    /// Extras/BulletMultiThreaded)
-    _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
-
     _broadphase = new btDbvtBroadphase();
 
-    /// the default constraint solver. For parallel processing you can use a different solver (see
-    /// Extras/BulletMultiThreaded)
-    btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
-    _solver                                  = sol;
-
     btGhostPairCallback* ghostCallback = new btGhostPairCallback();
     _ghostCallback                     = ghostCallback;
 
-    _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    if (info->isMultiThreadingEnabled)
+    {
+#    if BT_THREADSAFE
+        auto scheduler = getJobSystemTaskScheduler();
+        if (scheduler->isUsable())
+        {
+            /// narrow phase and islands are dispatched through btParallelFor, one solver per worker
+            if (btGetTaskScheduler() != scheduler)
+                btSetTaskScheduler(scheduler);
+
+            _dispatcher     = new btCollisionDispatcherMt(_collisionConfiguration);
+            auto solverPool = new btConstraintSolverPoolMt(scheduler->getNumThreads());
+            _solver         = solverPool;
+            _btPhyiscsWorld =
+                new btDiscreteDynamicsWorldMt(_dispatcher, _broadphase, solverPool, nullptr, _collisionConfiguration);
+            _multiThreaded = true;
+        }
+        else
+        {
+            AXLOGW("Physics3DWorld: the job system has more threads than bullet supports, falling back to single "
+                   "thread");
+        }
+#    else
+        AXLOGW("Physics3DWorld: multi-threading needs bullet built with BT_THREADSAFE, falling back to single thread");
+#    endif
+    }
+
+    if (!_btPhyiscsWorld)
+    {
+        /// use the default collision dispatcher.
+        _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+
+        /// the default constraint solver.
+        _solver = new btSequentialImpulseConstraintSolver();
+
+        _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    }
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(info->gravity));
     if (info->isDebugDrawEnabled)
     {
@@ -259,6 +400,8 @@ void Physics3DWorld::stepSimulate(float dt)
     if (_btPhyiscsWorld)
     {
         setGhostPairCallback();
+        // nodes only move in postSimulate, so parent transforms are shared by both passes
+        _parentInverseCache.clear();
         // should sync kinematic node before simulation
         for (auto&& it : _physicsComponents)
         {
@@ -270,11 +413,23 @@ void Physics3DWorld::stepSimulate(float dt)
         {
             it->postSimulate();
         }
+        _parentInverseCache.clear();
         if (needCollisionChecking())
             collisionChecking();
     }
 }
 
+const Mat4& Physics3DWorld::getParentInverseTransform(Node* parent)
+{
+    if (!parent)
+        return Mat4::IDENTITY;
+
+    auto it = _parentInverseCache.find(parent);
+    if (it == _parentInverseCache.end())
+        it = _parentInverseCache.emplace(parent, parent->getNodeToWorldTransform().getInversed()).first;
+    return it->second;
+}
+
 void Physics3DWorld::debugDraw(Renderer* renderer)
 {
     if (_debugDrawer)
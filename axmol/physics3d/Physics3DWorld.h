@@ -29,6 +29,7 @@
 #include "axmol/math/Math.h"
 #include "axmol/base/Object.h"
 #include "axmol/base/Config.h"
+#include <unordered_map>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
@@ -36,7 +37,7 @@ class btDynamicsWorld;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 struct btDbvtBroadphase;
-class btSequentialImpulseConstraintSolver;
+class btConstraintSolver;
 class btGhostPairCallback;
 class btRigidBody;
 class btCollisionObject;
@@ -54,18 +55,22 @@ class Physics3DDebugDrawer;
 class Physics3DComponent;
 class Physics3DShape;
 class Renderer;
+class Node;
 
 /**
  * @brief The description of Physics3DWorld.
  */
 struct AX_DLL Physics3DWorldDes
 {
-    bool isDebugDrawEnabled;  // using physics debug draw?, false by default
-    ax::Vec3 gravity;         // gravity, (0, -9.8, 0)
+    bool isDebugDrawEnabled;       // using physics debug draw?, false by default
+    bool isMultiThreadingEnabled;  // solve islands on the engine job system, needs bullet built with BT_THREADSAFE
+                                   // (AX_ENABLE_3D_PHYSICS_MT), false by default
+    ax::Vec3 gravity;              // gravity, (0, -9.8, 0)
     Physics3DWorldDes()
     {
-        isDebugDrawEnabled = false;
-        gravity            = ax::Vec3(0.f, -9.8f, 0.f);
+        isDebugDrawEnabled      = false;
+        isMultiThreadingEnabled = false;
+        gravity                 = ax::Vec3(0.f, -9.8f, 0.f);
     }
 };
 
@@ -125,6 +130,9 @@ public:
     /** Check debug drawing is enabled. */
     bool isDebugDrawEnabled() const;
 
+    /** Check whether the simulation runs on the engine job system. */
+    bool isMultiThreadingEnabled() const { return _multiThreaded; }
+
     /** Internal method, the updater of debug drawing, need called each frame. */
     void debugDraw(ax::Renderer* renderer);
 
@@ -159,18 +167,23 @@ public:
 protected:
     void removePhysics3DConstraintFromBullet(Physics3DConstraint* constraint);
 
+    /** The inverse world transform of a component owner's parent, computed once per step for all its children. */
+    const Mat4& getParentInverseTransform(Node* parent);
+
     std::vector<Physics3DObject*> _objects;
     std::vector<Physics3DConstraint*> _constraints;
     std::vector<Physics3DComponent*> _physicsComponents;  // physics3d components
+    std::unordered_map<Node*, Mat4> _parentInverseCache;   // valid during stepSimulate only
     bool _needCollisionChecking;
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
+    bool _multiThreaded;
 
     btDynamicsWorld* _btPhyiscsWorld;
     btDefaultCollisionConfiguration* _collisionConfiguration;
     btCollisionDispatcher* _dispatcher;
     btDbvtBroadphase* _broadphase;
-    btSequentialImpulseConstraintSolver* _solver;
+    btConstraintSolver* _solver;
     btGhostPairCallback* _ghostCallback;
     Physics3DDebugDrawer* _debugDrawer;
 };
@@ -161,6 +161,7 @@ void Pass::initUniformLocations()
 
     _locColor         = ps->getUniformLocation("u_color");
     _locMatrixPalette = ps->getUniformLocation("u_matrixPalette");
+    _locCompactVertex = ps->getUniformLocation("u_compactVertex");
 
     _locDirLightColor = ps->getUniformLocation(s_dirLightUniformColorName);
     ps->getUniformLocations(s_dirLightUniformDirName, _locDirLightDir);
@@ -304,6 +305,11 @@ void Pass::setUniformMatrixPalette(const void* data, size_t dataLen)
     TRY_SET_UNIFORM(_locMatrixPalette);
 }
 
+void Pass::setUniformCompactVertex(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locCompactVertex);
+}
+
 void Pass::setUniformDirLightColor(const void* data, size_t dataLen)
 {
     TRY_SET_UNIFORM(_locDirLightColor);
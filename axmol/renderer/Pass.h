@@ -113,6 +113,7 @@ public:
 
     void setUniformColor(const void*, size_t);          // ucolor
     void setUniformMatrixPalette(const void*, size_t);  // u_matrixPalette
+    void setUniformCompactVertex(const void*, size_t);  // u_compactVertex
 
     void setUniformDirLightColor(const void*, size_t);
     void setUniformDirLightDir(const void*, size_t);
@@ -164,6 +165,7 @@ private:
 
     rhi::UniformLocation _locColor;          // ucolor
     rhi::UniformLocation _locMatrixPalette;  // u_matrixPalette
+    rhi::UniformLocation _locCompactVertex;  // u_compactVertex
 
     rhi::UniformLocation _locDirLightColor;
     rhi::UniformLocationVector _locDirLightDir;
@@ -0,0 +1,25 @@
+/*
+* decode the compact vertex attributes, see MeshVertexData::setCompactVertexEnabled
+*   normals, tangents and binormals: octahedral in unorm16x2
+*   bone indices: unorm8
+* the other packed attributes are converted to float by the vertex fetch
+*/
+vec3 decodeOctahedral(vec2 e)
+{
+    e = e * 2.0 - 1.0;
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 decodeDirection(vec3 v, float compact)
+{
+    return compact > 0.5 ? decodeOctahedral(v.xy) : v;
+}
+
+vec4 decodeBlendIndex(vec4 v, float compact)
+{
+    return compact > 0.5 ? v * 255.0 : v;
+}
@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 #ifdef USE_NORMAL_MAPPING
 #endif
@@ -41,15 +42,16 @@ layout(std140, set = 0, binding = 0) uniform vs_ub {
     mat4 u_MVMatrix;
     mat4 u_PMatrix;
     mat3 u_NormalMatrix;
+    float u_compactVertex;
 };
 
 void main(void)
 {
     vec4 ePosition = u_MVMatrix * a_position;
 #ifdef USE_NORMAL_MAPPING
-    vec3 eTangent = normalize(u_NormalMatrix * a_tangent);
-    vec3 eBinormal = normalize(u_NormalMatrix * a_binormal);
-    vec3 eNormal = normalize(u_NormalMatrix * a_normal);
+    vec3 eTangent = normalize(u_NormalMatrix * decodeDirection(a_tangent, u_compactVertex));
+    vec3 eBinormal = normalize(u_NormalMatrix * decodeDirection(a_binormal, u_compactVertex));
+    vec3 eNormal = normalize(u_NormalMatrix * decodeDirection(a_normal, u_compactVertex));
     for (int i = 0; i < MAX_DIRECTIONAL_LIGHT_NUM; ++i)
     {
         v_dirLightDirection[i].x = dot(eTangent, vvec3_at(u_DirLightSourceDirection, i));
@@ -87,7 +89,7 @@ void main(void)
         v_vertexToSpotLightDirection[i] = vvec3_at(u_SpotLightSourcePosition, i) - ePosition.xyz;
     }
 
-    v_normal = u_NormalMatrix * a_normal;
+    v_normal = u_NormalMatrix * decodeDirection(a_normal, u_compactVertex);
 #endif
 
     v_texCoord = a_texCoord;
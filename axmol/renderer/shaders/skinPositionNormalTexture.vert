@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 layout(location = POSITION) in vec3 a_position;
 
@@ -47,13 +48,15 @@ layout(std140, set = 0, binding = 0) uniform vs_ub {
     mat4 u_MVMatrix;
     mat3 u_NormalMatrix;
     mat4 u_PMatrix;
+    float u_compactVertex;
 };
 
 void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent, out vec3 binormal)
 {
+    vec4 blendIndex = decodeBlendIndex(a_blendIndex, u_compactVertex);
     float blendWeight = a_blendWeight[0];
 
-    int matrixIndex = int (a_blendIndex[0]) * 3;
+    int matrixIndex = int(blendIndex[0] + 0.5) * 3;
     vec4 matrixPalette1 = u_matrixPalette[matrixIndex] * blendWeight;
     vec4 matrixPalette2 = u_matrixPalette[matrixIndex + 1] * blendWeight;
     vec4 matrixPalette3 = u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -62,7 +65,7 @@ void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent,
     blendWeight = a_blendWeight[1];
     if (blendWeight > 0.0)
     {
-        matrixIndex = int(a_blendIndex[1]) * 3;
+        matrixIndex = int(blendIndex[1] + 0.5) * 3;
         matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
         matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
         matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -70,7 +73,7 @@ void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent,
         blendWeight = a_blendWeight[2];
         if (blendWeight > 0.0)
         {
-            matrixIndex = int(a_blendIndex[2]) * 3;
+            matrixIndex = int(blendIndex[2] + 0.5) * 3;
             matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
             matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
             matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -78,7 +81,7 @@ void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent,
             blendWeight = a_blendWeight[3];
             if (blendWeight > 0.0)
             {
-                matrixIndex = int(a_blendIndex[3]) * 3;
+                matrixIndex = int(blendIndex[3] + 0.5) * 3;
                 matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
                 matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
                 matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -92,16 +95,16 @@ void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent,
     position.z = dot(p, matrixPalette3);
     position.w = p.w;
 
-    vec4 n = vec4(a_normal, 0.0);
+    vec4 n = vec4(decodeDirection(a_normal, u_compactVertex), 0.0);
     normal.x = dot(n, matrixPalette1);
     normal.y = dot(n, matrixPalette2);
     normal.z = dot(n, matrixPalette3);
 #ifdef USE_NORMAL_MAPPING
-    vec4 t = vec4(a_tangent, 0.0);
+    vec4 t = vec4(decodeDirection(a_tangent, u_compactVertex), 0.0);
     tangent.x = dot(t, matrixPalette1);
     tangent.y = dot(t, matrixPalette2);
     tangent.z = dot(t, matrixPalette3);
-    vec4 b = vec4(a_binormal, 0.0);
+    vec4 b = vec4(decodeDirection(a_binormal, u_compactVertex), 0.0);
     binormal.x = dot(b, matrixPalette1);
     binormal.y = dot(b, matrixPalette2);
     binormal.z = dot(b, matrixPalette3);
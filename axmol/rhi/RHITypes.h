@@ -81,6 +81,8 @@ enum class VertexFormat : uint16_t
     USHORT2,
     UBYTE4,
     MAT4,
+    HALF2,
+    HALF4,
     COUNT,
 };
 /** @typedef rhi::PixelFormat
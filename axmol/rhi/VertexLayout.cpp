@@ -44,6 +44,8 @@ static constexpr size_t s_vertexFormatSizeMap[] = {
     4,   // USHORT2
     4,   // UBYTE4
     64,  // MAT4 (4x4)
+    4,   // HALF2
+    8,   // HALF4
 };
 
 static_assert(AX_ARRAYSIZE(s_vertexFormatSizeMap) == (int)VertexFormat::COUNT,
@@ -61,6 +61,11 @@ static DXGI_FORMAT toDxgiFormat(VertexFormat format, bool unorm)
     case VertexFormat::MAT4:
         return DXGI_FORMAT_R32G32B32A32_FLOAT;
 
+    case VertexFormat::HALF2:
+        return DXGI_FORMAT_R16G16_FLOAT;
+    case VertexFormat::HALF4:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
     default:
         return DXGI_FORMAT_UNKNOWN;
     }
@@ -67,10 +67,16 @@ static MTLVertexFormat toMTLVertexFormat(VertexFormat vertexFormat, bool needNor
         ret = MTLVertexFormatInt;
         break;
     case VertexFormat::USHORT4:
-        ret = MTLVertexFormatUShort4;
+        if (needNormalize)
+            ret = MTLVertexFormatUShort4Normalized;
+        else
+            ret = MTLVertexFormatUShort4;
         break;
     case VertexFormat::USHORT2:
-        ret = MTLVertexFormatUShort2;
+        if (needNormalize)
+            ret = MTLVertexFormatUShort2Normalized;
+        else
+            ret = MTLVertexFormatUShort2;
         break;
     case VertexFormat::UBYTE4:
         if (needNormalize)
@@ -78,6 +84,12 @@ static MTLVertexFormat toMTLVertexFormat(VertexFormat vertexFormat, bool needNor
         else
             ret = MTLVertexFormatUChar4;
         break;
+    case VertexFormat::HALF2:
+        ret = MTLVertexFormatHalf2;
+        break;
+    case VertexFormat::HALF4:
+        ret = MTLVertexFormatHalf4;
+        break;
     default:
         assert(false);
         break;
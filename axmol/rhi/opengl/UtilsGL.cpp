@@ -125,9 +125,17 @@ GLenum UtilsGL::toGLAttributeType(VertexFormat vertexFormat)
     case VertexFormat::INT:
         ret = GL_INT;
         break;
+    case VertexFormat::USHORT4:
+    case VertexFormat::USHORT2:
+        ret = GL_UNSIGNED_SHORT;
+        break;
     case VertexFormat::UBYTE4:
         ret = GL_UNSIGNED_BYTE;
         break;
+    case VertexFormat::HALF4:
+    case VertexFormat::HALF2:
+        ret = GL_HALF_FLOAT;
+        break;
     default:
         break;
     }
@@ -143,6 +151,8 @@ bool UtilsGL::isFloatFormat(VertexFormat vfmt)
     case VertexFormat::FLOAT2:
     case VertexFormat::FLOAT:
     case VertexFormat::MAT4:
+    case VertexFormat::HALF4:
+    case VertexFormat::HALF2:
         return true;
     default:
         return false;
@@ -156,7 +166,9 @@ GLsizei UtilsGL::getGLAttributeSize(VertexFormat vertexFormat)
     {
     case VertexFormat::FLOAT4:
     case VertexFormat::INT4:
+    case VertexFormat::USHORT4:
     case VertexFormat::UBYTE4:
+    case VertexFormat::HALF4:
         ret = 4;
         break;
     case VertexFormat::FLOAT3:
@@ -165,6 +177,8 @@ GLsizei UtilsGL::getGLAttributeSize(VertexFormat vertexFormat)
         break;
     case VertexFormat::FLOAT2:
     case VertexFormat::INT2:
+    case VertexFormat::USHORT2:
+    case VertexFormat::HALF2:
         ret = 2;
         break;
     case VertexFormat::FLOAT:
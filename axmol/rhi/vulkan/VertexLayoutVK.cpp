@@ -62,6 +62,11 @@ static VkFormat toVkFormat(VertexFormat format, bool unorm)
     case VertexFormat::MAT4:
         return VK_FORMAT_R32G32B32A32_SFLOAT;
 
+    case VertexFormat::HALF2:
+        return VK_FORMAT_R16G16_SFLOAT;
+    case VertexFormat::HALF4:
+        return VK_FORMAT_R16G16B16A16_SFLOAT;
+
     default:
         return VK_FORMAT_UNDEFINED;
     }
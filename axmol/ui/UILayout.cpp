@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "axmol/2d/DrawNode.h"
 #include "axmol/2d/Layer.h"
 #include "axmol/2d/Sprite.h"
+#include "axmol/2d/RenderTexture.h"
 #include "axmol/base/EventFocus.h"
 #include "axmol/base/StencilStateManager.h"
 #include <algorithm>
@@ -73,7 +74,11 @@ Layout::Layout()
     , _clippingRectDirty(true)
     , _stencilStateManager(new StencilStateManager())
     , _doLayoutDirty(true)
+    , _doLayoutRequested(true)
     , _isInterceptTouch(false)
+    , _renderCacheEnabled(false)
+    , _renderCacheDirty(true)
+    , _renderCache(nullptr)
     , _loopFocus(false)
     , _passFocusToChild(true)
     , _isFocusPassing(false)
@@ -84,6 +89,7 @@ Layout::Layout()
 Layout::~Layout()
 {
     AX_SAFE_RELEASE(_clippingStencil);
+    AX_SAFE_RELEASE(_renderCache);
     AX_SAFE_DELETE(_stencilStateManager);
 }
 
@@ -212,6 +218,29 @@ void Layout::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t par
     adaptRenderers();
     doLayout();
 
+    if (_renderCacheEnabled)
+    {
+        size_t index = 0;
+        if (scanRenderCacheChildren(getProtectedChildren(), index) && scanRenderCacheChildren(getChildren(), index))
+        {
+            if (index != _renderCacheEntries.size())
+            {
+                _renderCacheEntries.resize(index);
+                _renderCacheDirty = true;
+            }
+            renderCacheVisit(renderer, parentTransform, parentFlags);
+            return;
+        }
+
+        // the children were last visited in the texture's space
+        if (_renderCache)
+        {
+            AX_SAFE_RELEASE_NULL(_renderCache);
+            _transformUpdated = true;
+        }
+        _renderCacheEntries.clear();
+    }
+
     if (_clippingEnabled)
     {
         switch (_clippingType)
@@ -233,6 +262,126 @@ void Layout::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t par
     }
 }
 
+void Layout::renderCacheVisit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    processParentFlags(parentTransform, parentFlags);
+
+    const auto& size = getContentSize();
+    const int width  = static_cast<int>(std::ceil(size.width));
+    const int height = static_cast<int>(std::ceil(size.height));
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    if (!_renderCache || !_renderCache->getSprite()->getContentSize().equals(Vec2(width, height)))
+    {
+        AX_SAFE_RELEASE(_renderCache);
+        _renderCache = RenderTexture::create(width, height, rhi::PixelFormat::RGBA8, rhi::PixelFormat::D24S8);
+        AX_SAFE_RETAIN(_renderCache);
+        _renderCacheDirty = true;
+        if (!_renderCache)
+        {
+            return;
+        }
+    }
+
+    if (_renderCacheDirty)
+    {
+        // visit the subtree in the layout's own space, which the texture covers from the origin
+        const Mat4 modelViewTransform = _modelViewTransform;
+        _renderCache->beginWithClear(0, 0, 0, 0);
+        ProtectedNode::visit(renderer, getNodeToParentTransform().getInversed(), FLAGS_TRANSFORM_DIRTY);
+        _renderCache->end();
+        _modelViewTransform = modelViewTransform;
+        _renderCacheDirty   = false;
+    }
+
+    _renderCache->getSprite()->visit(renderer, _modelViewTransform, FLAGS_TRANSFORM_DIRTY);
+}
+
+bool Layout::scanRenderCacheChildren(const Vector<Node*>& children, size_t& index)
+{
+    for (auto&& child : children)
+    {
+        if (index == _renderCacheEntries.size())
+        {
+            _renderCacheEntries.emplace_back();
+        }
+        auto& cached = _renderCacheEntries[index++];
+        if (cached.node != child)
+        {
+            // the types are looked up once per node rather than on every scan
+            cached.node          = child;
+            cached.layout        = dynamic_cast<Layout*>(child);
+            cached.protectedNode = dynamic_cast<ProtectedNode*>(child);
+            _renderCacheDirty    = true;
+        }
+
+        const bool visible = child->isVisible();
+
+        // scissor rects are computed in screen space, which the texture doesn't share
+        auto layout = cached.layout;
+        if (layout && layout->_clippingEnabled && layout->_clippingType == ClippingType::SCISSOR && visible)
+        {
+            return false;
+        }
+
+        const auto& size   = child->getContentSize();
+        const auto& color  = child->getDisplayedColor();
+        const auto opacity = child->getDisplayedOpacity();
+        if (!cached.size.equals(size) || !(cached.color == color) || cached.opacity != opacity ||
+            cached.visible != visible)
+        {
+            cached.size       = size;
+            cached.color      = color;
+            cached.opacity    = opacity;
+            cached.visible    = visible;
+            _renderCacheDirty = true;
+        }
+
+        if (!visible)
+        {
+            continue;
+        }
+
+        _renderCacheDirty |= child->isVisitDirty() || child->isContentDirty();
+
+        // the recursion may grow _renderCacheEntries, so don't touch cached past this point
+        auto protectedNode = cached.protectedNode;
+        if (!scanRenderCacheChildren(child->getChildren(), index))
+        {
+            return false;
+        }
+        if (protectedNode)
+        {
+            if (!scanRenderCacheChildren(protectedNode->getProtectedChildren(), index))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void Layout::setRenderCacheEnabled(bool enabled)
+{
+    if (_renderCacheEnabled == enabled)
+    {
+        return;
+    }
+
+    _renderCacheEnabled = enabled;
+    _renderCacheDirty   = true;
+    _renderCacheEntries.clear();
+    if (!enabled)
+    {
+        AX_SAFE_RELEASE_NULL(_renderCache);
+        // the children were last visited in the texture's space
+        _transformUpdated = true;
+    }
+}
+
 void Layout::stencilClippingVisit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
     if (!_visible)
@@ -877,7 +1026,8 @@ const Vec2& Layout::getBackGroundImageTextureSize() const
 
 void Layout::setLayoutType(Type type)
 {
-    _layoutType = type;
+    _layoutType        = type;
+    _doLayoutRequested = true;
 
     for (auto&& child : _children)
     {
@@ -903,7 +1053,80 @@ void Layout::forceDoLayout()
 
 void Layout::requestDoLayout()
 {
-    _doLayoutDirty = true;
+    _doLayoutDirty     = true;
+    _doLayoutRequested = true;
+}
+
+void Layout::onChildSizeChanged(Widget* /*child*/)
+{
+    // the size of a layout never depends on its children, so the change stops here
+    if (_layoutType != Type::ABSOLUTE)
+    {
+        _doLayoutDirty = true;
+    }
+}
+
+bool Layout::measureLayoutElements()
+{
+    const auto& elements  = getLayoutElements();
+    const Vec2 layoutSize = getLayoutContentSize();
+
+    bool changed        = !_measuredLayoutSize.equals(layoutSize) || _measuredElements.size() != elements.size();
+    _measuredLayoutSize = layoutSize;
+    _measuredElements.resize(elements.size());
+
+    for (ssize_t i = 0; i < elements.size(); ++i)
+    {
+        Node* node = elements.at(i);
+        MeasuredElement current{node, node->getBoundingBox().size, node->getAnchorPoint(), node->getPosition(),
+                                Margin::ZERO, -1};
+
+        auto parameterProtocol = dynamic_cast<LayoutParameterProtocol*>(node);
+        if (auto parameter = parameterProtocol ? parameterProtocol->getLayoutParameter() : nullptr)
+        {
+            current.margin = parameter->getMargin();
+            if (parameter->getLayoutType() == LayoutParameter::Type::LINEAR)
+                current.alignment = static_cast<int>(static_cast<LinearLayoutParameter*>(parameter)->getGravity());
+            else if (parameter->getLayoutType() == LayoutParameter::Type::RELATIVE)
+                current.alignment = static_cast<int>(static_cast<RelativeLayoutParameter*>(parameter)->getAlign());
+        }
+
+        auto& measured = _measuredElements[i];
+        if (!changed)
+        {
+            changed = measured.node != current.node || !measured.size.equals(current.size) ||
+                      !measured.anchorPoint.equals(current.anchorPoint) ||
+                      !measured.position.equals(current.position) || !measured.margin.equals(current.margin) ||
+                      measured.alignment != current.alignment;
+        }
+        measured = current;
+    }
+    return changed;
+}
+
+namespace
+{
+unsigned int s_layoutStatsFrame = 0;
+Layout::LayoutFrameStats s_currentLayoutStats;
+Layout::LayoutFrameStats s_lastLayoutStats;
+
+Layout::LayoutFrameStats& currentLayoutStats()
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (frame != s_layoutStatsFrame)
+    {
+        s_lastLayoutStats    = frame == s_layoutStatsFrame + 1 ? s_currentLayoutStats : Layout::LayoutFrameStats{};
+        s_currentLayoutStats = Layout::LayoutFrameStats{};
+        s_layoutStatsFrame   = frame;
+    }
+    return s_currentLayoutStats;
+}
+}  // namespace
+
+Layout::LayoutFrameStats Layout::getLayoutFrameStats()
+{
+    currentLayoutStats();
+    return s_lastLayoutStats;
 }
 
 Vec2 Layout::getLayoutContentSize() const
@@ -952,14 +1175,34 @@ void Layout::doLayout()
 
     sortAllChildren();
 
+    // children left where the last pass put them don't need another one
+    const bool measured = _layoutType != Type::ABSOLUTE;
+    if (measured && !measureLayoutElements() && !_doLayoutRequested)
+    {
+        ++currentLayoutStats().skipped;
+        _doLayoutDirty = false;
+        return;
+    }
+
     LayoutManager* executant = this->createLayoutManager();
 
     if (executant)
     {
         executant->doLayout(this);
+        ++currentLayoutStats().arranged;
+
+        if (measured)
+        {
+            const auto& elements = getLayoutElements();
+            for (ssize_t i = 0; i < elements.size() && i < static_cast<ssize_t>(_measuredElements.size()); ++i)
+            {
+                _measuredElements[i].position = elements.at(i)->getPosition();
+            }
+        }
     }
 
-    _doLayoutDirty = false;
+    _doLayoutRequested = false;
+    _doLayoutDirty     = false;
 }
 
 std::string Layout::getDescription() const
@@ -992,6 +1235,7 @@ void Layout::copySpecialProperties(Widget* widget)
         setLayoutType(layout->_layoutType);
         setClippingEnabled(layout->_clippingEnabled);
         setClippingType(layout->_clippingType);
+        setRenderCacheEnabled(layout->_renderCacheEnabled);
         _loopFocus        = layout->_loopFocus;
         _passFocusToChild = layout->_passFocusToChild;
         _isInterceptTouch = layout->_isInterceptTouch;
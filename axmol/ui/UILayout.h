@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include "axmol/ui/UIWidget.h"
 #include "axmol/ui/GUIExport.h"
+#include "axmol/base/RefPtr.h"
 #include "axmol/renderer/CustomCommand.h"
 #include "axmol/renderer/GroupCommand.h"
 #include "axmol/renderer/CallbackCommand.h"
@@ -43,6 +44,7 @@ class DrawNode;
 class LayerColor;
 class LayerGradient;
 class StencilStateManager;
+class RenderTexture;
 struct AX_DLL ResourceData;
 
 namespace ui
@@ -339,6 +341,26 @@ public:
      */
     virtual bool isClippingEnabled() const;
 
+    /**
+     * Renders the layout and its descendants once into a texture, then draws that texture as a single quad
+     * until a descendant changes.
+     *
+     * Changes to the transform, content size, color, opacity, visibility or children of any descendant invalidate
+     * the cache, so do content changes reported by Node::isContentDirty(), like a new Label text or Sprite frame.
+     * Anything else, e.g. a custom node drawing different vertices, needs invalidateRenderCache().
+     * Content outside the layout's bounds is cut off. Subtrees containing a scissor-clipped layout are drawn
+     * normally.
+     *
+     * @param enabled Pass true to cache the rendered subtree, false otherwise.
+     */
+    void setRenderCacheEnabled(bool enabled);
+    bool isRenderCacheEnabled() const { return _renderCacheEnabled; }
+
+    /**
+     * Renders the cached subtree again on the next visit.
+     */
+    void invalidateRenderCache() { _renderCacheDirty = true; }
+
     /**
      * Returns the "class name" of widget.
      */
@@ -400,6 +422,20 @@ public:
      */
     virtual void requestDoLayout();
 
+    /**
+     * Layout passes of one frame, for profiling.
+     */
+    struct LayoutFrameStats
+    {
+        unsigned int arranged = 0;  // dirty layouts that positioned their children
+        unsigned int skipped  = 0;  // dirty layouts whose measured children had not changed
+    };
+
+    /**
+     * @return The layout passes of the previous frame.
+     */
+    static LayoutFrameStats getLayoutFrameStats();
+
     /**
      * @lua NA
      */
@@ -487,6 +523,16 @@ protected:
     Vec2 getLayoutContentSize() const override;
     const Vector<Node*>& getLayoutElements() const override;
 
+    void onChildSizeChanged(Widget* child) override;
+
+    // measures everything the layout managers read, returns whether it changed since the last layout pass
+    bool measureLayoutElements();
+
+    // render cache
+    void renderCacheVisit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
+    // compares the descendants with the last scan, returns false when they can't be rendered into the cache
+    bool scanRenderCacheChildren(const Vector<Node*>& children, size_t& index);
+
     // clipping
 
     void onBeforeVisitScissor();
@@ -641,8 +687,38 @@ protected:
     // CallbackCommand _afterVisitCmdScissor;
 
     bool _doLayoutDirty;
+    // requested layouts run even when the measured children did not change
+    bool _doLayoutRequested;
     bool _isInterceptTouch;
 
+    struct MeasuredElement
+    {
+        Node* node;
+        Vec2 size;
+        Vec2 anchorPoint;
+        Vec2 position;
+        Margin margin;
+        int alignment;
+    };
+    std::vector<MeasuredElement> _measuredElements;
+    Vec2 _measuredLayoutSize;
+
+    struct RenderCacheEntry
+    {
+        // kept alive so the casts below stay valid while the entry refers to the node
+        RefPtr<Node> node;
+        Layout* layout               = nullptr;
+        ProtectedNode* protectedNode = nullptr;
+        Vec2 size;
+        Color32 color;
+        uint8_t opacity = 0;
+        bool visible    = false;
+    };
+    bool _renderCacheEnabled;
+    bool _renderCacheDirty;
+    RenderTexture* _renderCache;
+    std::vector<RenderCacheEntry> _renderCacheEntries;
+
     // whether enable loop focus or not
     bool _loopFocus;
     // on default, it will pass the focus to the next nearest widget
@@ -33,6 +33,26 @@ namespace ax
 namespace ui
 {
 
+namespace
+{
+// the parameter keeps its type, which is cheaper to check than a dynamic_cast per element on every pass
+LinearLayoutParameter* getLinearLayoutParameter(LayoutParameterProtocol* child)
+{
+    auto parameter = child->getLayoutParameter();
+    if (parameter && parameter->getLayoutType() == LayoutParameter::Type::LINEAR)
+        return static_cast<LinearLayoutParameter*>(parameter);
+    return nullptr;
+}
+
+RelativeLayoutParameter* getRelativeLayoutParameter(LayoutParameterProtocol* child)
+{
+    auto parameter = child->getLayoutParameter();
+    if (parameter && parameter->getLayoutType() == LayoutParameter::Type::RELATIVE)
+        return static_cast<RelativeLayoutParameter*>(parameter);
+    return nullptr;
+}
+}  // namespace
+
 LinearHorizontalLayoutManager* LinearHorizontalLayoutManager::create()
 {
     LinearHorizontalLayoutManager* ret = new LinearHorizontalLayoutManager();
@@ -42,15 +62,15 @@ LinearHorizontalLayoutManager* LinearHorizontalLayoutManager::create()
 
 void LinearHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
 {
-    Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
-    float leftBoundary      = 0.0f;
+    Vec2 layoutSize    = layout->getLayoutContentSize();
+    auto&& container   = layout->getLayoutElements();
+    float leftBoundary = 0.0f;
     for (auto&& subWidget : container)
     {
         Widget* child = dynamic_cast<Widget*>(subWidget);
         if (child)
         {
-            LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            LinearLayoutParameter* layoutParameter = getLinearLayoutParameter(child);
             if (layoutParameter)
             {
                 LinearLayoutParameter::LinearGravity childGravity = layoutParameter->getGravity();
@@ -92,16 +112,16 @@ LinearVerticalLayoutManager* LinearVerticalLayoutManager::create()
 
 void LinearVerticalLayoutManager::doLayout(LayoutProtocol* layout)
 {
-    Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
-    float topBoundary       = layoutSize.height;
+    Vec2 layoutSize   = layout->getLayoutContentSize();
+    auto&& container  = layout->getLayoutElements();
+    float topBoundary = layoutSize.height;
 
     for (auto&& subWidget : container)
     {
         LayoutParameterProtocol* child = dynamic_cast<LayoutParameterProtocol*>(subWidget);
         if (child)
         {
-            LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            LinearLayoutParameter* layoutParameter = getLinearLayoutParameter(child);
 
             if (layoutParameter)
             {
@@ -156,7 +176,7 @@ void LinearCenterVerticalLayoutManager::doLayout(LayoutProtocol* layout)
         auto* child = dynamic_cast<LayoutParameterProtocol*>(subWidget);
         if (child)
         {
-            auto* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            auto* layoutParameter = getLinearLayoutParameter(child);
             if (layoutParameter)
             {
                 auto&& mg = layoutParameter->getMargin();
@@ -172,7 +192,7 @@ void LinearCenterVerticalLayoutManager::doLayout(LayoutProtocol* layout)
         auto* child = dynamic_cast<LayoutParameterProtocol*>(subWidget);
         if (child)
         {
-            auto* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            auto* layoutParameter = getLinearLayoutParameter(child);
 
             if (layoutParameter)
             {
@@ -226,7 +246,7 @@ void LinearCenterHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
         auto* child = dynamic_cast<LayoutParameterProtocol*>(subWidget);
         if (child)
         {
-            auto* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            auto* layoutParameter = getLinearLayoutParameter(child);
             if (layoutParameter)
             {
                 auto&& mg = layoutParameter->getMargin();
@@ -242,7 +262,7 @@ void LinearCenterHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
         Widget* child = dynamic_cast<Widget*>(subWidget);
         if (child)
         {
-            LinearLayoutParameter* layoutParameter = dynamic_cast<LinearLayoutParameter*>(child->getLayoutParameter());
+            LinearLayoutParameter* layoutParameter = getLinearLayoutParameter(child);
             if (layoutParameter)
             {
                 LinearLayoutParameter::LinearGravity childGravity = layoutParameter->getGravity();
@@ -285,18 +305,23 @@ RelativeLayoutManager* RelativeLayoutManager::create()
 
 Vector<Widget*> RelativeLayoutManager::getAllWidgets(ax::ui::LayoutProtocol* layout)
 {
-    Vector<Node*> container = layout->getLayoutElements();
+    auto&& container = layout->getLayoutElements();
     Vector<Widget*> widgetChildren;
+    _widgetParameters.clear();
     for (auto&& subWidget : container)
     {
         Widget* child = dynamic_cast<Widget*>(subWidget);
         if (child)
         {
-            RelativeLayoutParameter* layoutParameter =
-                dynamic_cast<RelativeLayoutParameter*>(child->getLayoutParameter());
-            layoutParameter->_put = false;
+            // the parameters are read on every pass of doLayout, look them up once
+            RelativeLayoutParameter* layoutParameter = getRelativeLayoutParameter(child);
+            if (layoutParameter)
+            {
+                layoutParameter->_put = false;
+            }
             _unlayoutChildCount++;
             widgetChildren.pushBack(child);
+            _widgetParameters.emplace_back(layoutParameter);
         }
     }
     return widgetChildren;
@@ -305,23 +330,19 @@ Vector<Widget*> RelativeLayoutManager::getAllWidgets(ax::ui::LayoutProtocol* lay
 Widget* RelativeLayoutManager::getRelativeWidget(Widget* widget)
 {
     Widget* relativeWidget                   = nullptr;
-    RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(widget->getLayoutParameter());
+    RelativeLayoutParameter* layoutParameter = getRelativeLayoutParameter(widget);
     auto relativeName                        = layoutParameter->getRelativeToWidgetName();
 
     if (!relativeName.empty())
     {
-        for (auto&& sWidget : _widgetChildren)
+        for (ssize_t i = 0; i < _widgetChildren.size(); ++i)
         {
-            if (sWidget)
+            RelativeLayoutParameter* rlayoutParameter = _widgetParameters[i];
+            if (rlayoutParameter && rlayoutParameter->getRelativeName() == relativeName)
             {
-                RelativeLayoutParameter* rlayoutParameter =
-                    dynamic_cast<RelativeLayoutParameter*>(sWidget->getLayoutParameter());
-                if (rlayoutParameter && rlayoutParameter->getRelativeName() == relativeName)
-                {
-                    relativeWidget    = sWidget;
-                    _relativeWidgetLP = rlayoutParameter;
-                    break;
-                }
+                relativeWidget    = _widgetChildren.at(i);
+                _relativeWidgetLP = rlayoutParameter;
+                break;
             }
         }
     }
@@ -338,7 +359,7 @@ bool RelativeLayoutManager::calculateFinalPositionWithRelativeWidget(LayoutProto
 
     Widget* relativeWidget = this->getRelativeWidget(_widget);
 
-    RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(_widget->getLayoutParameter());
+    RelativeLayoutParameter* layoutParameter = _widgetParameter;
 
     RelativeLayoutParameter::RelativeAlign align = layoutParameter->getAlign();
 
@@ -554,7 +575,7 @@ bool RelativeLayoutManager::calculateFinalPositionWithRelativeWidget(LayoutProto
 
 void RelativeLayoutManager::calculateFinalPositionWithRelativeAlign()
 {
-    RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(_widget->getLayoutParameter());
+    RelativeLayoutParameter* layoutParameter = _widgetParameter;
 
     Margin mg = layoutParameter->getMargin();
 
@@ -652,14 +673,17 @@ void RelativeLayoutManager::doLayout(LayoutProtocol* layout)
 
     _widgetChildren = this->getAllWidgets(layout);
 
+    ssize_t unplacedCount = _widgetChildren.size();
     while (_unlayoutChildCount > 0)
     {
-        for (auto&& subWidget : _widgetChildren)
+        // a pass that places nothing leaves nothing new for the next one to depend on
+        ssize_t placedCount = 0;
+        for (ssize_t i = 0; i < _widgetChildren.size(); ++i)
         {
-            _widget = static_cast<Widget*>(subWidget);
+            _widget          = _widgetChildren.at(i);
+            _widgetParameter = _widgetParameters[i];
 
-            RelativeLayoutParameter* layoutParameter =
-                dynamic_cast<RelativeLayoutParameter*>(_widget->getLayoutParameter());
+            RelativeLayoutParameter* layoutParameter = _widgetParameter;
 
             if (layoutParameter)
             {
@@ -679,11 +703,22 @@ void RelativeLayoutManager::doLayout(LayoutProtocol* layout)
                 _widget->setPosition(Vec2(_finalPositionX, _finalPositionY));
 
                 layoutParameter->_put = true;
+                ++placedCount;
             }
         }
         _unlayoutChildCount--;
+
+        unplacedCount -= placedCount;
+        if (placedCount == 0 || unplacedCount <= 0)
+        {
+            break;
+        }
     }
+    _unlayoutChildCount = 0;
     _widgetChildren.clear();
+    _widgetParameters.clear();
+    _widget          = nullptr;
+    _widgetParameter = nullptr;
 }
 
 }  // namespace ui
@@ -137,6 +137,7 @@ private:
     RelativeLayoutManager()
         : _unlayoutChildCount(0)
         , _widget(nullptr)
+        , _widgetParameter(nullptr)
         , _finalPositionX(0.0f)
         , _finalPositionY(0.0f)
         , _relativeWidgetLP(nullptr)
@@ -152,7 +153,9 @@ private:
 
     ssize_t _unlayoutChildCount;
     Vector<Widget*> _widgetChildren;
+    std::vector<RelativeLayoutParameter*> _widgetParameters;  // parameters of _widgetChildren
     Widget* _widget;
+    RelativeLayoutParameter* _widgetParameter;  // parameter of _widget
     float _finalPositionX;
     float _finalPositionY;
 
@@ -48,6 +48,10 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _virtualItemCount(-1)
+    , _virtualFirstIndex(0)
+    , _virtualCacheExtent(0.5f)
+    , _virtualItemsDirty(false)
 {
     this->setTouchEnabled(true);
 }
@@ -55,6 +59,7 @@ ListView::ListView()
 ListView::~ListView()
 {
     _items.clear();
+    _virtualItemPool.clear();
     AX_SAFE_RELEASE(_model);
 }
 
@@ -247,6 +252,12 @@ void ListView::pushBackDefaultItem()
     {
         return;
     }
+    // default items of a virtual list are bound from the data source
+    if (isVirtual())
+    {
+        setVirtualItemCount(_virtualItemCount + 1);
+        return;
+    }
     Widget* newItem = _model->clone();
     remedyLayoutParameter(newItem);
     addChild(newItem);
@@ -259,11 +270,21 @@ void ListView::insertDefaultItem(ssize_t index)
     {
         return;
     }
+    if (isVirtual())
+    {
+        setVirtualItemCount(_virtualItemCount + 1);
+        return;
+    }
     insertCustomItem(_model->clone(), index);
 }
 
 void ListView::pushBackCustomItem(Widget* item)
 {
+    AXASSERT(!isVirtual(), "Custom items can't be added to a virtual ListView, change the virtual item count instead!");
+    if (isVirtual())
+    {
+        return;
+    }
     remedyLayoutParameter(item);
     addChild(item);
     requestDoLayout();
@@ -338,11 +359,18 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    _virtualItemPool.clear();
+    _virtualFirstIndex = 0;
     onItemListChanged();
 }
 
 void ListView::insertCustomItem(Widget* item, ssize_t index)
 {
+    AXASSERT(!isVirtual(), "Custom items can't be added to a virtual ListView, change the virtual item count instead!");
+    if (isVirtual())
+    {
+        return;
+    }
     if (-1 != _curSelectedIndex)
     {
         if (_curSelectedIndex >= index)
@@ -361,6 +389,11 @@ void ListView::insertCustomItem(Widget* item, ssize_t index)
 
 void ListView::removeItem(ssize_t index)
 {
+    AXASSERT(!isVirtual(), "Items can't be removed from a virtual ListView, change the virtual item count instead!");
+    if (isVirtual())
+    {
+        return;
+    }
     Widget* item = getItem(index);
     if (nullptr == item)
     {
@@ -381,6 +414,7 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index) const
 {
+    index -= _virtualFirstIndex;
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -399,7 +433,212 @@ ssize_t ListView::getIndex(Widget* item) const
     {
         return -1;
     }
-    return _items.getIndex(item);
+    auto index = _items.getIndex(item);
+    return index == -1 ? -1 : index + _virtualFirstIndex;
+}
+
+void ListView::setVirtualItems(ssize_t count,
+                               const ccVirtualItemSizeCallback& sizeCallback,
+                               const ccVirtualItemBindCallback& bindCallback)
+{
+    _virtualItemSizeCallback = sizeCallback;
+    _virtualItemBindCallback = bindCallback;
+    setVirtualItemCount(count);
+}
+
+void ListView::setVirtualItemCount(ssize_t count)
+{
+    count = std::max(count, static_cast<ssize_t>(-1));
+    if (isVirtual() != (count >= 0))
+    {
+        removeAllItems();
+        // virtual items are placed by the list itself
+        if (count >= 0)
+            setLayoutType(Type::ABSOLUTE);
+        else
+            setLayoutType(_direction == Direction::HORIZONTAL ? Type::HORIZONTAL : Type::VERTICAL);
+    }
+    _virtualItemCount = count;
+    if (_curSelectedIndex >= count)
+    {
+        _curSelectedIndex = -1;
+    }
+    reloadVirtualItems();
+}
+
+ssize_t ListView::getVirtualItemCount() const
+{
+    return _virtualItemCount;
+}
+
+void ListView::reloadVirtualItems()
+{
+    _virtualItemsDirty = true;
+    requestDoLayout();
+}
+
+void ListView::setVirtualCacheExtent(float ratio)
+{
+    _virtualCacheExtent = std::max(ratio, 0.f);
+}
+
+float ListView::getVirtualCacheExtent() const
+{
+    return _virtualCacheExtent;
+}
+
+void ListView::updateVirtualItemSlots()
+{
+    const bool vertical = _direction == Direction::VERTICAL;
+
+    _virtualItemSizes.resize(_virtualItemCount);
+    _virtualItemStarts.resize(_virtualItemCount + 1);
+
+    float position = vertical ? _topPadding : _leftPadding;
+    for (ssize_t index = 0; index < _virtualItemCount; ++index)
+    {
+        auto& size = _virtualItemSizes[index];
+        if (_virtualItemSizeCallback)
+            size = _virtualItemSizeCallback(index);
+        else
+            size = _model ? _model->getContentSize() : Vec2::ZERO;
+
+        _virtualItemStarts[index] = position;
+        position += (vertical ? size.height : size.width) + _itemsMargin;
+    }
+    _virtualItemStarts[_virtualItemCount] = position;
+
+    float length = 0.f;
+    if (_virtualItemCount > 0)
+        length = position - _itemsMargin + (vertical ? _bottomPadding : _rightPadding);
+
+    if (vertical)
+        setInnerContainerSize(Vec2(_contentSize.width, length));
+    else
+        setInnerContainerSize(Vec2(length, _contentSize.height));
+}
+
+Vec2 ListView::getVirtualItemOrigin(ssize_t index) const
+{
+    const Vec2& size = _virtualItemSizes[index];
+    const float start = _virtualItemStarts[index];
+    if (_direction == Direction::VERTICAL)
+    {
+        float x = _leftPadding;
+        if (_gravity == Gravity::RIGHT)
+            x = _contentSize.width - _rightPadding - size.width;
+        else if (_gravity == Gravity::CENTER_HORIZONTAL)
+            x = (_contentSize.width - size.width) / 2;
+        return Vec2(x, _innerContainer->getContentSize().height - start - size.height);
+    }
+
+    float y = _contentSize.height - _topPadding - size.height;
+    if (_gravity == Gravity::BOTTOM)
+        y = _bottomPadding;
+    else if (_gravity == Gravity::CENTER_VERTICAL)
+        y = (_contentSize.height - size.height) / 2;
+    return Vec2(start, y);
+}
+
+Widget* ListView::obtainVirtualItem()
+{
+    if (!_virtualItemPool.empty())
+    {
+        // still a child of the inner container, which keeps it alive
+        Widget* item = _virtualItemPool.back();
+        _virtualItemPool.popBack();
+        item->setVisible(true);
+        return item;
+    }
+    if (nullptr == _model)
+    {
+        AXLOGW("ListView: a virtual list needs an item model!");
+        return nullptr;
+    }
+    Widget* item = _model->clone();
+    ScrollView::addChild(item);
+    return item;
+}
+
+void ListView::updateVirtualItems()
+{
+    // the view and the cache extent around it, as distances from the start of the list
+    float viewStart, viewLength;
+    if (_direction == Direction::VERTICAL)
+    {
+        viewLength = _contentSize.height;
+        viewStart  = _innerContainer->getTopBoundary() - viewLength;
+    }
+    else
+    {
+        viewLength = _contentSize.width;
+        viewStart  = -_innerContainer->getLeftBoundary();
+    }
+    const float viewEnd = viewStart + viewLength * (1.f + _virtualCacheExtent);
+    viewStart -= viewLength * _virtualCacheExtent;
+
+    auto starts    = _virtualItemStarts.begin();
+    auto startsEnd = starts + _virtualItemCount;
+    ssize_t first  = std::max(static_cast<ssize_t>(std::upper_bound(starts, startsEnd, viewStart) - starts) - 1,
+                              static_cast<ssize_t>(0));
+    ssize_t last   = std::max(static_cast<ssize_t>(std::lower_bound(starts, startsEnd, viewEnd) - starts), first);
+
+    if (!_virtualItemsDirty && first == _virtualFirstIndex && last == _virtualFirstIndex + _items.size())
+    {
+        return;
+    }
+
+    // recycle the items that scrolled out
+    for (ssize_t i = 0; i < _items.size(); ++i)
+    {
+        ssize_t index = _virtualFirstIndex + i;
+        if (_virtualItemsDirty || index < first || index >= last)
+        {
+            Widget* item = _items.at(i);
+            item->setVisible(false);
+            _virtualItemPool.pushBack(item);
+        }
+    }
+
+    Vector<Widget*> items(last - first);
+    for (ssize_t index = first; index < last; ++index)
+    {
+        ssize_t boundIndex = index - _virtualFirstIndex;
+        if (!_virtualItemsDirty && boundIndex >= 0 && boundIndex < _items.size())
+        {
+            items.pushBack(_items.at(boundIndex));
+            continue;
+        }
+
+        Widget* item = obtainVirtualItem();
+        if (nullptr == item)
+        {
+            break;
+        }
+        const Vec2& size   = _virtualItemSizes[index];
+        const Vec2& anchor = item->getAnchorPoint();
+        item->setPosition(getVirtualItemOrigin(index) + Vec2(size.width * anchor.x, size.height * anchor.y));
+        if (_virtualItemBindCallback)
+        {
+            _virtualItemBindCallback(item, index);
+        }
+        items.pushBack(item);
+    }
+
+    _items             = std::move(items);
+    _virtualFirstIndex = first;
+    _virtualItemsDirty = false;
+}
+
+Vec2 ListView::calculateVirtualItemDestination(ssize_t index,
+                                               const Vec2& positionRatioInView,
+                                               const Vec2& itemAnchorPoint)
+{
+    const Vec2& size = _virtualItemSizes[index];
+    Vec2 itemPosition =
+        getVirtualItemOrigin(index) + Vec2(size.width * itemAnchorPoint.x, size.height * itemAnchorPoint.y);
+    Vec2 positionInView(_contentSize.width * positionRatioInView.x, _contentSize.height * positionRatioInView.y);
+    return -(itemPosition - positionInView);
 }
 
 void ListView::setGravity(Gravity gravity)
@@ -540,6 +779,11 @@ void ListView::setDirection(Direction dir)
         break;
     }
     ScrollView::setDirection(dir);
+    if (isVirtual())
+    {
+        setLayoutType(Type::ABSOLUTE);
+        reloadVirtualItems();
+    }
 }
 
 void ListView::requestDoLayout()
@@ -549,6 +793,18 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (isVirtual())
+    {
+        if (_innerContainerDoLayoutDirty)
+        {
+            updateVirtualItemSlots();
+            _innerContainerDoLayoutDirty = false;
+            _virtualItemsDirty           = true;
+        }
+        updateVirtualItems();
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -814,13 +1070,21 @@ void ListView::jumpToPercentBothDirection(const Vec2& percent)
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
     Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    if (isVirtual())
+    {
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+    }
+    else if (item == nullptr)
     {
         return;
     }
     doLayout();
 
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
+    Vec2 destination = isVirtual() ? calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint)
+                                   : calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -840,6 +1104,18 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (isVirtual())
+    {
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        doLayout();
+        startAutoScrollToDestination(
+            calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint), timeInSec, true);
+        return;
+    }
+
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
@@ -882,6 +1158,11 @@ Widget* ListView::createCloneInstance()
 
 void ListView::copyClonedWidgetChildren(Widget* model)
 {
+    // virtual items are created by the clone itself
+    if (static_cast<ListView*>(model)->isVirtual())
+    {
+        return;
+    }
     auto& arrayItems = static_cast<ListView*>(model)->getItems();
     for (auto&& item : arrayItems)
     {
@@ -899,6 +1180,12 @@ void ListView::copySpecialProperties(Widget* model)
         setItemsMargin(listViewEx->_itemsMargin);
         setGravity(listViewEx->_gravity);
         _eventCallback = listViewEx->_eventCallback;
+        if (listViewEx->isVirtual())
+        {
+            setVirtualCacheExtent(listViewEx->_virtualCacheExtent);
+            setVirtualItems(listViewEx->_virtualItemCount, listViewEx->_virtualItemSizeCallback,
+                            listViewEx->_virtualItemBindCallback);
+        }
     }
 }
 
@@ -926,26 +1213,38 @@ Vec2 ListView::getHowMuchOutOfBoundary(const Vec2& addition)
         ssize_t lastItemIndex = _items.size() - 1;
         Vec2 contentSize      = getContentSize();
         Vec2 firstItemAdjustment, lastItemAdjustment;
+        Vec2 firstItemSize, lastItemSize;
+        if (isVirtual())
+        {
+            // the first and last items are not necessarily bound
+            firstItemSize = _virtualItemSizes.front();
+            lastItemSize  = _virtualItemSizes.back();
+        }
+        else
+        {
+            firstItemSize = _items.at(0)->getContentSize();
+            lastItemSize  = _items.at(lastItemIndex)->getContentSize();
+        }
         if (_magneticType == MagneticType::CENTER)
         {
-            firstItemAdjustment = (contentSize - _items.at(0)->getContentSize()) / 2;
-            lastItemAdjustment  = (contentSize - _items.at(lastItemIndex)->getContentSize()) / 2;
+            firstItemAdjustment = (contentSize - firstItemSize) / 2;
+            lastItemAdjustment  = (contentSize - lastItemSize) / 2;
         }
         else if (_magneticType == MagneticType::LEFT)
         {
-            lastItemAdjustment = contentSize - _items.at(lastItemIndex)->getContentSize();
+            lastItemAdjustment = contentSize - lastItemSize;
         }
         else if (_magneticType == MagneticType::RIGHT)
         {
-            firstItemAdjustment = contentSize - _items.at(0)->getContentSize();
+            firstItemAdjustment = contentSize - firstItemSize;
         }
         else if (_magneticType == MagneticType::TOP)
         {
-            lastItemAdjustment = contentSize - _items.at(lastItemIndex)->getContentSize();
+            lastItemAdjustment = contentSize - lastItemSize;
         }
         else if (_magneticType == MagneticType::BOTTOM)
         {
-            firstItemAdjustment = contentSize - _items.at(0)->getContentSize();
+            firstItemAdjustment = contentSize - firstItemSize;
         }
         leftBoundary += firstItemAdjustment.x;
         rightBoundary -= lastItemAdjustment.x;
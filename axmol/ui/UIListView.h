@@ -42,9 +42,8 @@ namespace ui
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
- *ScrollView.
+ * @warning Regular list items are not reused, if you have a large amount of data need to be displayed, use the virtual
+ *mode, see `setVirtualItems`. ListView is a subclass of  `ScrollView`, so it shares many features of ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
 {
@@ -95,6 +94,16 @@ public:
      */
     typedef std::function<void(Object*, EventType)> ccListViewCallback;
 
+    /**
+     * Returns the size of a virtual item, see `setVirtualItems`.
+     */
+    typedef std::function<Vec2(ssize_t index)> ccVirtualItemSizeCallback;
+
+    /**
+     * Fills a recycled item widget with the data of a virtual item, see `setVirtualItems`.
+     */
+    typedef std::function<void(Widget* item, ssize_t index)> ccVirtualItemBindCallback;
+
     /**
      * Default constructor
      * @lua new
@@ -124,23 +133,25 @@ public:
 
     /**
      * Insert a default item(create by a cloned model) at the end of the listview.
+     * In virtual mode it adds one to the virtual item count, the data source binds the new item.
      */
     void pushBackDefaultItem();
 
     /**
      * Insert a default item(create by cloning model) into listview at a give index.
+     * In virtual mode it adds one to the virtual item count and the visible items are bound again.
      *@param index  An index in ssize_t.
      */
     void insertDefaultItem(ssize_t index);
 
     /**
-     * Insert a  custom item into the end of ListView.
+     * Insert a  custom item into the end of ListView, not allowed in virtual mode.
      *@param item An item in `Widget*`.
      */
     void pushBackCustomItem(Widget* item);
 
     /**
-     * @brief Insert a custom widget into ListView at a given index.
+     * @brief Insert a custom widget into ListView at a given index, not allowed in virtual mode.
      *
      * @param item A widget pointer to be inserted.
      * @param index A given index in ssize_t.
@@ -153,7 +164,7 @@ public:
     void removeLastItem();
 
     /**
-     * Remove an item at given index.
+     * Remove an item at given index, not allowed in virtual mode.
      *
      * @param index A given index in ssize_t.
      */
@@ -188,6 +199,54 @@ public:
      */
     ssize_t getIndex(Widget* item) const;
 
+    /**
+     * Turns the ListView into a virtual list of `count` items.
+     *
+     * Only the items inside the view and the cache extent around it exist as widgets. They are cloned from the item
+     * model, recycled while scrolling and passed to `bindCallback` each time they show another index. `sizeCallback`
+     * returns the size of the item at an index, the item model size is used without it.
+     * Items can't be added or removed one by one in virtual mode, change the count instead.
+     *
+     * @param count The number of items, a negative count turns the virtual mode off.
+     * @param sizeCallback Returns the size of an item.
+     * @param bindCallback Binds an item widget to an index.
+     */
+    void setVirtualItems(ssize_t count,
+                         const ccVirtualItemSizeCallback& sizeCallback,
+                         const ccVirtualItemBindCallback& bindCallback);
+
+    /**
+     * Change the number of virtual items and bind the visible items again, a negative count turns the virtual mode
+     * off.
+     */
+    void setVirtualItemCount(ssize_t count);
+
+    /**
+     * @return The number of virtual items, -1 unless the ListView is virtual.
+     */
+    ssize_t getVirtualItemCount() const;
+
+    /**
+     * Query whether the ListView is in virtual mode.
+     */
+    bool isVirtual() const { return _virtualItemCount >= 0; }
+
+    /**
+     * Query the sizes of all virtual items again and bind the visible items again, call it when the data changed.
+     */
+    void reloadVirtualItems();
+
+    /**
+     * Set how far beyond the view virtual items are kept alive on both ends, as a ratio of the view length.
+     * Default is 0.5.
+     */
+    void setVirtualCacheExtent(float ratio);
+
+    /**
+     * Get how far beyond the view virtual items are kept alive on both ends, as a ratio of the view length.
+     */
+    float getVirtualCacheExtent() const;
+
     /**
      * Set the gravity of ListView.
      * @see `ListViewGravity`
@@ -441,6 +500,12 @@ protected:
 
     void startMagneticScroll();
 
+    void updateVirtualItemSlots();
+    void updateVirtualItems();
+    Widget* obtainVirtualItem();
+    Vec2 getVirtualItemOrigin(ssize_t index) const;
+    Vec2 calculateVirtualItemDestination(ssize_t index, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint);
+
 protected:
     Widget* _model;
 
@@ -462,6 +527,17 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    // virtual mode, _items holds the bound items starting at _virtualFirstIndex
+    ssize_t _virtualItemCount;
+    ssize_t _virtualFirstIndex;
+    float _virtualCacheExtent;
+    bool _virtualItemsDirty;
+    std::vector<float> _virtualItemStarts;
+    std::vector<Vec2> _virtualItemSizes;
+    Vector<Widget*> _virtualItemPool;
+    ccVirtualItemSizeCallback _virtualItemSizeCallback;
+    ccVirtualItemBindCallback _virtualItemBindCallback;
 };
 
 }  // namespace ui
@@ -66,11 +66,36 @@ namespace
 {
 struct PrivateVideoContext
 {
-    MediaEngine* _engine        = nullptr;
-    Texture2D* _vtexture        = nullptr;
-    Texture2D* _vchromaTexture  = nullptr;
-    Texture2D* _vchroma2Texture = nullptr;
-    Sprite* _vrender            = nullptr;
+    static constexpr int MAX_PLANES = 3;
+
+    // a plane of the frame data and the texture it's uploaded to
+    struct VideoPlane
+    {
+        bool cbcr;          // located in the chroma data of the frame rather than the luma data
+        size_t offset;      // from the start of that data
+        int width;          // in texels
+        int height;         // in rows
+        int bytesPerRow;
+        PixelFormat format;
+    };
+
+    MediaEngine* _engine = nullptr;
+    Sprite* _vrender     = nullptr;
+
+    // double-buffered, the sprite samples the front set while the next frame is uploaded into the back set
+    Texture2D* _textures[2][MAX_PLANES] = {};
+    int _frontSet                       = 0;
+    VideoPlane _planes[MAX_PLANES]      = {};
+    int _numPlanes                      = 0;
+
+    // the pooled frame being uploaded, a band of rows per draw
+    std::shared_ptr<MEFrameBuffer> _pendingFrame;
+    int _pendingPlane    = 0;
+    int _pendingRow      = 0;
+    size_t _uploadBudget = 0;
+
+    MediaPlayer::VideoStats _stats;
+    float _drawUploadMs = 0;
 
     MEVideoPixelDesc _vpixelDesc;
 
@@ -82,9 +107,36 @@ struct PrivateVideoContext
     {
         if (_engine)
             _engine->close();
+        _pendingFrame.reset();
     }
 
-    std::function<void(const MEVideoFrame& frame)> _renderFrameFunc;
+    void releaseTextures()
+    {
+        for (auto& set : _textures)
+            for (auto& texture : set)
+                AX_SAFE_RELEASE_NULL(texture);
+        _numPlanes = 0;
+    }
+
+    void addPlane(bool cbcr, size_t offset, int width, int height, int bytesPerTexel, PixelFormat format)
+    {
+        _planes[_numPlanes] = VideoPlane{cbcr, offset, width, height, width * bytesPerTexel, format};
+        for (auto& set : _textures)
+        {
+            auto texture = new Texture2D();
+            texture->initWithSpec(
+                {
+                    .width       = static_cast<uint16_t>(width),
+                    .height      = static_cast<uint16_t>(height),
+                    .pixelFormat = format,
+                },
+                Texture2D::DEFAULT_SLICE_DATA);
+            if (_numPlanes > 0)
+                texture->setAliasTexParameters();
+            set[_numPlanes] = texture;
+        }
+        ++_numPlanes;
+    }
 
     bool updatePixelDesc(const MEVideoFrame& frame)
     {
@@ -96,190 +148,139 @@ struct PrivateVideoContext
 
         auto pixelFormat = desc._PF;
 
-        AX_SAFE_RELEASE(_vtexture);
-        AX_SAFE_RELEASE_NULL(_vchromaTexture);
-        AX_SAFE_RELEASE_NULL(_vchroma2Texture);
-
-        auto programManager = ProgramManager::getInstance();
+        releaseTextures();
+        _pendingFrame.reset();
+        _frontSet = 0;
 
+        const int w = desc._dim.x;
+        const int h = desc._dim.y;
         switch (pixelFormat)
         {
         case MEVideoPixelFormat::YUY2:
-            // RG8
-            _vtexture = new Texture2D();
-            _vtexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::RG8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-
-            // RGBA8
-            _vchromaTexture = new Texture2D();
-            _vchromaTexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x >> 1),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::RGBA8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-            _vchromaTexture->setAliasTexParameters();
+            // both planes sample the packed data: luma as RG8, chroma as RGBA8
+            addPlane(false, 0, w, h, 2, PixelFormat::RG8);
+            addPlane(false, 0, w >> 1, h, 4, PixelFormat::RGBA8);
             _vrender->setProgramState(rhi::ProgramType::VIDEO_TEXTURE_YUY2);
-
-            _renderFrameFunc = [this](const MEVideoFrame& frame) {
-                if (_vtexture && _vchromaTexture)
-                {
-                    auto& bufferDim = frame._vpd._dim;
-                    _vtexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x, bufferDim.y);
-                    _vchromaTexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x >> 1, bufferDim.y);
-                }
-            };
             break;
         case MEVideoPixelFormat::NV12:
-            // R8
-            _vtexture = new Texture2D();
-            _vtexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::R8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-
-            // RG8
-            _vchromaTexture = new Texture2D();
-            _vchromaTexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x >> 1),
-                    .height      = static_cast<uint16_t>(desc._dim.y >> 1),
-                    .pixelFormat = PixelFormat::RG8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-            _vchromaTexture->setAliasTexParameters();
+            addPlane(false, 0, w, h, 1, PixelFormat::R8);
+            addPlane(true, 0, w >> 1, h >> 1, 2, PixelFormat::RG8);
             _vrender->setProgramState(rhi::ProgramType::VIDEO_TEXTURE_NV12);
-
-            // allocate tex storage
-            _renderFrameFunc = [this](const MEVideoFrame& frame) {
-                if (_vtexture && _vchromaTexture)
-                {
-                    auto& bufferDim = frame._vpd._dim;
-                    _vtexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x, bufferDim.y);
-                    _vchromaTexture->updateSubData(frame._cbcrDataPointer, 0, 0, bufferDim.x >> 1, bufferDim.y >> 1);
-                }
-            };
             break;
         case MEVideoPixelFormat::I420:
-            // R8
-            _vtexture = new Texture2D();
-            _vtexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::R8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-            // R8
-            _vchromaTexture = new Texture2D();
-            _vchromaTexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x >> 1),
-                    .height      = static_cast<uint16_t>(desc._dim.y >> 1),
-                    .pixelFormat = PixelFormat::R8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-            _vchromaTexture->setAliasTexParameters();
-            // R8
-            _vchroma2Texture = new Texture2D();
-            _vchroma2Texture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x >> 1),
-                    .height      = static_cast<uint16_t>(desc._dim.y >> 1),
-                    .pixelFormat = PixelFormat::R8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
-            _vchroma2Texture->setAliasTexParameters();
+            addPlane(false, 0, w, h, 1, PixelFormat::R8);
+            addPlane(true, 0, w >> 1, h >> 1, 1, PixelFormat::R8);
+            addPlane(true, (w * h) >> 2, w >> 1, h >> 1, 1, PixelFormat::R8);
             _vrender->setProgramState(rhi::ProgramType::VIDEO_TEXTURE_I420);
-
-            _renderFrameFunc = [this](const MEVideoFrame& frame) {
-                if (_vtexture && _vchromaTexture && _vchroma2Texture)
-                {
-                    auto& bufferDim              = frame._vpd._dim;
-                    const auto chromaTexDataSize = (bufferDim.x * bufferDim.y) >> 2;
-                    _vtexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x, bufferDim.y);
-                    _vchromaTexture->updateSubData(frame._cbcrDataPointer, 0, 0, bufferDim.x >> 1, bufferDim.y >> 1);
-                    _vchroma2Texture->updateSubData(frame._cbcrDataPointer + chromaTexDataSize, 0, 0, bufferDim.x >> 1,
-                                                    bufferDim.y >> 1);
-                }
-            };
             break;
         case MEVideoPixelFormat::RGB32:
-            // RGBA8
-            _vtexture = new Texture2D();
-            _vtexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::RGBA8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
+            addPlane(false, 0, w, h, 4, PixelFormat::RGBA8);
             _vrender->setProgramState(rhi::ProgramType::VIDEO_TEXTURE_RGB32);
-
-            _renderFrameFunc = [this](const MEVideoFrame& frame) {
-                if (_vtexture)
-                {
-                    auto& bufferDim = frame._vpd._dim;
-                    _vtexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x, bufferDim.y);
-                }
-            };
             break;
         case MEVideoPixelFormat::BGR32:
-            // BGRA8
-            _vtexture = new Texture2D();
-            _vtexture->initWithSpec(
-                {
-                    .width       = static_cast<uint16_t>(desc._dim.x),
-                    .height      = static_cast<uint16_t>(desc._dim.y),
-                    .pixelFormat = PixelFormat::BGRA8,
-                },
-                Texture2D::DEFAULT_SLICE_DATA);
+            addPlane(false, 0, w, h, 4, PixelFormat::BGRA8);
             _vrender->setProgramState(rhi::ProgramType::VIDEO_TEXTURE_RGB32);
-            _renderFrameFunc = [this](const MEVideoFrame& frame) {
-                if (_vtexture)
-                {
-                    auto& bufferDim = frame._vpd._dim;
-                    _vtexture->updateSubData(frame._dataPointer, 0, 0, bufferDim.x, bufferDim.y);
-                }
-            };
             break;
+        default:
+            return false;
         }
 
-        _vrender->setTexture(_vtexture);
+        bindFrontSet();
         _vrender->setTextureRect(ax::Rect{Vec2::ZERO, Vec2{
                                                           frame._videoDim.x / AX_CONTENT_SCALE_FACTOR(),
                                                           frame._videoDim.y / AX_CONTENT_SCALE_FACTOR(),
                                                       }});
 
         if (pixelFormat >= MEVideoPixelFormat::YUY2)
+            PrivateVideoContext::updateColorTransform(_vrender->getProgramState(), frame._vpd._fullRange);
+
+        _scaleDirty = true;
+
+        return true;
+    }
+
+    void bindFrontSet()
+    {
+        auto& front = _textures[_frontSet];
+        _vrender->setTexture(front[0]);
+        if (_numPlanes > 1)
         {
             auto ps = _vrender->getProgramState();
-            PrivateVideoContext::updateColorTransform(ps, frame._vpd._fullRange);
+            ps->setTexture(ps->getUniformLocation("u_tex1"), 1, front[1]->getRHITexture());
+            if (_numPlanes > 2)
+                ps->setTexture(ps->getUniformLocation("u_tex2"), 2, front[2]->getRHITexture());
+        }
+    }
 
-            ps->setTexture(ps->getUniformLocation("u_tex1"), 1, _vchromaTexture->getRHITexture());
+    void renderFrame(const MEVideoFrame& frame)
+    {
+        if (_numPlanes == 0)
+            return;
+
+        // draw() doesn't transfer while a frame is pending, only a frame pushed outside of it lands here
+        if (_pendingFrame)
+            ++_stats.framesSkipped;
+        _pendingPlane = 0;
+        _pendingRow   = 0;
 
-            if (pixelFormat == MEVideoPixelFormat::I420)
-                ps->setTexture(ps->getUniformLocation("u_tex2"), 2, _vchroma2Texture->getRHITexture());
+        // only pooled frames outlive the callback, others are uploaded at once
+        if (frame._buffer && _uploadBudget > 0)
+        {
+            _pendingFrame = frame._buffer;
+            uploadPendingFrame();
         }
+        else
+        {
+            _pendingFrame.reset();
+            uploadRows(frame._dataPointer, frame._cbcrDataPointer, SIZE_MAX);
+        }
+    }
 
-        _scaleDirty = true;
+    void uploadPendingFrame()
+    {
+        if (!_pendingFrame)
+            return;
 
-        return true;
+        auto& buffer = *_pendingFrame;
+        if (uploadRows(buffer._data.data(), buffer._data.data() + buffer._cbcrOffset, _uploadBudget))
+            _pendingFrame.reset();
     }
 
-    void renderFrame(const MEVideoFrame& frame)
+    // uploads up to budget bytes into the back set, presents it once the frame is complete
+    bool uploadRows(const uint8_t* data, const uint8_t* cbcrData, size_t budget)
     {
-        if (_renderFrameFunc)
-            _renderFrameFunc(const_cast<MEVideoFrame&>(frame));
+        auto start = std::chrono::steady_clock::now();
+
+        auto& back = _textures[_frontSet ^ 1];
+        while (_pendingPlane < _numPlanes && budget > 0)
+        {
+            auto& plane = _planes[_pendingPlane];
+            auto rows   = plane.height - _pendingRow;
+            if (budget < static_cast<size_t>(rows) * plane.bytesPerRow)  // at least a row to make progress
+                rows = (std::max)(1, static_cast<int>(budget / plane.bytesPerRow));
+
+            auto src = (plane.cbcr ? cbcrData : data) + plane.offset +
+                       static_cast<size_t>(_pendingRow) * plane.bytesPerRow;
+            back[_pendingPlane]->updateSubData(src, 0, _pendingRow, plane.width, rows);
+
+            budget -= (std::min)(budget, static_cast<size_t>(rows) * plane.bytesPerRow);
+            _pendingRow += rows;
+            if (_pendingRow == plane.height)
+            {
+                ++_pendingPlane;
+                _pendingRow = 0;
+            }
+        }
+
+        _drawUploadMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (_pendingPlane < _numPlanes)
+            return false;
+
+        _frontSet ^= 1;
+        bindFrontSet();
+        ++_stats.framesUploaded;
+        return true;
     }
 
     void rescaleTo(MediaPlayer* videoView)
@@ -1136,9 +1137,7 @@ MediaPlayer::~MediaPlayer()
         _meFactory->destroyMediaEngine(pvd->_engine);
     }
     AX_SAFE_RELEASE(pvd->_vrender);
-    AX_SAFE_RELEASE(pvd->_vtexture);
-    AX_SAFE_RELEASE(pvd->_vchromaTexture);
-    AX_SAFE_RELEASE(pvd->_vchroma2Texture);
+    pvd->releaseTextures();
 
     if (g_mediaControlsTexture && g_mediaControlsTexture->getReferenceCount() == 1)
     {
@@ -1227,10 +1226,18 @@ void MediaPlayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags
     if (!vrender || !engine)
         return;
 
+    pvd->_drawUploadMs = 0;
     if (isPlaying())
-    {  // render 1 video sample if avaiable
-        engine->transferVideoFrame();
+    {
+        // finish the frame being uploaded before taking the next one, the engine keeps only the latest frame
+        // meanwhile, so a frame needing more draws than the frame interval is still presented
+        if (pvd->_pendingFrame)
+            pvd->uploadPendingFrame();
+        else
+            engine->transferVideoFrame();
     }
+    pvd->_stats.lastUploadMs = pvd->_drawUploadMs;
+    pvd->_stats.maxUploadMs  = (std::max)(pvd->_stats.maxUploadMs, pvd->_drawUploadMs);
     if (pvd->_scaleDirty || (flags & FLAGS_TRANSFORM_DIRTY))
         pvd->rescaleTo(this);
 
@@ -1242,6 +1249,30 @@ void MediaPlayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags
 #    endif
 }
 
+void MediaPlayer::setVideoUploadBudget(size_t bytesPerDraw)
+{
+    reinterpret_cast<PrivateVideoContext*>(_videoContext)->_uploadBudget = bytesPerDraw;
+}
+
+size_t MediaPlayer::getVideoUploadBudget() const
+{
+    return reinterpret_cast<PrivateVideoContext*>(_videoContext)->_uploadBudget;
+}
+
+MediaPlayer::VideoStats MediaPlayer::getVideoStats() const
+{
+    auto pvd   = reinterpret_cast<PrivateVideoContext*>(_videoContext);
+    auto stats = pvd->_stats;
+    if (pvd->_engine)
+    {
+        auto frameStats         = pvd->_engine->getFrameStats();
+        stats.framesDecoded     = frameStats.framesDecoded;
+        stats.framesDropped     = frameStats.framesDropped;
+        stats.bufferAllocations = frameStats.bufferAllocations;
+    }
+    return stats;
+}
+
 void MediaPlayer::setContentSize(const Size& contentSize)
 {
     Widget::setContentSize(contentSize);
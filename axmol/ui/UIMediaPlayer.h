@@ -189,6 +189,20 @@ public:
         NONE
     };
 
+    /**
+     * Counters of the video frame path, from the media engine to the textures.
+     */
+    struct VideoStats
+    {
+        uint64_t framesDecoded{0};      // frames produced by the media engine
+        uint64_t framesDropped{0};      // decoded frames superseded before they were transferred
+        uint64_t framesSkipped{0};      // transferred frames superseded before their upload completed
+        uint64_t framesUploaded{0};     // frames fully uploaded and presented
+        uint64_t bufferAllocations{0};  // frame buffers allocated by the media engine
+        float lastUploadMs{0};          // main thread time spent uploading during the last draw
+        float maxUploadMs{0};
+    };
+
     /**
      * A callback which will be called after specific MediaPlayer event happens.
      */
@@ -387,6 +401,18 @@ public:
     void setMediaController(MediaController* controller);
     MediaController* getMediaController() const { return _mediaController; }
 
+    /**
+     * Bounds the bytes of video data uploaded to the GPU per draw, a larger frame is uploaded over
+     * several draws into the back textures and presented once complete. The frames decoded meanwhile
+     * are dropped except the latest, which is uploaded next.
+     *
+     * @param bytesPerDraw  0 (the default) uploads every frame at once.
+     */
+    void setVideoUploadBudget(size_t bytesPerDraw);
+    size_t getVideoUploadBudget() const;
+
+    VideoStats getVideoStats() const;
+
     MediaPlayer();
     ~MediaPlayer() override;
 
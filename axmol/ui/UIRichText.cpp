@@ -31,6 +31,7 @@
 #include <locale>
 #include <algorithm>
 #include <regex>
+#include <list>
 
 #include "axmol/platform/FileUtils.h"
 #include "axmol/platform/Application.h"
@@ -889,7 +890,7 @@ void MyXMLVisitor::startElement(void* /*ctx*/, const char* elementName, const ch
 
                 if (auto&& itr = attrValueMap.find(RichText::KEY_FONT_SIZE); itr != attrValueMap.end())
                 {
-                    std::regex fontSizePattern(R"(([0-9]*(?:\.[0-9]+)?)(%|em)$)");
+                    static const std::regex fontSizePattern(R"(([0-9]*(?:\.[0-9]+)?)(%|em)$)");
                     std::smatch match;
                     auto sizeString = itr->second.asString();
                     if (std::regex_match(sizeString, match, fontSizePattern) && match.size() == 3 &&
@@ -1245,6 +1246,57 @@ const std::string_view RichText::KEY_ANCHOR_TEXT_SHADOW_BLUR_RADIUS("KEY_ANCHOR_
 const std::string_view RichText::KEY_ANCHOR_TEXT_GLOW_COLOR("KEY_ANCHOR_TEXT_GLOW_COLOR"sv);
 const std::string_view RichText::KEY_ID("KEY_ID"sv);
 
+size_t RichText::_parseCacheCapacity = 128;
+
+namespace
+{
+// most recently used first
+template <typename _Ty>
+struct LruCache
+{
+    using Entries = std::list<std::pair<std::string, _Ty>>;
+
+    Entries entries;
+    std::unordered_map<std::string_view, typename Entries::iterator> index;
+
+    const _Ty* find(std::string_view key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return nullptr;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    void insert(std::string&& key, _Ty&& value, size_t capacity)
+    {
+        if (auto it = index.find(key); it != index.end())
+        {
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        entries.emplace_front(std::move(key), std::move(value));
+        index[entries.front().first] = entries.begin();
+        trim(capacity);
+    }
+
+    void trim(size_t capacity)
+    {
+        while (entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+};
+
+// parsed elements by markup, never handed out directly, see RichText::cloneElement
+LruCache<Vector<RichElement*>> s_parseCache;
+
+// split position of a text run by font, style, wrap mode and the space left on the line
+LruCache<int> s_splitCache;
+}  // namespace
+
 RichText::RichText() : _formatTextDirty(true), _leftSpaceWidth(0.0f)
 {
     _defaults[KEY_VERTICAL_SPACE]           = 0.0f;
@@ -1327,14 +1379,121 @@ bool RichText::setString(std::string_view text)
         fmt::format_to(std::back_inserter(_xmlText), FMT_COMPILE(R"(<font face="{}" size="{}" color="{}">{}</font>)"),
                        this->getFontFace(), this->getFontSize(), this->getFontColor(), _text);
 
+        // the anchor style is applied while parsing, so it is part of the key
+        std::string cacheKey;
+        if (_parseCacheCapacity > 0)
+        {
+            cacheKey = _xmlText;
+            for (auto key : {KEY_ANCHOR_FONT_COLOR_STRING, KEY_ANCHOR_TEXT_BOLD, KEY_ANCHOR_TEXT_ITALIC,
+                             KEY_ANCHOR_TEXT_LINE, KEY_ANCHOR_TEXT_STYLE, KEY_ANCHOR_TEXT_OUTLINE_COLOR,
+                             KEY_ANCHOR_TEXT_OUTLINE_SIZE, KEY_ANCHOR_TEXT_SHADOW_COLOR,
+                             KEY_ANCHOR_TEXT_SHADOW_OFFSET_WIDTH, KEY_ANCHOR_TEXT_SHADOW_OFFSET_HEIGHT,
+                             KEY_ANCHOR_TEXT_SHADOW_BLUR_RADIUS, KEY_ANCHOR_TEXT_GLOW_COLOR})
+            {
+                cacheKey.push_back('\0');
+                if (auto it = _defaults.find(key); it != _defaults.end())
+                    cacheKey += it->second.asString();
+            }
+
+            if (auto cached = s_parseCache.find(cacheKey))
+            {
+                _richElements.reserve(cached->size());
+                for (auto element : *cached)
+                    _richElements.pushBack(cloneElement(element));
+                return true;
+            }
+        }
+
         MyXMLVisitor visitor(this);
         SAXParser parser;
         parser.setDelegator(&visitor);
-        return parser.parseIntrusive(&_xmlText.front(), _xmlText.length(), SAXParser::ParseOption::HTML);
+        if (!parser.parseIntrusive(&_xmlText.front(), _xmlText.length(), SAXParser::ParseOption::HTML))
+            return false;
+
+        // a custom node can only be added to one RichText
+        if (_parseCacheCapacity > 0 && std::none_of(_richElements.begin(), _richElements.end(), [](RichElement* e) {
+                return e->equalType(RichElement::Type::CUSTOM);
+            }))
+        {
+            Vector<RichElement*> elements;
+            elements.reserve(_richElements.size());
+            for (auto element : _richElements)
+                elements.pushBack(cloneElement(element));
+            s_parseCache.insert(std::move(cacheKey), std::move(elements), _parseCacheCapacity);
+        }
     }
     return true;
 }
 
+RichElement* RichText::cloneElement(RichElement* element)
+{
+    // fields are copied one by one, a copy constructed Object would also copy the reference count
+    RichElement* clone = nullptr;
+    switch (element->_type)
+    {
+    case RichElement::Type::TEXT:
+    {
+        auto src  = static_cast<RichElementText*>(element);
+        auto text = new RichElementText();
+
+        text->_text             = src->_text;
+        text->_fontName         = src->_fontName;
+        text->_fontSize         = src->_fontSize;
+        text->_flags            = src->_flags;
+        text->_url              = src->_url;
+        text->_outlineColor     = src->_outlineColor;
+        text->_outlineSize      = src->_outlineSize;
+        text->_shadowColor      = src->_shadowColor;
+        text->_shadowOffset     = src->_shadowOffset;
+        text->_shadowBlurRadius = src->_shadowBlurRadius;
+        text->_glowColor        = src->_glowColor;
+        text->_id               = src->_id;
+        clone                   = text;
+        break;
+    }
+    case RichElement::Type::IMAGE:
+    {
+        auto src   = static_cast<RichElementImage*>(element);
+        auto image = new RichElementImage();
+
+        image->_filePath    = src->_filePath;
+        image->_textureRect = src->_textureRect;
+        image->_textureType = src->_textureType;
+        image->_width       = src->_width;
+        image->_height      = src->_height;
+        image->_scaleX      = src->_scaleX;
+        image->_scaleY      = src->_scaleY;
+        image->_url         = src->_url;
+        image->_id          = src->_id;
+        clone               = image;
+        break;
+    }
+    case RichElement::Type::NEWLINE:
+        clone = new RichElementNewLine(static_cast<RichElementNewLine*>(element)->_quantity);
+        break;
+    default:  // custom nodes are never cached
+        AXASSERT(false, "RichText: only text, image and newline elements can be cloned");
+        return nullptr;
+    }
+    clone->_tag   = element->_tag;
+    clone->_color = element->_color;
+    clone->autorelease();
+    return clone;
+}
+
+void RichText::setParseCacheCapacity(size_t capacity)
+{
+    _parseCacheCapacity = capacity;
+    s_parseCache.trim(capacity);
+    s_splitCache.trim(capacity);
+}
+
+void RichText::clearParseCache()
+{
+    s_parseCache.trim(0);
+    s_splitCache.trim(0);
+}
+
 void RichText::initRenderer() {}
 
 void RichText::insertElement(RichElement* element, int index)
@@ -1725,11 +1884,13 @@ void RichText::setTagDescription(std::string_view tag,
                                  VisitExitHandler handleVisitExit)
 {
     MyXMLVisitor::setTagDescription(tag, isFontElement, std::move(handleVisitEnter), std::move(handleVisitExit));
+    clearParseCache();
 }
 
 void RichText::removeTagDescription(std::string_view tag)
 {
     MyXMLVisitor::removeTagDescription(tag);
+    clearParseCache();
 }
 
 void RichText::openUrl(std::string_view url)
@@ -2168,14 +2329,31 @@ void RichText::handleTextRenderer(std::string_view text,
             else
                 estimatedIdx = static_cast<int>(_leftSpaceWidth / fontSize);
 
+            // the search below measures the label once per word or char, a repeated string at the same width
+            // reuses the position found last time
+            std::string splitKey;
+            const int* cachedLength = nullptr;
+            if (_parseCacheCapacity > 0)
+            {
+                fmt::format_to(std::back_inserter(splitKey), "{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{}",
+                               fontName, fileExist, fontSize, flags, outlineSize, static_cast<int>(wrapMode),
+                               _leftSpaceWidth, _customSize.width, utf8Text);
+                cachedLength = s_splitCache.find(splitKey);
+            }
+
             int leftLength = 0;
-            if (wrapMode == WRAP_PER_WORD)
+            if (cachedLength)
+                leftLength = *cachedLength;
+            else if (wrapMode == WRAP_PER_WORD)
                 leftLength =
                     findSplitPositionForWord(textRenderer, textSpan, estimatedIdx, _leftSpaceWidth, _customSize.width);
             else
                 leftLength =
                     findSplitPositionForChar(textRenderer, textSpan, estimatedIdx, _leftSpaceWidth, _customSize.width);
 
+            if (!cachedLength && _parseCacheCapacity > 0)
+                s_splitCache.insert(std::move(splitKey), int{leftLength}, _parseCacheCapacity);
+
             // split string
             if (leftLength > 0)
             {
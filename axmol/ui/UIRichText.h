@@ -573,6 +573,22 @@ public:
      */
     static void removeTagDescription(std::string_view tag);
 
+    /**
+     * @brief Sets how many parsed markup strings are kept for reuse, 0 disables the cache.
+     * Elements are cached by source string and anchor style, the cache is cleared whenever a tag description
+     * changes. Markup that produces custom nodes is never cached. Every RichText gets its own copy of the cached
+     * elements, so changing an element of one RichText never affects another.
+     * The same capacity bounds the cache of line break positions, which lets a repeated string at the same width
+     * skip the per word measurement of formatText.
+     */
+    static void setParseCacheCapacity(size_t capacity);
+    static size_t getParseCacheCapacity() { return _parseCacheCapacity; }
+
+    /**
+     * @brief Removes all cached parse results and line break positions.
+     */
+    static void clearParseCache();
+
     void openUrl(std::string_view url);
 
     /**
@@ -618,6 +634,7 @@ protected:
                              float scaleY        = 1.f,
                              std::string_view id = ""sv);
     void handleCustomRenderer(Node* renderer, std::string_view id = ""sv);
+    static RichElement* cloneElement(RichElement* element);
     void formatRenderers();
     void addNewLine(int quantity = 1);
     void doHorizontalAlignment(const Vector<Node*>& row, float rowWidth);
@@ -634,6 +651,8 @@ protected:
 
     std::string _text;
     std::string _xmlText;
+
+    static size_t _parseCacheCapacity;
 };
 
 }  // namespace ui
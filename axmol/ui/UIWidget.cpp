@@ -555,6 +555,12 @@ void Widget::onSizeChanged()
             }
         }
     }
+
+    Widget* widgetParent = getWidgetParent();
+    if (widgetParent)
+    {
+        widgetParent->onChildSizeChanged(this);
+    }
 }
 
 Vec2 Widget::getVirtualRendererSize() const
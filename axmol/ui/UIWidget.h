@@ -801,6 +801,9 @@ protected:
     // call back function called when size changed.
     virtual void onSizeChanged();
 
+    // call back function called when the size of a child widget changed.
+    virtual void onChildSizeChanged(Widget* /*child*/) {}
+
     // initializes renderer of widget.
     virtual void initRenderer();
 
@@ -23,6 +23,7 @@
  THE SOFTWARE.
  ****************************************************************************/
 #include "AssetsManagerEx.h"
+#include "AssetsPatch.h"
 #include "EventListenerAssetsManagerEx.h"
 #include "axmol/base/text_utils.h"
 #include "axmol/base/Director.h"
@@ -42,6 +43,7 @@ NS_AX_EXT_BEGIN
 #define VERSION_FILENAME           "version.manifest"
 #define TEMP_MANIFEST_FILENAME     "project.manifest.temp"
 #define MANIFEST_FILENAME          "project.manifest"
+#define PATCH_SUFFIX               ".patch"
 
 #define BUFFER_SIZE                8192
 #define MAX_FILENAME               512
@@ -573,6 +575,192 @@ void AssetsManagerEx::decompressDownloadedZip(std::string_view customId, std::st
     }, [decompressFinished, asyncData]() { decompressFinished(asyncData); });
 }
 
+void AssetsManagerEx::preparePatch(DownloadUnit& unit)
+{
+    auto& remoteAssets = _remoteManifest->getAssets();
+    auto& localAssets  = _localManifest->getAssets();
+    auto remoteIt      = remoteAssets.find(unit.customId);
+    auto localIt       = localAssets.find(unit.customId);
+    if (remoteIt == remoteAssets.end() || localIt == localAssets.end() || localIt->second.md5.empty())
+        return;
+
+    // a compressed asset is removed once unzipped, there is no installed file to patch
+    if (remoteIt->second.compressed || localIt->second.compressed)
+        return;
+
+    for (auto&& patch : remoteIt->second.patches)
+    {
+        if (patch.from != localIt->second.md5)
+            continue;
+
+        auto basePath = _localManifest->_manifestRoot + localIt->second.path;
+        if (!_fileUtils->isFileExist(basePath))
+            return;
+
+        unit.srcUrl = _remoteManifest->getPackageUrl();
+        unit.srcUrl += patch.path;
+        unit.storagePath += PATCH_SUFFIX;
+        unit.size      = patch.size;
+        unit.patchBase = std::move(basePath);
+        return;
+    }
+}
+
+void AssetsManagerEx::processDownloadedAsset(std::string_view customId, std::string_view storagePath)
+{
+    enum class Result
+    {
+        SUCCEED,
+        PATCH_FAILED,
+        VERIFY_FAILED,
+        VERIFY_PENDING,  // the verify callback must run on the main thread
+        DECOMPRESS_FAILED
+    };
+
+    struct AsyncData
+    {
+        std::string customId;
+        std::string downloadedFile;
+        std::string assetFile;
+        std::string patchBase;
+        Manifest::Asset asset;
+        bool compressed;
+        bool verify;
+        Result result;
+    };
+
+    auto& assets = _remoteManifest->getAssets();
+    auto assetIt = assets.find(customId);
+    auto unitIt  = _downloadUnits.find(customId);
+
+    AsyncData* asyncData      = new AsyncData;
+    asyncData->customId       = customId;
+    asyncData->downloadedFile = storagePath;
+    asyncData->assetFile      = storagePath;
+    asyncData->compressed     = false;
+    asyncData->verify         = false;
+    asyncData->result         = Result::SUCCEED;
+    if (assetIt != assets.end())
+    {
+        asyncData->asset      = assetIt->second;
+        asyncData->compressed = assetIt->second.compressed;
+        asyncData->verify     = _verifyCallback != nullptr;
+    }
+    if (unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty())
+    {
+        asyncData->patchBase = unitIt->second.patchBase;
+        asyncData->assetFile.resize(asyncData->assetFile.size() - (sizeof(PATCH_SUFFIX) - 1));
+    }
+
+    auto verifyCallback = _concurrentVerifyEnabled ? _verifyCallback : nullptr;
+
+    // completion runs on the main thread, assets in flight are processed on as many workers as are free
+    this->retain();
+    Director::getInstance()->getJobSystem()->enqueue([this, asyncData, verifyCallback]() {
+        if (!asyncData->patchBase.empty())
+        {
+            bool patched =
+                AssetsPatch::apply(asyncData->patchBase, asyncData->downloadedFile, asyncData->assetFile);
+            _fileUtils->removeFile(asyncData->downloadedFile);
+            if (!patched)
+            {
+                _fileUtils->removeFile(asyncData->assetFile);
+                asyncData->result = Result::PATCH_FAILED;
+                return;
+            }
+        }
+
+        if (asyncData->verify)
+        {
+            if (!verifyCallback)
+            {
+                asyncData->result = Result::VERIFY_PENDING;
+                return;
+            }
+            if (!verifyCallback(asyncData->assetFile, asyncData->asset))
+            {
+                asyncData->result = Result::VERIFY_FAILED;
+                return;
+            }
+        }
+
+        if (asyncData->compressed)
+        {
+            if (!decompress(asyncData->assetFile))
+                asyncData->result = Result::DECOMPRESS_FAILED;
+            _fileUtils->removeFile(asyncData->assetFile);
+        }
+    }, [this, asyncData]() {
+        auto result = asyncData->result;
+        if (result == Result::VERIFY_PENDING)
+        {
+            if (!_verifyCallback(asyncData->assetFile, asyncData->asset))
+                result = Result::VERIFY_FAILED;
+            else if (asyncData->compressed)
+            {
+                decompressDownloadedZip(asyncData->customId, asyncData->assetFile);
+                delete asyncData;
+                this->release();
+                return;
+            }
+            else
+                result = Result::SUCCEED;
+        }
+
+        switch (result)
+        {
+        case Result::SUCCEED:
+            fileSuccess(asyncData->customId, asyncData->assetFile);
+            break;
+        case Result::VERIFY_FAILED:
+            // a patched asset that doesn't verify was built from a modified base, fetch the whole file instead
+            if (!asyncData->patchBase.empty())
+            {
+                downloadWithoutPatch(asyncData->customId);
+                break;
+            }
+            fileError(asyncData->customId, "Asset file verification failed after downloaded");
+            break;
+        case Result::PATCH_FAILED:
+            downloadWithoutPatch(asyncData->customId);
+            break;
+        default:
+        {
+            std::string errorMsg = "Unable to decompress file " + asyncData->assetFile;
+            dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_DECOMPRESS, "", errorMsg);
+            fileError(asyncData->customId, errorMsg);
+        }
+        }
+        delete asyncData;
+        this->release();
+    });
+}
+
+void AssetsManagerEx::downloadWithoutPatch(std::string_view customId)
+{
+    AXLOGD("AssetsManagerEx : patch of {} can't be applied, download the whole file\n", customId);
+
+    auto unitIt  = _downloadUnits.find(customId);
+    auto& assets = _remoteManifest->getAssets();
+    auto assetIt = assets.find(customId);
+    if (unitIt == _downloadUnits.end() || assetIt == assets.end())
+    {
+        fileError(customId, "Asset patch can't be applied");
+        return;
+    }
+
+    DownloadUnit& unit = unitIt->second;
+    unit.srcUrl        = _remoteManifest->getPackageUrl();
+    unit.srcUrl += assetIt->second.path;
+    unit.storagePath.resize(unit.storagePath.size() - (sizeof(PATCH_SUFFIX) - 1));
+    unit.size = assetIt->second.size;
+    unit.patchBase.clear();
+
+    _currConcurrentTask = MAX(0, _currConcurrentTask - 1);
+    _queue.emplace_back(unit.customId);
+    queueDowload();
+}
+
 void AssetsManagerEx::dispatchUpdateEvent(EventAssetsManagerEx::EventCode code,
                                           std::string_view assetId /* = ""*/,
                                           std::string_view message /* = ""*/,
@@ -626,7 +814,10 @@ void AssetsManagerEx::downloadVersion()
     {
         _updateState = State::DOWNLOADING_VERSION;
         // Download version file asynchronously
-        _downloader->createDownloadFileTask(versionUrl, _tempVersionPath, VERSION_ID);
+        _downloader->createDownloadFileTask(versionUrl, _tempVersionPath, VERSION_ID, "", false, "",
+                                            network::Downloader::Priority::HIGH);
+        // the assets are usually served by another host, connect to it while the version is checked
+        _downloader->warmup(_localManifest->getPackageUrl());
     }
     // No version file found
     else
@@ -697,7 +888,8 @@ void AssetsManagerEx::downloadManifest()
     {
         _updateState = State::DOWNLOADING_MANIFEST;
         // Download version file asynchronously
-        _downloader->createDownloadFileTask(manifestUrl, _tempManifestPath, MANIFEST_ID);
+        _downloader->createDownloadFileTask(manifestUrl, _tempManifestPath, MANIFEST_ID, "", false, "",
+                                            network::Downloader::Priority::HIGH);
     }
     // No manifest file found
     else
@@ -762,6 +954,8 @@ void AssetsManagerEx::startUpdate()
     {
         _tempManifest->saveToFile(_tempManifestPath);
         _tempManifest->genResumeAssetsList(&_downloadUnits);
+        for (auto&& item : _downloadUnits)
+            preparePatch(item.second);
         _totalWaitToDownload = _totalToDownload = (int)_downloadUnits.size();
         this->batchDownload();
 
@@ -811,6 +1005,7 @@ void AssetsManagerEx::startUpdate()
                     unit.srcUrl += path;
                     unit.storagePath = _tempStoragePath + path;
                     unit.size        = diff.asset.size;
+                    preparePatch(unit);
                     _downloadUnits.emplace(unit.customId, unit);
                     _tempManifest->setAssetDownloadState(it->first, Manifest::DownloadState::UNSTARTED);
                 }
@@ -1186,6 +1381,14 @@ void AssetsManagerEx::onSuccess(std::string_view /*srcUrl*/, std::string_view st
         bool ok      = true;
         auto& assets = _remoteManifest->getAssets();
         auto assetIt = assets.find(customId);
+        auto unitIt  = _downloadUnits.find(customId);
+        bool patched = unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty();
+        if (patched || (_concurrentVerifyEnabled && _verifyCallback))
+        {
+            processDownloadedAsset(customId, storagePath);
+            return;
+        }
+
         if (assetIt != assets.end())
         {
             Manifest::Asset asset = assetIt->second;
@@ -134,6 +134,13 @@ public:
         _verifyCallback = callback;
     };
 
+    /** @brief Run the verify callback on worker threads, so hashing overlaps with patching and unzipping of
+     * other assets. The callback must be thread safe then, which script callbacks aren't, so it's off by default.
+     */
+    void setConcurrentVerifyEnabled(bool enabled) { _concurrentVerifyEnabled = enabled; };
+
+    bool isConcurrentVerifyEnabled() const { return _concurrentVerifyEnabled; };
+
     AssetsManagerEx(std::string_view manifestUrl, std::string_view storagePath);
 
     virtual ~AssetsManagerEx();
@@ -168,6 +175,18 @@ protected:
     bool decompress(std::string_view filename);
     void decompressDownloadedZip(std::string_view customId, std::string_view storagePath);
 
+    /** @brief Download a delta patch instead of the whole asset when the manifest has one for the installed version
+     */
+    void preparePatch(DownloadUnit& unit);
+
+    /** @brief Apply the patch, verify and decompress a downloaded asset on a worker thread
+     */
+    void processDownloadedAsset(std::string_view customId, std::string_view storagePath);
+
+    /** @brief Download the whole asset after its patch failed to apply
+     */
+    void downloadWithoutPatch(std::string_view customId);
+
     /** @brief Update a list of assets under the current AssetsManagerEx context
      */
     void updateAssets(const DownloadUnits& assets);
@@ -329,6 +348,9 @@ private:
     //! Callback function to verify the downloaded assets
     std::function<bool(std::string_view path, Manifest::Asset asset)> _verifyCallback = nullptr;
 
+    //! Whether the verify callback runs on worker threads
+    bool _concurrentVerifyEnabled = false;
+
     //! Marker for whether the assets manager is inited
     bool _inited = false;
 };
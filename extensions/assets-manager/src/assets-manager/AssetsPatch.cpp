@@ -0,0 +1,235 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "AssetsPatch.h"
+#include "axmol/base/ZipUtils.h"
+#include "axmol/platform/FileUtils.h"
+
+#include <string.h>
+#include <unordered_map>
+
+NS_AX_EXT_BEGIN
+
+#define PATCH_MAGIC      "AXPT"
+#define PATCH_VERSION    1
+#define PATCH_BLOCK_SIZE 32
+#define COPY_BUFFER_SIZE 65536
+
+enum PatchOp : uint8_t
+{
+    PATCH_OP_COPY,
+    PATCH_OP_ADD,
+};
+
+static void writeVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool AssetsPatch::apply(std::string_view oldFile, std::string_view patchFile, std::string_view newFile)
+{
+    auto fileUtils = FileUtils::getInstance();
+
+    std::vector<uint8_t> patch;
+    if (fileUtils->getContents(patchFile, &patch) != FileUtils::Status::OK || patch.size() < 5 ||
+        memcmp(patch.data(), PATCH_MAGIC, 4) != 0 || patch[4] != PATCH_VERSION)
+    {
+        AXLOGW("AssetsPatch : invalid patch file {}", patchFile);
+        return false;
+    }
+
+    const uint8_t* p   = patch.data() + 5;
+    const uint8_t* end = patch.data() + patch.size();
+    uint64_t oldSize = 0, newSize = 0;
+    if (!readVarint(p, end, oldSize) || !readVarint(p, end, newSize))
+        return false;
+
+    auto ops = ZipUtils::decompressGZ(p, end - p);
+
+    auto oldFs = fileUtils->openFileStream(oldFile, IFileStream::Mode::READ);
+    if (!oldFs || static_cast<uint64_t>(oldFs->size()) != oldSize)
+    {
+        AXLOGW("AssetsPatch : {} is not the file the patch was made from", oldFile);
+        return false;
+    }
+
+    auto newFs = fileUtils->openFileStream(newFile, IFileStream::Mode::WRITE);
+    if (!newFs)
+        return false;
+
+    std::vector<uint8_t> buffer(COPY_BUFFER_SIZE);
+    uint64_t written = 0;
+    p                = ops.data();
+    end              = ops.data() + ops.size();
+    while (p < end)
+    {
+        uint8_t op      = *p++;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        if (op == PATCH_OP_COPY)
+        {
+            if (!readVarint(p, end, offset) || !readVarint(p, end, length) || offset + length > oldSize)
+                return false;
+            oldFs->seek(static_cast<int64_t>(offset), SEEK_SET);
+            while (length > 0)
+            {
+                auto chunk = static_cast<unsigned int>(std::min<uint64_t>(length, buffer.size()));
+                if (oldFs->read(buffer.data(), chunk) != static_cast<int>(chunk) ||
+                    newFs->write(buffer.data(), chunk) != static_cast<int>(chunk))
+                    return false;
+                length -= chunk;
+                written += chunk;
+            }
+        }
+        else if (op == PATCH_OP_ADD)
+        {
+            if (!readVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+                return false;
+            if (newFs->write(p, static_cast<unsigned int>(length)) != static_cast<int>(length))
+                return false;
+            p += length;
+            written += length;
+        }
+        else
+            return false;
+    }
+
+    return written == newSize;
+}
+
+std::vector<uint8_t> AssetsPatch::create(std::span<const uint8_t> oldData, std::span<const uint8_t> newData)
+{
+    // Rabin-Karp over PATCH_BLOCK_SIZE windows, the old file is indexed at block boundaries and every
+    // position of the new file is looked up, matches are then extended in both directions
+    constexpr uint64_t base = 1099511628211ull;
+    uint64_t outFactor      = 1;
+    for (int i = 1; i < PATCH_BLOCK_SIZE; ++i)
+        outFactor *= base;
+
+    auto hashBlock = [](const uint8_t* data) {
+        uint64_t h = 0;
+        for (int i = 0; i < PATCH_BLOCK_SIZE; ++i)
+            h = h * base + data[i];
+        return h;
+    };
+
+    std::unordered_map<uint64_t, size_t> blocks;
+    if (oldData.size() >= PATCH_BLOCK_SIZE)
+    {
+        blocks.reserve(oldData.size() / PATCH_BLOCK_SIZE);
+        for (size_t offset = 0; offset + PATCH_BLOCK_SIZE <= oldData.size(); offset += PATCH_BLOCK_SIZE)
+            blocks.emplace(hashBlock(oldData.data() + offset), offset);
+    }
+
+    std::vector<uint8_t> ops;
+    size_t addStart = 0;
+    auto flushAdd   = [&](size_t addEnd) {
+        if (addEnd > addStart)
+        {
+            ops.push_back(PATCH_OP_ADD);
+            writeVarint(ops, addEnd - addStart);
+            ops.insert(ops.end(), newData.begin() + addStart, newData.begin() + addEnd);
+        }
+    };
+
+    size_t pos = 0;
+    uint64_t h = 0;
+    if (!blocks.empty() && newData.size() >= PATCH_BLOCK_SIZE)
+        h = hashBlock(newData.data());
+    while (!blocks.empty() && pos + PATCH_BLOCK_SIZE <= newData.size())
+    {
+        auto it = blocks.find(h);
+        if (it != blocks.end() &&
+            memcmp(oldData.data() + it->second, newData.data() + pos, PATCH_BLOCK_SIZE) == 0)
+        {
+            size_t oldStart = it->second;
+            size_t newStart = pos;
+            while (newStart > addStart && oldStart > 0 && oldData[oldStart - 1] == newData[newStart - 1])
+            {
+                --oldStart;
+                --newStart;
+            }
+            size_t length = pos - newStart + PATCH_BLOCK_SIZE;
+            while (oldStart + length < oldData.size() && newStart + length < newData.size() &&
+                   oldData[oldStart + length] == newData[newStart + length])
+                ++length;
+
+            flushAdd(newStart);
+            ops.push_back(PATCH_OP_COPY);
+            writeVarint(ops, oldStart);
+            writeVarint(ops, length);
+
+            pos = addStart = newStart + length;
+            if (pos + PATCH_BLOCK_SIZE <= newData.size())
+                h = hashBlock(newData.data() + pos);
+            continue;
+        }
+
+        if (pos + PATCH_BLOCK_SIZE < newData.size())
+            h = (h - newData[pos] * outFactor) * base + newData[pos + PATCH_BLOCK_SIZE];
+        ++pos;
+    }
+    flushAdd(newData.size());
+
+    std::vector<uint8_t> patch(PATCH_MAGIC, PATCH_MAGIC + 4);
+    patch.push_back(PATCH_VERSION);
+    writeVarint(patch, oldData.size());
+    writeVarint(patch, newData.size());
+    auto compressed = ZipUtils::compressGZ(ops.data(), ops.size());
+    patch.insert(patch.end(), compressed.begin(), compressed.end());
+    return patch;
+}
+
+bool AssetsPatch::create(std::string_view oldFile, std::string_view newFile, std::string_view patchFile)
+{
+    auto fileUtils = FileUtils::getInstance();
+
+    std::vector<uint8_t> oldData, newData;
+    if (fileUtils->getContents(oldFile, &oldData) != FileUtils::Status::OK ||
+        fileUtils->getContents(newFile, &newData) != FileUtils::Status::OK)
+        return false;
+
+    auto patch = create(oldData, newData);
+    return FileUtils::writeBinaryToFile(patch.data(), patch.size(), patchFile);
+}
+
+NS_AX_EXT_END
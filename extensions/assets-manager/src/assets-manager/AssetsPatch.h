@@ -0,0 +1,62 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "extensions/ExtensionMacros.h"
+#include "extensions/ExtensionExport.h"
+
+NS_AX_EXT_BEGIN
+
+/**
+ * @brief Binary delta between two versions of an asset.
+ *
+ * A patch is the "AXPT" magic, a format version byte, the varint sizes of the old and the new file and a
+ * gzip stream of ops. COPY(offset, length) copies a range of the old file, ADD(length, bytes) inserts new
+ * bytes. Patches are generated offline with create() and applied by AssetsManagerEx when the manifest
+ * lists one for the installed version of an asset.
+ */
+class AX_EX_DLL AssetsPatch
+{
+public:
+    /** @brief Rebuilds newFile from oldFile and patchFile, the old file is read range by range.
+     * @return false if the patch is malformed or doesn't match the size of the old file
+     */
+    static bool apply(std::string_view oldFile, std::string_view patchFile, std::string_view newFile);
+
+    /** @brief Generates a patch turning oldData into newData, for tools and tests.
+     */
+    static std::vector<uint8_t> create(std::span<const uint8_t> oldData, std::span<const uint8_t> newData);
+
+    /** @brief Generates the patch between two files.
+     */
+    static bool create(std::string_view oldFile, std::string_view newFile, std::string_view patchFile);
+};
+
+NS_AX_EXT_END
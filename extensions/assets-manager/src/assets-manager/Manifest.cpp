@@ -47,6 +47,8 @@
 #define KEY_SIZE             "size"
 #define KEY_COMPRESSED_FILE  "compressedFile"
 #define KEY_DOWNLOAD_STATE   "downloadState"
+#define KEY_PATCHES          "patches"
+#define KEY_PATCH_FROM       "from"
 
 NS_AX_EXT_BEGIN
 
@@ -451,6 +453,24 @@ Manifest::Asset Manifest::parseAsset(std::string_view path, const rapidjson::Val
     else
         asset.downloadState = DownloadState::UNMARKED;
 
+    if (json.HasMember(KEY_PATCHES) && json[KEY_PATCHES].IsArray())
+    {
+        const rapidjson::Value& patches = json[KEY_PATCHES];
+        for (rapidjson::SizeType i = 0; i < patches.Size(); ++i)
+        {
+            const rapidjson::Value& entry = patches[i];
+            if (!entry.IsObject() || !entry.HasMember(KEY_PATCH_FROM) || !entry[KEY_PATCH_FROM].IsString() ||
+                !entry.HasMember(KEY_PATH) || !entry[KEY_PATH].IsString())
+                continue;
+
+            ManifestPatch patch;
+            patch.from = entry[KEY_PATCH_FROM].GetString();
+            patch.path = entry[KEY_PATH].GetString();
+            patch.size = entry.HasMember(KEY_SIZE) && entry[KEY_SIZE].IsInt() ? entry[KEY_SIZE].GetInt() : 0;
+            asset.patches.emplace_back(std::move(patch));
+        }
+    }
+
     return asset;
 }
 
@@ -45,6 +45,17 @@ struct DownloadUnit
     std::string storagePath;
     std::string customId;
     float size;
+    //! The installed file the downloaded delta patch applies to, empty for a full download
+    std::string patchBase;
+};
+
+//! A delta patch that rebuilds an asset from one of its previous versions, see AssetsPatch
+struct ManifestPatch
+{
+    //! md5 of the previous version the patch applies to
+    std::string from;
+    std::string path;
+    float size;
 };
 
 struct ManifestAsset
@@ -54,6 +65,7 @@ struct ManifestAsset
     bool compressed;
     float size;
     int downloadState;
+    std::vector<ManifestPatch> patches;
 };
 
 typedef tlx::string_map<DownloadUnit> DownloadUnits;
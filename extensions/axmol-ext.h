@@ -35,6 +35,7 @@
 
 #include "assets-manager/src/assets-manager/AssetsManager.h"
 #include "assets-manager/src/assets-manager/AssetsManagerEx.h"
+#include "assets-manager/src/assets-manager/AssetsPatch.h"
 #include "assets-manager/src/assets-manager/EventAssetsManagerEx.h"
 #include "assets-manager/src/assets-manager/EventListenerAssetsManagerEx.h"
 #include "assets-manager/src/assets-manager/Manifest.h"
@@ -80,7 +80,9 @@ int lua_register_ax_rhi_VertexFormat(lua_State* tolua_S)
         tolua_constant(tolua_S, "USHORT2", 9);
         tolua_constant(tolua_S, "UBYTE4", 10);
         tolua_constant(tolua_S, "MAT4", 11);
-        tolua_constant(tolua_S, "COUNT", 12);
+        tolua_constant(tolua_S, "HALF2", 12);
+        tolua_constant(tolua_S, "HALF4", 13);
+        tolua_constant(tolua_S, "COUNT", 14);
     tolua_endmodule(tolua_S);
 
     auto typeName = typeid(ax::rhi::VertexFormat).name(); // rtti is literal storage
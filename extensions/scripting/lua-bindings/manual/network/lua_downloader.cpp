@@ -126,6 +126,7 @@ static int lua_downloader_new(lua_State* L)
         hints.countOfMaxProcessingTasks = get_field_int(L, "countOfMaxProcessingTasks", 6);
         hints.timeoutInSeconds          = get_field_int(L, "timeoutInSeconds", 45);
         hints.tempFileNameSuffix        = get_field_string(L, "tempFileNameSuffix", ".tmp");
+        hints.countOfMaxTasksPerHost    = get_field_int(L, "countOfMaxTasksPerHost", 0);
 
         auto ptr   = lua_newuserdata(L, sizeof(Downloader));
         downloader = new (ptr) Downloader(hints);
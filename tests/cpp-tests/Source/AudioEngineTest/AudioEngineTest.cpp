@@ -43,7 +43,10 @@ AudioEngineTests::AudioEngineTests()
     ADD_TEST_CASE(AudioProfileTest);
     ADD_TEST_CASE(InvalidAudioFileTest);
     ADD_TEST_CASE(LargeAudioFileTest);
+    ADD_TEST_CASE(AudioStreamStatsTest);
     ADD_TEST_CASE(AudioPerformanceTest);
+    ADD_TEST_CASE(AudioVoiceStealingTest);
+    ADD_TEST_CASE(AudioCacheBenchmarkTest);
     ADD_TEST_CASE(AudioSmallFileTest);
     ADD_TEST_CASE(AudioSmallFile2Test);
     ADD_TEST_CASE(AudioSmallFile3Test);
@@ -778,6 +781,65 @@ std::string LargeAudioFileTest::title() const
     return "Test large audio file";
 }
 
+bool AudioStreamStatsTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        auto& layerSize = this->getContentSize();
+
+        auto playItem = TextButton::create("play 4 streams", [this](TextButton* button) {
+            for (int i = 0; i < 2; ++i)
+            {
+                _streamIds.emplace_back(AudioEngine::play2d("audio/LuckyDay.mp3", true, 0.25f));
+                _streamIds.emplace_back(AudioEngine::play2d("audio/MUS_BGM_Battle_Round1_v1.caf", true, 0.25f));
+            }
+        });
+        playItem->setPosition(layerSize.width * 0.3f, layerSize.height * 0.7f);
+        addChild(playItem);
+
+        auto stopItem = TextButton::create("stop all", [this](TextButton* button) {
+            AudioEngine::stopAll();
+            _streamIds.clear();
+        });
+        stopItem->setPosition(layerSize.width * 0.7f, layerSize.height * 0.7f);
+        addChild(stopItem);
+
+        _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+        _statsLabel->setPosition(layerSize.width * 0.5f, layerSize.height * 0.4f);
+        addChild(_statsLabel);
+
+        scheduleUpdate();
+        return true;
+    }
+
+    return false;
+}
+
+void AudioStreamStatsTest::update(float dt)
+{
+    std::string info;
+    AudioStreamStats stats;
+    for (auto audioId : _streamIds)
+    {
+        if (AudioEngine::getStreamStats(audioId, stats))
+        {
+            info += fmt::format("id {}: underruns {}, buffers {}, decode {:.2f}ms (max {:.2f}ms)\n", audioId,
+                                stats.underruns, stats.buffersQueued, stats.decodeTimeMs, stats.maxDecodeTimeMs);
+        }
+    }
+    _statsLabel->setString(info);
+}
+
+std::string AudioStreamStatsTest::title() const
+{
+    return "Streaming audio stats";
+}
+
+std::string AudioStreamStatsTest::subtitle() const
+{
+    return "All streams are refilled by one service thread, underruns should stay at 0";
+}
+
 bool AudioIssue18597Test::init()
 {
     if (AudioEngineTestDemo::init())
@@ -977,6 +1039,177 @@ std::string AudioPerformanceTest::subtitle() const
     return "Please see console for the result";
 }
 
+bool AudioVoiceStealingTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        AudioEngine::setMaxAudioInstance(256);
+        AudioEngine::setMaxRealVoices(4);
+
+        auto& layerSize = this->getContentSize();
+
+        auto playItem = TextButton::create("fire 32 one-shots", [this](TextButton* button) {
+            for (int i = 0; i < 32; ++i)
+            {
+                AudioPlayerSettings settings;
+                settings.volume   = ax::random(0.1f, 1.0f);
+                settings.priority = i % 8 == 0 ? 1 : 0;
+                auto audioFile    = fmt::format("audio/SoundEffectsFX009/FX0{}.mp3", 81 + i % 10);
+                _audioIds.emplace_back(AudioEngine::play2d(audioFile, settings));
+            }
+        });
+        playItem->setPosition(layerSize.width * 0.5f, layerSize.height * 0.7f);
+        addChild(playItem);
+
+        _voicesLabel = Label::createWithTTF("", "fonts/arial.ttf", 20);
+        _voicesLabel->setPosition(layerSize.width * 0.5f, layerSize.height * 0.4f);
+        addChild(_voicesLabel);
+
+        scheduleUpdate();
+        return true;
+    }
+
+    return false;
+}
+
+void AudioVoiceStealingTest::onExit()
+{
+    AudioEngine::setMaxRealVoices(MAX_AUDIOINSTANCES);
+    AudioEngine::setMaxAudioInstance(MAX_AUDIOINSTANCES);
+    AudioEngineTestDemo::onExit();
+}
+
+void AudioVoiceStealingTest::update(float dt)
+{
+    int realVoices = 0, virtualVoices = 0;
+    std::erase_if(_audioIds, [](AUDIO_ID audioId) {
+        return AudioEngine::getState(audioId) == AudioEngine::AudioState::ERROR;
+    });
+    for (auto audioId : _audioIds)
+    {
+        if (AudioEngine::isVirtual(audioId))
+            ++virtualVoices;
+        else
+            ++realVoices;
+    }
+    _voicesLabel->setString(fmt::format("real voices: {}, virtual voices: {}", realVoices, virtualVoices));
+}
+
+std::string AudioVoiceStealingTest::title() const
+{
+    return "Voice virtualization";
+}
+
+std::string AudioVoiceStealingTest::subtitle() const
+{
+    return "Only 4 real voices, the loudest and high priority sounds should be heard";
+}
+
+bool AudioCacheBenchmarkTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        for (int i = 81; i <= 90; ++i)
+            _audioFiles.emplace_back(fmt::format("audio/SoundEffectsFX009/FX0{}.mp3", i));
+
+        auto& layerSize = this->getContentSize();
+
+        auto pcmItem = TextButton::create("pcm cache", [this](TextButton* button) { runBenchmark(false); });
+        pcmItem->setPosition(layerSize.width * 0.3f, layerSize.height * 0.75f);
+        addChild(pcmItem);
+
+        auto compressedItem =
+            TextButton::create("compressed cache", [this](TextButton* button) { runBenchmark(true); });
+        compressedItem->setPosition(layerSize.width * 0.7f, layerSize.height * 0.75f);
+        addChild(compressedItem);
+
+        auto budgetItem = TextButton::create("pcm budget: unlimited", [](TextButton* button) {
+            auto budget = AudioEngine::getPcmCacheBudget() == 0 ? 256 * 1024 : 0;
+            AudioEngine::setPcmCacheBudget(budget);
+            button->setString(budget == 0 ? "pcm budget: unlimited" : "pcm budget: 256 KB");
+        });
+        budgetItem->setPosition(layerSize.width * 0.5f, layerSize.height * 0.62f);
+        addChild(budgetItem);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            _resultLabels[i] = Label::createWithTTF("", "fonts/arial.ttf", 16);
+            _resultLabels[i]->setPosition(layerSize.width * 0.5f, layerSize.height * (0.48f - i * 0.08f));
+            addChild(_resultLabels[i]);
+        }
+
+        _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+        _statsLabel->setPosition(layerSize.width * 0.5f, layerSize.height * 0.25f);
+        addChild(_statsLabel);
+
+        scheduleUpdate();
+        return true;
+    }
+
+    return false;
+}
+
+void AudioCacheBenchmarkTest::runBenchmark(bool compressed)
+{
+    if (_pendingLoads > 0)
+        return;
+
+    AudioEngine::stopAll();
+    AudioEngine::uncacheAll();
+    AudioEngine::setCompressedCacheEnabled(compressed);
+
+    _pendingLoads = static_cast<int>(_audioFiles.size());
+    _loadStart    = std::chrono::steady_clock::now();
+    for (auto&& audioFile : _audioFiles)
+    {
+        AudioEngine::preload(audioFile, [this, compressed](bool isSuccess) {
+            if (--_pendingLoads > 0)
+                return;
+
+            using namespace std::chrono;
+            auto preloadTime = duration<double, std::milli>(steady_clock::now() - _loadStart).count();
+
+            auto playStart = steady_clock::now();
+            for (auto&& audioFile : _audioFiles)
+                AudioEngine::play2d(audioFile, false, 0.2f);
+            auto playTime = duration<double, std::milli>(steady_clock::now() - playStart).count();
+
+            AudioCacheStats stats;
+            AudioEngine::getCacheStats(stats);
+            _resultLabels[compressed ? 1 : 0]->setString(
+                fmt::format("{}: preload {:.2f} ms, play2d x{} {:.3f} ms, memory {} KB",
+                            compressed ? "compressed" : "pcm", preloadTime, _audioFiles.size(), playTime,
+                            (stats.pcmBytes + stats.compressedBytes) / 1024));
+        });
+    }
+}
+
+void AudioCacheBenchmarkTest::onExit()
+{
+    AudioEngine::setCompressedCacheEnabled(false);
+    AudioEngine::setPcmCacheBudget(0);
+    AudioEngineTestDemo::onExit();
+}
+
+void AudioCacheBenchmarkTest::update(float dt)
+{
+    AudioCacheStats stats;
+    AudioEngine::getCacheStats(stats);
+    _statsLabel->setString(fmt::format("pcm: {} caches, {} KB; compressed: {} caches, {} KB; evictions: {}",
+                                       stats.pcmCaches, stats.pcmBytes / 1024, stats.compressedCaches,
+                                       stats.compressedBytes / 1024, stats.evictions));
+}
+
+std::string AudioCacheBenchmarkTest::title() const
+{
+    return "Compressed audio cache benchmark";
+}
+
+std::string AudioCacheBenchmarkTest::subtitle() const
+{
+    return "Compare the preload, play latency and memory of both cache modes";
+}
+
 /////////////////////////////////////////////////////////////////////////
 
 void AudioSwitchStateTest::onEnter()
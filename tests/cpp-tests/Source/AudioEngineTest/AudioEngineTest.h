@@ -191,6 +191,22 @@ public:
 private:
 };
 
+class AudioStreamStatsTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioStreamStatsTest);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<AUDIO_ID> _streamIds;
+    ax::Label* _statsLabel = nullptr;
+};
+
 class AudioLoadTest : public AudioEngineTestDemo
 {
 public:
@@ -236,6 +252,45 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class AudioVoiceStealingTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioVoiceStealingTest);
+
+    virtual bool init() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<AUDIO_ID> _audioIds;
+    ax::Label* _voicesLabel = nullptr;
+};
+
+class AudioCacheBenchmarkTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioCacheBenchmarkTest);
+
+    virtual bool init() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void runBenchmark(bool compressed);
+
+    std::vector<std::string> _audioFiles;
+    std::chrono::steady_clock::time_point _loadStart;
+    int _pendingLoads           = 0;
+    ax::Label* _resultLabels[2] = {};
+    ax::Label* _statsLabel      = nullptr;
+};
+
 class AudioSwitchStateTest : public AudioEngineTestDemo
 {
 public:
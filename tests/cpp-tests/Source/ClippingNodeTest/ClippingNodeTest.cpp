@@ -64,6 +64,7 @@ ClippingNodeTests::ClippingNodeTests()
     ADD_TEST_CASE(RawStencilBufferTest5);
     ADD_TEST_CASE(RawStencilBufferTest6);
     ADD_TEST_CASE(ClippingToRenderTextureTest);
+    ADD_TEST_CASE(ScissorToRenderTextureTest);
     ADD_TEST_CASE(ClippingRectangleNodeTest);
     ADD_TEST_CASE(ClippingNodePerformanceTest);
     ADD_TEST_CASE(UniqueChildStencilTest);
@@ -942,6 +943,67 @@ void ClippingToRenderTextureTest::reproduceBug()
     rt->end();
 }
 
+// ScissorToRenderTextureTest
+
+std::string ScissorToRenderTextureTest::title() const
+{
+    return "Scissor clipping to RenderTexture";
+}
+
+std::string ScissorToRenderTextureTest::subtitle() const
+{
+    return "Both should be clipped the same, left by scissor, right by stencil";
+}
+
+void ScissorToRenderTextureTest::setup()
+{
+    auto s = Director::getInstance()->getCanvasSize();
+
+    // a rectangular stencil qualifies for the scissor test when drawn on screen
+    auto createClipper = []() {
+        auto stencil = DrawNode::create();
+        stencil->drawSolidRect(Vec2(-50, -50), Vec2(50, 50), Color::GREEN);
+
+        auto clipper = ClippingNode::create(stencil);
+        auto content = Sprite::create("Images/grossini.png");
+        content->setScale(2);
+        clipper->addChild(content);
+        return clipper;
+    };
+
+    auto onScreen = createClipper();
+    onScreen->setPosition(s.width / 4, s.height / 2);
+    addChild(onScreen);
+
+    // visited by hand into the render texture, the scissor box would be in the wrong space, so the stencil is used,
+    // the hidden holder keeps it running without drawing it on screen
+    Node* offScreen = createClipper();
+    offScreen->setPosition(s.width / 4, s.height / 2);
+    auto holder = Node::create();
+    holder->setVisible(false);
+    holder->addChild(offScreen);
+    addChild(holder);
+
+    auto rt = RenderTexture::create(s.width / 2, s.height, rhi::PixelFormat::RGBA8, PixelFormat::D24S8);
+    rt->setPosition(s.width * 3 / 4, s.height / 2);
+    addChild(rt);
+
+    auto statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    statsLabel->setPosition(s.width / 2, s.height / 4);
+    addChild(statsLabel, 1);
+
+    schedule(
+        [rt, offScreen, statsLabel](float) {
+            rt->beginWithClear(0, 0, 0, 0);
+            offScreen->visit();
+            rt->end();
+
+            auto stats = ClippingNode::getClippingStats();
+            statsLabel->setString(fmt::format("scissor: {}, stencil: {}", stats.scissor, stats.stencil));
+        },
+        "renderClipper");
+}
+
 // ClippingRectangleNodeDemo
 
 std::string ClippingRectangleNodeTest::title() const
@@ -279,6 +279,17 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class ScissorToRenderTextureTest : public BaseClippingNodeTest
+{
+public:
+    CREATE_FUNC(ScissorToRenderTextureTest);
+
+    // override
+    virtual void setup() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class ClippingRectangleNodeTest : public BaseClippingNodeTest
 {
 public:
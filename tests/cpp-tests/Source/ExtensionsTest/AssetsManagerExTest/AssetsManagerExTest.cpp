@@ -41,6 +41,7 @@ AssetsManagerExTests::AssetsManagerExTests()
     addTestCase("AssetsManager Test1", []() { return AssetsManagerExLoaderScene::create(0); });
     addTestCase("AssetsManager Test2", []() { return AssetsManagerExLoaderScene::create(1); });
     addTestCase("AssetsManager Test3", []() { return AssetsManagerExLoaderScene::create(2); });
+    addTestCase("AssetsPatch Test", []() { return AssetsPatchTest::create(); });
 }
 
 AssetsManagerExLoaderScene* AssetsManagerExLoaderScene::create(int testIndex)
@@ -220,3 +221,64 @@ std::string AssetsManagerExLoaderScene::title() const
 {
     return "AssetsManagerExTest";
 }
+
+void AssetsPatchTest::onEnter()
+{
+    TestCase::onEnter();
+
+    // a 40 MB pack with a 2 KB change in the middle
+    constexpr size_t packSize = 40 * 1024 * 1024;
+    std::vector<uint8_t> oldPack(packSize);
+    uint32_t seed = 0x9e3779b9;
+    for (auto& byte : oldPack)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        byte = static_cast<uint8_t>(seed);
+    }
+    std::vector<uint8_t> newPack = oldPack;
+    for (size_t i = 0; i < 2048; ++i)
+        newPack[packSize / 2 + i] ^= 0x5a;
+
+    auto fileUtils = FileUtils::getInstance();
+    auto dir       = fileUtils->getWritablePath() + "CppTests/AssetsManagerExTest/patch/";
+    fileUtils->createDirectories(dir);
+    auto oldFile     = dir + "pack.bin";
+    auto patchFile   = dir + "pack.bin.patch";
+    auto patchedFile = dir + "pack.bin.new";
+    FileUtils::writeBinaryToFile(oldPack.data(), oldPack.size(), oldFile);
+
+    auto start = std::chrono::steady_clock::now();
+    auto patch = AssetsPatch::create(oldPack, newPack);
+    FileUtils::writeBinaryToFile(patch.data(), patch.size(), patchFile);
+    auto created = std::chrono::steady_clock::now();
+    bool applied = AssetsPatch::apply(oldFile, patchFile, patchedFile);
+    auto done    = std::chrono::steady_clock::now();
+
+    std::vector<uint8_t> patchedPack;
+    fileUtils->getContents(patchedFile, &patchedPack);
+    bool matched = applied && patchedPack == newPack;
+    fileUtils->removeDirectory(dir);
+
+    auto msg = fmt::format("{}\npatch: {} bytes for a {} MB pack\ncreate: {} ms, apply: {} ms",
+                           matched ? "patched pack matches" : "patched pack mismatch", patch.size(),
+                           packSize / 1024 / 1024,
+                           std::chrono::duration_cast<std::chrono::milliseconds>(created - start).count(),
+                           std::chrono::duration_cast<std::chrono::milliseconds>(done - created).count());
+    AXLOGI("{}", msg);
+
+    auto label = Label::createWithTTF(msg, "fonts/arial.ttf", 16);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+std::string AssetsPatchTest::title() const
+{
+    return "AssetsPatch Test";
+}
+
+std::string AssetsPatchTest::subtitle() const
+{
+    return "delta patch of a 2 KB change to a 40 MB pack";
+}
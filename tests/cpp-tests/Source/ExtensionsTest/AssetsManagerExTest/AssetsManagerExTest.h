@@ -56,4 +56,15 @@ private:
     void onLoadEnd();
 };
 
+class AssetsPatchTest : public TestCase
+{
+public:
+    CREATE_FUNC(AssetsPatchTest);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+};
+
 #endif /* defined(__AssetsManagerEx_Test_H__) */
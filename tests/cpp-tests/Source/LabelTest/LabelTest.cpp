@@ -27,6 +27,7 @@
 #include "../testResource.h"
 #include "axmol/renderer/Renderer.h"
 #include "axmol/2d/FontAtlasCache.h"
+#include <chrono>
 
 using namespace ax;
 using namespace ui;
@@ -173,6 +174,8 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelIncrementalLayoutBenchmark);
+    ADD_TEST_CASE(LabelIncrementalLayoutTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -4202,3 +4205,220 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color32&
             letter->setColor(color);
     }
 }
+
+//
+// LabelIncrementalLayoutBenchmark
+//
+LabelIncrementalLayoutBenchmark::LabelIncrementalLayoutBenchmark()
+{
+    auto size = Director::getInstance()->getCanvasSize();
+
+    // a 500 letter score board whose trailing 20 letters change every frame
+    _counterText.reserve(500);
+    for (int i = 0; _counterText.size() < 480; ++i)
+        _counterText += fmt::format("Player {:02} score {:06}\n", i, i * 137);
+    _counterText.resize(480);
+
+    _counterLabel = Label::createWithTTF("", "fonts/arial.ttf", 10);
+    _counterLabel->setDimensions(size.width / 2 - 20, 0);
+    _counterLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _counterLabel->setPosition(10, size.height - 60);
+    addChild(_counterLabel);
+
+    // a chat box that receives one line per frame and drops its older half once full
+    for (int i = 0; i < 20; ++i)
+        _chatLines.emplace_back(fmt::format("user{}: message number {} in the chat box", i % 7, i));
+
+    _chatLabel = Label::createWithTTF("", "fonts/arial.ttf", 10);
+    _chatLabel->setDimensions(size.width / 2 - 20, 0);
+    _chatLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _chatLabel->setPosition(size.width / 2 + 10, size.height - 60);
+    addChild(_chatLabel);
+
+    _resultLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _resultLabel->setPosition(size.width / 2, 40);
+    addChild(_resultLabel);
+
+    schedule(AX_CALLBACK_1(LabelIncrementalLayoutBenchmark::step, this), "step");
+}
+
+void LabelIncrementalLayoutBenchmark::onEnter()
+{
+    AtlasDemoNew::onEnter();
+    _savedEnabled = Label::isIncrementalLayoutEnabled();
+}
+
+void LabelIncrementalLayoutBenchmark::onExit()
+{
+    Label::setIncrementalLayoutEnabled(_savedEnabled);
+    AtlasDemoNew::onExit();
+}
+
+void LabelIncrementalLayoutBenchmark::step(float /*dt*/)
+{
+    // alternate between full and incremental layout every 60 frames
+    const int mode = (_frame / 60) % 2;
+    Label::setIncrementalLayoutEnabled(mode == 1);
+    ++_frame;
+
+    auto counterText = _counterText + fmt::format("Time {:>15}", _frame * 16667);
+    auto start       = std::chrono::steady_clock::now();
+    _counterLabel->setString(counterText);
+    _counterLabel->getContentSize();
+    auto counterEnd = std::chrono::steady_clock::now();
+
+    if (_chatLines.size() >= 40)
+        _chatLines.erase(_chatLines.begin(), _chatLines.begin() + 20);
+    _chatLines.emplace_back(fmt::format("user{}: message number {} in the chat box", _frame % 7, _frame + 20));
+    std::string chatText;
+    for (auto&& line : _chatLines)
+        chatText.append(line).push_back('\n');
+    auto chatStart = std::chrono::steady_clock::now();
+    _chatLabel->setString(chatText);
+    _chatLabel->getContentSize();
+    auto chatEnd = std::chrono::steady_clock::now();
+
+    _counterTime[mode] += std::chrono::duration<double, std::micro>(counterEnd - start).count();
+    _chatTime[mode] += std::chrono::duration<double, std::micro>(chatEnd - chatStart).count();
+    ++_samples[mode];
+
+    if (_samples[0] > 0 && _samples[1] > 0)
+    {
+        _resultLabel->setString(fmt::format(
+            "counter: full {:.1f}us, incremental {:.1f}us\nchat: full {:.1f}us, incremental {:.1f}us",
+            _counterTime[0] / _samples[0], _counterTime[1] / _samples[1], _chatTime[0] / _samples[0],
+            _chatTime[1] / _samples[1]));
+    }
+}
+
+std::string LabelIncrementalLayoutBenchmark::title() const
+{
+    return "Incremental layout benchmark";
+}
+
+std::string LabelIncrementalLayoutBenchmark::subtitle() const
+{
+    return "Average update time of a changing counter and a scrolling chat";
+}
+
+//
+// LabelIncrementalLayoutTest
+//
+namespace
+{
+// exposes the letter layout and the glyph quads of a label
+class LayoutProbeLabel : public Label
+{
+public:
+    static LayoutProbeLabel* create(float width)
+    {
+        auto ret = new LayoutProbeLabel();
+        if (ret->initWithTTF("", "fonts/arial.ttf", 16, Vec2(width, 0)))
+        {
+            ret->autorelease();
+            return ret;
+        }
+        AX_SAFE_DELETE(ret);
+        return nullptr;
+    }
+
+    std::string dumpLayout()
+    {
+        auto& size       = getContentSize();
+        std::string dump = fmt::format("size {:.3f}x{:.3f}, {} letters\n", size.width, size.height, _lengthOfString);
+        for (int i = 0; i < _lengthOfString; ++i)
+        {
+            auto& letter = _lettersInfo[i];
+            if (letter.valid)
+                dump += fmt::format("letter {} U+{:04X} line {} at {:.3f},{:.3f}\n", i,
+                                    static_cast<uint32_t>(letter.utf32Char), letter.lineIndex, letter.positionX,
+                                    letter.positionY);
+        }
+        for (ssize_t batch = 0; batch < _batchNodes.size(); ++batch)
+        {
+            auto atlas = _batchNodes.at(batch)->getTextureAtlas();
+            auto quads = atlas->getQuads();
+            for (ssize_t i = 0; i < atlas->getTotalQuads(); ++i)
+            {
+                auto& quad = quads[i];
+                dump += fmt::format("quad {}:{} {:.3f},{:.3f} {:.3f},{:.3f} uv {:.4f},{:.4f} {:.4f},{:.4f}\n", batch,
+                                    i, quad.bl.position.x, quad.bl.position.y, quad.tr.position.x,
+                                    quad.tr.position.y, quad.bl.texCoord.x, quad.bl.texCoord.y, quad.tr.texCoord.x,
+                                    quad.tr.texCoord.y);
+            }
+        }
+        return dump;
+    }
+};
+}  // namespace
+
+LabelIncrementalLayoutTest::LabelIncrementalLayoutTest()
+{
+    auto size = Director::getInstance()->getCanvasSize();
+
+    // every edit goes through the incremental path of one label, then a full layout of the same text
+    // must produce the same letters and quads
+    // clang-format off
+    const char* steps[] = {
+        "The quick brown fox jumps over the lazy dog",
+        "The quick brown fox jumps over the lazy dog and the cat",                // append
+        "The quick red brown fox jumps over the lazy dog and the cat",            // insert mid line
+        "The quick red fox jumps over the lazy dog and the cat",                  // delete
+        "The quick red fox jumps over the extraordinarily lazy dog and the cat",  // a long word wraps
+        "The quick red fox jumps over the lazy dog and the cat",                  // and unwraps
+        "The quick red fox jumps over the lazy dog\nand the cat",                 // explicit line break
+        "The quick red fox jumps over the lazy dog\nand the cat AVAVAV To",       // kerning pairs at the end
+        "The quick red fox jumps over the lazy dog\nand the cat AVWAV Tx",        // kerning pairs changed
+        "AVThe quick red fox jumps over the lazy dog\nand the cat AVWAV Tx",      // change at the start
+        "AV",                                                                     // shrink to one line
+        "",
+        "Player 01 score 000137\nPlayer 02 score 000274\nTime 16667",
+        "Player 01 score 000137\nPlayer 02 score 000274\nTime 33334",             // counter update
+    };
+    // clang-format on
+
+    const float width  = 200;
+    auto probe         = LayoutProbeLabel::create(width);
+    auto reference     = LayoutProbeLabel::create(width);
+    const bool enabled = Label::isIncrementalLayoutEnabled();
+
+    int failed = 0;
+    for (auto text : steps)
+    {
+        Label::setIncrementalLayoutEnabled(true);
+        probe->setString(text);
+        auto incremental = probe->dumpLayout();
+
+        Label::setIncrementalLayoutEnabled(false);
+        reference->setString(text);
+        auto full = reference->dumpLayout();
+
+        if (incremental != full)
+        {
+            ++failed;
+            AXLOGW("incremental layout of \"{}\" differs\nincremental:\n{}full:\n{}", text, incremental, full);
+        }
+    }
+    Label::setIncrementalLayoutEnabled(enabled);
+
+    probe->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    probe->setPosition(size.width / 2 - width / 2, size.height - 80);
+    addChild(probe);
+
+    auto result = Label::createWithTTF(
+        fmt::format("{} of {} edits match the full layout", std::size(steps) - failed, std::size(steps)),
+        "fonts/arial.ttf", 18);
+    result->setColor(failed ? Color32::RED : Color32::GREEN);
+    result->setPosition(size.width / 2, 60);
+    addChild(result);
+}
+
+std::string LabelIncrementalLayoutTest::title() const
+{
+    return "Incremental layout test";
+}
+
+std::string LabelIncrementalLayoutTest::subtitle() const
+{
+    return "Letters and quads after each edit are compared with a full layout";
+}
@@ -31,6 +31,7 @@
 #include "axmol/ui/CocosGUI.h"
 #include "extensions/axmol-ext.h"
 #include "cocostudio/LocalizationManager.h"
+#include <deque>
 
 DEFINE_TEST_SUITE(NewLabelTests);
 
@@ -1081,4 +1082,43 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color32& color);
 };
 
+class LabelIncrementalLayoutBenchmark : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelIncrementalLayoutBenchmark);
+
+    LabelIncrementalLayoutBenchmark();
+
+    void onEnter() override;
+    void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void step(float dt);
+
+    ax::Label* _counterLabel = nullptr;
+    ax::Label* _chatLabel    = nullptr;
+    ax::Label* _resultLabel  = nullptr;
+    std::string _counterText;
+    std::deque<std::string> _chatLines;
+    int _frame             = 0;
+    double _counterTime[2] = {};
+    double _chatTime[2]    = {};
+    int _samples[2]        = {};
+    bool _savedEnabled     = false;
+};
+
+class LabelIncrementalLayoutTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelIncrementalLayoutTest);
+
+    LabelIncrementalLayoutTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
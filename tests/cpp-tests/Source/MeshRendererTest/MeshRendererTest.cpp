@@ -28,6 +28,7 @@
 #include "MeshRendererTest.h"
 #include "DrawNode3D.h"
 #include "axmol/2d/CameraBackgroundBrush.h"
+#include "axmol/3d/Bundle3D.h"
 #include "axmol/3d/MeshMaterial.h"
 #include "axmol/3d/MotionStreak3D.h"
 
@@ -75,6 +76,7 @@ MeshRendererTests::MeshRendererTests()
     ADD_TEST_CASE(MeshRendererPropertyTest);
     ADD_TEST_CASE(MeshRendererNormalMappingTest);
     ADD_TEST_CASE(Issue16155Test);
+    ADD_TEST_CASE(MeshRendererTrianglesTest);
 };
 
 //------------------------------------------------------------------
@@ -2828,3 +2830,40 @@ std::string Issue16155Test::subtitle() const
 {
     return "Should not leak texture. See console";
 }
+
+//
+// MeshRendererTrianglesTest
+//
+MeshRendererTrianglesTest::MeshRendererTrianglesTest()
+{
+    // collider triangles of a .c3b must be the same whether the bundle is mapped or buffered
+    const bool mappedEnabled = Bundle3D::isMappedFileEnabled();
+
+    Bundle3D::setMappedFileEnabled(true);
+    auto mapped = Bundle3D::getTrianglesList("MeshRendererTest/boss.c3b");
+    Bundle3D::setMappedFileEnabled(false);
+    auto buffered = Bundle3D::getTrianglesList("MeshRendererTest/boss.c3b");
+    Bundle3D::setMappedFileEnabled(mappedEnabled);
+
+    const bool passed = !mapped.empty() && mapped.size() % 3 == 0 && mapped == buffered;
+    AXASSERT(passed, "MeshRendererTrianglesTest: triangles of a mapped .c3b don't match the buffered load");
+
+    _result = fmt::format("mapped: {} vertices, buffered: {} vertices, {}", mapped.size(), buffered.size(),
+                          passed ? "PASSED" : "FAILED");
+    AXLOGI("MeshRendererTrianglesTest: {}", _result);
+
+    auto s     = Director::getInstance()->getCanvasSize();
+    auto label = Label::createWithTTF(_result, "fonts/arial.ttf", 16);
+    label->setPosition(Vec2(s.width / 2, s.height / 2));
+    label->setTextColor(passed ? Color32::GREEN : Color32::RED);
+    addChild(label);
+}
+
+std::string MeshRendererTrianglesTest::title() const
+{
+    return "Collider triangles from .c3b";
+}
+std::string MeshRendererTrianglesTest::subtitle() const
+{
+    return "Mapped and buffered loads should match";
+}
@@ -660,3 +660,16 @@ public:
     virtual std::string title() const override;
     virtual std::string subtitle() const override;
 };
+
+class MeshRendererTrianglesTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererTrianglesTest);
+    MeshRendererTrianglesTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    std::string _result;
+};
+
@@ -366,8 +366,266 @@ struct DownloaderMultiTask : public TestCase
     }
 };
 
+struct DownloaderStreamTask : public TestCase
+{
+    CREATE_FUNC(DownloaderStreamTask);
+
+    virtual std::string title() const override { return "Downloader Stream Task"; }
+    virtual std::string subtitle() const override
+    {
+        return "streams the big file through a slow consumer, memory stays bounded";
+    }
+
+    // the consumer buffers at most this much, the transfer is paused beyond it
+    static constexpr size_t MAX_PENDING_BYTES = 2 * 1024 * 1024;
+    // and drains this much per frame
+    static constexpr size_t DRAIN_BYTES_PER_FRAME = 512 * 1024;
+
+    std::unique_ptr<network::Downloader> downloader;
+    std::shared_ptr<network::DownloadTask> task;
+
+    std::mutex pendingMutex;
+    size_t pendingBytes  = 0;
+    size_t peakPending   = 0;
+    size_t bytesConsumed = 0;
+    int pauseCount       = 0;
+    bool paused          = false;
+    bool finished        = false;
+    bool failed          = false;
+
+    Label* statusLabel = nullptr;
+
+    DownloaderStreamTask() { downloader.reset(new network::Downloader()); }
+
+    virtual void onEnter() override
+    {
+        TestCase::onEnter();
+
+        statusLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+        statusLabel->setPosition(VisibleRect::center());
+        addChild(statusLabel);
+
+        // invoked on the downloader thread
+        downloader->onTaskData = [this](const network::DownloadTask&, const unsigned char*, size_t size) {
+            std::lock_guard<std::mutex> lck(pendingMutex);
+            if (pendingBytes + size > MAX_PENDING_BYTES)
+            {
+                paused = true;
+                ++pauseCount;
+                return false;
+            }
+            pendingBytes += size;
+            peakPending = std::max(peakPending, pendingBytes);
+            return true;
+        };
+        downloader->onDataTaskSuccess = [this](const network::DownloadTask&, std::vector<unsigned char>& data) {
+            AXLOGI("stream task success, buffered body size: {}", data.size());
+            finished = true;
+        };
+        downloader->onTaskError = [this](const network::DownloadTask& task, int errorCode, int errorCodeInternal,
+                                         std::string_view errorStr) {
+            AXLOGW("stream task failed : {}, error code({}), internal error code({}) desc({})", task.requestURL,
+                   errorCode, errorCodeInternal, errorStr);
+            statusLabel->setString(errorStr);
+            finished = failed = true;
+        };
+
+        task = downloader->createDownloadDataTask(sURLList[3], sNameList[3]);
+        scheduleUpdate();
+    }
+
+    virtual void onExit() override
+    {
+        if (task && !finished)
+            task->cancel();
+        TestCase::onExit();
+    }
+
+    virtual void update(float) override
+    {
+        bool resume = false;
+        {
+            std::lock_guard<std::mutex> lck(pendingMutex);
+            auto drained = std::min(pendingBytes, DRAIN_BYTES_PER_FRAME);
+            pendingBytes -= drained;
+            bytesConsumed += drained;
+            if (paused && pendingBytes < MAX_PENDING_BYTES / 2)
+            {
+                paused = false;
+                resume = true;
+            }
+        }
+        if (resume)
+            task->resume();
+
+        if (!failed)
+            statusLabel->setString(fmt::format("consumed: {} KB\npeak pending: {} KB\npauses: {}{}",
+                                               bytesConsumed / 1024, peakPending / 1024, pauseCount,
+                                               finished && !pendingBytes ? "\ndone" : ""));
+    }
+};
+
+struct DownloaderPriorityTask : public TestCase
+{
+    CREATE_FUNC(DownloaderPriorityTask);
+
+    virtual std::string title() const override { return "Downloader Priority Task"; }
+    virtual std::string subtitle() const override
+    {
+        return "a HIGH task queued behind busy slots, without and with warmup";
+    }
+
+    // two big file tasks take both processing slots before the small tasks are queued
+    static constexpr int BLOCKER_TASKS = 2;
+    static constexpr int LOW_TASKS     = 4;
+
+    std::unique_ptr<network::Downloader> downloader;
+    std::vector<std::shared_ptr<network::DownloadTask>> blockers;
+    std::unordered_set<std::string> activeSmallTasks;  // the small tasks share one host
+    std::chrono::steady_clock::time_point highQueuedTime;
+
+    size_t maxActiveSmallTasks = 0;
+    int lowFinished            = 0;
+    int lowFinishedBeforeHigh  = -1;
+    double highLatencyMs       = 0;
+    bool warmup                = false;
+    bool running               = false;
+
+    Label* resultLabels[2] = {};
+
+    virtual void onEnter() override
+    {
+        TestCase::onEnter();
+
+        auto menu = Menu::create();
+        menu->setPosition(Vec2::ZERO);
+        addChild(menu);
+
+        const char* texts[] = {"Run cold", "Run with warmup"};
+        for (int i = 0; i < 2; ++i)
+        {
+            auto item = MenuItemLabel::create(Label::createWithTTF(texts[i], "fonts/arial.ttf", 22),
+                                              [this, i](Object*) { run(i == 1); });
+            item->setPosition(VisibleRect::center().x, VisibleRect::top().y - 100 - i * 35);
+            menu->addChild(item);
+
+            resultLabels[i] = Label::createWithTTF("", "fonts/arial.ttf", 16);
+            resultLabels[i]->setPosition(VisibleRect::center().x, VisibleRect::center().y - i * 40);
+            addChild(resultLabels[i]);
+        }
+    }
+
+    virtual void onExit() override
+    {
+        cancelBlockers();
+        TestCase::onExit();
+    }
+
+    void cancelBlockers()
+    {
+        for (auto&& blocker : blockers)
+            blocker->cancel();
+        blockers.clear();
+    }
+
+    void run(bool withWarmup)
+    {
+        if (running)
+            return;
+
+        // a new downloader doesn't share connections with the previous run
+        network::DownloaderHints hints = {BLOCKER_TASKS, 60, ".going", 2};
+        downloader.reset(new network::Downloader(hints));
+        setupCallbacks();
+
+        running               = true;
+        warmup                = withWarmup;
+        maxActiveSmallTasks   = 0;
+        lowFinished           = 0;
+        lowFinishedBeforeHigh = -1;
+        activeSmallTasks.clear();
+        resultLabels[warmup ? 1 : 0]->setString("running...");
+
+        if (warmup)
+            downloader->warmup(sURLList[1]);
+
+        for (int i = 0; i < BLOCKER_TASKS; ++i)
+        {
+            auto path = fmt::format("{}CppTests/DownloaderTest/priority_blocker_{}",
+                                    FileUtils::getInstance()->getWritablePath(), i);
+            blockers.emplace_back(
+                downloader->createDownloadFileTask(sURLList[3], path, fmt::format("blocker_{}", i)));
+        }
+
+        // give the blockers time to take the slots, and the warmup time to connect
+        scheduleOnce(
+            [this](float) {
+                for (int i = 0; i < LOW_TASKS; ++i)
+                    downloader->createDownloadDataTask(sURLList[0], fmt::format("low_{}", i),
+                                                       network::Downloader::Priority::LOW);
+                highQueuedTime = std::chrono::steady_clock::now();
+                downloader->createDownloadDataTask(sURLList[1], "high", network::Downloader::Priority::HIGH);
+            },
+            1.0f, "queue_small_tasks");
+    }
+
+    void setupCallbacks()
+    {
+        downloader->onTaskProgress = [this](const network::DownloadTask& task) {
+            if (task.identifier.starts_with("blocker"))
+                return;
+            activeSmallTasks.emplace(task.identifier);
+            maxActiveSmallTasks = std::max(maxActiveSmallTasks, activeSmallTasks.size());
+        };
+        downloader->onDataTaskSuccess = [this](const network::DownloadTask& task, std::vector<unsigned char>&) {
+            onSmallTaskDone(task);
+        };
+        downloader->onFileTaskSuccess = [](const network::DownloadTask& task) {
+            AXLOGI("priority test: {} finished before it was cancelled", task.identifier);
+        };
+        downloader->onTaskError = [this](const network::DownloadTask& task, int errorCode, int errorCodeInternal,
+                                         std::string_view errorStr) {
+            if (task.identifier.starts_with("blocker"))
+                return;  // cancelled once the HIGH task is done
+            AXLOGW("priority test: {} failed, error code({}), internal error code({}) desc({})", task.identifier,
+                   errorCode, errorCodeInternal, errorStr);
+            onSmallTaskDone(task);
+        };
+    }
+
+    void onSmallTaskDone(const network::DownloadTask& task)
+    {
+        activeSmallTasks.erase(task.identifier);
+
+        if (task.identifier == "high")
+        {
+            using namespace std::chrono;
+            highLatencyMs         = duration<double, std::milli>(steady_clock::now() - highQueuedTime).count();
+            lowFinishedBeforeHigh = lowFinished;
+            // free the slots for the LOW tasks
+            cancelBlockers();
+        }
+        else
+            ++lowFinished;
+
+        if (lowFinished < LOW_TASKS || lowFinishedBeforeHigh < 0)
+            return;
+
+        // the HIGH task must not wait for the busy slots, and the LOW tasks must respect the per host limit
+        auto result = fmt::format("{}: HIGH done in {:.0f} ms, LOW done before it: {} ({}), max per host: {} ({})",
+                                  warmup ? "warmup" : "cold", highLatencyMs, lowFinishedBeforeHigh,
+                                  lowFinishedBeforeHigh == 0 ? "ok" : "FAILED", maxActiveSmallTasks,
+                                  maxActiveSmallTasks <= 2 ? "ok" : "FAILED");
+        AXLOGI("priority test: {}", result);
+        resultLabels[warmup ? 1 : 0]->setString(result);
+        running = false;
+    }
+};
+
 DownloaderTests::DownloaderTests()
 {
     ADD_TEST_CASE(DownloaderTest);
     ADD_TEST_CASE(DownloaderMultiTask);
+    ADD_TEST_CASE(DownloaderStreamTask);
+    ADD_TEST_CASE(DownloaderPriorityTask);
 };
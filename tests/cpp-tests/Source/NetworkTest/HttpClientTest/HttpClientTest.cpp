@@ -25,6 +25,8 @@
 
 #include "HttpClientTest.h"
 #include <string>
+#include "axmol/base/ZipUtils.h"
+#include "yasio/yasio.hpp"
 
 using namespace ax;
 using namespace ax::network;
@@ -37,6 +39,7 @@ HttpClientTests::HttpClientTests()
 {
     ADD_TEST_CASE(HttpClientTest);
     ADD_TEST_CASE(HttpClientClearRequestsTest);
+    ADD_TEST_CASE(HttpClientKeepAliveTest);
 }
 
 HttpClientTest::HttpClientTest() : _labelStatusCode(nullptr)
@@ -509,3 +512,162 @@ void HttpClientClearRequestsTest::onHttpRequestCompleted(HttpClient* sender, Htt
         // AXLOGW("error buffer: {}", response->getErrorBuffer());
     }
 }
+
+// HttpClientKeepAliveTest
+static const int KEEP_ALIVE_TEST_PORT     = 18088;
+static const int KEEP_ALIVE_TEST_REQUESTS = 500;
+static const int KEEP_ALIVE_TEST_PARALLEL = 4;
+
+HttpClientKeepAliveTest::HttpClientKeepAliveTest()
+{
+    auto canvasSize = Director::getInstance()->getCanvasSize();
+
+    const int MARGIN = 40;
+    const int SPACE  = 35;
+    const int CENTER = canvasSize.width / 2;
+
+    for (int i = 0; i < 64; ++i)
+        _responseBody += fmt::format("keep-alive benchmark line {}\n", i);
+    _encodedBody = ZipUtils::compressGZ(_responseBody.data(), _responseBody.size());
+
+    startServer();
+
+    auto menuRequest = Menu::create();
+    menuRequest->setPosition(Vec2::ZERO);
+    addChild(menuRequest);
+
+    auto labelReuse = Label::createWithTTF("Run with keep-alive", "fonts/arial.ttf", 22);
+    auto itemReuse  = MenuItemLabel::create(labelReuse, [this](Object*) { runBenchmark(true); });
+    itemReuse->setPosition(CENTER, canvasSize.height - MARGIN - SPACE);
+    menuRequest->addChild(itemReuse);
+
+    auto labelNoReuse = Label::createWithTTF("Run without keep-alive", "fonts/arial.ttf", 22);
+    auto itemNoReuse  = MenuItemLabel::create(labelNoReuse, [this](Object*) { runBenchmark(false); });
+    itemNoReuse->setPosition(CENTER, canvasSize.height - MARGIN - 2 * SPACE);
+    menuRequest->addChild(itemNoReuse);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        _resultLabels[i] = Label::createWithTTF("", "fonts/arial.ttf", 18);
+        _resultLabels[i]->setPosition(CENTER, canvasSize.height - MARGIN - (4 + i) * SPACE);
+        addChild(_resultLabels[i]);
+    }
+}
+
+HttpClientKeepAliveTest::~HttpClientKeepAliveTest()
+{
+    HttpClient::destroyInstance();
+    delete _server;
+}
+
+void HttpClientKeepAliveTest::startServer()
+{
+    _server = new yasio::io_service(yasio::io_hostent{"127.0.0.1", KEEP_ALIVE_TEST_PORT});
+    _server->set_option(yasio::YOPT_S_FORWARD_PACKET, 1);
+    _server->start([this](yasio::event_ptr&& e) { handleServerEvent(e.get()); });
+    _server->open(0, yasio::YCK_TCP_SERVER);
+}
+
+void HttpClientKeepAliveTest::handleServerEvent(yasio::io_event* event)
+{
+    auto transport = event->transport();
+    switch (event->kind())
+    {
+    case yasio::YEK_ON_PACKET:
+    {
+        auto&& pkt  = event->packet_view();
+        auto& input = _serverInputs[transport];
+        input.append(pkt.data(), pkt.size());
+
+        // the client sends one GET at a time per connection, answer every complete request head
+        size_t headEnd;
+        while ((headEnd = input.find("\r\n\r\n")) != std::string::npos)
+        {
+            std::string_view head{input.data(), headEnd};
+            bool gzip      = head.find("gzip") != std::string_view::npos;
+            bool keepAlive = head.find("Connection: close") == std::string_view::npos;
+
+            auto bodySize = gzip ? _encodedBody.size() : _responseBody.size();
+            auto response = fmt::format(
+                "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: {}\r\n{}{}\r\n", bodySize,
+                gzip ? "Content-Encoding: gzip\r\n" : "", keepAlive ? "" : "Connection: close\r\n");
+            tlx::sbyte_buffer buffer{response.data(), response.data() + response.size()};
+            if (gzip)
+                buffer.insert(buffer.end(), _encodedBody.begin(), _encodedBody.end());
+            else
+                buffer.insert(buffer.end(), _responseBody.begin(), _responseBody.end());
+            _server->write(transport, std::move(buffer));
+
+            input.erase(0, headEnd + 4);
+        }
+        break;
+    }
+    case yasio::YEK_ON_CLOSE:
+        _serverInputs.erase(transport);
+        break;
+    default:
+        break;
+    }
+}
+
+void HttpClientKeepAliveTest::runBenchmark(bool keepAlive)
+{
+    if (_running)
+        return;
+
+    auto httpClient = HttpClient::getInstance();
+    httpClient->closeIdleConnections();
+    httpClient->setKeepAliveEnabled(keepAlive);
+    // the loopback server answers gzip encoded bodies when asked, exercise the transparent decoding too
+    httpClient->setDecompressionEnabled(true);
+    // complete on the network thread, the main thread dispatches only one response per frame
+    httpClient->setDispatchOnWorkThread(true);
+
+    _running        = true;
+    _keepAlive      = keepAlive;
+    _requestsSent   = 0;
+    _requestsDone   = 0;
+    _requestsFailed = 0;
+    _resultLabels[keepAlive ? 0 : 1]->setString("running...");
+    _startTime = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < KEEP_ALIVE_TEST_PARALLEL; ++i)
+        sendNextRequest();
+}
+
+void HttpClientKeepAliveTest::sendNextRequest()
+{
+    if (++_requestsSent > KEEP_ALIVE_TEST_REQUESTS)
+        return;
+
+    auto request = new HttpRequest();
+    request->setUrl(fmt::format("http://127.0.0.1:{}/bench", KEEP_ALIVE_TEST_PORT));
+    request->setRequestType(HttpRequest::Type::GET);
+    request->setCompleteCallback(AX_CALLBACK_2(HttpClientKeepAliveTest::onHttpRequestCompleted, this));
+    HttpClient::getInstance()->send(request);
+    request->release();
+}
+
+void HttpClientKeepAliveTest::onHttpRequestCompleted(HttpClient* sender, HttpResponse* response)
+{
+    auto data = response->getResponseData();
+    if (!response->isSucceed() || std::string_view{data->data(), data->size()} != _responseBody)
+        ++_requestsFailed;
+
+    if (++_requestsDone < KEEP_ALIVE_TEST_REQUESTS)
+    {
+        sendNextRequest();
+        return;
+    }
+
+    using namespace std::chrono;
+    auto elapsed = duration<double>(steady_clock::now() - _startTime).count();
+    auto result  = fmt::format("{}: {:.0f} requests/sec, {} failed", _keepAlive ? "keep-alive" : "no keep-alive",
+                               KEEP_ALIVE_TEST_REQUESTS / elapsed, _requestsFailed.load());
+    Director::getInstance()->getScheduler()->runOnAxmolThread([this, result = std::move(result)]() {
+        HttpClient::getInstance()->setDispatchOnWorkThread(false);
+        HttpClient::getInstance()->setDecompressionEnabled(false);
+        _resultLabels[_keepAlive ? 0 : 1]->setString(result);
+        _running = false;
+    });
+}
@@ -82,4 +82,37 @@ private:
     ax::Label* _labelStatusCode;
 };
 
+class HttpClientKeepAliveTest : public TestCase
+{
+public:
+    CREATE_FUNC(HttpClientKeepAliveTest);
+
+    HttpClientKeepAliveTest();
+    virtual ~HttpClientKeepAliveTest();
+
+    virtual std::string title() const override { return "Http Keep-Alive Test"; }
+    virtual std::string subtitle() const override { return "Requests/sec against a loopback server"; }
+
+private:
+    void startServer();
+    void handleServerEvent(yasio::io_event* event);
+
+    void runBenchmark(bool keepAlive);
+    void sendNextRequest();
+    void onHttpRequestCompleted(ax::network::HttpClient* sender, ax::network::HttpResponse* response);
+
+    yasio::io_service* _server = nullptr;
+    std::unordered_map<yasio::transport_handle_t, std::string> _serverInputs;  // accessed on server thread only
+    std::string _responseBody;
+    tlx::byte_buffer _encodedBody;
+
+    std::atomic<int> _requestsSent{0};
+    std::atomic<int> _requestsDone{0};
+    std::atomic<int> _requestsFailed{0};
+    std::chrono::steady_clock::time_point _startTime;
+    bool _keepAlive             = true;
+    bool _running               = false;
+    ax::Label* _resultLabels[2] = {};
+};
+
 #endif  //__HTTPREQUESTHTTP_H
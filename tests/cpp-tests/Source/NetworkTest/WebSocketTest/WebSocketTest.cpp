@@ -28,6 +28,8 @@
 #include "testResource.h"
 
 #include "axmol/tlx/format.hpp"
+#include "yasio/yasio.hpp"
+#include "zlib.h"
 
 /* https://websocket.org/
  list of public test servers: (Note, on china mainland, may need VPN):
@@ -52,6 +54,9 @@ WebSocketTests::WebSocketTests()
     ADD_TEST_CASE(WebSocketTest);
     ADD_TEST_CASE(WebSocketCloseTest);
     ADD_TEST_CASE(WebSocketDelayTest);
+#if !defined(__EMSCRIPTEN__)
+    ADD_TEST_CASE(WebSocketEchoBenchmark);
+#endif
 }
 
 WebSocketTest::WebSocketTest()
@@ -595,3 +600,373 @@ void WebSocketDelayTest::onMenuSendTextClicked(ax::Object* sender)
         _sendTextStatus->setString(warningStr);
     }
 }
+
+#if !defined(__EMSCRIPTEN__)
+// WebSocketEchoBenchmark
+static const int ECHO_TEST_PORT     = 18089;
+static const int ECHO_TEST_MESSAGES = 20000;
+static const int ECHO_TEST_WINDOW   = 64;
+
+// the client deflates with this window, its handshake parsing and deflater setup are part of the test
+static const int ECHO_TEST_CLIENT_WINDOW_BITS = 10;
+
+// the server side of permessage-deflate, echoes are inflated and deflated again like a real server would
+struct WebSocketEchoBenchmark::PerMessageDeflate
+{
+    z_stream inflater{};
+    z_stream deflater{};
+    tlx::sbyte_buffer inflated;
+
+    PerMessageDeflate()
+    {
+        inflateInit2(&inflater, -MAX_WBITS);
+        deflateInit2(&deflater, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    }
+    ~PerMessageDeflate()
+    {
+        inflateEnd(&inflater);
+        deflateEnd(&deflater);
+    }
+
+    // replaces the compressed message with its echo, false when it isn't a valid deflate stream
+    bool recompress(tlx::sbyte_buffer& message)
+    {
+        static const char tail[] = {'\x00', '\x00', '\xff', '\xff'};
+        message.extend(std::begin(tail), std::end(tail));
+
+        inflated.clear();
+        inflater.next_in  = reinterpret_cast<Bytef*>(message.data());
+        inflater.avail_in = static_cast<uInt>(message.size());
+        int ret           = Z_OK;
+        do
+        {
+            auto used = inflated.size();
+            inflated.resize(used + 4096);
+            inflater.next_out  = reinterpret_cast<Bytef*>(inflated.data() + used);
+            inflater.avail_out = 4096;
+            ret                = ::inflate(&inflater, Z_SYNC_FLUSH);
+            inflated.resize(inflated.size() - inflater.avail_out);
+        } while (ret == Z_OK && inflater.avail_out == 0);
+        if (ret == Z_STREAM_END)
+            inflateReset(&inflater);
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return false;
+
+        message.resize(deflateBound(&deflater, static_cast<uLong>(inflated.size())) + 16);
+        deflater.next_in   = reinterpret_cast<Bytef*>(inflated.data());
+        deflater.avail_in  = static_cast<uInt>(inflated.size());
+        deflater.next_out  = reinterpret_cast<Bytef*>(message.data());
+        deflater.avail_out = static_cast<uInt>(message.size());
+        if (::deflate(&deflater, Z_SYNC_FLUSH) != Z_OK || deflater.avail_in != 0 || deflater.avail_out == 0)
+            return false;
+
+        // strip the trailing empty stored block, the client appends it back
+        message.resize(message.size() - deflater.avail_out - sizeof(tail));
+        return true;
+    }
+};
+
+void WebSocketEchoBenchmark::ServerConnection::sendFrame(int flags, const tlx::sbyte_buffer& data)
+{
+    tlx::sbyte_buffer frame;
+    frame.resize(websocket_calc_frame_size((websocket_flags)flags, data.size()));
+    websocket_build_frame(frame.data(), (websocket_flags)flags, nullptr, data.data(), data.size());
+    server->write(transport, std::move(frame));
+}
+
+WebSocketEchoBenchmark::WebSocketEchoBenchmark()
+{
+    auto canvasSize = Director::getInstance()->getCanvasSize();
+
+    const int MARGIN = 40;
+    const int SPACE  = 35;
+    const int CENTER = canvasSize.width / 2;
+
+    // about the size of a realtime game state update
+    _message = "{\"t\":0,\"x\":12.5,\"y\":-3.25,\"vx\":0.5,\"vy\":0,\"seq\":123456}";
+
+    // a snapshot of several entities, past the size the client starts compressing at
+    _compressibleMessage = "[";
+    for (int i = 0; i < 16; ++i)
+        fmt::format_to(std::back_inserter(_compressibleMessage), "{}{{\"id\":{},\"x\":{}.5,\"y\":-3.25,\"hp\":100}}",
+                       i ? "," : "", i, i * 8);
+    _compressibleMessage += "]";
+
+    startServer();
+
+    auto menuRequest = Menu::create();
+    menuRequest->setPosition(Vec2::ZERO);
+    addChild(menuRequest);
+
+    auto labelUnbatched = Label::createWithTTF("Run", "fonts/arial.ttf", 22);
+    auto itemUnbatched  = MenuItemLabel::create(labelUnbatched, [this](Object*) { runBenchmark(false, false); });
+    itemUnbatched->setPosition(CENTER, canvasSize.height - MARGIN - SPACE);
+    menuRequest->addChild(itemUnbatched);
+
+    auto labelBatched = Label::createWithTTF("Run with batched sends", "fonts/arial.ttf", 22);
+    auto itemBatched  = MenuItemLabel::create(labelBatched, [this](Object*) { runBenchmark(true, false); });
+    itemBatched->setPosition(CENTER, canvasSize.height - MARGIN - 2 * SPACE);
+    menuRequest->addChild(itemBatched);
+
+    auto labelCompressed = Label::createWithTTF("Run with compressed messages", "fonts/arial.ttf", 22);
+    auto itemCompressed  = MenuItemLabel::create(labelCompressed, [this](Object*) { runBenchmark(false, true); });
+    itemCompressed->setPosition(CENTER, canvasSize.height - MARGIN - 3 * SPACE);
+    menuRequest->addChild(itemCompressed);
+
+    _statusLabel = Label::createWithTTF("Connecting...", "fonts/arial.ttf", 18);
+    _statusLabel->setPosition(CENTER, canvasSize.height - MARGIN - 4 * SPACE);
+    addChild(_statusLabel);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        _resultLabels[i] = Label::createWithTTF("", "fonts/arial.ttf", 18);
+        _resultLabels[i]->setPosition(CENTER, canvasSize.height - MARGIN - (5 + i) * SPACE);
+        addChild(_resultLabels[i]);
+    }
+
+    _ws = new network::WebSocket();
+    _ws->setPerMessageDeflateEnabled(true);
+    _ws->open(this, fmt::format("ws://127.0.0.1:{}/echo", ECHO_TEST_PORT));
+}
+
+WebSocketEchoBenchmark::~WebSocketEchoBenchmark()
+{
+    delete _server;
+}
+
+void WebSocketEchoBenchmark::onExit()
+{
+    if (_ws)
+    {
+        _ws->close();
+        AX_SAFE_DELETE(_ws);
+    }
+
+    TestCase::onExit();
+}
+
+void WebSocketEchoBenchmark::startServer()
+{
+    _server = new yasio::io_service(yasio::io_hostent{"127.0.0.1", ECHO_TEST_PORT});
+    _server->set_option(yasio::YOPT_S_FORWARD_PACKET, 1);
+    _server->start([this](yasio::event_ptr&& e) { handleServerEvent(e.get()); });
+    _server->open(0, yasio::YCK_TCP_SERVER);
+}
+
+void WebSocketEchoBenchmark::handleServerEvent(yasio::io_event* event)
+{
+    static websocket_parser_settings settings = [] {
+        websocket_parser_settings s;
+        websocket_parser_settings_init(&s);
+        s.on_frame_header = [](websocket_parser* parser) {
+            auto connection = static_cast<ServerConnection*>(parser->data);
+            auto opcode     = parser->flags & WS_OP_MASK;
+            if (opcode >= WS_OP_CLOSE)
+                connection->payload.clear();
+            else if (opcode != WS_OP_CONTINUE)
+            {
+                // only the first frame of a message carries RSV1
+                connection->opcode     = opcode;
+                connection->compressed = parser->flags & WS_RSV1;
+                connection->message.clear();
+            }
+            return 0;
+        };
+        s.on_frame_body = [](websocket_parser* parser, const char* at, size_t length) {
+            auto connection = static_cast<ServerConnection*>(parser->data);
+            if (parser->flags & WS_HAS_MASK)
+                websocket_parser_decode(const_cast<char*>(at), at, length, parser);
+            auto& data = (parser->flags & WS_OP_MASK) >= WS_OP_CLOSE ? connection->payload : connection->message;
+            data.extend(at, at + length);
+            return 0;
+        };
+        // echo every message unmasked, the echoed close frame completes the closing handshake
+        s.on_frame_end = [](websocket_parser* parser) {
+            auto connection = static_cast<ServerConnection*>(parser->data);
+            auto opcode     = parser->flags & WS_OP_MASK;
+            if (opcode >= WS_OP_CLOSE)
+            {
+                connection->sendFrame(opcode | WS_FIN, connection->payload);
+                return 0;
+            }
+            if (!(parser->flags & WS_FIN))
+                return 0;
+
+            auto flags = connection->opcode | WS_FIN;
+            if (connection->compressed)
+            {
+                if (!connection->deflate || !connection->deflate->recompress(connection->message))
+                {
+                    AXLOGW("WebSocketEchoBenchmark: invalid compressed message");
+                    connection->server->close(connection->transport);
+                    return 0;
+                }
+                flags |= WS_RSV1;
+            }
+            connection->sendFrame(flags, connection->message);
+            return 0;
+        };
+        return s;
+    }();
+
+    auto transport = event->transport();
+    switch (event->kind())
+    {
+    case yasio::YEK_ON_OPEN:
+        if (event->status() == 0 && transport)
+        {
+            auto& connection     = _serverConnections[transport];
+            connection.server    = _server;
+            connection.transport = transport;
+            websocket_parser_init(&connection.parser);
+            connection.parser.data = &connection;
+        }
+        break;
+    case yasio::YEK_ON_PACKET:
+    {
+        auto&& pkt       = event->packet_view();
+        auto& connection = _serverConnections[transport];
+        if (connection.upgraded)
+        {
+            websocket_parser_execute(&connection.parser, &settings, pkt.data(), pkt.size());
+            break;
+        }
+
+        connection.handshake.append(pkt.data(), pkt.size());
+        auto headEnd = connection.handshake.find("\r\n\r\n");
+        if (headEnd == std::string::npos)
+            break;
+
+        std::string_view head{connection.handshake.data(), headEnd};
+        auto keyStart = head.find("Sec-WebSocket-Key: ");
+        if (keyStart == std::string_view::npos)
+        {
+            _server->close(transport);
+            break;
+        }
+        keyStart += sizeof("Sec-WebSocket-Key: ") - 1;
+        auto key = std::string{head.substr(keyStart, head.find("\r\n", keyStart) - keyStart)};
+        key += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        auto accept = utils::computeDigest(key, "sha1"sv, utils::DigestPresent::Base64);
+
+        auto response = fmt::format(
+            "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: {}\r\n",
+            accept);
+
+        // accept permessage-deflate when offered, narrowing the client's window
+        auto extensionsStart = head.find("Sec-WebSocket-Extensions: ");
+        if (extensionsStart != std::string_view::npos)
+        {
+            auto extensions = head.substr(extensionsStart, head.find("\r\n", extensionsStart) - extensionsStart);
+            if (extensions.find("permessage-deflate") != std::string_view::npos)
+            {
+                connection.deflate = std::make_unique<PerMessageDeflate>();
+                fmt::format_to(std::back_inserter(response),
+                               "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits={}\r\n",
+                               ECHO_TEST_CLIENT_WINDOW_BITS);
+            }
+        }
+        response += "\r\n";
+        _server->write(transport, response.data(), response.size());
+        connection.upgraded = true;
+
+        if (connection.handshake.size() > headEnd + 4)
+            websocket_parser_execute(&connection.parser, &settings, connection.handshake.data() + headEnd + 4,
+                                     connection.handshake.size() - headEnd - 4);
+        break;
+    }
+    case yasio::YEK_ON_CLOSE:
+        _serverConnections.erase(transport);
+        break;
+    default:
+        break;
+    }
+}
+
+void WebSocketEchoBenchmark::runBenchmark(bool batched, bool compressed)
+{
+    if (_running || !_ws || _ws->getReadyState() != network::WebSocket::State::OPEN)
+        return;
+
+    _ws->setSendBatchingEnabled(batched);
+
+    _running          = true;
+    _run              = compressed ? 2 : (batched ? 1 : 0);
+    _sending          = compressed ? &_compressibleMessage : &_message;
+    _messagesSent     = 0;
+    _messagesReceived = 0;
+    _badEchoes        = 0;
+    _startStats       = _ws->getStats();
+    _resultLabels[_run]->setString("running...");
+    _startTime = std::chrono::steady_clock::now();
+
+    sendMessages(ECHO_TEST_WINDOW);
+}
+
+void WebSocketEchoBenchmark::sendMessages(int count)
+{
+    for (; count > 0 && _messagesSent < ECHO_TEST_MESSAGES; --count, ++_messagesSent)
+        _ws->send(*_sending);
+}
+
+void WebSocketEchoBenchmark::onOpen(network::WebSocket* ws)
+{
+    _statusLabel->setString(fmt::format("Connected to {}, permessage-deflate {}", ws->getUrl(),
+                                        ws->isPerMessageDeflateActive() ? "on" : "off"));
+}
+
+void WebSocketEchoBenchmark::onMessage(network::WebSocket* ws, const network::WebSocket::Data& data) {}
+
+void WebSocketEchoBenchmark::onMessages(network::WebSocket* ws, std::span<const network::WebSocket::Data> messages)
+{
+    if (!_running)
+        return;
+
+    // a compressed round trip goes through both deflaters and inflaters, it must come back intact
+    for (auto&& message : messages)
+    {
+        if (std::string_view{message.bytes, message.len} != *_sending)
+            ++_badEchoes;
+    }
+
+    _messagesReceived += static_cast<int>(messages.size());
+    if (_messagesReceived < ECHO_TEST_MESSAGES)
+    {
+        // keep ECHO_TEST_WINDOW messages in flight
+        sendMessages(static_cast<int>(messages.size()));
+        return;
+    }
+
+    using namespace std::chrono;
+    static const char* runNames[] = {"unbatched", "batched", "compressed"};
+
+    auto elapsed = duration<double>(steady_clock::now() - _startTime).count();
+    auto stats   = ws->getStats();
+    auto messagesHandled =
+        (stats.messagesSent - _startStats.messagesSent) + (stats.messagesReceived - _startStats.messagesReceived);
+    auto allocations = stats.bufferAllocations - _startStats.bufferAllocations;
+    auto wireBytes   = (stats.bytesSent - _startStats.bytesSent) + (stats.bytesReceived - _startStats.bytesReceived);
+    auto result = fmt::format("{}: {:.0f} messages/sec, {:.3f} buffer allocations/message, {:.0f} wire bytes/message",
+                              runNames[_run], ECHO_TEST_MESSAGES / elapsed,
+                              static_cast<double>(allocations) / messagesHandled,
+                              static_cast<double>(wireBytes) / messagesHandled);
+    if (_badEchoes)
+        fmt::format_to(std::back_inserter(result), ", {} bad echoes", _badEchoes);
+    _resultLabels[_run]->setString(result);
+    _resultLabels[_run]->setTextColor(_badEchoes ? Color32::RED : Color32::WHITE);
+    _running = false;
+}
+
+void WebSocketEchoBenchmark::onClose(network::WebSocket* ws, uint16_t code, std::string_view reason)
+{
+    _statusLabel->setString(fmt::format("Closed: {} {}", code, reason));
+    _running = false;
+}
+
+void WebSocketEchoBenchmark::onError(network::WebSocket* ws, const network::WebSocket::ErrorCode& error)
+{
+    _statusLabel->setString(fmt::format("An error was fired, code: {}", static_cast<int>(error)));
+    _running = false;
+}
+#endif
@@ -143,4 +143,71 @@ private:
     int _receiveTextTimes = 0;
 };
 
+#if !defined(__EMSCRIPTEN__)
+// the loopback echo server can't run in a browser
+class WebSocketEchoBenchmark : public TestCase, public ax::network::WebSocket::Delegate
+{
+public:
+    CREATE_FUNC(WebSocketEchoBenchmark);
+
+    WebSocketEchoBenchmark();
+    virtual ~WebSocketEchoBenchmark();
+
+    virtual void onExit() override;
+
+    virtual void onOpen(ax::network::WebSocket* ws) override;
+    virtual void onMessage(ax::network::WebSocket* ws, const ax::network::WebSocket::Data& data) override;
+    virtual void onMessages(ax::network::WebSocket* ws,
+                            std::span<const ax::network::WebSocket::Data> messages) override;
+    virtual void onClose(ax::network::WebSocket* ws, uint16_t code, std::string_view reason) override;
+    virtual void onError(ax::network::WebSocket* ws, const ax::network::WebSocket::ErrorCode& error) override;
+
+    virtual std::string title() const override { return "WebSocket Echo Benchmark"; }
+    virtual std::string subtitle() const override { return "Messages/sec against a loopback echo server"; }
+
+private:
+    struct PerMessageDeflate;
+
+    struct ServerConnection
+    {
+        void sendFrame(int flags, const tlx::sbyte_buffer& payload);
+
+        std::string handshake;
+        bool upgraded = false;
+        websocket_parser parser;
+        tlx::sbyte_buffer payload;  // control frame
+        tlx::sbyte_buffer message;  // data frames of the current message
+        int opcode      = 0;
+        bool compressed = false;  // RSV1 was set on the first frame of the message
+        std::unique_ptr<PerMessageDeflate> deflate;
+        yasio::io_service* server;
+        yasio::transport_handle_t transport;
+    };
+
+    void startServer();
+    void handleServerEvent(yasio::io_event* event);
+
+    void runBenchmark(bool batched, bool compressed);
+    void sendMessages(int count);
+
+    yasio::io_service* _server = nullptr;
+    std::unordered_map<yasio::transport_handle_t, ServerConnection> _serverConnections;  // server thread only
+
+    ax::network::WebSocket* _ws = nullptr;
+    std::string _message;
+    std::string _compressibleMessage;  // long enough to be sent with permessage-deflate
+    const std::string* _sending = nullptr;
+
+    int _messagesSent     = 0;
+    int _messagesReceived = 0;
+    int _badEchoes        = 0;
+    ax::network::WebSocket::Stats _startStats;
+    std::chrono::steady_clock::time_point _startTime;
+    int _run                    = 0;
+    bool _running               = false;
+    ax::Label* _statusLabel     = nullptr;
+    ax::Label* _resultLabels[3] = {};
+};
+#endif
+
 #endif /* defined(__TestCpp__WebSocketTest__) */
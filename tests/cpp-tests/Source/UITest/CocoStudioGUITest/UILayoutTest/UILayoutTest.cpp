@@ -46,6 +46,8 @@ UILayoutTests::UILayoutTests()
     ADD_TEST_CASE(UILayoutComponent_Berth_Stretch_Test);
     ADD_TEST_CASE(UILayoutTest_Issue19890);
     ADD_TEST_CASE(UILayout_Clipping_Test);
+    ADD_TEST_CASE(UILayoutTest_RenderCache);
+    ADD_TEST_CASE(UILayoutTest_RenderCacheLabel);
 }
 
 // UILayoutTest
@@ -1136,3 +1138,116 @@ bool UILayout_Clipping_Test::init()
     }
     return false;
 }
+
+bool UILayoutTest_RenderCache::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    const Size widgetSize = _widget->getContentSize();
+
+    auto alert = Text::create("Render cache", "fonts/Marker Felt.ttf", 30);
+    alert->setColor(Color32(159, 168, 176));
+    alert->setPosition(
+        Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f - alert->getContentSize().height * 3.075f));
+    _uiLayer->addChild(alert);
+
+    Layout* root              = static_cast<Layout*>(_uiLayer->getChildByTag(81));
+    Layout* background        = dynamic_cast<Layout*>(root->getChildByName("background_Panel"));
+    const Size backgroundSize = background->getContentSize();
+
+    // a static panel with many widgets, drawn as one quad while cached
+    auto panel = Layout::create();
+    panel->setBackGroundColor(Color32(40, 40, 60));
+    panel->setBackGroundColorType(Layout::BackGroundColorType::SOLID);
+    panel->setContentSize(backgroundSize);
+    panel->setPosition(Vec2((widgetSize.width - backgroundSize.width) / 2.0f,
+                            (widgetSize.height - backgroundSize.height) / 2.0f));
+    panel->setRenderCacheEnabled(true);
+    _uiLayer->addChild(panel);
+
+    const int columns = 8;
+    const int rows    = 5;
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto button = Button::create("cocosui/button.png", "cocosui/buttonHighlighted.png");
+        button->setScale9Enabled(true);
+        button->setContentSize(Size(backgroundSize.width / columns - 4, backgroundSize.height / (rows + 1) - 4));
+        button->setTitleText(std::to_string(i));
+        button->setPosition(Vec2(backgroundSize.width / columns * (i % columns + 0.5f),
+                                 backgroundSize.height / (rows + 1) * (i / columns + 1.5f)));
+        panel->addChild(button);
+    }
+
+    // changes once a second, which re-renders the cache
+    auto clock = Text::create("0", "fonts/Marker Felt.ttf", 20);
+    clock->setPosition(Vec2(backgroundSize.width / 2.0f, backgroundSize.height / (rows + 1) * 0.5f));
+    panel->addChild(clock);
+    int seconds = 0;
+    clock->schedule([clock, seconds](float) mutable { clock->setString(std::to_string(++seconds)); }, 1.0f, "clock");
+
+    auto toggle = Button::create("cocosui/animationbuttonnormal.png", "cocosui/animationbuttonpressed.png");
+    toggle->setTitleText("Cache: on");
+    toggle->setPosition(Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f + backgroundSize.height / 2.0f + 20));
+    toggle->addClickEventListener([panel, toggle](Object*) {
+        panel->setRenderCacheEnabled(!panel->isRenderCacheEnabled());
+        toggle->setTitleText(panel->isRenderCacheEnabled() ? "Cache: on" : "Cache: off");
+    });
+    _uiLayer->addChild(toggle);
+
+    return true;
+}
+
+bool UILayoutTest_RenderCacheLabel::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    const Size widgetSize = _widget->getContentSize();
+
+    auto alert = Text::create("Render cache: both panels show the same text", "fonts/Marker Felt.ttf", 24);
+    alert->setColor(Color32(159, 168, 176));
+    alert->setPosition(
+        Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f - alert->getContentSize().height * 3.075f));
+    _uiLayer->addChild(alert);
+
+    // the labels have fixed dimensions, so a text change keeps their content size
+    const Size panelSize(widgetSize.width / 3.0f, widgetSize.height / 4.0f);
+    Label* labels[2] = {};
+    for (int i = 0; i < 2; ++i)
+    {
+        auto panel = Layout::create();
+        panel->setBackGroundColor(Color32(40, 40, 60));
+        panel->setBackGroundColorType(Layout::BackGroundColorType::SOLID);
+        panel->setContentSize(panelSize);
+        panel->setPosition(Vec2(widgetSize.width / 2.0f + (i == 0 ? -panelSize.width - 10 : 10),
+                                (widgetSize.height - panelSize.height) / 2.0f));
+        panel->setRenderCacheEnabled(i == 0);
+        _uiLayer->addChild(panel);
+
+        auto title = Label::createWithTTF(i == 0 ? "cached" : "not cached", "fonts/arial.ttf", 14);
+        title->setPosition(Vec2(panelSize.width / 2.0f, panelSize.height - 12));
+        panel->addChild(title);
+
+        labels[i] = Label::createWithTTF("", "fonts/arial.ttf", 24, Size(panelSize.width - 20, 40),
+                                         TextHAlignment::CENTER, TextVAlignment::CENTER);
+        labels[i]->setPosition(Vec2(panelSize.width / 2.0f, panelSize.height / 2.0f));
+        panel->addChild(labels[i]);
+    }
+
+    static const char* words[] = {"apple", "grape", "lemon", "melon", "peach"};
+    int index                  = 0;
+    _uiLayer->schedule(
+        [labels, index](float) mutable {
+            index = (index + 1) % (sizeof(words) / sizeof(words[0]));
+            for (auto label : labels)
+                label->setString(words[index]);
+        },
+        0.5f, "change_text");
+
+    return true;
+}
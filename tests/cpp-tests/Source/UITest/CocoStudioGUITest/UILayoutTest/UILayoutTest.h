@@ -199,4 +199,20 @@ public:
     CREATE_FUNC(UILayout_Clipping_Test);
 };
 
+class UILayoutTest_RenderCache : public UIScene
+{
+public:
+    virtual bool init() override;
+
+    CREATE_FUNC(UILayoutTest_RenderCache);
+};
+
+class UILayoutTest_RenderCacheLabel : public UIScene
+{
+public:
+    virtual bool init() override;
+
+    CREATE_FUNC(UILayoutTest_RenderCacheLabel);
+};
+
 #endif /* defined(__TestCpp__UILayoutTest__) */
@@ -41,6 +41,7 @@ UIListViewTests::UIListViewTests()
     ADD_TEST_CASE(UIListViewTest_PaddingHorizontal);
     ADD_TEST_CASE(Issue12692);
     ADD_TEST_CASE(Issue8316);
+    ADD_TEST_CASE(UIListViewTest_Virtual);
 }
 
 // UIListViewTest_Vertical
@@ -1061,3 +1062,70 @@ void UIListViewTest_Padding::sliderEvent(Object* pSender, Slider::EventType type
         }
     }
 }
+
+// UIListViewTest_Virtual
+bool UIListViewTest_Virtual::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    Size layerSize = _uiLayer->getContentSize();
+
+    auto titleLabel = Text::create("Virtual list of 10000 items", font_UIListViewTest, 32);
+    titleLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    titleLabel->setPosition(Vec2(layerSize / 2) + Vec2(0.0f, titleLabel->getContentSize().height * 3.15f));
+    _uiLayer->addChild(titleLabel, 3);
+
+    _statusLabel = Text::create("", font_UIListViewTest, 16);
+    _statusLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE_LEFT);
+    _statusLabel->setPosition(Vec2(layerSize / 2) + Vec2(layerSize.width / 4 + 10.0f, 0.0f));
+    _uiLayer->addChild(_statusLabel, 3);
+
+    _listView = ListView::create();
+    _listView->setDirection(ScrollView::Direction::VERTICAL);
+    _listView->setBounceEnabled(true);
+    _listView->setBackGroundImage("cocosui/green_edit.png");
+    _listView->setBackGroundImageScale9Enabled(true);
+    _listView->setContentSize(layerSize / 2);
+    _listView->setScrollBarPositionFromCorner(Vec2(7, 7));
+    _listView->setItemsMargin(2.0f);
+    _listView->setGravity(ListView::Gravity::CENTER_HORIZONTAL);
+    _listView->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _listView->setPosition(layerSize / 2);
+    _uiLayer->addChild(_listView);
+
+    auto model = Button::create("cocosui/backtotoppressed.png", "cocosui/backtotopnormal.png");
+    model->setScale9Enabled(true);
+    model->setTitleFontSize(16);
+    _listView->setItemModel(model);
+
+    // every tenth row is a taller section header
+    const float rowWidth = layerSize.width / 2 - 40;
+    _listView->setVirtualItems(
+        10000, [rowWidth](ssize_t index) { return Vec2(rowWidth, index % 10 == 0 ? 50.0f : 30.0f); },
+        [rowWidth](Widget* item, ssize_t index) {
+            auto button = static_cast<Button*>(item);
+            button->setContentSize(Size(rowWidth, index % 10 == 0 ? 50.0f : 30.0f));
+            button->setTitleText(fmt::format("#{}  player_{}  {} pts", index + 1, index, 1000000 - index * 97));
+        });
+
+    _listView->ScrollView::addEventListener([this](Object*, ScrollView::EventType eventType) {
+        if (eventType == ScrollView::EventType::CONTAINER_MOVED)
+        {
+            _statusLabel->setString(fmt::format("bound items: {}\nwidgets: {}", _listView->getItems().size(),
+                                                _listView->getChildrenCount()));
+        }
+    });
+
+    auto jumpButton = Button::create("cocosui/backtotoppressed.png", "cocosui/backtotopnormal.png");
+    jumpButton->setScale(0.8f);
+    jumpButton->setPosition(Vec2(layerSize / 2) + Vec2(layerSize.width / 4 + 70.0f, -60.0f));
+    jumpButton->setTitleText("Go to 5000");
+    jumpButton->addClickEventListener(
+        [this](Object*) { _listView->scrollToItem(4999, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE, 1.0f); });
+    _uiLayer->addChild(jumpButton);
+
+    return true;
+}
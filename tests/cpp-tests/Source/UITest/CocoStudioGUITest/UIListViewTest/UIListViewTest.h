@@ -219,4 +219,17 @@ public:
     }
 };
 
+// Test for a virtual list with recycled items
+class UIListViewTest_Virtual : public UIScene
+{
+public:
+    CREATE_FUNC(UIListViewTest_Virtual);
+
+    virtual bool init() override;
+
+protected:
+    ax::ui::ListView* _listView;
+    ax::ui::Text* _statusLabel;
+};
+
 #endif /* defined(__TestCpp__UIListViewTest__) */
@@ -55,6 +55,7 @@ UIRichTextTests::UIRichTextTests()
     ADD_TEST_CASE(UIRichTextDynamicFontSize);
     ADD_TEST_CASE(UIRichTextParagraph);
     ADD_TEST_CASE(UIRichTextScrollTo);
+    ADD_TEST_CASE(UIRichTextParseCache);
 }
 
 //
@@ -1220,3 +1221,126 @@ void UIRichTextScrollTo::updateScrollViewSize()
     _scrollView->setInnerContainerSize(Size(_scrollView->getInnerContainerSize().width, newHeight));
     _scrollView->scrollToTop(0.f, false);
 }
+
+namespace
+{
+// exposes the elements and renderers of a RichText so two instances can be compared
+class ElementProbeRichText : public RichText
+{
+public:
+    static ElementProbeRichText* create()
+    {
+        auto richText = new ElementProbeRichText();
+        if (richText->init())
+        {
+            richText->autorelease();
+            return richText;
+        }
+        AX_SAFE_DELETE(richText);
+        return nullptr;
+    }
+
+    const Vector<RichElement*>& getElements() const { return _richElements; }
+
+    std::string dumpRenderers()
+    {
+        formatText(true);
+
+        std::string out;
+        for (auto child : getProtectedChildren())
+        {
+            auto& pos  = child->getPosition();
+            auto& size = child->getContentSize();
+            if (auto label = dynamic_cast<Label*>(child))
+                fmt::format_to(std::back_inserter(out), "\"{}\" {} {} #{:08x}\n", label->getString(), pos.x, pos.y,
+                               label->getTextColor().value);
+            else
+                fmt::format_to(std::back_inserter(out), "node {} {} {}x{}\n", pos.x, pos.y, size.width, size.height);
+        }
+        return out;
+    }
+};
+}  // namespace
+
+bool UIRichTextParseCache::init()
+{
+    if (UIRichTextTestBase::init())
+    {
+        auto& widgetSize = _widget->getContentSize();
+
+        // two instances parse the same markup over and over, one of them then edits its elements, the other one
+        // must still lay out like a parse with the cache disabled
+        const char* markups[] = {
+            "Cached <b>markup</b> with an <img src='cocosui/sliderballnormal.png' width='20' height='20'/> image "
+            "and a line that is long enough to wrap a few times",
+            "<font color='#ff0000'>Another</font> string<br/>with a <a href='https://axmol.dev'>link</a> in it",
+            "Cached <b>markup</b> with an <img src='cocosui/sliderballnormal.png' width='20' height='20'/> image",
+        };
+
+        const auto capacity = RichText::getParseCacheCapacity();
+        RichText::clearParseCache();
+
+        auto reference = ElementProbeRichText::create();
+        auto first     = ElementProbeRichText::create();
+        auto second    = ElementProbeRichText::create();
+        for (auto richText : {reference, first, second})
+        {
+            richText->ignoreContentAdaptWithSize(false);
+            richText->setContentSize(Size(120, 100));
+        }
+
+        int checks = 0;
+        int failed = 0;
+        auto check = [&](bool passed, std::string_view what, const char* markup) {
+            ++checks;
+            if (!passed)
+            {
+                ++failed;
+                AXLOGW("RichText parse cache: {} for \"{}\"", what, markup);
+            }
+        };
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (auto markup : markups)
+            {
+                RichText::setParseCacheCapacity(0);
+                reference->setString(markup);
+                auto renderers = reference->dumpRenderers();
+                RichText::setParseCacheCapacity(capacity);
+
+                first->setString(markup);
+                second->setString(markup);
+                check(first->dumpRenderers() == renderers, "first instance differs", markup);
+                check(second->dumpRenderers() == renderers, "second instance differs", markup);
+
+                bool shared = false;
+                for (auto element : first->getElements())
+                    shared |= second->getElements().contains(element);
+                check(!shared, "elements are shared", markup);
+
+                // edit every element of the first instance
+                for (auto element : first->getElements())
+                {
+                    element->setColor(Color32::RED);
+                    if (element->equalType(RichElement::Type::IMAGE))
+                        static_cast<RichElementImage*>(element)->setWidth(7);
+                }
+                check(second->dumpRenderers() == renderers, "an edit leaked into the second instance", markup);
+            }
+        }
+        RichText::setParseCacheCapacity(capacity);
+
+        second->setPosition(Vec2(widgetSize.width / 2, widgetSize.height / 2));
+        _widget->addChild(second);
+
+        Text* result =
+            Text::create(fmt::format("{} of {} checks passed", checks - failed, checks), "fonts/arial.ttf", 18);
+        result->setColor(failed ? Color32::RED : Color32::GREEN);
+        result->setPosition(Vec2(widgetSize.width / 2, widgetSize.height / 2 - 70));
+        _widget->addChild(result);
+
+        return true;
+    }
+    return false;
+}
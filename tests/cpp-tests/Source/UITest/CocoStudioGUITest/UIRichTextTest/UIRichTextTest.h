@@ -240,4 +240,12 @@ protected:
     ax::ui::ScrollView* _scrollView;
 };
 
+class UIRichTextParseCache : public UIRichTextTestBase
+{
+public:
+    CREATE_FUNC(UIRichTextParseCache);
+
+    bool init() override;
+};
+
 #endif /* defined(__TestCpp__UIRichTextTest__) */
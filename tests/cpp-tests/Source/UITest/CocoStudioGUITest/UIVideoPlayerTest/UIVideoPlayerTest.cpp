@@ -41,6 +41,7 @@ VideoPlayerTests::VideoPlayerTests()
 {
     ADD_TEST_CASE(VideoPlayerTest);
     ADD_TEST_CASE(SimpleVideoPlayerTest);
+    ADD_TEST_CASE(VideoPlayerStatsTest);
 }
 
 bool VideoPlayerTest::init()
@@ -449,3 +450,103 @@ void SimpleVideoPlayerTest::createVideo()
     _videoPlayer->setFileName("video/h264/1920x1080.mp4");
     _videoPlayer->play();
 }
+
+// Video Upload Stats Test
+
+// 0 uploads every frame at once, a 1080p frame takes a few MB
+static const size_t sUploadBudgets[] = {0, 2 * 1024 * 1024, 512 * 1024};
+
+bool VideoPlayerStatsTest::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    _visibleRect = Director::getInstance()->getRenderView()->getVisibleRect();
+
+    MenuItemFont::setFontSize(16);
+
+    _switchBudget =
+        createMenuFontWithColor("Upload Budget", AX_CALLBACK_1(VideoPlayerStatsTest::switchBudgetCallback, this));
+    _switchBudget->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _switchBudget->setPosition(Vec2(_visibleRect.origin.x + 10, _visibleRect.origin.y + 50));
+
+    auto menu = Menu::create(_switchBudget, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    _uiLayer->addChild(menu);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _statsLabel->setPosition(Vec2(_visibleRect.origin.x + 10, _visibleRect.origin.y + _visibleRect.size.height - 60));
+    _uiLayer->addChild(_statsLabel);
+
+    return true;
+}
+
+void VideoPlayerStatsTest::onEnter()
+{
+    UIScene::onEnter();
+
+    createVideo();
+    schedule(AX_SCHEDULE_SELECTOR(VideoPlayerStatsTest::updateStats), 0.25f);
+}
+
+void VideoPlayerStatsTest::onExit()
+{
+    unschedule(AX_SCHEDULE_SELECTOR(VideoPlayerStatsTest::updateStats));
+    if (_videoPlayer)
+        _videoPlayer->removeFromParent();
+
+    UIScene::onExit();
+}
+
+void VideoPlayerStatsTest::switchBudgetCallback(Object* sender)
+{
+    _budgetIndex = (_budgetIndex + 1) % (sizeof(sUploadBudgets) / sizeof(sUploadBudgets[0]));
+
+    // the stats are cumulative, restart the video to compare the budgets from a clean state
+    createVideo();
+}
+
+void VideoPlayerStatsTest::createVideo()
+{
+    if (_videoPlayer)
+    {
+        _uiLayer->removeChild(_videoPlayer);
+    }
+    auto centerPos =
+        Vec2(_visibleRect.origin.x + _visibleRect.size.width / 2, _visibleRect.origin.y + _visibleRect.size.height / 2);
+
+    auto widgetSize = _widget->getContentSize();
+
+    _videoPlayer = VideoPlayer::create();
+    _videoPlayer->setPosition(centerPos);
+    _videoPlayer->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _videoPlayer->setContentSize(Size(widgetSize.width * 0.4f, widgetSize.height * 0.4f));
+    _videoPlayer->setLooping(true);
+    _videoPlayer->setKeepAspectRatioEnabled(true);
+    _videoPlayer->setVideoUploadBudget(sUploadBudgets[_budgetIndex]);
+
+    _uiLayer->addChild(_videoPlayer);
+
+    _videoPlayer->setFileName("video/h264/1920x1080.mp4");
+    _videoPlayer->play();
+
+    auto budget = _videoPlayer->getVideoUploadBudget();
+    _switchBudget->setString(budget ? fmt::format("< Upload Budget: {} KB/draw >", budget / 1024)
+                                    : std::string{"< Upload Budget: unlimited >"});
+}
+
+void VideoPlayerStatsTest::updateStats(float dt)
+{
+    if (!_videoPlayer)
+        return;
+
+    auto stats = _videoPlayer->getVideoStats();
+    _statsLabel->setString(
+        fmt::format("upload: {:.2f} ms (max {:.2f} ms)\ndecoded: {}\nuploaded: {}\ndropped: {}\nskipped: {}\n"
+                    "buffer allocations: {}",
+                    stats.lastUploadMs, stats.maxUploadMs, stats.framesDecoded, stats.framesUploaded,
+                    stats.framesDropped, stats.framesSkipped, stats.bufferAllocations));
+}
@@ -98,4 +98,30 @@ private:
     void updateButtonsTexts();
 };
 
+class VideoPlayerStatsTest : public UIScene
+{
+public:
+    CREATE_FUNC(VideoPlayerStatsTest);
+
+    virtual bool init() override;
+
+    virtual std::string title() const override { return "Video Upload Stats"; }
+    virtual std::string subtitle() const override { return "Switch the upload budget and compare the stats"; }
+
+    void switchBudgetCallback(ax::Object* sender);
+
+    void onEnter() override;
+    void onExit() override;
+
+private:
+    void createVideo();
+    void updateStats(float dt);
+
+    ax::Rect _visibleRect;
+    ax::ui::VideoPlayer* _videoPlayer = nullptr;
+    ax::MenuItemFont* _switchBudget   = nullptr;
+    ax::Label* _statsLabel            = nullptr;
+    int _budgetIndex                  = 0;
+};
+
 #endif  // __tests__VideoPlayerTest__
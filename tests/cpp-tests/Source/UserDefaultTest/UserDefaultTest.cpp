@@ -29,6 +29,7 @@
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <chrono>
 
 #include "axmol/tlx/format.hpp"
 
@@ -39,6 +40,7 @@ using namespace ax;
 UserDefaultTests::UserDefaultTests()
 {
     ADD_TEST_CASE(UserDefaultTest);
+    ADD_TEST_CASE(UserDefaultBenchmark);
 }
 
 UserDefaultTest::UserDefaultTest()
@@ -205,3 +207,95 @@ void UserDefaultTest::printValue()
 }
 
 UserDefaultTest::~UserDefaultTest() {}
+
+//------------------------------------------------------------------
+//
+// UserDefaultBenchmark
+//
+//------------------------------------------------------------------
+static const int BENCHMARK_KEYS = 2000;
+
+static std::string benchmarkFilePath()
+{
+    return FileUtils::getInstance()->getNativeWritableAbsolutePath() + "bench_UserDefault.bin";
+}
+
+UserDefaultBenchmark::UserDefaultBenchmark()
+{
+    auto s = Director::getInstance()->getCanvasSize();
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _label->setPosition(Vec2(s.width / 2, s.height / 2));
+    addChild(_label);
+
+    // use a storage of its own, the application one is reopened by the next getInstance()
+    UserDefault::destroyInstance();
+    UserDefault::setFileName("bench_");
+
+    std::string result = runCommits(false);
+    result += runCommits(true);
+    result += fmt::format("torn commit recovery: {}", checkCrashRecovery() ? "OK" : "FAILED");
+
+    UserDefault::destroyInstance();
+    FileUtils::getInstance()->removeFile(benchmarkFilePath());
+    UserDefault::setFileName();
+
+    AXLOGD("{}", result);
+    _label->setString(result);
+}
+
+std::string UserDefaultBenchmark::runCommits(bool transaction)
+{
+    UserDefault::destroyInstance();
+    FileUtils::getInstance()->removeFile(benchmarkFilePath());
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < BENCHMARK_KEYS; ++i)
+        keys.emplace_back(fmt::format("key{}", i));
+
+    auto userDefault = UserDefault::getInstance();
+    userDefault->getBoolForKey("");  // open the storage outside of the measure
+
+    auto start = std::chrono::steady_clock::now();
+    if (transaction)
+        userDefault->beginTransaction();
+    for (int i = 0; i < BENCHMARK_KEYS; ++i)
+    {
+        userDefault->setIntegerForKey(keys[i].c_str(), i);
+        userDefault->setDoubleForKey(keys[i].c_str(), i * 0.5);
+    }
+    if (transaction)
+        userDefault->commitTransaction();
+    auto setTime = std::chrono::steady_clock::now() - start;
+    userDefault->flush();
+    auto flushTime = std::chrono::steady_clock::now() - start;
+
+    auto& stats = userDefault->getStats();
+    return fmt::format("{}: {} sets in {:.2f}ms, {:.2f}ms until written\n{} commits, {} compactions, {} bytes\n\n",
+                       transaction ? "one transaction" : "commit per set", BENCHMARK_KEYS * 2,
+                       std::chrono::duration<double, std::milli>(setTime).count(),
+                       std::chrono::duration<double, std::milli>(flushTime).count(), stats.commits, stats.compactions,
+                       stats.journalSize);
+}
+
+bool UserDefaultBenchmark::checkCrashRecovery()
+{
+    UserDefault::destroyInstance();
+
+    // a commit cut short by a crash: the frame header announces more payload than was written
+    {
+        FileStream fs;
+        if (!fs.open(benchmarkFilePath(), IFileStream::Mode::APPEND))
+            return false;
+        const char tornCommit[] = {0, 0, 1, 0, 0x12, 0x34, 0x56, 0x78, 'k', 'e', 'y'};
+        fs.write(tornCommit, sizeof(tornCommit));
+    }
+
+    auto userDefault = UserDefault::getInstance();
+    for (int i = 0; i < BENCHMARK_KEYS; ++i)
+    {
+        if (userDefault->getDoubleForKey(fmt::format("key{}", i).c_str(), -1) != i * 0.5)
+            return false;
+    }
+    return true;
+}
@@ -44,4 +44,20 @@ private:
     ax::Label* _label;
 };
 
+// times per-set commits against one transaction, then reloads the storage after a torn commit
+class UserDefaultBenchmark : public TestCase
+{
+public:
+    CREATE_FUNC(UserDefaultBenchmark);
+    UserDefaultBenchmark();
+
+    std::string title() const override { return "UserDefault commit benchmark"; }
+    std::string subtitle() const override { return "Results are logged to the console as well"; }
+
+private:
+    std::string runCommits(bool transaction);
+    bool checkCrashRecovery();
+    ax::Label* _label;
+};
+
 #endif  // _USERDEFAULT_TEST_H_
@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 layout(location = POSITION) in vec4 a_position;
 layout(location = NORMAL) in vec3 a_normal;
@@ -8,12 +9,13 @@ layout(location = NORMAL) in vec3 a_normal;
 layout(std140, set = 0, binding = 0) uniform vs_ub {
     float OutlineWidth;
     mat4 u_MVPMatrix;
+    float u_compactVertex;
 };
 
 void main(void)
 {
     vec4 pos = u_MVPMatrix * a_position;
-    vec4 normalproj = u_MVPMatrix * vec4(a_normal, 0);
+    vec4 normalproj = u_MVPMatrix * vec4(decodeDirection(a_normal, u_compactVertex), 0);
     normalproj = normalize(normalproj);
     pos.xy += normalproj.xy * (OutlineWidth * (pos.z * 0.5 + 0.5));
 
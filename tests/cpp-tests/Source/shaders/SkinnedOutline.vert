@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 layout(location = POSITION) in vec3 a_position;
 layout(location = NORMAL) in vec3 a_normal;
@@ -18,13 +19,15 @@ layout(std140, set = 0, binding = 0) uniform vs_ub {
     float OutlineWidth;
     vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];
     mat4 u_MVPMatrix;
+    float u_compactVertex;
 };
 
 vec4 SkinnedVec3(vec4 vec)
 {
+    vec4 blendIndex = decodeBlendIndex(a_blendIndex, u_compactVertex);
     float blendWeight = a_blendWeight[0];
 
-    int matrixIndex = int (a_blendIndex[0]) * 3;
+    int matrixIndex = int(blendIndex[0] + 0.5) * 3;
     vec4 matrixPalette1 = u_matrixPalette[matrixIndex] * blendWeight;
     vec4 matrixPalette2 = u_matrixPalette[matrixIndex + 1] * blendWeight;
     vec4 matrixPalette3 = u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -33,7 +36,7 @@ vec4 SkinnedVec3(vec4 vec)
     blendWeight = a_blendWeight[1];
     if (blendWeight > 0.0)
     {
-        matrixIndex = int(a_blendIndex[1]) * 3;
+        matrixIndex = int(blendIndex[1] + 0.5) * 3;
         matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
         matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
         matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -43,7 +46,7 @@ vec4 SkinnedVec3(vec4 vec)
     blendWeight = a_blendWeight[2];
     if (blendWeight > 0.0)
     {
-        matrixIndex = int(a_blendIndex[2]) * 3;
+        matrixIndex = int(blendIndex[2] + 0.5) * 3;
         matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
         matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
         matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -53,7 +56,7 @@ vec4 SkinnedVec3(vec4 vec)
     blendWeight = a_blendWeight[3];
     if (blendWeight > 0.0)
     {
-        matrixIndex = int(a_blendIndex[3]) * 3;
+        matrixIndex = int(blendIndex[3] + 0.5) * 3;
         matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
         matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
         matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -74,7 +77,7 @@ void main()
 {
     vec4 pos = u_MVPMatrix * SkinnedVec3(vec4(a_position,1.0));
     
-    vec4 normalproj = u_MVPMatrix * vec4(SkinnedVec3(vec4(a_normal,0.0)).xyz, 0);
+    vec4 normalproj = u_MVPMatrix * vec4(SkinnedVec3(vec4(decodeDirection(a_normal, u_compactVertex), 0.0)).xyz, 0);
     normalproj = normalize(normalproj);
     pos.xy += normalproj.xy * (OutlineWidth * (pos.z * 0.5 + 0.5));
 
@@ -1,4 +1,7 @@
 #version 310 es
+
+#include "compactVertex.glsl"
+
 layout(location = POSITION) in vec4 a_position;
 layout(location = NORMAL) in vec3 a_normal;
 
@@ -9,6 +12,7 @@ layout(std140, set = 0, binding = 0) uniform vs_ub {
     mat4 u_MVPMatrix;
     mat4 u_MVMatrix;
     mat3 u_NormalMatrix;
+    float u_compactVertex;
 };
 
 void main(void)
@@ -19,6 +23,6 @@ void main(void)
     vec4 positionWorldViewSpace = u_MVMatrix * a_position;
     vec3 vEyeVertex     = normalize(positionWorldViewSpace.xyz);
     
-    vec3 v_normalVector = u_NormalMatrix * a_normal;
+    vec3 v_normalVector = u_NormalMatrix * decodeDirection(a_normal, u_compactVertex);
     v_reflect           = normalize(reflect(-vEyeVertex, v_normalVector));
 }
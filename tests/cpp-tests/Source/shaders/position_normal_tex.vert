@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 #define MAX_POINT_LIGHT_NUM 1
 #define MAX_SPOT_LIGHT_NUM 1
@@ -36,6 +37,7 @@ layout(std140, set = 0, binding = 0) uniform vs_ub {
     mat4 u_MVMatrix;
     mat4 u_PMatrix;
     mat3 u_NormalMatrix;
+    float u_compactVertex;
 };
 
 void main(void)
@@ -56,7 +58,7 @@ void main(void)
 #endif
         
 #if ((MAX_DIRECTIONAL_LIGHT_NUM > 0) || (MAX_POINT_LIGHT_NUM > 0) || (MAX_SPOT_LIGHT_NUM > 0))
-    v_normal = u_NormalMatrix * a_normal;
+    v_normal = u_NormalMatrix * decodeDirection(a_normal, u_compactVertex);
 #endif
 
     v_texCoord = a_texCoord;
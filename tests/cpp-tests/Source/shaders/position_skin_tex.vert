@@ -1,6 +1,7 @@
 #version 310 es
 
 #include "base.glsl"
+#include "compactVertex.glsl"
 
 layout(location = POSITION) in vec3 a_position;
 
@@ -18,13 +19,15 @@ layout(location = TEXCOORD0) out vec2 v_texCoord;
 layout(std140, set = 0, binding = 0) uniform vs_ub {
     vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];
     mat4 u_MVPMatrix;
+    float u_compactVertex;
 };
 
 vec4 getPosition()
 {
+    vec4 blendIndex = decodeBlendIndex(a_blendIndex, u_compactVertex);
     float blendWeight = a_blendWeight[0];
 
-    int matrixIndex = int (a_blendIndex[0]) * 3;
+    int matrixIndex = int(blendIndex[0] + 0.5) * 3;
     vec4 matrixPalette1 = u_matrixPalette[matrixIndex] * blendWeight;
     vec4 matrixPalette2 = u_matrixPalette[matrixIndex + 1] * blendWeight;
     vec4 matrixPalette3 = u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -33,7 +36,7 @@ vec4 getPosition()
     blendWeight = a_blendWeight[1];
     if (blendWeight > 0.0)
     {
-        matrixIndex = int(a_blendIndex[1]) * 3;
+        matrixIndex = int(blendIndex[1] + 0.5) * 3;
         matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
         matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
         matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -41,7 +44,7 @@ vec4 getPosition()
         blendWeight = a_blendWeight[2];
         if (blendWeight > 0.0)
         {
-            matrixIndex = int(a_blendIndex[2]) * 3;
+            matrixIndex = int(blendIndex[2] + 0.5) * 3;
             matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
             matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
             matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
@@ -49,7 +52,7 @@ vec4 getPosition()
             blendWeight = a_blendWeight[3];
             if (blendWeight > 0.0)
             {
-                matrixIndex = int(a_blendIndex[3]) * 3;
+                matrixIndex = int(blendIndex[3] + 0.5) * 3;
                 matrixPalette1 += u_matrixPalette[matrixIndex] * blendWeight;
                 matrixPalette2 += u_matrixPalette[matrixIndex + 1] * blendWeight;
                 matrixPalette3 += u_matrixPalette[matrixIndex + 2] * blendWeight;
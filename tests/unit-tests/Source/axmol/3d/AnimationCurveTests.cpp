@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "axmol/3d/AnimationCurve.h"
+
+using namespace ax;
+
+TEST_SUITE("3d/AnimationCurve")
+{
+    static void makeTranslationKeys(std::vector<float>& keys, std::vector<float>& values, int count)
+    {
+        keys.resize(count);
+        values.resize(count * 3);
+        for (int i = 0; i < count; ++i)
+        {
+            float t           = i / float(count - 1);
+            keys[i]           = t;
+            values[i * 3]     = std::sin(t * 6.0f) * 10.0f;
+            values[i * 3 + 1] = t * 4.0f;  // linear, reduced to end points
+            values[i * 3 + 2] = 0.5f;
+        }
+    }
+
+    static void makeRotationKeys(std::vector<float>& keys, std::vector<float>& values, int count)
+    {
+        keys.resize(count);
+        values.resize(count * 4);
+        for (int i = 0; i < count; ++i)
+        {
+            float t = i / float(count - 1);
+            keys[i] = t;
+            Quaternion q(Vec3(0.3f, 1.0f, 0.2f).getNormalized(), t * 5.0f);
+            q.multiply(Quaternion(Vec3::UNIT_X, std::sin(t * 3.0f)));
+            values[i * 4]     = q.x;
+            values[i * 4 + 1] = q.y;
+            values[i * 4 + 2] = q.z;
+            values[i * 4 + 3] = q.w;
+        }
+    }
+
+    TEST_CASE("compressed_vec3")
+    {
+        std::vector<float> keys, values;
+        makeTranslationKeys(keys, values, 300);
+
+        const float maxError = 0.001f;
+        auto raw             = AnimationCurve<3>::create(keys.data(), values.data(), (int)keys.size());
+        auto compressed      = AnimationCurve<3>::createCompressed(keys.data(), values.data(), (int)keys.size(), maxError);
+
+        CHECK(compressed->isCompressed());
+        CHECK_LT(compressed->getKeyCount(), raw->getKeyCount());
+        CHECK_LT(compressed->getMemorySize() * 2, raw->getMemorySize());
+        CHECK_EQ(compressed->getStartTime(), doctest::Approx(raw->getStartTime()));
+        CHECK_EQ(compressed->getEndTime(), doctest::Approx(raw->getEndTime()));
+
+        // reduction error plus half a quantization step of the 20 unit range
+        const float tolerance = maxError + 20.0f / 65535.0f;
+        for (int i = 0; i <= 1000; ++i)
+        {
+            float time = i / 1000.0f;
+            float expected[3], actual[3];
+            raw->evaluate(time, expected, EvaluateType::INT_LINEAR);
+            compressed->evaluate(time, actual, EvaluateType::INT_LINEAR);
+            for (int c = 0; c < 3; ++c)
+                CHECK_LE(std::abs(expected[c] - actual[c]), tolerance);
+        }
+    }
+
+    TEST_CASE("compressed_quat")
+    {
+        std::vector<float> keys, values;
+        makeRotationKeys(keys, values, 300);
+
+        const float maxError = 0.0005f;
+        auto raw             = AnimationCurve<4>::create(keys.data(), values.data(), (int)keys.size());
+        auto compressed      = AnimationCurve<4>::createCompressed(keys.data(), values.data(), (int)keys.size(), maxError);
+
+        CHECK(compressed->isCompressed());
+        CHECK_LT(compressed->getMemorySize() * 2, raw->getMemorySize());
+
+        for (int i = 0; i <= 1000; ++i)
+        {
+            float time = i / 1000.0f;
+            float expected[4], actual[4];
+            raw->evaluate(time, expected, EvaluateType::INT_QUAT_SLERP);
+            compressed->evaluate(time, actual, EvaluateType::INT_QUAT_SLERP);
+            // q and -q are the same rotation
+            float dot = std::abs(expected[0] * actual[0] + expected[1] * actual[1] + expected[2] * actual[2] +
+                                 expected[3] * actual[3]);
+            CHECK_GE(dot, 0.9999f);
+        }
+    }
+
+    TEST_CASE("stream")
+    {
+        std::vector<float> keys, values;
+        makeTranslationKeys(keys, values, 64);
+
+        auto compressed = AnimationCurve<3>::createCompressed(keys.data(), values.data(), (int)keys.size(), 0.001f);
+        yasio::fast_obstream obs;
+        compressed->writeCompressed(obs);
+
+        yasio::fast_ibstream_view ibs(obs.data(), obs.length());
+        auto loaded = AnimationCurve<3>::createFromStream(ibs);
+        CHECK_EQ(loaded->getKeyCount(), compressed->getKeyCount());
+
+        for (int i = 0; i <= 100; ++i)
+        {
+            float time = i / 100.0f;
+            float expected[3], actual[3];
+            compressed->evaluate(time, expected, EvaluateType::INT_LINEAR);
+            loaded->evaluate(time, actual, EvaluateType::INT_LINEAR);
+            for (int c = 0; c < 3; ++c)
+                CHECK_EQ(expected[c], actual[c]);
+        }
+    }
+
+    TEST_CASE("stream_truncated")
+    {
+        std::vector<float> keys, values;
+        makeTranslationKeys(keys, values, 64);
+
+        auto compressed = AnimationCurve<3>::createCompressed(keys.data(), values.data(), (int)keys.size(), 0.001f);
+        yasio::fast_obstream obs;
+        compressed->writeCompressed(obs);
+
+        // the key count no longer matches the data that follows
+        yasio::fast_ibstream_view ibs(obs.data(), obs.length() - 2);
+        CHECK_EQ(AnimationCurve<3>::createFromStream(ibs), nullptr);
+
+        yasio::fast_obstream bogus;
+        bogus.write<int32_t>(0x7fffffff);
+        bogus.fill_bytes(64);
+        yasio::fast_ibstream_view bogusIbs(bogus.data(), bogus.length());
+        CHECK_EQ(AnimationCurve<3>::createFromStream(bogusIbs), nullptr);
+    }
+}